@@ -0,0 +1,185 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+extern char** environ;
+#define FK_CT_CAN_SPAWN 1
+#endif
+
+/* Compile time matrix of template heavy pipeline construction.
+ *
+ * Each cell compiles compile_time_case.cpp with the compiler that built this
+ * benchmark (FK_CT_COMPILER, FK_CT_FLAGS and FK_CT_INCLUDE_DIR are set by
+ * benchmarks/CMakeLists.txt) along one of four axes:
+ *   pipeline   - number of compute IOps in a TransformDPP
+ *   batch      - BATCH of a Crop + Resize read
+ *   tuple      - .then() steps folded into one fused IOp (OperationTuple depth)
+ *   divergent  - sequences of a DivergentBatchTransformDPP
+ * Every cell is compiled twice: -fsyntax-only for the frontend (parsing and
+ * template instantiation) and -c for the full compilation. The report holds
+ * the frontend wall time statistics plus, as metrics, frontend CPU time,
+ * full compile time, the peak RSS of both compiler processes and the size
+ * of the object file. FK_BENCHMARK_QUICK=1 runs the two smallest sizes of
+ * each axis once. */
+
+namespace {
+
+struct CompileTimeAxis {
+    int id;
+    const char* name;
+    std::vector<int> sizes;
+};
+
+struct CompileRun {
+    bool ok{ false };
+    double wallMs{ 0. };
+    double cpuMs{ 0. };
+    long maxRssKB{ 0 };
+};
+
+#if defined(FK_CT_CAN_SPAWN) && defined(FK_CT_COMPILER)
+std::vector<CompileTimeAxis> compileTimeAxes() {
+    std::vector<CompileTimeAxis> axes{ { 0, "pipeline", { 1, 4, 16, 64 } },
+                                       { 1, "batch", { 1, 10, 50, 100 } },
+                                       { 2, "tuple", { 1, 4, 16, 64 } },
+                                       { 3, "divergent", { 1, 4, 16, 32 } } };
+    if (cpuBenchmarkQuick()) {
+        for (CompileTimeAxis& axis : axes) axis.sizes.resize(2);
+    }
+    return axes;
+}
+
+std::vector<std::string> splitCompileFlags(const std::string& flags) {
+    std::vector<std::string> args;
+    size_t pos = 0;
+    while (pos < flags.size()) {
+        const size_t end = flags.find(' ', pos);
+        const std::string arg = flags.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        if (!arg.empty()) args.push_back(arg);
+        if (end == std::string::npos) break;
+        pos = end + 1;
+    }
+    return args;
+}
+
+// Runs the compiler on one cell; wall time from the parent, CPU time and
+// peak RSS of the child from wait4.
+CompileRun compileCase(const int axis, const int size, const bool syntaxOnly, const std::string& object) {
+    std::vector<std::string> args{ FK_CT_COMPILER };
+    for (std::string& flag : splitCompileFlags(FK_CT_FLAGS)) args.push_back(std::move(flag));
+    args.push_back(std::string("-I") + FK_CT_INCLUDE_DIR);
+    args.push_back("-DFK_CT_AXIS=" + std::to_string(axis));
+    args.push_back("-DFK_CT_SIZE=" + std::to_string(size));
+    if (syntaxOnly) {
+        args.push_back("-fsyntax-only");
+    } else {
+        args.insert(args.end(), { "-c", "-o", object });
+    }
+    args.push_back(FK_CT_CASE_SOURCE);
+
+    std::vector<char*> argv;
+    for (std::string& arg : args) argv.push_back(arg.data());
+    argv.push_back(nullptr);
+
+    CompileRun run;
+    const auto start = std::chrono::steady_clock::now();
+    pid_t pid;
+    if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) return run;
+    int status = 0;
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) != pid) return run;
+    run.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    run.cpuMs = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+                (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-3;
+#if defined(__APPLE__)
+    run.maxRssKB = usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    run.maxRssKB = usage.ru_maxrss;
+#endif
+    run.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return run;
+}
+
+bool benchmarkCompileTime(BenchmarkReport& report, const CompileTimeAxis& axis, const int size) {
+    const int samples = cpuBenchmarkQuick() ? 1 : 3;
+    const std::string object = (std::filesystem::temp_directory_path() /
+        ("fk_compile_time_" + std::to_string(axis.id) + "_" + std::to_string(size) + ".o")).string();
+
+    std::vector<double> frontendMs;
+    double frontendCpuMs = 0., fullMs = 0.;
+    long frontendRss = 0, fullRss = 0;
+    for (int i = 0; i < samples; ++i) {
+        const CompileRun frontend = compileCase(axis.id, size, true, object);
+        const CompileRun full = compileCase(axis.id, size, false, object);
+        if (!frontend.ok || !full.ok) {
+            std::printf("compile of %s=%d failed\n", axis.name, size);
+            return false;
+        }
+        frontendMs.push_back(frontend.wallMs);
+        frontendCpuMs += frontend.cpuMs / samples;
+        fullMs += full.wallMs / samples;
+        frontendRss = std::max(frontendRss, frontend.maxRssKB);
+        fullRss = std::max(fullRss, full.maxRssKB);
+    }
+    std::error_code error;
+    const auto objectBytes = std::filesystem::file_size(object, error);
+    std::filesystem::remove(object, error);
+
+    const BenchmarkStats stats = computeBenchmarkStats(frontendMs);
+    report.add("CompileTime/" + std::string(axis.name), { { "axis", axis.name }, { "size", std::to_string(size) } },
+               stats, { { "frontend_cpu_ms", frontendCpuMs },
+                        { "frontend_max_rss_kb", static_cast<double>(frontendRss) },
+                        { "full_ms", fullMs },
+                        { "full_max_rss_kb", static_cast<double>(fullRss) },
+                        { "object_bytes", static_cast<double>(objectBytes) } });
+    std::printf("%-10s %4d  frontend %9.1f ms %8ld KB  full %9.1f ms %8ld KB  object %9zu B\n",
+                axis.name, size, stats.p50Ms, frontendRss, fullMs, fullRss, static_cast<size_t>(objectBytes));
+    return true;
+}
+#endif // defined(FK_CT_CAN_SPAWN) && defined(FK_CT_COMPILER)
+
+} // namespace
+
+int launch() {
+#if defined(FK_CT_CAN_SPAWN) && defined(FK_CT_COMPILER)
+    BenchmarkReport report;
+    bool ok = true;
+    for (const CompileTimeAxis& axis : compileTimeAxes()) {
+        for (const int size : axis.sizes) {
+            ok &= benchmarkCompileTime(report, axis, size);
+        }
+    }
+    writeCpuBenchmarkReport(report, "benchmark_compile_time");
+    return ok ? 0 : -1;
+#else
+    std::printf("benchmark_compile_time: needs a GCC or Clang compatible compiler on a POSIX host, skipped\n");
+    return 0;
+#endif
+}
@@ -0,0 +1,100 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// One cell of the compile time matrix, compiled (never linked) by
+// benchmark_compile_time with:
+//   FK_CT_AXIS  0: TransformDPP pipeline with FK_CT_SIZE compute IOps
+//               1: batched Crop + Resize with BATCH = FK_CT_SIZE
+//               2: one fused IOp built with FK_CT_SIZE .then() steps
+//               3: DivergentBatchTransformDPP with FK_CT_SIZE sequences
+//   FK_CT_SIZE  size along that axis
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/image_processing/crop.h>
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+#include <utility>
+
+#if !defined(FK_CT_AXIS) || !defined(FK_CT_SIZE)
+#error "FK_CT_AXIS and FK_CT_SIZE must be defined"
+#endif
+
+constexpr fk::ParArch CT_PA = fk::ParArch::CPU;
+
+struct CompileTimePlaneSelector {
+    FK_HOST_DEVICE_FUSE uint at(const uint& zIdx) { return zIdx; }
+};
+
+template <size_t... Is>
+void pipelineCase(fk::Stream_<CT_PA>& stream, const fk::Ptr2D<float>& input, const fk::Ptr2D<float>& output,
+                  std::index_sequence<Is...>) {
+    fk::executeOperations<fk::TransformDPP<CT_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, float>::build(input),
+        fk::Add<float>::build(static_cast<float>(Is))..., fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+}
+
+template <size_t BATCH>
+void batchCase(fk::Stream_<CT_PA>& stream, const fk::Ptr2D<float>& input, const fk::Tensor<float>& output) {
+    std::array<fk::Rect, BATCH> crops{};
+    for (size_t i = 0; i < BATCH; ++i) crops[i] = fk::Rect(static_cast<int>(i), 0, 16, 16);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, float>::build(input)
+        .then(fk::Crop<>::build(crops))
+        .then(fk::Resize<fk::InterpolationType::INTER_LINEAR>::build(fk::Size(8, 8)));
+    fk::executeOperations<fk::TransformDPP<CT_PA>>(stream, read, fk::Mul<float>::build(2.f),
+                                                   fk::PerThreadWrite<fk::ND::_3D, float>::build(output.ptr()));
+}
+
+template <size_t... Is>
+void tupleCase(fk::Stream_<CT_PA>& stream, const fk::Ptr2D<float>& input, const fk::Ptr2D<float>& output,
+               std::index_sequence<Is...>) {
+    const auto fused = fk::Add<float>::build(0.f).then(fk::Add<float>::build(static_cast<float>(Is + 1))...);
+    fk::executeOperations<fk::TransformDPP<CT_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, float>::build(input),
+                                                   fused, fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+}
+
+template <size_t I>
+auto divergentSequence(const fk::Ptr2D<float>& input, const fk::Tensor<float>& output) {
+    if constexpr (I % 2 == 0) {
+        return fk::buildOperationSequence(fk::PerThreadRead<fk::ND::_2D, float>::build(input),
+            fk::Add<float>::build(static_cast<float>(I)), fk::PerThreadWrite<fk::ND::_3D, float>::build(output.ptr()));
+    } else {
+        return fk::buildOperationSequence(fk::PerThreadRead<fk::ND::_2D, float>::build(input),
+            fk::Mul<float>::build(static_cast<float>(I)), fk::PerThreadWrite<fk::ND::_3D, float>::build(output.ptr()));
+    }
+}
+
+template <size_t... Is>
+void divergentCase(fk::Stream_<CT_PA>& stream, const fk::Ptr2D<float>& input, const fk::Tensor<float>& output,
+                   std::index_sequence<Is...>) {
+    fk::executeOperations<fk::DivergentBatchTransformDPP<CT_PA, CompileTimePlaneSelector>>(
+        stream, divergentSequence<Is>(input, output)...);
+}
+
+// Externally visible so that everything above is instantiated and emitted
+void fkCompileTimeCase(fk::Stream_<CT_PA>& stream, const fk::Ptr2D<float>& input, const fk::Ptr2D<float>& output,
+                       const fk::Tensor<float>& batchOutput) {
+#if FK_CT_AXIS == 0
+    pipelineCase(stream, input, output, std::make_index_sequence<FK_CT_SIZE>{});
+#elif FK_CT_AXIS == 1
+    batchCase<FK_CT_SIZE>(stream, input, batchOutput);
+#elif FK_CT_AXIS == 2
+    tupleCase(stream, input, output, std::make_index_sequence<FK_CT_SIZE>{});
+#elif FK_CT_AXIS == 3
+    divergentCase(stream, input, batchOutput, std::make_index_sequence<FK_CT_SIZE>{});
+#else
+#error "Unknown FK_CT_AXIS"
+#endif
+}
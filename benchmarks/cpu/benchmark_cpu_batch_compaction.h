@@ -0,0 +1,163 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+#include <cmath>
+
+// Batches of crops with skewed sizes (most small, a few large, as face
+// crops), processed by TransformDPP over the max-extent grid, by
+// CompactedBatchTransformDPP over the real pixels only, and by one
+// TransformDPP launch per crop. Crops and outputs live inside allocations
+// of the largest crop, so the max-extent grid stays in bounds.
+
+namespace {
+
+constexpr int BATCH = 64;
+
+struct CropBatch {
+    int minSide;
+    int maxSide;
+    double skew;  // side = min + (max - min) * u^skew
+    std::array<int, BATCH> widths{};
+    std::array<int, BATCH> heights{};
+    fk::Ptr2D<uchar3> source;
+    std::array<fk::Ptr2D<uchar3>, BATCH> crops;
+    std::array<fk::Ptr2D<float3>, BATCH> outputs;
+    std::array<fk::Ptr2D<float3>, BATCH> outputViews;
+    double pixels{ 0. };
+
+    CropBatch(const int minSide_, const int maxSide_, const double skew_)
+        : minSide(minSide_), maxSide(maxSide_), skew(skew_),
+          source(maxSide_ + 2 * BATCH, maxSide_ + 2 * BATCH, 0, fk::MemType::Host) {
+        for (int y = 0; y < static_cast<int>(source.dims().height); ++y) {
+            for (int x = 0; x < static_cast<int>(source.dims().width); ++x) {
+                source.at(fk::Point{ x, y, 0 }) = fk::make_set<uchar3>(static_cast<uchar>((x * 7 + y * 13) % 251));
+            }
+        }
+        uint state = 12345u;
+        const auto uniform = [&state] {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<double>(state >> 8) / static_cast<double>(1u << 24);
+        };
+        for (int i = 0; i < BATCH; ++i) {
+            widths[i] = minSide + static_cast<int>((maxSide - minSide) * std::pow(uniform(), skew));
+            heights[i] = minSide + static_cast<int>((maxSide - minSide) * std::pow(uniform(), skew));
+            pixels += static_cast<double>(widths[i]) * heights[i];
+            crops[i] = source.crop(fk::Point{ i, 2 * i, 0 },
+                                   fk::PtrDims<fk::ND::_2D>(widths[i], heights[i], source.dims().pitch));
+            outputs[i] = fk::Ptr2D<float3>(maxSide, maxSide, 0, fk::MemType::Host);
+            outputViews[i] = outputs[i].crop(fk::Point{ 0, 0, 0 },
+                                             fk::PtrDims<fk::ND::_2D>(widths[i], heights[i], outputs[i].dims().pitch));
+        }
+    }
+};
+
+bool sameRealPixels(const CropBatch& batch, const std::array<fk::Ptr2D<float3>, BATCH>& other) {
+    for (int i = 0; i < BATCH; ++i) {
+        for (int y = 0; y < batch.heights[i]; ++y) {
+            for (int x = 0; x < batch.widths[i]; ++x) {
+                const float3 a = batch.outputs[i].at(fk::Point{ x, y, 0 });
+                const float3 b = other[i].at(fk::Point{ x, y, 0 });
+                if (a.x != b.x || a.y != b.y || a.z != b.z) return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool benchmarkCompaction(BenchmarkReport& report, CpuStream& stream, const int minSide, const int maxSide,
+                         const double skew) {
+    CropBatch batch(minSide, maxSide, skew);
+    std::array<fk::Ptr2D<float3>, BATCH> reference;
+    std::array<fk::Ptr2D<float3>, BATCH> referenceViews;
+    for (int i = 0; i < BATCH; ++i) {
+        reference[i] = fk::Ptr2D<float3>(maxSide, maxSide, 0, fk::MemType::Host);
+        referenceViews[i] = reference[i].crop(fk::Point{ 0, 0, 0 },
+            fk::PtrDims<fk::ND::_2D>(batch.widths[i], batch.heights[i], reference[i].dims().pitch));
+    }
+    const auto scale = fk::Mul<float3>::build(fk::make_set<float3>(1.f / 255.f));
+    const auto offset = fk::Sub<float3>::build(fk::make_<float3>(0.485f, 0.456f, 0.406f));
+
+    const auto grid = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, uchar3>::build(batch.crops),
+            fk::Cast<uchar3, float3>::build(), scale, offset, fk::PerThreadWrite<fk::ND::_2D, float3>::build(batch.outputViews));
+    };
+    const auto compacted = [&] {
+        fk::executeOperations<fk::CompactedBatchTransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, uchar3>::build(batch.crops), fk::Cast<uchar3, float3>::build(),
+            scale, offset, fk::PerThreadWrite<fk::ND::_2D, float3>::build(batch.outputViews));
+    };
+    const auto perPlane = [&] {
+        for (int i = 0; i < BATCH; ++i) {
+            fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, uchar3>::build(batch.crops[i]),
+                fk::Cast<uchar3, float3>::build(), scale, offset, fk::PerThreadWrite<fk::ND::_2D, float3>::build(referenceViews[i]));
+        }
+    };
+    perPlane();
+    compacted();
+    stream.sync();
+    if (!sameRealPixels(batch, reference)) {
+        std::printf("CompactedBatchTransformDPP: compacted and per-plane outputs differ\n");
+        return false;
+    }
+
+    // Only the real pixels are useful work, whatever the variant visits
+    BenchmarkTraffic traffic;
+    traffic.pixels = batch.pixels;
+    traffic.bytes = batch.pixels * (sizeof(uchar3) + sizeof(float3));
+    const double gridPixels = static_cast<double>(BATCH) * maxSide * maxSide;
+    std::printf("crops %d..%d skew %.1f: %.1f%% of the max-extent grid are real pixels\n",
+                minSide, maxSide, skew, 100. * batch.pixels / gridPixels);
+
+    const auto run = [&](const char* variant, const auto& body) {
+        const BenchmarkReport::Params params{ { "batch", std::to_string(BATCH) },
+                                              { "min_side", std::to_string(minSide) },
+                                              { "max_side", std::to_string(maxSide) },
+                                              { "skew", std::to_string(skew) },
+                                              { "type", "uchar3->float3" },
+                                              { "variant", variant } };
+        runCpuBenchmark(report, stream, "CompactedBatch", params, traffic, body);
+    };
+    run("max_extent_grid", grid);
+    run("compacted", compacted);
+    run("per_plane", perPlane);
+    return true;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkCompaction(report, stream, 8, 96, 3.);
+    } else {
+        passed &= benchmarkCompaction(report, stream, 20, 400, 1.);
+        passed &= benchmarkCompaction(report, stream, 20, 400, 3.);
+        passed &= benchmarkCompaction(report, stream, 20, 400, 6.);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_batch_compaction");
+    return passed ? 0 : -1;
+}
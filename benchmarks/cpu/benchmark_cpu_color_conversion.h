@@ -0,0 +1,111 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/color_conversion.h>
+#include <fused_kernel/algorithms/image_processing/image.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cstdlib>
+
+// NV12 (8 bit) and P010 (10 bit) to RGB, read with ReadYUV and converted with
+// ColorConversion<COLOR_YUV2RGB_NV12>, once with ColorArithmetic::Float (float)
+// and once with ColorArithmetic::FixedPoint (fixed_point). Both write the pixel type.
+
+namespace {
+
+template <fk::PixelFormat PF>
+bool benchmarkYUVToRGB(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size,
+                       const char* format) {
+    using namespace fk;
+    constexpr ColorDepth CD = PixelFormatTraits<PF>::depth;
+    using Pixel = ColorDepthPixelType<CD>;
+    using Base = ColorDepthPixelBaseType<CD>;
+    constexpr int maxVal = static_cast<int>(maxDepthValue<CD>);
+    constexpr auto CODE = ColorConversionCodes::COLOR_YUV2RGB_NV12;
+    Image<PF> source(static_cast<uint>(size.width), static_cast<uint>(size.height), MemType::Host);
+    const Ptr<ND::_2D, Base> data = source.getData();
+    for (uint y = 0; y < data.dims().height; ++y) {
+        for (uint x = 0; x < data.dims().width; ++x) {
+            *PtrAccessor<ND::_2D>::point(Point(x, y, 0), data.ptr()) = static_cast<Base>((x * 7 + y * 3) % (maxVal + 1));
+        }
+    }
+    Ptr2D<Pixel> floatOutput = cpuBenchmarkImage<Pixel>(size);
+    Ptr2D<Pixel> fixedOutput = cpuBenchmarkImage<Pixel>(size);
+    const auto read = ReadYUV<PF>::build(source);
+
+    const auto floatPath = [&] {
+        executeOperations<TransformDPP<CPU_PA>>(stream, read,
+            ColorConversion<CODE, Pixel, Pixel, CD, ColorArithmetic::Float>::build(),
+            PerThreadWrite<ND::_2D, Pixel>::build(floatOutput));
+    };
+    const auto fixedPath = [&] {
+        executeOperations<TransformDPP<CPU_PA>>(stream, read,
+            ColorConversion<CODE, Pixel, Pixel, CD, ColorArithmetic::FixedPoint>::build(),
+            PerThreadWrite<ND::_2D, Pixel>::build(fixedOutput));
+    };
+    floatPath();
+    fixedPath();
+    stream.sync();
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            const Pixel a = floatOutput.at(Point{ x, y, 0 });
+            const Pixel b = fixedOutput.at(Point{ x, y, 0 });
+            if (std::abs(a.x - b.x) > 1 || std::abs(a.y - b.y) > 1 || std::abs(a.z - b.z) > 1) {
+                std::printf("ColorConversion %s: fixed point and float outputs differ by more than 1 LSB\n", format);
+                return false;
+            }
+        }
+    }
+
+    BenchmarkTraffic traffic;
+    traffic.read(data).write(floatOutput);
+    const auto run = [&](const char* variant, const auto& body) {
+        const BenchmarkReport::Params params{ { "width", std::to_string(size.width) },
+                                              { "height", std::to_string(size.height) },
+                                              { "format", format },
+                                              { "variant", variant } };
+        runCpuBenchmark(report, stream, "YUVToRGB", params, traffic, body);
+    };
+    run("float", floatPath);
+    run("fixed_point", fixedPath);
+    return true;
+}
+
+bool benchmarkColorConversion(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    bool passed = benchmarkYUVToRGB<fk::PixelFormat::NV12>(report, stream, size, "NV12");
+    passed &= benchmarkYUVToRGB<fk::PixelFormat::P010>(report, stream, size, "P010");
+    return passed;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkColorConversion(report, stream, { 640, 480 });
+    } else {
+        passed &= benchmarkColorConversion(report, stream, { 1920, 1080 });
+        passed &= benchmarkColorConversion(report, stream, { 3840, 2160 });
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_color_conversion");
+    return passed ? 0 : -1;
+}
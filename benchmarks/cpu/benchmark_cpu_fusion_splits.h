@@ -0,0 +1,58 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+#include <benchmarks/fkFusionComparison.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/image_processing/color_conversion.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+
+// Every split configuration of a typical preprocessing chain:
+// uchar3 -> float3 -> normalize (mul, sub) -> gray -> uchar.
+
+namespace {
+
+void benchmarkPreprocessSplits(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    fk::Ptr2D<uchar3> input = cpuBenchmarkImage<uchar3>(size);
+    fk::Ptr2D<uchar> output = cpuBenchmarkImage<uchar>(size);
+    fk::setTo(fk::make_<uchar3>(10, 120, 240), input, stream);
+
+    const FusionComparison comparison = compareFusion(cpuBenchmarkConfig(), stream, FusionSplits::All,
+        fk::PerThreadRead<fk::ND::_2D, uchar3>::build(input), fk::SaturateCast<uchar3, float3>::build(),
+        fk::Mul<float3>::build(fk::make_set<float3>(0.9f)), fk::Sub<float3>::build(fk::make_set<float3>(4.f)),
+        fk::ColorConversion<fk::ColorConversionCodes::COLOR_RGB2GRAY, float3, float>::build(),
+        fk::SaturateCast<float, uchar>::build(), fk::PerThreadWrite<fk::ND::_2D, uchar>::build(output));
+
+    const std::string name = "preprocess " + std::to_string(size.width) + "x" + std::to_string(size.height);
+    comparison.print(name);
+    comparison.addTo(report, "FusionSplits/preprocess",
+                     { { "width", std::to_string(size.width) }, { "height", std::to_string(size.height) } });
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    for (const CpuBenchmarkSize& size : cpuBenchmarkSizes()) {
+        benchmarkPreprocessSplits(report, stream, size);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_fusion_splits");
+    return 0;
+}
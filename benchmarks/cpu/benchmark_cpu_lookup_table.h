@@ -0,0 +1,115 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/lookup_table.h>
+#include <fused_kernel/algorithms/basic_ops/math.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/fused_kernel.h>
+
+// A gamma curve (exp(ln(x) / 2.2)) on uchar3 and a 10 bit tone mapping
+// curve (x / (1 + x) after an exposure gain, as 1 - exp(-ln(1 + x))) on
+// ushort3, computed per pixel (chain) and as the LookupTable bake of the
+// same chain (lookup_table).
+
+namespace {
+
+template <typename I, typename O, int BITS, typename... IOps>
+bool benchmarkCurve(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size,
+                    const char* curve, const IOps&... iOps) {
+    fk::Ptr2D<I> source = cpuBenchmarkImage<I>(size);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = fk::make_set<I>(static_cast<fk::VBase<I>>(((x * 7 + y * 13) % 1021) & ((1 << BITS) - 1)));
+        }
+    }
+    fk::Ptr2D<O> chainOutput = cpuBenchmarkImage<O>(size);
+    fk::Ptr2D<O> lutOutput = cpuBenchmarkImage<O>(size);
+    fk::Ptr1D<fk::VBase<O>> table;
+    const auto read = fk::PerThreadRead<fk::ND::_2D, I>::build(source);
+    const auto lut = fk::LookupTable<I, BITS>::bake(table, stream, iOps...);
+
+    const auto chain = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, read, iOps...,
+                                                         fk::PerThreadWrite<fk::ND::_2D, O>::build(chainOutput));
+    };
+    const auto gathered = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, read, lut,
+                                                         fk::PerThreadWrite<fk::ND::_2D, O>::build(lutOutput));
+    };
+    chain();
+    gathered();
+    stream.sync();
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            const O a = chainOutput.at(fk::Point{ x, y, 0 });
+            const O b = lutOutput.at(fk::Point{ x, y, 0 });
+            if (a.x != b.x || a.y != b.y || a.z != b.z) {
+                std::printf("LookupTable %s: table and chain outputs differ\n", curve);
+                return false;
+            }
+        }
+    }
+
+    BenchmarkTraffic traffic;
+    traffic.read(source).write(chainOutput);
+    const auto run = [&](const char* variant, const auto& body) {
+        const BenchmarkReport::Params params{ { "width", std::to_string(size.width) },
+                                              { "height", std::to_string(size.height) },
+                                              { "curve", curve },
+                                              { "bits", std::to_string(BITS) },
+                                              { "variant", variant } };
+        runCpuBenchmark(report, stream, "LookupTable", params, traffic, body);
+    };
+    run("chain", chain);
+    run("lookup_table", gathered);
+    return true;
+}
+
+bool benchmarkLookupTable(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    bool passed = benchmarkCurve<uchar3, uchar3, 8>(report, stream, size, "gamma",
+        fk::Cast<uchar3, float3>::build(), fk::Mul<float3>::build(fk::make_set<float3>(1.f / 255.f)),
+        fk::Ln<float3>::build(), fk::Mul<float3>::build(fk::make_set<float3>(1.f / 2.2f)),
+        fk::Exp<float3>::build(), fk::Mul<float3>::build(fk::make_set<float3>(255.f)),
+        fk::SaturateCast<float3, uchar3>::build());
+    passed &= benchmarkCurve<ushort3, float3, 10>(report, stream, size, "tone_map",
+        fk::Cast<ushort3, float3>::build(), fk::Mul<float3>::build(fk::make_set<float3>(4.f / 1023.f)),
+        fk::Add<float3>::build(fk::make_set<float3>(1.f)), fk::Ln<float3>::build(),
+        fk::Mul<float3>::build(fk::make_set<float3>(-1.f)), fk::Exp<float3>::build(),
+        fk::Mul<float3>::build(fk::make_set<float3>(-1.f)), fk::Add<float3>::build(fk::make_set<float3>(1.f)));
+    return passed;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkLookupTable(report, stream, { 640, 480 });
+    } else {
+        passed &= benchmarkLookupTable(report, stream, { 1920, 1080 });
+        passed &= benchmarkLookupTable(report, stream, { 3840, 2160 });
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_lookup_table");
+    return passed ? 0 : -1;
+}
@@ -0,0 +1,246 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/box_filter_fast.h>
+#include <fused_kernel/algorithms/image_processing/convolution_fast.h>
+#include <fused_kernel/algorithms/image_processing/linear_filter.h>
+#include <fused_kernel/algorithms/image_processing/median_fast.h>
+#include <fused_kernel/algorithms/image_processing/morphology_fast.h>
+#include <fused_kernel/fused_kernel.h>
+
+// CPU baselines of the neighborhood DPPs over image size and kernel side.
+// "fused" folds a bias into the DPP read and another into its write;
+// "unfused" runs the same biases as TransformDPP passes around a plain
+// filter, which is what a pipeline without neighborhood fusion executes.
+
+namespace {
+
+template <typename T>
+struct FusionBuffers {
+    fk::Ptr2D<T> input, fusedOutput, unfusedOutput, preTemp, postTemp;
+
+    explicit FusionBuffers(const CpuBenchmarkSize& size)
+        : input(cpuBenchmarkImage<T>(size)), fusedOutput(cpuBenchmarkImage<T>(size)),
+          unfusedOutput(cpuBenchmarkImage<T>(size)), preTemp(cpuBenchmarkImage<T>(size)),
+          postTemp(cpuBenchmarkImage<T>(size)) {
+        fillPattern(input, 0);
+    }
+
+    // input bias pass -> preTemp, filter -> postTemp, output bias pass
+    template <typename Filter>
+    void runUnfused(CpuStream& stream, const T readBias, const T writeBias, Filter&& filter) {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, T>::build(input), fk::Add<T>::build(readBias),
+            fk::PerThreadWrite<fk::ND::_2D, T>::build(preTemp));
+        filter(fk::PerThreadRead<fk::ND::_2D, T>::build(preTemp),
+               fk::PerThreadWrite<fk::ND::_2D, T>::build(postTemp));
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, T>::build(postTemp), fk::Add<T>::build(writeBias),
+            fk::PerThreadWrite<fk::ND::_2D, T>::build(unfusedOutput));
+    }
+};
+
+template <typename T, typename Fused, typename Unfused>
+bool benchmarkFusionPair(BenchmarkReport& report, CpuStream& stream, const std::string& name,
+                         const CpuBenchmarkSize& size, const int kernelSide,
+                         FusionBuffers<T>& buffers, Fused&& fused, Unfused&& unfused) {
+    const std::string type = fk::typeToString<T>();
+    fused();
+    unfused();
+    stream.sync();
+    if (!checkCpuVariants(name + "<" + type + "> k" + std::to_string(kernelSide),
+                          buffers.fusedOutput, buffers.unfusedOutput)) {
+        return false;
+    }
+
+    BenchmarkTraffic fusedTraffic;
+    fusedTraffic.read(buffers.input).write(buffers.fusedOutput);
+    BenchmarkTraffic unfusedTraffic;
+    unfusedTraffic.read(buffers.input).write(buffers.preTemp).read(buffers.preTemp)
+                  .write(buffers.postTemp).read(buffers.postTemp).write(buffers.unfusedOutput);
+    unfusedTraffic.pixels = fusedTraffic.pixels;
+
+    const std::string kernel = std::to_string(kernelSide) + "x" + std::to_string(kernelSide);
+    BenchmarkReport::Params fusedParams = cpuBenchmarkParams(size, type, "fused");
+    fusedParams.push_back({ "kernel", kernel });
+    BenchmarkReport::Params unfusedParams = cpuBenchmarkParams(size, type, "unfused");
+    unfusedParams.push_back({ "kernel", kernel });
+    runCpuBenchmark(report, stream, name, fusedParams, fusedTraffic, fused);
+    runCpuBenchmark(report, stream, name, unfusedParams, unfusedTraffic, unfused);
+    return true;
+}
+
+template <typename T, int K>
+bool benchmarkBoxFilter(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using DPP = fk::BoxFilterQuadDPP<CPU_PA, float, 4, 4, K, K>;
+    const T readBias = static_cast<T>(1);
+    const T writeBias = static_cast<T>(2);
+    FusionBuffers<T> buffers(size);
+    const fk::BoxFilterQuadDetails details{ size.width, size.height, K, K, K / 2, K / 2 };
+    const auto compute = fk::make_tuple(fk::Add<float, float, float, fk::UnaryType>::build(),
+                                        fk::Sub<float, float, float, fk::UnaryType>::build(),
+                                        fk::Div<float>::build(static_cast<float>(K * K)));
+
+    const auto fused = [&] {
+        const auto read = fk::PerThreadRead<fk::ND::_2D, T>::build(buffers.input)
+            .then(fk::Add<T>::build(readBias)).then(fk::Cast<T, float>::build());
+        const auto write = fk::Cast<float, T>::build().then(fk::Add<T>::build(writeBias))
+            .then(fk::PerThreadWrite<fk::ND::_2D, T>::build(buffers.fusedOutput));
+        fk::executeBoxFilterQuad<DPP>(stream, details, read, compute, write);
+    };
+    const auto unfused = [&] {
+        buffers.runUnfused(stream, readBias, writeBias, [&](const auto& read, const auto& write) {
+            fk::executeBoxFilterQuad<DPP>(stream, details, read.then(fk::Cast<T, float>::build()), compute,
+                                          fk::Cast<float, T>::build().then(write));
+        });
+    };
+    return benchmarkFusionPair(report, stream, "BoxFilterQuadDPP", size, K, buffers, fused, unfused);
+}
+
+template <int K>
+bool benchmarkConvolution(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using DPP = fk::ConvQuadDPP<CPU_PA, float, 4, 4, K, K>;
+    FusionBuffers<float> buffers(size);
+    fk::ConvQuadDetails details{ size.width, size.height, K, K, K / 2, K / 2, {} };
+    for (int i = 0; i < K * K; ++i) {
+        details.coefficients[i] = static_cast<float>((i * 7) % 13 - 6) / static_cast<float>(K * K * 4);
+    }
+    const auto compute = fk::make_tuple(fk::Mul<float, float, float, fk::UnaryType>::build(),
+                                        fk::Add<float, float, float, fk::UnaryType>::build());
+
+    const auto fused = [&] {
+        const auto read = fk::PerThreadRead<fk::ND::_2D, float>::build(buffers.input)
+            .then(fk::Add<float>::build(0.25f));
+        const auto write = fk::Add<float>::build(-0.5f)
+            .then(fk::PerThreadWrite<fk::ND::_2D, float>::build(buffers.fusedOutput));
+        fk::executeConvQuad<DPP>(stream, details, read, compute, write);
+    };
+    const auto unfused = [&] {
+        buffers.runUnfused(stream, 0.25f, -0.5f, [&](const auto& read, const auto& write) {
+            fk::executeConvQuad<DPP>(stream, details, read, compute, write);
+        });
+    };
+    return benchmarkFusionPair(report, stream, "ConvQuadDPP", size, K, buffers, fused, unfused);
+}
+
+template <int K>
+bool benchmarkMedian(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using DPP = fk::MedianQuadDPP<CPU_PA, uchar, 4, 4, K, K>;
+    FusionBuffers<uchar> buffers(size);
+    const fk::MedianQuadDetails details{ size.width, size.height, K, K, K / 2, K / 2 };
+    const auto compare = fk::make_tuple(fk::Min<uchar, uchar, uchar, fk::UnaryType>::build(),
+                                        fk::Max<uchar, uchar, uchar, fk::UnaryType>::build());
+
+    const auto fused = [&] {
+        const auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(buffers.input)
+            .then(fk::Add<uchar>::build(1));
+        const auto write = fk::Add<uchar>::build(2)
+            .then(fk::PerThreadWrite<fk::ND::_2D, uchar>::build(buffers.fusedOutput));
+        fk::executeMedianQuad<DPP>(stream, details, read, compare, write);
+    };
+    const auto unfused = [&] {
+        buffers.runUnfused(stream, 1, 2, [&](const auto& read, const auto& write) {
+            fk::executeMedianQuad<DPP>(stream, details, read, compare, write);
+        });
+    };
+    return benchmarkFusionPair(report, stream, "MedianQuadDPP", size, K, buffers, fused, unfused);
+}
+
+template <int K>
+bool benchmarkMorphology(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using DPP = fk::MorphQuadDPP<CPU_PA, uchar, 4, 4, K, K>;
+    FusionBuffers<uchar> buffers(size);
+    const fk::MorphQuadDetails details{ size.width, size.height, K, K, K / 2, K / 2 };
+    const auto erode = fk::Min<uchar, uchar, uchar, fk::UnaryType>::build();
+
+    const auto fused = [&] {
+        const auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(buffers.input)
+            .then(fk::Add<uchar>::build(1));
+        const auto write = fk::Add<uchar>::build(2)
+            .then(fk::PerThreadWrite<fk::ND::_2D, uchar>::build(buffers.fusedOutput));
+        fk::executeMorphQuad<DPP>(stream, details, read, erode, write);
+    };
+    const auto unfused = [&] {
+        buffers.runUnfused(stream, 1, 2, [&](const auto& read, const auto& write) {
+            fk::executeMorphQuad<DPP>(stream, details, read, erode, write);
+        });
+    };
+    return benchmarkFusionPair(report, stream, "MorphQuadDPP", size, K, buffers, fused, unfused);
+}
+
+template <int K>
+bool benchmarkLinearFilter(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using Details = fk::LinearFilterDPPDetails<float>;
+    using DPP = fk::LinearFilterDPP<CPU_PA, Details>;
+    FusionBuffers<float> buffers(size);
+    const Details details{ size.width, size.height, K, K, K / 2, K / 2 };
+    fk::Ptr2D<float> kernel(K, K, 0, fk::MemType::Host);
+    for (int y = 0; y < K; ++y) {
+        for (int x = 0; x < K; ++x) {
+            kernel.at(fk::Point{ x, y, 0 }) = static_cast<float>((x * 5 + y * 3) % 11 - 5) / static_cast<float>(K * K * 4);
+        }
+    }
+    const auto kernelRead = fk::PerThreadRead<fk::ND::_2D, float>::build(kernel);
+    const auto multiply = fk::Mul<float, float, float, fk::UnaryType>::build();
+    const auto accumulate = fk::Add<float, float, float, fk::UnaryType>::build();
+
+    const auto fused = [&] {
+        const auto read = fk::PerThreadRead<fk::ND::_2D, float>::build(buffers.input)
+            .then(fk::Add<float>::build(0.25f));
+        const auto write = fk::Add<float>::build(-0.5f)
+            .then(fk::PerThreadWrite<fk::ND::_2D, float>::build(buffers.fusedOutput));
+        DPP::exec(details, fk::make_tuple(read, kernelRead), multiply, accumulate, write);
+    };
+    const auto unfused = [&] {
+        buffers.runUnfused(stream, 0.25f, -0.5f, [&](const auto& read, const auto& write) {
+            DPP::exec(details, fk::make_tuple(read, kernelRead), multiply, accumulate, write);
+        });
+    };
+    return benchmarkFusionPair(report, stream, "LinearFilterDPP", size, K, buffers, fused, unfused);
+}
+
+template <int K>
+bool benchmarkKernelSide(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    bool passed = true;
+    passed &= benchmarkBoxFilter<uchar, K>(report, stream, size);
+    passed &= benchmarkBoxFilter<float, K>(report, stream, size);
+    passed &= benchmarkConvolution<K>(report, stream, size);
+    passed &= benchmarkMedian<K>(report, stream, size);
+    passed &= benchmarkMorphology<K>(report, stream, size);
+    passed &= benchmarkLinearFilter<K>(report, stream, size);
+    return passed;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    for (const CpuBenchmarkSize& size : cpuBenchmarkSizes()) {
+        passed &= benchmarkKernelSide<3>(report, stream, size);
+        passed &= benchmarkKernelSide<5>(report, stream, size);
+        passed &= benchmarkKernelSide<7>(report, stream, size);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_neighborhood");
+    return passed ? 0 : -1;
+}
@@ -0,0 +1,107 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/image_pyramid.h>
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+
+// A 6 level uchar3 pyramid (scale 0.75 between levels), as one Resize
+// pipeline per level reading the source (independent_resize), one
+// SeparableResizeDPP per level reading the source (independent_separable),
+// and the executePyramid cascade that reads the source once.
+
+namespace {
+
+constexpr size_t LEVELS = 6;
+
+bool benchmarkPyramid(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& srcSize) {
+    fk::Ptr2D<uchar3> source = cpuBenchmarkImage<uchar3>(srcSize);
+    for (int y = 0; y < srcSize.height; ++y) {
+        for (int x = 0; x < srcSize.width; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = fk::make_set<uchar3>(static_cast<uchar>((x * 7 + y * 13) % 251));
+        }
+    }
+    const auto details = fk::ImagePyramid::geometric<LEVELS>(fk::Size(srcSize.width * 3 / 4, srcSize.height * 3 / 4), 0.75f);
+    std::array<fk::Ptr2D<uchar3>, LEVELS> outputs;
+    double outputPixels = 0.;
+    for (size_t i = 0; i < LEVELS; ++i) {
+        outputs[i] = cpuBenchmarkImage<uchar3>({ details.sizes[i].width, details.sizes[i].height });
+        outputPixels += static_cast<double>(details.sizes[i].width) * details.sizes[i].height;
+    }
+    std::array<fk::Ptr2D<float3>, LEVELS - 1> levels;
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    const auto output = [&](const size_t i) {
+        return fk::FusedOperation<>::build(fk::SaturateCast<float3, uchar3>::build(),
+                                           fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(outputs[i]));
+    };
+
+    const auto independentResize = [&] {
+        for (size_t i = 0; i < LEVELS; ++i) {
+            fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+                fk::Resize<fk::InterpolationType::INTER_LINEAR>::build(read, details.sizes[i]),
+                fk::SaturateCast<float3, uchar3>::build(), fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(outputs[i]));
+        }
+    };
+    const auto independentSeparable = [&] {
+        for (size_t i = 0; i < LEVELS; ++i) {
+            fk::executeSeparableResize<fk::SeparableResizeDPP<CPU_PA>>(stream,
+                fk::SeparableResize<>::details(read, details.sizes[i]), read, output(i));
+        }
+    };
+    const auto cascade = [&] {
+        fk::executePyramid<fk::SeparableResizeDPP<CPU_PA>>(stream, details, levels, read,
+            output(0), output(1), output(2), output(3), output(4), output(5));
+    };
+
+    BenchmarkTraffic traffic;
+    traffic.pixels = outputPixels;
+    traffic.bytes = static_cast<double>(srcSize.width) * srcSize.height * sizeof(uchar3) + outputPixels * sizeof(uchar3);
+    const auto run = [&](const char* variant, const auto& body) {
+        const BenchmarkReport::Params params{ { "src", std::to_string(srcSize.width) + "x" + std::to_string(srcSize.height) },
+                                              { "levels", std::to_string(LEVELS) },
+                                              { "scale", "0.75" },
+                                              { "type", "uchar3->uchar3" },
+                                              { "variant", variant } };
+        runCpuBenchmark(report, stream, "Pyramid", params, traffic, body);
+    };
+    run("independent_resize", independentResize);
+    run("independent_separable", independentSeparable);
+    run("cascade", cascade);
+    return true;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkPyramid(report, stream, { 640, 480 });
+    } else {
+        passed &= benchmarkPyramid(report, stream, { 1920, 1080 });
+        passed &= benchmarkPyramid(report, stream, { 3840, 2160 });
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_pyramid");
+    return passed ? 0 : -1;
+}
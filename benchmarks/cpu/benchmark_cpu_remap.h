@@ -0,0 +1,85 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/remap.h>
+#include <fused_kernel/fused_kernel.h>
+
+// Perspective Warping of a uchar3 frame, computing the geometry per pixel,
+// against Remap over a baked float2 map and a baked short2 fixed-point map.
+
+namespace {
+
+bool benchmarkRemap(BenchmarkReport& report, CpuStream& stream, const int width, const int height) {
+    fk::Ptr2D<uchar3> source(width, height, 0, fk::MemType::Host);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = fk::make_set<uchar3>(static_cast<uchar>((x * 7 + y * 13) % 251));
+        }
+    }
+    fk::WarpingParameters<fk::WarpType::Perspective> params{};
+    const float matrix[3][3]{ { 0.95f, 0.05f, 4.f }, { -0.03f, 1.02f, 3.f }, { 0.00002f, 0.00001f, 1.f } };
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            params.transformMatrix.data[i][j] = matrix[i][j];
+        }
+    }
+    params.dstSize = fk::Size(width, height);
+    fk::Ptr2D<float3> output(width, height, 0, fk::MemType::Host);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    const auto write = fk::PerThreadWrite<fk::ND::_2D, float3>::build(output);
+    const auto warp = read.then(fk::Warping<fk::WarpType::Perspective>::build(params));
+
+    fk::Ptr2D<float2> floatMap;
+    fk::Ptr2D<short2> fixedMap;
+    const auto floatRemap = fk::RemapTable::bake(warp, floatMap, stream);
+    const auto fixedRemap = fk::RemapTable::bake(warp, fixedMap, stream);
+
+    const double pixels = static_cast<double>(width) * height;
+    const auto run = [&](const char* variant, const double mapBytes, const auto& body) {
+        BenchmarkTraffic traffic;
+        traffic.pixels = pixels;
+        traffic.bytes = pixels * (sizeof(uchar3) + sizeof(float3) + mapBytes);
+        const BenchmarkReport::Params benchParams{ { "width", std::to_string(width) },
+                                                   { "height", std::to_string(height) },
+                                                   { "type", "uchar3->float3" },
+                                                   { "variant", variant } };
+        runCpuBenchmark(report, stream, "Remap", benchParams, traffic, body);
+    };
+    run("warping", 0., [&] { fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, warp, write); });
+    run("remap_float2", sizeof(float2), [&] { fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, read, floatRemap, write); });
+    run("remap_short2", sizeof(short2), [&] { fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, read, fixedRemap, write); });
+    return true;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkRemap(report, stream, 320, 240);
+    } else {
+        passed &= benchmarkRemap(report, stream, 1920, 1080);
+        passed &= benchmarkRemap(report, stream, 3840, 2160);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_remap");
+    return passed ? 0 : -1;
+}
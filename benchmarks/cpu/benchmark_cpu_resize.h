@@ -0,0 +1,99 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/algorithms/image_processing/separable_resize.h>
+#include <fused_kernel/fused_kernel.h>
+
+// uchar3 to uchar3 bilinear resize, with float interpolation and a
+// SaturateCast (INTER_LINEAR), with 11 bit fixed-point weights that return
+// uchar3 directly (INTER_LINEAR_EXACT), and the two pass
+// SeparableResizeDPP, bilinear (separable_linear) and area averaging on the
+// axes downscaled by 2 or more (separable_auto).
+
+namespace {
+
+bool benchmarkResize(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& srcSize,
+                     const CpuBenchmarkSize& dstSize) {
+    fk::Ptr2D<uchar3> source = cpuBenchmarkImage<uchar3>(srcSize);
+    for (int y = 0; y < srcSize.height; ++y) {
+        for (int x = 0; x < srcSize.width; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = fk::make_set<uchar3>(static_cast<uchar>((x * 7 + y * 13) % 251));
+        }
+    }
+    fk::Ptr2D<uchar3> linearOutput = cpuBenchmarkImage<uchar3>(dstSize);
+    fk::Ptr2D<uchar3> exactOutput = cpuBenchmarkImage<uchar3>(dstSize);
+    fk::Ptr2D<uchar3> separableOutput = cpuBenchmarkImage<uchar3>(dstSize);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    const fk::Size size(dstSize.width, dstSize.height);
+
+    const auto linear = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::Resize<fk::InterpolationType::INTER_LINEAR>::build(read, size), fk::SaturateCast<float3, uchar3>::build(),
+            fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(linearOutput));
+    };
+    const auto exact = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::Resize<fk::InterpolationType::INTER_LINEAR_EXACT>::build(read, size),
+            fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(exactOutput));
+    };
+    const auto separable = [&](const fk::SeparableResizeMode mode) {
+        return [&, mode] {
+            fk::executeSeparableResize<fk::SeparableResizeDPP<CPU_PA>>(stream,
+                fk::SeparableResize<>::details(read, size, mode), read, fk::SaturateCast<float3, uchar3>::build(),
+                fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(separableOutput));
+        };
+    };
+
+    BenchmarkTraffic traffic;
+    traffic.read(source).write(linearOutput);
+    traffic.pixels = static_cast<double>(dstSize.width) * dstSize.height;
+    const auto run = [&](const char* variant, const auto& body) {
+        const BenchmarkReport::Params params{ { "src", std::to_string(srcSize.width) + "x" + std::to_string(srcSize.height) },
+                                              { "dst", std::to_string(dstSize.width) + "x" + std::to_string(dstSize.height) },
+                                              { "type", "uchar3->uchar3" },
+                                              { "variant", variant } };
+        runCpuBenchmark(report, stream, "Resize", params, traffic, body);
+    };
+    run("inter_linear", linear);
+    run("inter_linear_exact", exact);
+    run("separable_linear", separable(fk::SeparableResizeMode::LINEAR));
+    run("separable_auto", separable(fk::SeparableResizeMode::AUTO));
+    return true;
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    if (cpuBenchmarkQuick()) {
+        passed &= benchmarkResize(report, stream, { 640, 480 }, { 320, 240 });
+        passed &= benchmarkResize(report, stream, { 1280, 720 }, { 160, 90 });
+    } else {
+        passed &= benchmarkResize(report, stream, { 1920, 1080 }, { 640, 640 });
+        passed &= benchmarkResize(report, stream, { 1920, 1080 }, { 3840, 2160 });
+        passed &= benchmarkResize(report, stream, { 3840, 2160 }, { 224, 224 });
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_resize");
+    return passed ? 0 : -1;
+}
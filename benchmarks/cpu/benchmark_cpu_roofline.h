@@ -0,0 +1,85 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+#include <benchmarks/fkRoofline.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/image_processing/color_conversion.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+
+#include <algorithm>
+
+// Places a few representative pipelines on the roofline of this machine.
+// Sizes whose working set fits in the last level cache are flagged as
+// cache resident and measured against an in-cache bandwidth roof.
+
+namespace {
+
+void benchmarkRoofline(BenchmarkReport& report, CpuStream& stream, const MachinePeak& peak,
+                       const CpuBenchmarkSize& size) {
+    const BenchmarkConfig config = cpuBenchmarkConfig();
+    const BenchmarkReport::Params params{ { "width", std::to_string(size.width) },
+                                          { "height", std::to_string(size.height) } };
+    const std::string suffix = " " + std::to_string(size.width) + "x" + std::to_string(size.height);
+
+    fk::Ptr2D<uchar3> rgb = cpuBenchmarkImage<uchar3>(size);
+    fk::Ptr2D<float3> rgbF = cpuBenchmarkImage<float3>(size);
+    fk::Ptr2D<uchar> gray = cpuBenchmarkImage<uchar>(size);
+    fk::setTo(fk::make_<uchar3>(10, 120, 240), rgb, stream);
+
+    const RooflineResult convert = analyzeRoofline(config, stream, peak,
+        fk::PerThreadRead<fk::ND::_2D, uchar3>::build(rgb), fk::SaturateCast<uchar3, float3>::build(),
+        fk::PerThreadWrite<fk::ND::_2D, float3>::build(rgbF));
+    convert.print("convert" + suffix);
+    convert.addTo(report, "Roofline/convert", params);
+
+    const RooflineResult normalize = analyzeRoofline(config, stream, peak,
+        fk::PerThreadRead<fk::ND::_2D, float3>::build(rgbF),
+        fk::Mul<float3>::build(fk::make_set<float3>(0.9f)), fk::Sub<float3>::build(fk::make_set<float3>(4.f)),
+        fk::PerThreadWrite<fk::ND::_2D, float3>::build(rgbF));
+    normalize.print("normalize" + suffix);
+    normalize.addTo(report, "Roofline/normalize", params);
+
+    const RooflineResult preprocess = analyzeRoofline(config, stream, peak,
+        fk::PerThreadRead<fk::ND::_2D, uchar3>::build(rgb), fk::SaturateCast<uchar3, float3>::build(),
+        fk::Mul<float3>::build(fk::make_set<float3>(0.9f)), fk::Sub<float3>::build(fk::make_set<float3>(4.f)),
+        fk::ColorConversion<fk::ColorConversionCodes::COLOR_RGB2GRAY, float3, float>::build(),
+        fk::SaturateCast<float, uchar>::build(), fk::PerThreadWrite<fk::ND::_2D, uchar>::build(gray));
+    preprocess.print("fused preprocess" + suffix);
+    preprocess.addTo(report, "Roofline/preprocess", params);
+}
+
+} // namespace
+
+int launch() {
+    const bool quick = cpuBenchmarkQuick();
+    // The DRAM probe must be well above the last level cache, even in quick mode
+    const size_t cacheElements = 4 * cpuLastLevelCacheBytes() / (3 * sizeof(double));
+    const MachinePeak peak = quick ? measureCpuMachinePeak(std::max(size_t{ 1 } << 18, cacheElements), size_t{ 1 } << 16, 2)
+                                   : measureCpuMachinePeak(std::max(size_t{ 1 } << 23, cacheElements));
+    std::printf("machine peak: %.2f GB/s, %.2f GOP/s, ridge %.3f op/B, last level cache %zu KiB\n",
+                peak.bandwidthGBps, peak.gops, peak.ridgePoint(), peak.lastLevelCacheBytes / 1024);
+    CpuStream stream;
+    BenchmarkReport report;
+    for (const CpuBenchmarkSize& size : cpuBenchmarkSizes()) {
+        benchmarkRoofline(report, stream, peak, size);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_roofline");
+    return 0;
+}
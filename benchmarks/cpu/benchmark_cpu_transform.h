@@ -0,0 +1,188 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/cpu/cpu_benchmark_common.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/circular_tensor.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+// CPU baselines of the element-wise patterns: TransformDPP fused against
+// the same pipeline split into one pass per operation, DivergentBatchTransformDPP
+// against one TransformDPP per sequence, and CircularTensor::update.
+
+namespace {
+
+struct PlaneSelector {
+    FK_HOST_DEVICE_FUSE uint at(const uint& zIdx) { return zIdx; }
+};
+
+// read T -> float -> *0.5 -> +3 -> T -> write, as one kernel or as four passes
+template <typename T>
+bool benchmarkTransform(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using FT = fk::VectorType_t<float, fk::cn<T>>;
+    const std::string type = fk::typeToString<T>();
+    const FT scale = fk::make_set<FT>(0.5f);
+    const FT offset = fk::make_set<FT>(3.f);
+
+    fk::Ptr2D<T> input = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<T> fusedOutput = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<T> unfusedOutput = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<FT> tempA = cpuBenchmarkImage<FT>(size);
+    fk::Ptr2D<FT> tempB = cpuBenchmarkImage<FT>(size);
+    fillPattern(input, 0);
+
+    const auto fused = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, T>::build(input), fk::SaturateCast<T, FT>::build(),
+            fk::Mul<FT>::build(scale), fk::Add<FT>::build(offset), fk::SaturateCast<FT, T>::build(),
+            fk::PerThreadWrite<fk::ND::_2D, T>::build(fusedOutput));
+    };
+    const auto unfused = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, T>::build(input), fk::SaturateCast<T, FT>::build(),
+            fk::PerThreadWrite<fk::ND::_2D, FT>::build(tempA));
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, FT>::build(tempA), fk::Mul<FT>::build(scale),
+            fk::PerThreadWrite<fk::ND::_2D, FT>::build(tempB));
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, FT>::build(tempB), fk::Add<FT>::build(offset),
+            fk::PerThreadWrite<fk::ND::_2D, FT>::build(tempA));
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream,
+            fk::PerThreadRead<fk::ND::_2D, FT>::build(tempA), fk::SaturateCast<FT, T>::build(),
+            fk::PerThreadWrite<fk::ND::_2D, T>::build(unfusedOutput));
+    };
+    fused();
+    unfused();
+    stream.sync();
+    if (!checkCpuVariants("TransformDPP<" + type + ">", fusedOutput, unfusedOutput)) return false;
+
+    BenchmarkTraffic fusedTraffic;
+    fusedTraffic.read(input).write(fusedOutput);
+    BenchmarkTraffic unfusedTraffic;
+    unfusedTraffic.read(input).write(tempA).read(tempA).write(tempB)
+                  .read(tempB).write(tempA).read(tempA).write(unfusedOutput);
+    // throughput in input pixels, so both variants are directly comparable
+    unfusedTraffic.pixels = fusedTraffic.pixels;
+
+    runCpuBenchmark(report, stream, "TransformDPP", cpuBenchmarkParams(size, type, "fused"),
+                    fusedTraffic, fused);
+    runCpuBenchmark(report, stream, "TransformDPP", cpuBenchmarkParams(size, type, "unfused"),
+                    unfusedTraffic, unfused);
+    return true;
+}
+
+// Two different sequences, one per output plane, in a single divergent
+// launch versus one TransformDPP launch per sequence.
+template <typename T>
+bool benchmarkDivergentBatch(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    const std::string type = fk::typeToString<T>();
+    const T addend = fk::make_set<T>(3);
+    const T factor = fk::make_set<T>(2);
+
+    fk::Ptr2D<T> input0 = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<T> input1 = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<T> output0 = cpuBenchmarkImage<T>(size);
+    fk::Ptr2D<T> output1 = cpuBenchmarkImage<T>(size);
+    fk::Tensor<T> batchOutput(size.width, size.height, 2, 1, fk::MemType::Host);
+    fillPattern(input0, 0);
+    fillPattern(input1, 101);
+
+    const auto divergent = [&] {
+        const auto addSequence = fk::buildOperationSequence(fk::PerThreadRead<fk::ND::_2D, T>::build(input0),
+            fk::Add<T>::build(addend), fk::PerThreadWrite<fk::ND::_3D, T>::build(batchOutput.ptr()));
+        const auto mulSequence = fk::buildOperationSequence(fk::PerThreadRead<fk::ND::_2D, T>::build(input1),
+            fk::Mul<T>::build(factor), fk::PerThreadWrite<fk::ND::_3D, T>::build(batchOutput.ptr()));
+        fk::executeOperations<fk::DivergentBatchTransformDPP<CPU_PA, PlaneSelector>>(stream, addSequence, mulSequence);
+    };
+    const auto separate = [&] {
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, T>::build(input0),
+            fk::Add<T>::build(addend), fk::PerThreadWrite<fk::ND::_2D, T>::build(output0));
+        fk::executeOperations<fk::TransformDPP<CPU_PA>>(stream, fk::PerThreadRead<fk::ND::_2D, T>::build(input1),
+            fk::Mul<T>::build(factor), fk::PerThreadWrite<fk::ND::_2D, T>::build(output1));
+    };
+    divergent();
+    separate();
+    stream.sync();
+    bool same = true;
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            const T plane0 = *fk::PtrAccessor<fk::ND::_3D>::point(fk::Point{ x, y, 0 }, batchOutput.ptr());
+            const T plane1 = *fk::PtrAccessor<fk::ND::_3D>::point(fk::Point{ x, y, 1 }, batchOutput.ptr());
+            same &= fk::Equal<T>::exec(fk::make_tuple(plane0, output0.at(fk::Point{ x, y, 0 }))) &&
+                    fk::Equal<T>::exec(fk::make_tuple(plane1, output1.at(fk::Point{ x, y, 0 })));
+        }
+    }
+    if (!same) {
+        std::printf("DivergentBatchTransformDPP<%s>: divergent and separate outputs differ\n", type.c_str());
+        return false;
+    }
+
+    BenchmarkTraffic traffic;
+    traffic.read(input0).read(input1).write(output0).write(output1);
+    runCpuBenchmark(report, stream, "DivergentBatchTransformDPP", cpuBenchmarkParams(size, type, "divergent"),
+                    traffic, divergent);
+    runCpuBenchmark(report, stream, "DivergentBatchTransformDPP", cpuBenchmarkParams(size, type, "separate"),
+                    traffic, separate);
+    return true;
+}
+
+template <int BATCH>
+void benchmarkCircularTensorUpdate(BenchmarkReport& report, CpuStream& stream, const CpuBenchmarkSize& size) {
+    using CTensor = fk::CircularTensor<float, 3, BATCH, fk::CircularTensorOrder::NewestFirst, fk::ColorPlanes::Standard>;
+    CTensor tensor(size.width, size.height, fk::MemType::Host);
+    fk::Ptr2D<uchar3> input = cpuBenchmarkImage<uchar3>(size);
+    fillPattern(input, 0);
+    fk::setTo(0.f, tensor, stream);
+
+    const auto update = [&] {
+        tensor.update(stream, fk::PerThreadRead<fk::ND::_2D, uchar3>::build(input),
+                      fk::SaturateCast<uchar3, float3>::build(), fk::TensorSplit<float3>::build(tensor.ptr()));
+    };
+    // one new plane is converted in, BATCH - 1 planes are shifted through the temp tensor
+    BenchmarkTraffic traffic;
+    traffic.read(input);
+    const double planeBytes = static_cast<double>(size.width) * size.height * sizeof(float3);
+    traffic.bytes += planeBytes * (1 + 2 * (BATCH - 1));
+
+    BenchmarkReport::Params params = cpuBenchmarkParams(size, "uchar3->float3", "update");
+    params.push_back({ "batch", std::to_string(BATCH) });
+    runCpuBenchmark(report, stream, "CircularTensor::update", params, traffic, update);
+}
+
+} // namespace
+
+int launch() {
+    CpuStream stream;
+    BenchmarkReport report;
+    bool passed = true;
+    for (const CpuBenchmarkSize& size : cpuBenchmarkSizes()) {
+        passed &= benchmarkTransform<uchar>(report, stream, size);
+        passed &= benchmarkTransform<uchar3>(report, stream, size);
+        passed &= benchmarkTransform<float>(report, stream, size);
+        passed &= benchmarkTransform<float3>(report, stream, size);
+        passed &= benchmarkDivergentBatch<uchar>(report, stream, size);
+        passed &= benchmarkDivergentBatch<float>(report, stream, size);
+        benchmarkCircularTensorUpdate<4>(report, stream, size);
+        benchmarkCircularTensorUpdate<8>(report, stream, size);
+    }
+    writeCpuBenchmarkReport(report, "benchmark_cpu_transform");
+    return passed ? 0 : -1;
+}
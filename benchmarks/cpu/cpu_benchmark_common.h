@@ -0,0 +1,165 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_CPU_BENCHMARK_COMMON_H
+#define FK_CPU_BENCHMARK_COMMON_H
+
+/* Shared setup of the CPU benchmark suite (benchmarks/cpu).
+ *
+ * Every benchmark of the suite runs on ParArch::CPU regardless of the
+ * backend the target is compiled for, sweeps cpuBenchmarkSizes() and
+ * records one BenchmarkReport entry per (benchmark, params). Each variant
+ * pair (fused/unfused) is checked for equal output before it is timed.
+ *
+ * FK_BENCHMARK_QUICK=1 in the environment shrinks the sweep to a single
+ * small image and a handful of iterations, so the suite can run as a smoke
+ * test under ctest. Reports are written to <name>.json and <name>.csv in
+ * the working directory. Where the hardware counters are available, IPC
+ * and misses per pixel are printed and recorded as metrics too;
+ * FK_PERF_COUNTERS=0 turns them off. */
+
+#include <benchmarks/fkBenchmarkHarness.h>
+#include <benchmarks/fkBenchmarksCommon.h>
+
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/stream.h>
+#include <fused_kernel/core/utils/type_to_string.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+constexpr fk::ParArch CPU_PA = fk::ParArch::CPU;
+using CpuStream = fk::Stream_<CPU_PA>;
+
+struct CpuBenchmarkSize {
+    int width;
+    int height;
+};
+
+inline bool cpuBenchmarkQuick() {
+    const char* quick = std::getenv("FK_BENCHMARK_QUICK");
+    return quick != nullptr && quick[0] != '\0' && quick[0] != '0';
+}
+
+inline std::vector<CpuBenchmarkSize> cpuBenchmarkSizes() {
+    if (cpuBenchmarkQuick()) {
+        return { { 320, 240 } };
+    }
+    return { { 640, 480 }, { 1920, 1080 }, { 3840, 2160 } };
+}
+
+// The serial CPU paths are orders of magnitude slower than the GPU ones:
+// fewer warmups and a wall-clock cap keep the full sweep within minutes.
+inline BenchmarkConfig cpuBenchmarkConfig() {
+    BenchmarkConfig config;
+    if (cpuBenchmarkQuick()) {
+        config.warmup = 1;
+        config.minIters = 3;
+        config.maxIters = 3;
+        config.targetRelStdErr = 0.;
+        config.maxSeconds = 1.;
+    } else {
+        config.warmup = 2;
+        config.minIters = 5;
+        config.maxIters = 200;
+        config.targetRelStdErr = 0.01;
+        config.maxSeconds = 3.;
+    }
+    return config;
+}
+
+inline BenchmarkReport::Params cpuBenchmarkParams(const CpuBenchmarkSize& size,
+                                                  const std::string& type,
+                                                  const std::string& variant) {
+    return { { "width", std::to_string(size.width) },
+             { "height", std::to_string(size.height) },
+             { "type", type },
+             { "variant", variant } };
+}
+
+template <typename T>
+inline fk::Ptr2D<T> cpuBenchmarkImage(const CpuBenchmarkSize& size) {
+    return fk::Ptr2D<T>(size.width, size.height, 0, fk::MemType::Host);
+}
+
+// Deterministic pixels in [0, 250], the same value in every channel. Each
+// seed shifts the pattern, so two inputs of one benchmark can differ.
+template <typename T>
+inline void fillPattern(fk::Ptr2D<T>& image, const int seed) {
+    using Base = typename fk::VectorTraits<T>::base;
+    const auto dims = image.dims();
+    for (int y = 0; y < static_cast<int>(dims.height); ++y) {
+        for (int x = 0; x < static_cast<int>(dims.width); ++x) {
+            image.at(fk::Point{ x, y, 0 }) = fk::make_set<T>(static_cast<Base>((x * 7 + y * 13 + seed) % 251));
+        }
+    }
+}
+
+inline void printCpuBenchmark(const std::string& name, const BenchmarkReport::Params& params,
+                              const BenchmarkStats& stats, const BenchmarkTraffic& traffic = {}) {
+    std::string text;
+    for (const auto& [key, value] : params) {
+        text += (text.empty() ? "" : " ") + key + "=" + value;
+    }
+    std::string counters;
+    const PerfSample& c = stats.counters;
+    if (c.ipc() > 0.) {
+        char buffer[96];
+        std::snprintf(buffer, sizeof(buffer), "  IPC %5.2f", c.ipc());
+        counters += buffer;
+    }
+    if (traffic.pixels > 0.) {
+        for (const PerfCounter counter : { PerfCounter::L1DMisses, PerfCounter::LLCMisses, PerfCounter::BranchMisses }) {
+            if (!c.has(counter)) continue;
+            char buffer[96];
+            std::snprintf(buffer, sizeof(buffer), "  %s/px %.4f", perfCounterName(counter), c[counter] / traffic.pixels);
+            counters += buffer;
+        }
+    }
+    std::printf("%-28s %-56s p50 %9.3f ms  p90 %9.3f ms  %8.1f Mpix/s%s%s\n",
+                name.c_str(), text.c_str(), stats.p50Ms, stats.p90Ms,
+                stats.pixelsPerSecond * 1e-6, counters.c_str(), stats.stable ? "" : " (unstable)");
+}
+
+// Times body() with the suite config, records and prints the result, with
+// the hardware counters when they are available.
+template <typename Body>
+inline void runCpuBenchmark(BenchmarkReport& report, CpuStream& stream, const std::string& name,
+                            const BenchmarkReport::Params& params, const BenchmarkTraffic& traffic,
+                            Body&& body) {
+    const BenchmarkStats stats = runBenchmark(cpuBenchmarkConfig(), stream, traffic, body);
+    report.add(name, params, stats, perfCounterMetrics(stats, traffic));
+    printCpuBenchmark(name, params, stats, traffic);
+}
+
+template <typename T>
+inline bool checkCpuVariants(const std::string& name, const fk::Ptr2D<T>& first,
+                             const fk::Ptr2D<T>& second) {
+    const bool same = compareAndCheck(first, second);
+    if (!same) {
+        std::printf("%s: fused and unfused outputs differ\n", name.c_str());
+    }
+    return same;
+}
+
+inline void writeCpuBenchmarkReport(const BenchmarkReport& report, const std::string& fileName) {
+    report.writeJSON(fileName + ".json");
+    report.writeCSV(fileName + ".csv");
+    std::printf("Wrote %zu results to %s.json and %s.csv\n", report.entries().size(),
+                fileName.c_str(), fileName.c_str());
+}
+
+#endif // FK_CPU_BENCHMARK_COMMON_H
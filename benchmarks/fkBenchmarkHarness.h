@@ -0,0 +1,374 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_BENCHMARK_HARNESS_H
+#define FK_BENCHMARK_HARNESS_H
+
+/* Reusable statistical benchmark harness.
+ *
+ *  - BenchmarkConfig: warmup count, min/max timed iterations and a relative
+ *    standard-error target: after minIters, sampling stops as soon as
+ *    stddev / sqrt(n) / mean <= targetRelStdErr (run-until-stable), or at
+ *    maxIters / maxSeconds.
+ *  - runBenchmark<PA>(config, stream, traffic, body) times body() with
+ *    std::chrono on CPU and CUDA events on GPU and returns BenchmarkStats:
+ *    mean, stddev, min, max, p50/p90/p99 and the throughput derived from
+ *    BenchmarkTraffic (bytes and pixels touched per iteration, accumulated
+ *    from the Ptr sizes) over the MEDIAN time, which outliers do not move.
+ *    On CPU the timer also reads the hardware counters of fkPerfCounters.h
+ *    around each iteration; their mean lands in BenchmarkStats::counters and
+ *    perfCounterMetrics() turns it into IPC and per pixel rates.
+ *  - BenchmarkReport collects results keyed by benchmark name + parameters
+ *    and writes them as JSON or CSV, one record per (benchmark, params).
+ *    Derived numbers (speedups, bytes saved...) ride along as metrics. */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/parallel_architectures.h>
+#include <fused_kernel/core/execution_model/stream.h>
+
+#include <benchmarks/fkPerfCounters.h>
+
+struct BenchmarkConfig {
+    int warmup{ 10 };
+    int minIters{ 20 };
+    int maxIters{ 1000 };
+    double targetRelStdErr{ 0.005 };   // 0 disables the adaptive stop
+    double maxSeconds{ 10.0 };         // wall-clock cap on the timed phase
+};
+
+// Bytes and pixels one iteration moves, derived from the Ptr sizes.
+struct BenchmarkTraffic {
+    double bytes{ 0. };
+    double pixels{ 0. };
+
+    template <fk::ND D, typename T>
+    inline BenchmarkTraffic& read(const fk::Ptr<D, T>& ptr) {
+        return add(ptr, true);
+    }
+    template <fk::ND D, typename T>
+    inline BenchmarkTraffic& write(const fk::Ptr<D, T>& ptr) {
+        return add(ptr, false);
+    }
+
+private:
+    template <fk::ND D, typename T>
+    inline BenchmarkTraffic& add(const fk::Ptr<D, T>& ptr, const bool countPixels) {
+        const size_t elems = ptr.getNumElements();
+        bytes += static_cast<double>(elems * sizeof(T));
+        // pixels are counted on the input side only: an op producing one
+        // output pixel per input pixel is 1 pixel per element, not 2
+        if (countPixels) pixels += static_cast<double>(elems);
+        return *this;
+    }
+};
+
+struct BenchmarkStats {
+    size_t samples{ 0 };
+    int warmup{ 0 };
+    bool stable{ false };          // reached targetRelStdErr before the caps
+    double meanMs{ 0. }, stddevMs{ 0. }, minMs{ 0. }, maxMs{ 0. };
+    double p50Ms{ 0. }, p90Ms{ 0. }, p99Ms{ 0. };
+    double bytesPerSecond{ 0. }, pixelsPerSecond{ 0. };
+    PerfSample counters;           // mean per iteration, validMask 0 without counters
+};
+
+// Linear interpolation between closest ranks; sorted must be non-empty.
+inline double benchmarkPercentile(const std::vector<double>& sorted, const double p) {
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(std::floor(rank));
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+}
+
+inline BenchmarkStats computeBenchmarkStats(std::vector<double> timesMs,
+                                            const BenchmarkTraffic& traffic = {}) {
+    BenchmarkStats s;
+    s.samples = timesMs.size();
+    if (timesMs.empty()) return s;
+    std::sort(timesMs.begin(), timesMs.end());
+    double sum = 0.;
+    for (const double t : timesMs) sum += t;
+    s.meanMs = sum / static_cast<double>(timesMs.size());
+    double sq = 0.;
+    for (const double t : timesMs) sq += (t - s.meanMs) * (t - s.meanMs);
+    s.stddevMs = timesMs.size() > 1 ? std::sqrt(sq / static_cast<double>(timesMs.size() - 1)) : 0.;
+    s.minMs = timesMs.front();
+    s.maxMs = timesMs.back();
+    s.p50Ms = benchmarkPercentile(timesMs, 0.50);
+    s.p90Ms = benchmarkPercentile(timesMs, 0.90);
+    s.p99Ms = benchmarkPercentile(timesMs, 0.99);
+    if (s.p50Ms > 0.) {
+        s.bytesPerSecond = traffic.bytes / (s.p50Ms * 1e-3);
+        s.pixelsPerSecond = traffic.pixels / (s.p50Ms * 1e-3);
+    }
+    return s;
+}
+
+template <enum fk::ParArch PA>
+class BenchmarkTimer;
+
+template <>
+class BenchmarkTimer<fk::ParArch::CPU> {
+    std::chrono::time_point<std::chrono::steady_clock> m_start;
+    PerfCounters m_counters;
+    PerfSample m_lastCounters;
+public:
+    explicit BenchmarkTimer(fk::Stream_<fk::ParArch::CPU>&) {}
+    inline void start() {
+        m_counters.start();
+        m_start = std::chrono::steady_clock::now();
+    }
+    inline double stopMs() {
+        const auto stop = std::chrono::steady_clock::now();
+        m_lastCounters = m_counters.stop();
+        return std::chrono::duration<double, std::milli>(stop - m_start).count();
+    }
+    inline const PerfSample& lastCounters() const { return m_lastCounters; }
+};
+
+#if defined(__CUDACC__) || defined(__HIP__)
+template <>
+class BenchmarkTimer<fk::ParArch::GPU_NVIDIA> {
+    cudaEvent_t m_start, m_stop;
+    cudaStream_t m_stream;
+public:
+    explicit BenchmarkTimer(fk::Stream_<fk::ParArch::GPU_NVIDIA>& stream) : m_stream(stream) {
+        gpuErrchk(cudaEventCreate(&m_start));
+        gpuErrchk(cudaEventCreate(&m_stop));
+    }
+    ~BenchmarkTimer() {
+        gpuErrchk(cudaEventDestroy(m_start));
+        gpuErrchk(cudaEventDestroy(m_stop));
+    }
+    inline void start() { gpuErrchk(cudaEventRecord(m_start, m_stream)); }
+    inline double stopMs() {
+        float ms = 0.f;
+        gpuErrchk(cudaEventRecord(m_stop, m_stream));
+        gpuErrchk(cudaEventSynchronize(m_stop));
+        gpuErrchk(cudaEventElapsedTime(&ms, m_start, m_stop));
+        return static_cast<double>(ms);
+    }
+};
+#endif // defined(__CUDACC__) || defined(__HIP__)
+
+template <enum fk::ParArch PA, typename Body>
+inline BenchmarkStats runBenchmark(const BenchmarkConfig& config, fk::Stream_<PA>& stream,
+                                   const BenchmarkTraffic& traffic, Body&& body) {
+    if (config.minIters < 2 || config.maxIters < config.minIters) {
+        throw std::invalid_argument("BenchmarkConfig: need 2 <= minIters <= maxIters");
+    }
+    for (int i = 0; i < config.warmup; ++i) body();
+    stream.sync();
+
+    BenchmarkTimer<PA> timer(stream);
+    std::vector<double> times;
+    times.reserve(config.minIters);
+    double sum = 0., sumSq = 0., elapsedMs = 0.;
+    bool stable = false;
+    PerfSample counters;
+    for (int i = 0; i < config.maxIters; ++i) {
+        timer.start();
+        body();
+        const double t = timer.stopMs();
+        if constexpr (requires { timer.lastCounters(); }) {
+            counters.accumulate(timer.lastCounters(), i == 0);
+        }
+        times.push_back(t);
+        sum += t;
+        sumSq += t * t;
+        elapsedMs += t;
+        const double n = static_cast<double>(times.size());
+        if (times.size() >= static_cast<size_t>(config.minIters)) {
+            const double mean = sum / n;
+            const double var = std::max(0., (sumSq - n * mean * mean) / (n - 1.));
+            if (config.targetRelStdErr > 0. && mean > 0. &&
+                std::sqrt(var / n) / mean <= config.targetRelStdErr) {
+                stable = true;
+                break;
+            }
+            if (elapsedMs * 1e-3 >= config.maxSeconds) break;
+        }
+    }
+    const double iterations = static_cast<double>(times.size());
+    BenchmarkStats s = computeBenchmarkStats(std::move(times), traffic);
+    s.warmup = config.warmup;
+    s.stable = stable;
+    s.counters = counters.scaled(1. / iterations);
+    return s;
+}
+
+// IPC plus every available counter per pixel of traffic (per iteration
+// when the traffic has no pixels); empty without counters.
+inline std::vector<std::pair<std::string, double>> perfCounterMetrics(const BenchmarkStats& stats,
+                                                                      const BenchmarkTraffic& traffic) {
+    std::vector<std::pair<std::string, double>> metrics;
+    if (stats.counters.validMask == 0) return metrics;
+    if (stats.counters.ipc() > 0.) metrics.push_back({ "ipc", stats.counters.ipc() });
+    const bool perPixel = traffic.pixels > 0.;
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        const PerfCounter counter = static_cast<PerfCounter>(i);
+        if (!stats.counters.has(counter)) continue;
+        metrics.push_back({ std::string(perfCounterName(counter)) + (perPixel ? "_per_pixel" : "_per_iter"),
+                            perPixel ? stats.counters[counter] / traffic.pixels : stats.counters[counter] });
+    }
+    return metrics;
+}
+
+class BenchmarkReport {
+public:
+    using Params = std::vector<std::pair<std::string, std::string>>;
+    using Metrics = std::vector<std::pair<std::string, double>>;
+
+    struct Entry {
+        std::string name;
+        Params params;
+        BenchmarkStats stats;
+        Metrics metrics;
+    };
+
+    // Adds a result; an existing (name, params) record is replaced.
+    inline void add(const std::string& name, const Params& params, const BenchmarkStats& stats,
+                    const Metrics& metrics = {}) {
+        for (auto& e : m_entries) {
+            if (e.name == name && e.params == params) {
+                e.stats = stats;
+                e.metrics = metrics;
+                return;
+            }
+        }
+        m_entries.push_back({ name, params, stats, metrics });
+    }
+
+    inline const std::vector<Entry>& entries() const { return m_entries; }
+
+    inline std::string toJSON() const {
+        std::ostringstream os;
+        os << std::setprecision(9) << "[\n";
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            const Entry& e = m_entries[i];
+            os << "  {\"benchmark\": \"" << escape(e.name) << "\", \"params\": {";
+            for (size_t p = 0; p < e.params.size(); ++p) {
+                os << (p ? ", " : "") << '"' << escape(e.params[p].first) << "\": \""
+                   << escape(e.params[p].second) << '"';
+            }
+            const BenchmarkStats& s = e.stats;
+            os << "}, \"samples\": " << s.samples << ", \"warmup\": " << s.warmup
+               << ", \"stable\": " << (s.stable ? "true" : "false")
+               << ", \"mean_ms\": " << number(s.meanMs) << ", \"stddev_ms\": " << number(s.stddevMs)
+               << ", \"min_ms\": " << number(s.minMs) << ", \"max_ms\": " << number(s.maxMs)
+               << ", \"p50_ms\": " << number(s.p50Ms) << ", \"p90_ms\": " << number(s.p90Ms)
+               << ", \"p99_ms\": " << number(s.p99Ms) << ", \"bytes_per_s\": " << number(s.bytesPerSecond)
+               << ", \"pixels_per_s\": " << number(s.pixelsPerSecond);
+            if (!e.metrics.empty()) {
+                os << ", \"metrics\": {";
+                for (size_t m = 0; m < e.metrics.size(); ++m) {
+                    os << (m ? ", " : "") << '"' << escape(e.metrics[m].first) << "\": " << number(e.metrics[m].second);
+                }
+                os << "}";
+            }
+            os << "}" << (i + 1 < m_entries.size() ? "," : "") << "\n";
+        }
+        os << "]\n";
+        return os.str();
+    }
+
+    // One row per record; parameters and metrics are folded into "k=v;k=v"
+    // columns so every benchmark shares the same header.
+    inline std::string toCSV() const {
+        std::ostringstream os;
+        os << std::setprecision(9)
+           << "benchmark,params,samples,warmup,stable,mean_ms,stddev_ms,min_ms,max_ms,"
+              "p50_ms,p90_ms,p99_ms,bytes_per_s,pixels_per_s,metrics\n";
+        for (const Entry& e : m_entries) {
+            std::string params;
+            for (size_t p = 0; p < e.params.size(); ++p) {
+                params += (p ? ";" : "") + e.params[p].first + "=" + e.params[p].second;
+            }
+            std::ostringstream metrics;
+            metrics << std::setprecision(9);
+            for (size_t m = 0; m < e.metrics.size(); ++m) {
+                metrics << (m ? ";" : "") << e.metrics[m].first << "=" << e.metrics[m].second;
+            }
+            const BenchmarkStats& s = e.stats;
+            os << csvField(e.name) << ',' << csvField(params) << ',' << s.samples << ','
+               << s.warmup << ',' << (s.stable ? 1 : 0) << ',' << s.meanMs << ','
+               << s.stddevMs << ',' << s.minMs << ',' << s.maxMs << ',' << s.p50Ms << ','
+               << s.p90Ms << ',' << s.p99Ms << ',' << s.bytesPerSecond << ','
+               << s.pixelsPerSecond << ',' << csvField(metrics.str()) << '\n';
+        }
+        return os.str();
+    }
+
+    inline void writeJSON(const std::string& fileName) const { writeFile(fileName, toJSON()); }
+    inline void writeCSV(const std::string& fileName) const { writeFile(fileName, toCSV()); }
+
+private:
+    std::vector<Entry> m_entries;
+
+    // JSON strings: quotes and backslashes escaped, control characters as \u00XX
+    static inline std::string escape(const std::string& s) {
+        std::string out;
+        for (const char c : s) {
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+                out += code;
+                continue;
+            }
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    // JSON numbers have no NaN nor infinity: those are written as null
+    static inline std::string number(const double value) {
+        if (!std::isfinite(value)) return "null";
+        std::ostringstream os;
+        os << std::setprecision(9) << value;
+        return os.str();
+    }
+
+    static inline std::string csvField(const std::string& s) {
+        if (s.find_first_of(",\"\n") == std::string::npos) return s;
+        std::string out = "\"";
+        for (const char c : s) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    static inline void writeFile(const std::string& fileName, const std::string& text) {
+        std::ofstream file(fileName);
+        if (!file) {
+            throw std::runtime_error("BenchmarkReport: cannot open " + fileName);
+        }
+        file << text;
+    }
+};
+
+#endif // FK_BENCHMARK_HARNESS_H
@@ -18,7 +18,9 @@
 #include <array>
 #include <chrono>
 #include <unordered_map>
+#include <utility>
 #include <sstream>
+#include <string>
 #include <fstream>
 #include <iostream>
 
@@ -28,6 +30,8 @@
 
 #include <fused_kernel/core/execution_model/parallel_architectures.h>
 
+#include <benchmarks/fkPerfCounters.h>
+
 constexpr int ITERS = 100;
 std::unordered_map<std::string, std::stringstream> benchmarkResultsText;
 std::unordered_map<std::string, std::ofstream> currentFile;
@@ -60,6 +64,44 @@ inline bool compareAndCheck(const fk::Ptr2D<T>& firstResult, const fk::Ptr2D<T>&
     return true;
 }
 
+// Mean of the per iteration counter samples; a counter missing in any
+// sample is missing in the mean.
+template <size_t N>
+inline PerfSample meanPerfSample(const std::array<PerfSample, N>& samples) {
+    PerfSample mean;
+    for (size_t i = 0; i < N; ++i) {
+        mean.accumulate(samples[i], i == 0);
+    }
+    return mean.scaled(1.0 / static_cast<double>(N));
+}
+
+// Extra CSV columns with the mean counters per iteration, prefixed by label.
+// Files always carry them, so that every row has the same columns
+inline std::string perfCsvHeader(const std::string& label) {
+    std::string header = ", " + label + "IPC";
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        header += ", " + label + "Mean " + perfCounterName(static_cast<PerfCounter>(i));
+    }
+    return header;
+}
+
+inline std::string perfCsvValues(const PerfSample& mean) {
+    std::stringstream values;
+    values << ", ";
+    if (mean.ipc() > 0.) { values << mean.ipc(); } else { values << "NA"; }
+    for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+        values << ", ";
+        if (mean.has(static_cast<PerfCounter>(i))) { values << mean.values[i]; } else { values << "NA"; }
+    }
+    return values.str();
+}
+
+// NA in every counter column when the marker has no counter samples
+template <size_t N>
+inline std::string perfCsvValues(const std::array<PerfSample, N>* samples) {
+    return perfCsvValues(samples != nullptr ? meanPerfSample(*samples) : PerfSample{});
+}
+
 struct BenchmarkResultsNumbersOne {
     float fkElapsedTimeMax{ fk::minValue<float> };;
     float fkElapsedTimeMin{ fk::maxValue<float> };
@@ -78,17 +120,21 @@ class TimeMarkerOne;
 template <>
 class TimeMarkerOne<fk::ParArch::CPU> final : public TimeMarkerInterfaceOne {
     std::array<float, ITERS> m_elapsedTime;
+    std::array<PerfSample, ITERS> m_counterSamples;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_start, m_stop;
+    PerfCounters m_counters;
 public:
     TimeMarkerOne(fk::Stream stream) {
         m_elapsedTime.fill(0.f);
     }
     ~TimeMarkerOne() = default;
     void start() final {
+        m_counters.start();
         m_start = std::chrono::high_resolution_clock::now();
     }
     void stop(BenchmarkResultsNumbersOne& resF, const int& idx) final {
         m_stop = std::chrono::high_resolution_clock::now();
+        m_counterSamples[idx] = m_counters.stop();
         m_elapsedTime[idx] = std::chrono::duration<float, std::milli>(m_stop - m_start).count();
         resF.fkElapsedTimeMax = resF.fkElapsedTimeMax < m_elapsedTime[idx] ? m_elapsedTime[idx] : resF.fkElapsedTimeMax;
         resF.fkElapsedTimeMin = resF.fkElapsedTimeMin > m_elapsedTime[idx] ? m_elapsedTime[idx] : resF.fkElapsedTimeMin;
@@ -97,6 +143,12 @@ public:
     std::array<float, ITERS> getElapsedTime() const final {
         return m_elapsedTime;
     }
+    const PerfCounters& counters() const {
+        return m_counters;
+    }
+    const std::array<PerfSample, ITERS>& getCounterSamples() const {
+        return m_counterSamples;
+    }
 };
 
 #if defined(__CUDACC__) || defined(__HIP__)
@@ -165,6 +217,18 @@ public:
 };
 #endif // defined(NVRTC_ENABLED)
 
+// Counter samples of a marker, or nullptr when it has none (GPU markers) or
+// the counters are unavailable
+template <typename Marker>
+inline const std::array<PerfSample, ITERS>* counterSamplesOf(const Marker& marker) {
+    if constexpr (requires { marker.getCounterSamples(); }) {
+        if (marker.counters().available()) {
+            return &marker.getCounterSamples();
+        }
+    }
+    return nullptr;
+}
+
 struct BenchmarkResultsNumbersTwo {
     float firstElapsedTimeMax{ fk::minValue<float> };
     float firstElapsedTimeMin{ fk::maxValue<float> };
@@ -189,7 +253,10 @@ template <>
 class TimeMarkerTwo<fk::ParArch::CPU> final : public TimeMarkerInterfaceTwo {
     std::array<float, ITERS> m_firstElapsedTime;
     std::array<float, ITERS> m_secondElapsedTime;
+    std::array<PerfSample, ITERS> m_firstCounterSamples;
+    std::array<PerfSample, ITERS> m_secondCounterSamples;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_start, m_stop;
+    PerfCounters m_counters;
 public:
     TimeMarkerTwo(fk::Stream stream) {
         m_firstElapsedTime.fill(0.f);
@@ -199,20 +266,24 @@ public:
     ~TimeMarkerTwo() = default;
 
     void startFirst() final {
+        m_counters.start();
         m_start = std::chrono::high_resolution_clock::now();
     };
 
     void stopFirstStartSecond(BenchmarkResultsNumbersTwo& resF, const int& idx) final {
         m_stop = std::chrono::high_resolution_clock::now();
+        m_firstCounterSamples[idx] = m_counters.stop();
         m_firstElapsedTime[idx] = std::chrono::duration<float, std::milli>(m_stop - m_start).count();
         resF.firstElapsedTimeMax = resF.firstElapsedTimeMax < m_firstElapsedTime[idx] ? m_firstElapsedTime[idx] : resF.firstElapsedTimeMax;
         resF.firstElapsedTimeMin = resF.firstElapsedTimeMin > m_firstElapsedTime[idx] ? m_firstElapsedTime[idx] : resF.firstElapsedTimeMin;
         resF.firstElapsedTimeAcum += m_firstElapsedTime[idx];
+        m_counters.start();
         m_start = std::chrono::high_resolution_clock::now();
     }
 
     void stopSecond(BenchmarkResultsNumbersTwo& resF, const int& idx) final {
         m_stop = std::chrono::high_resolution_clock::now();
+        m_secondCounterSamples[idx] = m_counters.stop();
         m_secondElapsedTime[idx] = std::chrono::duration<float, std::milli>(m_stop - m_start).count();
         resF.secondElapsedTimeMax = resF.secondElapsedTimeMax < m_secondElapsedTime[idx] ? m_secondElapsedTime[idx] : resF.secondElapsedTimeMax;
         resF.secondElapsedTimeMin = resF.secondElapsedTimeMin > m_secondElapsedTime[idx] ? m_secondElapsedTime[idx] : resF.secondElapsedTimeMin;
@@ -224,6 +295,15 @@ public:
     std::array<float, ITERS> getSecondElapsedTime() const final {
         return m_secondElapsedTime;
     };
+    const PerfCounters& counters() const {
+        return m_counters;
+    }
+    const std::array<PerfSample, ITERS>& getFirstCounterSamples() const {
+        return m_firstCounterSamples;
+    }
+    const std::array<PerfSample, ITERS>& getSecondCounterSamples() const {
+        return m_secondCounterSamples;
+    }
 };
 
 #if defined(__CUDACC__) || defined(__HIP__)
@@ -324,4 +404,15 @@ public:
 };
 #endif // NVRTC_ENABLED
 
+template <typename Marker>
+inline std::pair<const std::array<PerfSample, ITERS>*, const std::array<PerfSample, ITERS>*>
+counterSamplesOfTwo(const Marker& marker) {
+    if constexpr (requires { marker.getFirstCounterSamples(); }) {
+        if (marker.counters().available()) {
+            return { &marker.getFirstCounterSamples(), &marker.getSecondCounterSamples() };
+        }
+    }
+    return { nullptr, nullptr };
+}
+
 #endif // FK_BENCHMARKS_COMMON_H
\ No newline at end of file
@@ -0,0 +1,263 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_FUSION_COMPARISON_H
+#define FK_FUSION_COMPARISON_H
+
+/* Fused-vs-unfused comparison generator.
+ *
+ * Given one IOp chain (Read, compute IOps..., Write), FusionChain can run it
+ * with a split after any subset of its compute IOps: a split ends the current
+ * TransformDPP launch with a PerThreadWrite into an intermediate Ptr2D of the
+ * op's OutputType and starts the next launch with a PerThreadRead of it.
+ * Split configurations are bit masks, bit k meaning "split after compute IOp
+ * k" (0-based); mask 0 is the fully fused chain and the all-ones mask is one
+ * launch per compute IOp.
+ *
+ * compareFusion() times the configurations selected by FusionSplits with
+ * runBenchmark and reports, per configuration, the launch count, the bytes
+ * moved, the bytes fusion saves over it and the speedup of the fused chain
+ * over it (p50 ratio; > 1 means fusing wins).
+ *
+ * Only 2D chains are supported (the Read must declare a single plane).
+ * Bytes are counted at the chain ends with the Read OutputType and the Write
+ * InputType, plus one write and one read of every intermediate. */
+
+#include <benchmarks/fkBenchmarkHarness.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/data_parallel_patterns.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum class FusionSplits {
+    Ends,      // fully fused and one launch per op
+    Single,    // Ends plus every single split point
+    All        // every subset of split points
+};
+
+struct FusionSplitResult {
+    std::string label;          // "fused", "unfused" or "split@2,3" (1-based op indices)
+    unsigned int mask{ 0 };
+    int launches{ 1 };
+    BenchmarkStats stats;
+    double bytes{ 0. };         // traffic of one run of this configuration
+    double bytesSaved{ 0. };    // bytes - fused bytes
+    double speedup{ 1. };       // p50 of this configuration / p50 of the fused chain
+};
+
+template <enum fk::ParArch PA, typename... IOps>
+class FusionChain {
+    static_assert(sizeof...(IOps) >= 2, "A fusion chain needs at least a Read and a Write IOp");
+
+    using Chain = std::tuple<IOps...>;
+    template <size_t I>
+    using IOpAt = std::decay_t<std::tuple_element_t<I, Chain>>;
+
+public:
+    static constexpr size_t NUM_OPS = sizeof...(IOps) - 2;
+    static constexpr size_t NUM_GAPS = NUM_OPS > 0 ? NUM_OPS - 1 : 0;
+
+private:
+    // Type stored in the intermediate after compute IOp K
+    template <size_t K>
+    using GapType = typename IOpAt<K + 1>::Operation::OutputType;
+
+    template <size_t... Ks>
+    static auto makeTemps(std::index_sequence<Ks...>) -> std::tuple<fk::Ptr2D<GapType<Ks>>...>;
+    using Temps = decltype(makeTemps(std::make_index_sequence<NUM_GAPS>{}));
+
+    fk::Stream_<PA>& m_stream;
+    Chain m_iOps;
+    Temps m_temps;
+    fk::ActiveThreads m_activeThreads;
+
+    template <size_t... Ks>
+    inline void allocTemps(std::index_sequence<Ks...>) {
+        constexpr fk::MemType memType = PA == fk::ParArch::CPU ? fk::MemType::Host : fk::MemType::Device;
+        ((std::get<Ks>(m_temps) = fk::Ptr2D<GapType<Ks>>(m_activeThreads.x, m_activeThreads.y, 0, memType)), ...);
+    }
+
+    template <size_t... Ks>
+    inline double gapBytes(const unsigned int mask, std::index_sequence<Ks...>) const {
+        return (0. + ... + (((mask >> Ks) & 1u) ? 2. * sizeof(GapType<Ks>) : 0.)) * elements();
+    }
+
+    // One launch covering compute IOps [S, E)
+    template <size_t S, size_t E, size_t... Js>
+    inline void launchSegment(std::index_sequence<Js...>) {
+        const auto read = [&] {
+            if constexpr (S == 0) {
+                return std::get<0>(m_iOps);
+            } else {
+                return fk::PerThreadRead<fk::ND::_2D, GapType<S - 1>>::build(std::get<S - 1>(m_temps));
+            }
+        }();
+        const auto write = [&] {
+            if constexpr (E == NUM_OPS) {
+                return std::get<NUM_OPS + 1>(m_iOps);
+            } else {
+                return fk::PerThreadWrite<fk::ND::_2D, GapType<E - 1>>::build(std::get<E - 1>(m_temps));
+            }
+        }();
+        fk::executeOperations<fk::TransformDPP<PA>>(m_stream, read, std::get<S + 1 + Js>(m_iOps)..., write);
+    }
+
+    template <size_t S, size_t... Es>
+    inline void dispatchEnd(const size_t end, std::index_sequence<Es...>) {
+        ((end == S + 1 + Es ? launchSegment<S, S + 1 + Es>(std::make_index_sequence<1 + Es>{}) : void()), ...);
+    }
+
+    template <size_t... Ss>
+    inline void dispatch(const size_t start, const size_t end, std::index_sequence<Ss...>) {
+        ((start == Ss ? dispatchEnd<Ss>(end, std::make_index_sequence<NUM_OPS - Ss>{}) : void()), ...);
+    }
+
+public:
+    FusionChain(fk::Stream_<PA>& stream, const IOps&... iOps)
+        : m_stream(stream), m_iOps(iOps...), m_activeThreads(std::get<0>(m_iOps).getActiveThreads()) {
+        if (m_activeThreads.z != 1) {
+            throw std::invalid_argument("FusionChain: only single-plane (2D) chains can be split");
+        }
+        allocTemps(std::make_index_sequence<NUM_GAPS>{});
+    }
+
+    inline double elements() const {
+        return static_cast<double>(m_activeThreads.x) * static_cast<double>(m_activeThreads.y);
+    }
+
+    static constexpr unsigned int unfusedMask() { return (1u << NUM_GAPS) - 1u; }
+
+    // Masks selected by mode, fused first and without duplicates
+    static inline std::vector<unsigned int> masks(const FusionSplits mode) {
+        if (mode == FusionSplits::All && NUM_GAPS > 16) {
+            throw std::invalid_argument("FusionChain: too many split points to enumerate them all");
+        }
+        std::vector<unsigned int> result{ 0u };
+        if (mode == FusionSplits::All) {
+            for (unsigned int mask = 1; mask <= unfusedMask(); ++mask) result.push_back(mask);
+            return result;
+        }
+        if (mode == FusionSplits::Single && NUM_GAPS > 1) {
+            for (size_t k = 0; k < NUM_GAPS; ++k) result.push_back(1u << k);
+        }
+        if (NUM_GAPS > 0) result.push_back(unfusedMask());
+        return result;
+    }
+
+    static inline std::string label(const unsigned int mask) {
+        if (mask == 0u) return "fused";
+        if (mask == unfusedMask()) return "unfused";
+        std::string text = "split@";
+        bool first = true;
+        for (size_t k = 0; k < NUM_GAPS; ++k) {
+            if ((mask >> k) & 1u) {
+                text += (first ? "" : ",") + std::to_string(k + 1);
+                first = false;
+            }
+        }
+        return text;
+    }
+
+    static inline int launches(const unsigned int mask) {
+        int count = 1;
+        for (size_t k = 0; k < NUM_GAPS; ++k) count += (mask >> k) & 1u;
+        return count;
+    }
+
+    inline double bytes(const unsigned int mask) const {
+        using ReadOutputType = typename IOpAt<0>::Operation::OutputType;
+        using WriteInputType = typename IOpAt<NUM_OPS + 1>::Operation::InputType;
+        return elements() * static_cast<double>(sizeof(ReadOutputType) + sizeof(WriteInputType)) +
+               gapBytes(mask, std::make_index_sequence<NUM_GAPS>{});
+    }
+
+    // Runs the chain with the given split configuration
+    inline void run(const unsigned int mask) {
+        if (mask > unfusedMask()) {
+            throw std::invalid_argument("FusionChain: split mask out of range");
+        }
+        if constexpr (NUM_OPS == 0) {
+            launchSegment<0, 0>(std::index_sequence<>{});
+        } else {
+            size_t start = 0;
+            for (size_t k = 0; k < NUM_GAPS; ++k) {
+                if ((mask >> k) & 1u) {
+                    dispatch(start, k + 1, std::make_index_sequence<NUM_OPS>{});
+                    start = k + 1;
+                }
+            }
+            dispatch(start, NUM_OPS, std::make_index_sequence<NUM_OPS>{});
+        }
+    }
+};
+
+struct FusionComparison {
+    std::vector<FusionSplitResult> results;     // results[0] is the fused chain
+
+    inline void addTo(BenchmarkReport& report, const std::string& name,
+                      const BenchmarkReport::Params& params = {}) const {
+        for (const FusionSplitResult& r : results) {
+            BenchmarkReport::Params splitParams = params;
+            splitParams.push_back({ "split", r.label });
+            report.add(name, splitParams, r.stats,
+                       { { "launches", static_cast<double>(r.launches) }, { "bytes", r.bytes },
+                         { "bytes_saved", r.bytesSaved }, { "speedup", r.speedup } });
+        }
+    }
+
+    inline void print(const std::string& name) const {
+        std::printf("%s\n%-20s %9s %12s %14s %14s %9s\n", name.c_str(), "split", "launches",
+                    "p50 ms", "bytes", "bytes saved", "speedup");
+        for (const FusionSplitResult& r : results) {
+            std::printf("%-20s %9d %12.4f %14.0f %14.0f %8.2fx\n", r.label.c_str(), r.launches,
+                        r.stats.p50Ms, r.bytes, r.bytesSaved, r.speedup);
+        }
+    }
+};
+
+template <enum fk::ParArch PA, typename... IOps>
+inline FusionComparison compareFusion(const BenchmarkConfig& config, fk::Stream_<PA>& stream,
+                                      const FusionSplits mode, const IOps&... iOps) {
+    FusionChain<PA, IOps...> chain(stream, iOps...);
+    FusionComparison comparison;
+    for (const unsigned int mask : chain.masks(mode)) {
+        FusionSplitResult r;
+        r.label = chain.label(mask);
+        r.mask = mask;
+        r.launches = chain.launches(mask);
+        r.bytes = chain.bytes(mask);
+        BenchmarkTraffic traffic;
+        traffic.bytes = r.bytes;
+        traffic.pixels = chain.elements();
+        r.stats = runBenchmark(config, stream, traffic, [&] { chain.run(mask); });
+        comparison.results.push_back(r);
+    }
+    const FusionSplitResult& fused = comparison.results.front();
+    for (FusionSplitResult& r : comparison.results) {
+        r.bytesSaved = r.bytes - fused.bytes;
+        r.speedup = fused.stats.p50Ms > 0. ? r.stats.p50Ms / fused.stats.p50Ms : 0.;
+    }
+    return comparison;
+}
+
+#endif // FK_FUSION_COMPARISON_H
@@ -0,0 +1,238 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_PERF_COUNTERS_H
+#define FK_PERF_COUNTERS_H
+
+/* Hardware performance counters for the CPU benchmarks.
+ *
+ * PerfCounters opens one perf_event_open group on the calling thread with
+ * cycles, instructions, L1D read misses, cache misses (last level on most
+ * PMUs) and branch misses, user space only. start()/stop() read the whole
+ * group with a single read() each and return the delta as a PerfSample,
+ * scaled by time_enabled / time_running when the PMU multiplexes.
+ *
+ * Counters are optional: on non-Linux builds, when the PMU is not exposed
+ * (VMs, containers, perf_event_paranoid > 2) or with FK_PERF_COUNTERS=0 in
+ * the environment, available() is false, unavailableReason() says why and
+ * every sample comes back with validMask == 0. Events the PMU lacks are
+ * skipped individually. */
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class PerfCounter { Cycles = 0, Instructions, L1DMisses, LLCMisses, BranchMisses, Count };
+
+constexpr size_t NUM_PERF_COUNTERS = static_cast<size_t>(PerfCounter::Count);
+
+inline const char* perfCounterName(const PerfCounter counter) {
+    switch (counter) {
+    case PerfCounter::Cycles: return "cycles";
+    case PerfCounter::Instructions: return "instructions";
+    case PerfCounter::L1DMisses: return "l1d_misses";
+    case PerfCounter::LLCMisses: return "llc_misses";
+    case PerfCounter::BranchMisses: return "branch_misses";
+    default: return "unknown";
+    }
+}
+
+struct PerfSample {
+    std::array<double, NUM_PERF_COUNTERS> values{};
+    unsigned int validMask{ 0 };
+
+    inline bool has(const PerfCounter counter) const {
+        return (validMask >> static_cast<unsigned int>(counter)) & 1u;
+    }
+    inline double operator[](const PerfCounter counter) const { return values[static_cast<size_t>(counter)]; }
+
+    // Instructions per cycle, 0 when either counter is missing
+    inline double ipc() const {
+        return has(PerfCounter::Cycles) && has(PerfCounter::Instructions) && (*this)[PerfCounter::Cycles] > 0.
+            ? (*this)[PerfCounter::Instructions] / (*this)[PerfCounter::Cycles] : 0.;
+    }
+
+    // Accumulates b; a counter stays valid only if it is valid in both
+    inline PerfSample& accumulate(const PerfSample& b, const bool first) {
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) values[i] += b.values[i];
+        validMask = first ? b.validMask : (validMask & b.validMask);
+        return *this;
+    }
+
+    inline PerfSample scaled(const double factor) const {
+        PerfSample s = *this;
+        for (double& v : s.values) v *= factor;
+        return s;
+    }
+};
+
+class PerfCounters {
+    std::string m_reason;
+#if defined(__linux__)
+    int m_leader{ -1 };
+    std::vector<int> m_fds;
+    std::vector<PerfCounter> m_order;     // counter of each group slot
+
+    struct RawRead {
+        uint64_t nr;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+        uint64_t values[NUM_PERF_COUNTERS];
+    };
+    RawRead m_start{};
+    bool m_started{ false };
+
+    static inline int openEvent(const uint32_t type, const uint64_t config, const int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = groupFd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+
+    inline bool readGroup(RawRead& raw) const {
+        const ssize_t expected = static_cast<ssize_t>((3 + m_order.size()) * sizeof(uint64_t));
+        return read(m_leader, &raw, sizeof(raw)) == expected && raw.nr == m_order.size();
+    }
+#endif
+
+public:
+    PerfCounters() {
+        const char* env = std::getenv("FK_PERF_COUNTERS");
+        if (env != nullptr && env[0] == '0') {
+            m_reason = "disabled by FK_PERF_COUNTERS=0";
+            return;
+        }
+#if defined(__linux__)
+        const std::array<std::pair<uint32_t, uint64_t>, NUM_PERF_COUNTERS> events{ {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES } } };
+        int firstErrno = 0;
+        for (size_t i = 0; i < NUM_PERF_COUNTERS; ++i) {
+            const int fd = openEvent(events[i].first, events[i].second, m_leader);
+            if (fd < 0) {
+                if (firstErrno == 0) firstErrno = errno;
+                continue;
+            }
+            if (m_leader == -1) m_leader = fd;
+            m_fds.push_back(fd);
+            m_order.push_back(static_cast<PerfCounter>(i));
+        }
+        if (m_leader == -1) {
+            m_reason = std::string("perf_event_open failed: ") + std::strerror(firstErrno);
+            return;
+        }
+        if (ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+            m_reason = std::string("cannot enable perf counters: ") + std::strerror(errno);
+            closeAll();
+            return;
+        }
+        RawRead probe{};
+        if (!readGroup(probe)) {
+            m_reason = "cannot read perf counters";
+            closeAll();
+        }
+#else
+        m_reason = "perf counters are only supported on Linux";
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        closeAll();
+#endif
+    }
+
+    inline bool available() const {
+#if defined(__linux__)
+        return m_leader != -1;
+#else
+        return false;
+#endif
+    }
+
+    inline bool has(const PerfCounter counter) const {
+#if defined(__linux__)
+        for (const PerfCounter c : m_order) {
+            if (c == counter) return true;
+        }
+#endif
+        (void)counter;
+        return false;
+    }
+
+    inline const std::string& unavailableReason() const { return m_reason; }
+
+    inline void start() {
+#if defined(__linux__)
+        m_started = available() && readGroup(m_start);
+#endif
+    }
+
+    inline PerfSample stop() {
+        PerfSample sample;
+#if defined(__linux__)
+        RawRead end{};
+        if (!m_started || !readGroup(end)) return sample;
+        m_started = false;
+        const uint64_t enabled = end.timeEnabled - m_start.timeEnabled;
+        const uint64_t running = end.timeRunning - m_start.timeRunning;
+        // The group never got the PMU during the interval
+        if (running == 0) return sample;
+        const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+        for (size_t slot = 0; slot < m_order.size(); ++slot) {
+            const size_t i = static_cast<size_t>(m_order[slot]);
+            sample.values[i] = static_cast<double>(end.values[slot] - m_start.values[slot]) * scale;
+            sample.validMask |= 1u << i;
+        }
+#endif
+        return sample;
+    }
+
+private:
+#if defined(__linux__)
+    inline void closeAll() {
+        for (const int fd : m_fds) close(fd);
+        m_fds.clear();
+        m_order.clear();
+        m_leader = -1;
+    }
+#endif
+};
+
+#endif // FK_PERF_COUNTERS_H
@@ -0,0 +1,349 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_ROOFLINE_H
+#define FK_ROOFLINE_H
+
+/* Roofline analyzer for fused pipelines.
+ *
+ *  - RooflineModel<IOps...> computes, at compile time, the bytes moved and
+ *    the arithmetic ops executed per output element of an IOp chain. Bytes
+ *    come from the Read ReadDataType (or OutputType) and from the
+ *    WriteDataType (or InputType) of every Write and MidWrite; fused IOps
+ *    are walked recursively. ReadBack ops count one source element per
+ *    output element, so resizes and neighborhoods are an underestimate.
+ *  - RooflineOpCost<Operation> is the per-op cost table: by default one op
+ *    per output channel for compute Operations and none for memory ones.
+ *    Specialize it for Operations whose cost differs.
+ *  - measureCpuMachinePeak() probes the machine with a STREAM triad for
+ *    bandwidth and an FMA loop for arithmetic throughput. Both run on one
+ *    thread, like the CPU backend. It also records the last level cache
+ *    size, when the OS reports it.
+ *  - analyzeRoofline() runs the pipeline with runBenchmark and reports the
+ *    achieved GB/s and GOP/s, the attainable GOP/s for its intensity and
+ *    whether it is memory or compute bound. Memory bound pipelines are
+ *    the ones that gain from more fusion. A pipeline whose working set
+ *    fits in the last level cache is flagged as cache resident, and its
+ *    bandwidth roof is a triad probe of the same working set instead of
+ *    the DRAM one. */
+
+#include <benchmarks/fkBenchmarkHarness.h>
+
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/vector_ops.h>
+#include <fused_kernel/algorithms/image_processing/color_conversion.h>
+#include <fused_kernel/core/execution_model/data_parallel_patterns.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace roofline_detail {
+    template <typename Operation>
+    constexpr double defaultOpCost() {
+        if constexpr (fk::isComputeType<Operation>) {
+            return static_cast<double>(fk::cn<typename Operation::OutputType>);
+        } else {
+            return 0.;
+        }
+    }
+} // namespace roofline_detail
+
+template <typename Operation>
+struct RooflineOpCost {
+    static constexpr double value = roofline_detail::defaultOpCost<Operation>();
+};
+
+// Data movement only
+template <typename I, typename O>
+struct RooflineOpCost<fk::Cast<I, O>> {
+    static constexpr double value = 0.;
+};
+template <typename I, typename O>
+struct RooflineOpCost<fk::Discard<I, O>> {
+    static constexpr double value = 0.;
+};
+template <typename T, int... Idx>
+struct RooflineOpCost<fk::VectorReorder<T, Idx...>> {
+    static constexpr double value = 0.;
+};
+template <typename I, fk::ColorDepth CD>
+struct RooflineOpCost<fk::AddOpaqueAlpha<I, CD>> {
+    static constexpr double value = 0.;
+};
+
+// Three multiplies and two adds
+template <typename I, typename O, fk::GrayFormula GF>
+struct RooflineOpCost<fk::RGB2Gray<I, O, GF>> {
+    static constexpr double value = 5.;
+};
+
+namespace roofline_detail {
+    template <typename Operation>
+    struct OpTraffic;
+
+    template <typename IOp>
+    using OpTrafficOf = OpTraffic<typename std::decay_t<IOp>::Operation>;
+
+    template <typename List>
+    struct ListTraffic;
+
+    template <typename... IOps>
+    struct ListTraffic<fk::TypeList<IOps...>> {
+        static constexpr double BYTES_READ = (0. + ... + OpTrafficOf<IOps>::BYTES_READ);
+        static constexpr double BYTES_WRITTEN = (0. + ... + OpTrafficOf<IOps>::BYTES_WRITTEN);
+        static constexpr double OPS = (0. + ... + OpTrafficOf<IOps>::OPS);
+    };
+
+    template <typename Operation>
+    constexpr double readBytes() {
+        if constexpr (!fk::isAnyReadType<Operation>) {
+            return 0.;
+        } else if constexpr (requires { typename Operation::ReadDataType; }) {
+            return static_cast<double>(sizeof(typename Operation::ReadDataType));
+        } else {
+            return static_cast<double>(sizeof(typename Operation::OutputType));
+        }
+    }
+
+    template <typename Operation>
+    constexpr double writeBytes() {
+        if constexpr (!fk::isAnyWriteType<Operation>) {
+            return 0.;
+        } else if constexpr (requires { typename Operation::WriteDataType; }) {
+            return static_cast<double>(sizeof(typename Operation::WriteDataType));
+        } else {
+            return static_cast<double>(sizeof(typename Operation::InputType));
+        }
+    }
+
+    template <typename Operation>
+    struct OpTraffic {
+        static constexpr double BYTES_READ = readBytes<Operation>();
+        static constexpr double BYTES_WRITTEN = writeBytes<Operation>();
+        static constexpr double OPS = RooflineOpCost<Operation>::value;
+    };
+
+    template <typename Operation>
+        requires requires { typename Operation::Operations; }
+    struct OpTraffic<Operation> : ListTraffic<typename Operation::Operations> {};
+} // namespace roofline_detail
+
+template <typename... IOps>
+struct RooflineModel {
+    using Traffic = roofline_detail::ListTraffic<fk::TypeList<std::decay_t<IOps>...>>;
+    static constexpr double BYTES_READ_PER_ELEMENT = Traffic::BYTES_READ;
+    static constexpr double BYTES_WRITTEN_PER_ELEMENT = Traffic::BYTES_WRITTEN;
+    static constexpr double BYTES_PER_ELEMENT = BYTES_READ_PER_ELEMENT + BYTES_WRITTEN_PER_ELEMENT;
+    static constexpr double OPS_PER_ELEMENT = Traffic::OPS;
+    static constexpr double ARITHMETIC_INTENSITY =
+        BYTES_PER_ELEMENT > 0. ? OPS_PER_ELEMENT / BYTES_PER_ELEMENT : 0.;
+};
+
+struct MachinePeak {
+    double bandwidthGBps{ 0. };
+    double gops{ 0. };
+    size_t lastLevelCacheBytes{ 0 }; // 0 when unknown: nothing is flagged as cache resident
+
+    // Arithmetic intensity (ops/byte) above which a pipeline is compute bound
+    inline double ridgePoint() const { return bandwidthGBps > 0. ? gops / bandwidthGBps : 0.; }
+    inline double attainableGops(const double intensity) const {
+        return std::min(gops, intensity * bandwidthGBps);
+    }
+};
+
+namespace roofline_detail {
+    template <typename Body>
+    inline double bestSeconds(const int repetitions, Body&& body) {
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r < repetitions; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+} // namespace roofline_detail
+
+// Size of the largest data cache, 0 when the OS does not report it
+inline size_t cpuLastLevelCacheBytes() {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+    for (const int level : { _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE }) {
+        const long bytes = sysconf(level);
+        if (bytes > 0) {
+            return static_cast<size_t>(bytes);
+        }
+    }
+#endif
+    return 0;
+}
+
+// STREAM triad a = b + s * c over three arrays of `elements` doubles, in
+// GB/s (24 bytes per element, write allocate not counted). Small arrays are
+// swept several times per sample so that each one lasts long enough to time.
+// Best of `repetitions`.
+inline double measureCpuBandwidth(const size_t elements, const int repetitions) {
+    if (elements == 0 || repetitions < 1) {
+        throw std::invalid_argument("measureCpuBandwidth: sizes and repetitions must be positive");
+    }
+    constexpr size_t MIN_SAMPLE_BYTES = size_t{ 1 } << 26;
+    const size_t bytes = 3 * sizeof(double) * elements;
+    const size_t sweeps = std::max<size_t>(1, MIN_SAMPLE_BYTES / bytes);
+
+    std::vector<double> a(elements, 0.), b(elements, 1.), c(elements, 2.);
+    const double triadSeconds = roofline_detail::bestSeconds(repetitions, [&] {
+        double* const pa = a.data();
+        const double* const pb = b.data();
+        const double* const pc = c.data();
+        for (size_t sweep = 0; sweep < sweeps; ++sweep) {
+            // A different scalar per sweep, so that no sweep is redundant
+            const double scalar = 3. + static_cast<double>(sweep);
+            for (size_t i = 0; i < elements; ++i) pa[i] = pb[i] + scalar * pc[i];
+        }
+    });
+    volatile double triadSink = a[elements / 2];
+    (void)triadSink;
+    return static_cast<double>(bytes) * static_cast<double>(sweeps) / triadSeconds * 1e-9;
+}
+
+// measureCpuBandwidth over `elements` and a 16 chain FMA loop of
+// `fmaIterations` steps (2 ops per FMA). Best of `repetitions`. The arrays
+// must be well above the last level cache for the bandwidth to be the DRAM
+// one.
+inline MachinePeak measureCpuMachinePeak(const size_t elements = size_t{ 1 } << 23,
+                                         const size_t fmaIterations = size_t{ 1 } << 22,
+                                         const int repetitions = 5) {
+    if (elements == 0 || fmaIterations == 0 || repetitions < 1) {
+        throw std::invalid_argument("measureCpuMachinePeak: sizes and repetitions must be positive");
+    }
+    MachinePeak peak;
+    peak.bandwidthGBps = measureCpuBandwidth(elements, repetitions);
+    peak.lastLevelCacheBytes = cpuLastLevelCacheBytes();
+
+    constexpr int CHAINS = 16;
+    float acc[CHAINS];
+    const float mul = 0.999999f, add = 1e-6f;
+    const double fmaSeconds = roofline_detail::bestSeconds(repetitions, [&] {
+        for (int j = 0; j < CHAINS; ++j) acc[j] = static_cast<float>(j);
+        for (size_t i = 0; i < fmaIterations; ++i) {
+            for (int j = 0; j < CHAINS; ++j) acc[j] = acc[j] * mul + add;
+        }
+        volatile float fmaSink = acc[0] + acc[CHAINS - 1];
+        (void)fmaSink;
+    });
+    peak.gops = 2. * CHAINS * static_cast<double>(fmaIterations) / fmaSeconds * 1e-9;
+    return peak;
+}
+
+enum class RooflineBound { Memory, Compute };
+
+struct RooflineResult {
+    double elements{ 0. };
+    double bytesPerElement{ 0. };
+    double opsPerElement{ 0. };
+    double intensity{ 0. };         // ops per byte
+    BenchmarkStats stats;
+    double achievedGBps{ 0. };      // over the p50 time
+    double achievedGops{ 0. };
+    double attainableGops{ 0. };    // roofline at this intensity
+    double efficiency{ 0. };        // achieved / roof, of the limiting resource
+    RooflineBound bound{ RooflineBound::Memory };
+    double workingSetBytes{ 0. };   // bytes read and written by one run
+    bool cacheResident{ false };    // working set within the last level cache
+    double roofGBps{ 0. };          // bandwidth roof: DRAM, or in-cache when cacheResident
+    MachinePeak peak;
+
+    inline const char* boundName() const { return bound == RooflineBound::Memory ? "memory" : "compute"; }
+
+    inline void addTo(BenchmarkReport& report, const std::string& name,
+                      const BenchmarkReport::Params& params = {}) const {
+        BenchmarkReport::Params boundParams = params;
+        boundParams.push_back({ "cache_resident", cacheResident ? "true" : "false" });
+        boundParams.push_back({ "bound", boundName() });
+        report.add(name, boundParams, stats,
+                   { { "bytes_per_element", bytesPerElement }, { "ops_per_element", opsPerElement },
+                     { "intensity", intensity }, { "achieved_gbps", achievedGBps },
+                     { "achieved_gops", achievedGops }, { "attainable_gops", attainableGops },
+                     { "efficiency", efficiency }, { "working_set_bytes", workingSetBytes },
+                     { "roof_gbps", roofGBps }, { "peak_gbps", peak.bandwidthGBps },
+                     { "peak_gops", peak.gops } });
+    }
+
+    inline void print(const std::string& name) const {
+        std::printf("%-36s %6.2f B/el %6.2f op/el  AI %6.3f  %8.2f GB/s %8.2f GOP/s  %5.1f%% of roof  %s bound%s\n",
+                    name.c_str(), bytesPerElement, opsPerElement, intensity, achievedGBps, achievedGops,
+                    efficiency * 100., boundName(), cacheResident ? " (cache resident)" : "");
+    }
+};
+
+// Times executeOperations<TransformDPP<PA>>(stream, iOps...) and places it
+// on the roofline of peak. When the working set of a CPU pipeline fits in
+// peak's last level cache, the DRAM bandwidth is not a roof for it: the
+// bandwidth roof is then measured with a triad of the same working set.
+// Other architectures keep the bandwidth of peak.
+template <enum fk::ParArch PA, typename... IOps>
+inline RooflineResult analyzeRoofline(const BenchmarkConfig& config, fk::Stream_<PA>& stream,
+                                      const MachinePeak& peak, const IOps&... iOps) {
+    using Model = RooflineModel<IOps...>;
+    static_assert(sizeof...(IOps) >= 2, "A roofline pipeline needs at least a Read and a Write IOp");
+    if (peak.bandwidthGBps <= 0. || peak.gops <= 0.) {
+        throw std::invalid_argument("analyzeRoofline: machine peak must be positive");
+    }
+    RooflineResult r;
+    const fk::ActiveThreads activeThreads = fk::ppFirst(iOps...).getActiveThreads();
+    r.elements = static_cast<double>(activeThreads.x) * activeThreads.y * activeThreads.z;
+    r.bytesPerElement = Model::BYTES_PER_ELEMENT;
+    r.opsPerElement = Model::OPS_PER_ELEMENT;
+    r.intensity = Model::ARITHMETIC_INTENSITY;
+    r.peak = peak;
+
+    BenchmarkTraffic traffic;
+    traffic.bytes = r.bytesPerElement * r.elements;
+    traffic.pixels = r.elements;
+    r.stats = runBenchmark(config, stream, traffic,
+                           [&] { fk::executeOperations<fk::TransformDPP<PA>>(stream, iOps...); });
+
+    const double seconds = r.stats.p50Ms * 1e-3;
+    if (seconds > 0.) {
+        r.achievedGBps = traffic.bytes / seconds * 1e-9;
+        r.achievedGops = r.opsPerElement * r.elements / seconds * 1e-9;
+    }
+    r.workingSetBytes = traffic.bytes;
+    r.cacheResident = r.workingSetBytes <= static_cast<double>(peak.lastLevelCacheBytes);
+    MachinePeak roof = peak;
+    if constexpr (PA == fk::ParArch::CPU) {
+        if (r.cacheResident) {
+            const size_t triadElements = static_cast<size_t>(r.workingSetBytes) / (3 * sizeof(double));
+            roof.bandwidthGBps = measureCpuBandwidth(std::max<size_t>(1, triadElements), 5);
+        }
+    }
+    r.roofGBps = roof.bandwidthGBps;
+    r.attainableGops = roof.attainableGops(r.intensity);
+    r.bound = r.intensity < roof.ridgePoint() ? RooflineBound::Memory : RooflineBound::Compute;
+    r.efficiency = r.bound == RooflineBound::Memory ? r.achievedGBps / roof.bandwidthGBps
+                                                    : r.achievedGops / roof.gops;
+    return r;
+}
+
+#endif // FK_ROOFLINE_H
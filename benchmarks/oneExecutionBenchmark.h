@@ -34,7 +34,8 @@ template <int VARIABLE_DIMENSION, int ITERATIONS, int NUM_BATCH_VALUES, const st
 inline void processExecution(const BenchmarkResultsNumbersOne& resF,
                              const std::string& functionName,
                              const std::array<float, ITERS>& fkElapsedTime,
-                             const std::string& variableDimension) {
+                             const std::string& variableDimension,
+                             const std::array<PerfSample, ITERS>* counterSamples = nullptr) {
     // Create 2D Table for changing types and changing batch
     const std::string fileName = functionName + std::string("_") + std::string(fk::toStrView(fk::defaultParArch)) + std::string(".csv");
     if constexpr (VARIABLE_DIMENSION == variableDimensionValues[0]) {
@@ -46,6 +47,7 @@ inline void processExecution(const BenchmarkResultsNumbersOne& resF,
         currentFile[fileName] << ", TimeVariance";
         currentFile[fileName] << ", MaxTime";
         currentFile[fileName] << ", MinTime";
+        currentFile[fileName] << perfCsvHeader("");
         currentFile[fileName] << std::endl;
     }
 
@@ -59,6 +61,7 @@ inline void processExecution(const BenchmarkResultsNumbersOne& resF,
         currentFile[fileName] << ", " << computeVariance(fkMean, fkElapsedTime);
         currentFile[fileName] << ", " << resF.fkElapsedTimeMax;
         currentFile[fileName] << ", " << resF.fkElapsedTimeMin;
+        currentFile[fileName] << perfCsvValues(counterSamples);
         currentFile[fileName] << std::endl;
     }
 }
@@ -73,7 +76,7 @@ for (int i = 0; i < ITERS; i++) { \
 #define STOP_FK_BENCHMARK \
     marker.stop(resF, i); \
 } \
-processExecution<VARIABLE_DIMENSION, ITERS, variableDimensionValues.size(), variableDimensionValues>(resF, __func__, marker.getElapsedTime(), VARIABLE_DIMENSION_NAME);
+processExecution<VARIABLE_DIMENSION, ITERS, variableDimensionValues.size(), variableDimensionValues>(resF, __func__, marker.getElapsedTime(), VARIABLE_DIMENSION_NAME, counterSamplesOf(marker));
  
 #define CLOSE_BENCHMARK \
 for (auto&& [_, file] : currentFile) { \
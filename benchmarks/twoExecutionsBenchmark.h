@@ -35,7 +35,9 @@ template <int BATCH, int ITERATIONS, int NUM_BATCH_VALUES, const std::array<size
 inline void processExecution(const BenchmarkResultsNumbersTwo& resF, const std::string &functionName,
                              const std::string& firstLabel, const std::string& secondLabel,
                              const std::array<float, ITERS> &firstElapsedTime,
-                             const std::array<float, ITERS> &secondElapsedTime, const std::string &variableDimension) {
+                             const std::array<float, ITERS> &secondElapsedTime, const std::string &variableDimension,
+                             const std::pair<const std::array<PerfSample, ITERS> *,
+                                             const std::array<PerfSample, ITERS> *> &counterSamples = {nullptr, nullptr}) {
   // Create 2D Table for changing types and changing batch
   const std::string fileName = functionName + std::string("_") + std::string(fk::toStrView(fk::defaultParArch)) + std::string(".csv");
   if constexpr (BATCH == batchValues[0]) {
@@ -52,6 +54,7 @@ inline void processExecution(const BenchmarkResultsNumbersTwo& resF, const std::
     currentFile[fileName] << ", " + secondLabel + " MaxTime";
     currentFile[fileName] << ", " + secondLabel + " MinTime";
     currentFile[fileName] << ", Mean Speedup";
+    currentFile[fileName] << perfCsvHeader(firstLabel + " ") << perfCsvHeader(secondLabel + " ");
     currentFile[fileName] << std::endl;
   }
 
@@ -78,6 +81,7 @@ inline void processExecution(const BenchmarkResultsNumbersTwo& resF, const std::
     currentFile[fileName] << ", " << resF.secondElapsedTimeMax;
     currentFile[fileName] << ", " << resF.secondElapsedTimeMin;
     currentFile[fileName] << ", " << meanSpeedup;
+    currentFile[fileName] << perfCsvValues(counterSamples.first) << perfCsvValues(counterSamples.second);
     currentFile[fileName] << std::endl;
   }
 }
@@ -98,7 +102,8 @@ inline void processExecution(const BenchmarkResultsNumbersTwo& resF, const std::
   }                                                                                                                  \
 processExecution<BATCH, ITERS, variableDimensionValues.size(), variableDimensionValues>(                               \
         resF, __func__, std::string(FIRST_LABEL), std::string(SECOND_LABEL), \
-        marker.getFirstElapsedTime(), marker.getSecondElapsedTime(), VARIABLE_DIMENSION_NAME);
+        marker.getFirstElapsedTime(), marker.getSecondElapsedTime(), VARIABLE_DIMENSION_NAME,                   \
+        counterSamplesOfTwo(marker));
  
  
 #define CLOSE_BENCHMARK                                                                                                \
@@ -15,6 +15,7 @@ function (discover_tests DIR)
        
         string(FIND "${TEST_SOURCE_CONTENTS}" "ONLY_CU"  POS_ONLY_CU)
         string(FIND "${TEST_SOURCE_CONTENTS}" "ONLY_CPU"  POS_ONLY_CPU)
+        string(FIND "${TEST_SOURCE_CONTENTS}" "__CPU_JIT__"  POS_CPU_JIT)
         set (TEST_SOURCE1 "${TEST_SOURCE}")
         string(REPLACE ${CMAKE_SOURCE_DIR} "" TEST_SOURCE1 "${TEST_SOURCE1}") #make the path relative to the current directory)
         
@@ -23,6 +24,9 @@ function (discover_tests DIR)
         if (${POS_ONLY_CU} EQUAL -1) #if the source file does not contain "__ONLY_CU__"    
             if (${ENABLE_CPU})                                    
                 add_generated_test("${TARGET_NAME}" "${TEST_SOURCE}" "cpp" "${DIR_RELATIVE_PATH}")                
+                if (NOT ${POS_CPU_JIT} EQUAL -1) #if the source file contains "__CPU_JIT__"
+                    target_link_libraries("${TARGET_NAME}_cpp" PUBLIC FKL::cpu_jit)
+                endif()
              endif()
         endif()
 
@@ -62,9 +62,14 @@
 #include <fused_kernel/algorithms/attention/softmax.h>
 #include <fused_kernel/algorithms/basic_ops/memory_operations.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace fk {
 
-enum class KVLayout { DENSE, INT8_PER_TOKEN };
+enum class KVLayout { DENSE, INT8_PER_TOKEN, FP8_PER_TOKEN };
 
 // Identity IOp: applied when no epilogue chain is given.
 struct AttentionIdentityEpilogue {
@@ -146,6 +151,91 @@ inline auto makeInt8KVRead(const int8_t* data, const float* scales,
     return Int8TokenDequantRead::build(Int8TokenDequantReadParams{ ptr, scales });
 }
 
+// ---- FLEX ATTENTION: score mods (FlexAttention-style score_mod) ------------
+// A score mod is a tiny host/device functor applied to each attention score
+// AFTER scaling and bounds/causal masking, BEFORE the online softmax:
+//     s' = mod(s, q_idx, kv_idx)
+// Return -FLT_MAX to mask a position (mask_mod semantics). Composable with
+// everything else (prologues, epilogues, compressed KV, block sparsity).
+struct NoScoreMod {
+    FK_HOST_DEVICE_CNST float operator()(const float s, const int,
+                                         const int) const { return s; }
+};
+struct ALiBiScoreMod {              // s - slope * (q - k)
+    float slope;
+    FK_HOST_DEVICE_CNST float operator()(const float s, const int q,
+                                         const int k) const {
+        return s - slope * static_cast<float>(q - k);
+    }
+};
+struct SoftCapScoreMod {            // Gemma-2 style logit soft capping
+    float cap;
+    FK_HOST_DEVICE_CNST float operator()(const float s, const int,
+                                         const int) const {
+        return cap * tanhf(s / cap);
+    }
+};
+struct SlidingWindowMask {          // mask_mod: keep only last `window` keys
+    int window;
+    FK_HOST_DEVICE_CNST float operator()(const float s, const int q,
+                                         const int k) const {
+        return (q - k) >= window ? -FLT_MAX : s;
+    }
+};
+
+/* BLOCK-SPARSE ATTENTION: a (bh, nQBlocks, nKVBlocks) uint8 mask at
+ * (maskBQ x maskBKV) granularity. Inactive KV tiles are SKIPPED ENTIRELY —
+ * no global reads, no mma, no softmax (both bandwidth and compute scale
+ * with the sparsity). nullptr = dense. Requirements (checked at launch):
+ * maskBQ % BLOCK_Q == 0 and maskBKV % BLOCK_KV == 0. */
+struct BlockSparsity {
+    const unsigned char* mask = nullptr;   // nullptr = dense
+    int nQBlocks = 0, nKVBlocks = 0;
+    int maskBQ = 128, maskBKV = 128;
+};
+
+/* GROUPED-QUERY ATTENTION: batchHeads counts QUERY heads (batch * qHeads)
+ * and K/V hold batchHeads / kvGroup planes (batch * kvHeads), so query head
+ * bh reads KV head bh / kvGroup. kvGroup = qHeads / kvHeads: 1 is MHA,
+ * qHeads is MQA. The DPPs schedule the query heads of a group together so
+ * the group shares every K/V tile load instead of repeating it. */
+inline void checkKVGroup(const int batchHeads, const int kvGroup) {
+    if (kvGroup < 1 || batchHeads % kvGroup != 0) {
+        throw std::invalid_argument(
+            "kvGroup must be >= 1 and divide batchHeads (batchHeads=" +
+            std::to_string(batchHeads) + ", kvGroup=" + std::to_string(kvGroup) + ")");
+    }
+}
+
+/* Host helper: build a sliding-window block mask at (blockQ x blockKV)
+ * granularity. Tile (qb, kb) is active iff ANY (q, k) pair inside it
+ * satisfies causal q >= k AND q - k < window. Finer blocks (e.g. 64 to
+ * match the raw-path kernel tiles) skip more tiles -> faster. The exact
+ * per-element window edge is enforced by SlidingWindowMask (score mod);
+ * compose both: mask for the skip, mod for the edge. */
+inline std::vector<unsigned char>
+makeSlidingWindowBlockMask(const int batchHeads, const int seqQ, const int seqK,
+                           const int window, const int blockQ, const int blockKV) {
+    const int nQB = (seqQ + blockQ - 1) / blockQ;
+    const int nKB = (seqK + blockKV - 1) / blockKV;
+    std::vector<unsigned char> m((size_t)batchHeads * nQB * nKB, 0);
+    for (int qb = 0; qb < nQB; ++qb) {
+        const int qLo = qb * blockQ;
+        const int qHi = std::min(seqQ - 1, qLo + blockQ - 1);
+        for (int kb = 0; kb < nKB; ++kb) {
+            const int kLo = kb * blockKV;
+            // active iff intervals [kLo, kHi] and [qHi-window+1, qHi] overlap
+            // under causality (k <= qHi) — widest query row decides.
+            const bool active = (kLo <= qHi) && (kLo + blockKV - 1 >= qLo - window + 1);
+            if (active)
+                for (int b = 0; b < batchHeads; ++b)
+                    m[((size_t)b * nQB + qb) * nKB + kb] = 1;
+        }
+    }
+    return m;
+}
+
+
 #if defined(__NVCC__)
 
 /* The DPP. QIOp/KIOp/VIOp are INSTANTIABLE Read or ReadBack IOps (possibly
@@ -179,6 +269,7 @@ public:
         float scale;             // logit scale, usually rsqrt(HEAD_DIM)
         bool causal;
         EpilogueIOp epilogue;    // fused IOp chain on the output (pre-write)
+        int kv_group = 1;        // query heads per KV head (GQA/MQA; 1 = MHA)
     };
 
     template <typename IOp>
@@ -195,8 +286,13 @@ public:
 
         const int lane = threadIdx.x & 31;
         const int warp = threadIdx.x >> 5;
-        const int qIdx = blockIdx.x * WARPS_PER_BLOCK + warp;
-        const int bh = blockIdx.y;
+        // GQA/MQA: one block per KV head (blockIdx.y). Warps walk the
+        // (query row, head in group) pairs head-fastest, so every query head
+        // of the group consumes the SAME staged K/V tiles in shared memory.
+        const int qLinear = blockIdx.x * WARPS_PER_BLOCK + warp;
+        const int qIdx = qLinear / p.kv_group;
+        const int kvBh = blockIdx.y;
+        const int bh = kvBh * p.kv_group + qLinear % p.kv_group;
         const bool active = qIdx < p.seq_q;
 
         float qReg[ELEMS_PER_LANE];
@@ -210,7 +306,7 @@ public:
         float m = -FLT_MAX;
         float l = 0.f;
 
-        const int blockMaxQ = blockIdx.x * WARPS_PER_BLOCK + WARPS_PER_BLOCK - 1;
+        const int blockMaxQ = (blockIdx.x * WARPS_PER_BLOCK + WARPS_PER_BLOCK - 1) / p.kv_group;
         const int kvEnd = p.causal ? ::min(p.seq_k, blockMaxQ + 1) : p.seq_k;
 
         for (int tile = 0; tile < kvEnd; tile += BLOCK_N) {
@@ -222,8 +318,8 @@ public:
             for (int idx = threadIdx.x; idx < tileLen * HEAD_DIM; idx += THREADS) {
                 const int r = idx / HEAD_DIM;
                 const int c = idx % HEAD_DIM;
-                kTile[r][c] = readElem(p.k, c, tile + r, bh);
-                vTile[r][c] = readElem(p.v, c, tile + r, bh);
+                kTile[r][c] = readElem(p.k, c, tile + r, kvBh);
+                vTile[r][c] = readElem(p.v, c, tile + r, kvBh);
             }
             __syncthreads();
 
@@ -286,13 +382,17 @@ inline void executeFlashAttention(
         const QIOp& q, const KIOp& k, const VIOp& v, OT* o,
         const int batchHeads, const int seqQ, const int seqK,
         const bool causal, Stream_<ParArch::GPU_NVIDIA>& stream,
-        const float scaleOverride = -1.f, const EpilogueIOp& epilogue = {}) {
+        const float scaleOverride = -1.f, const EpilogueIOp& epilogue = {},
+        const int kvGroup = 1) {
     using DPP = FlashAttentionDPP<OT, HEAD_DIM, QIOp, KIOp, VIOp,
                                   EpilogueIOp, BLOCK_N, WARPS_PER_BLOCK>;
+    checkKVGroup(batchHeads, kvGroup);
     const float scale = scaleOverride > 0.f ? scaleOverride
                                             : rsqrtf(static_cast<float>(HEAD_DIM));
-    const typename DPP::Params params{ q, k, v, o, seqQ, seqK, scale, causal, epilogue };
-    const dim3 grid((seqQ + WARPS_PER_BLOCK - 1) / WARPS_PER_BLOCK, batchHeads, 1);
+    const typename DPP::Params params{ q, k, v, o, seqQ, seqK, scale, causal, epilogue,
+                                       kvGroup };
+    const int rows = seqQ * kvGroup;
+    const dim3 grid((rows + WARPS_PER_BLOCK - 1) / WARPS_PER_BLOCK, batchHeads / kvGroup, 1);
     const dim3 block(DPP::THREADS, 1, 1);
     launchFlashAttentionDPP_Kernel<OT, HEAD_DIM, QIOp, KIOp, VIOp, EpilogueIOp, BLOCK_N, WARPS_PER_BLOCK>
         <<<grid, block, 0, stream.getCUDAStream()>>>(params);
@@ -314,6 +414,7 @@ inline void executeFlashAttention(
         const float* kScale = nullptr, const float* vScale = nullptr,
         const float scaleOverride = -1.f,
         const EpilogueIOp& epilogue = {}) {
+    static_assert(KVL != KVLayout::FP8_PER_TOKEN, "Use makeFp8KVRead with the IOp-first API");
     const auto qIOp = makeAttentionRead(q, batchHeads, seqQ, HEAD_DIM);
     if constexpr (KVL == KVLayout::INT8_PER_TOKEN) {
         const auto kIOp = makeInt8KVRead(k, kScale, batchHeads, seqK, HEAD_DIM);
@@ -0,0 +1,271 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_ATTENTION_FLASH_ATTENTION_CPU_H
+#define FK_ATTENTION_FLASH_ATTENTION_CPU_H
+
+/* FlashAttentionCpuDPP: tiled FlashAttention-2 forward for ParArch::CPU,
+ * the host counterpart of FlashAttentionMmaDPP. Same IOp contract (Q/K/V
+ * prologue Read IOps, epilogue chain on the output), same score mods and
+ * the same BlockSparsity mask:
+ *
+ *  - Q is processed in BLOCK_Q row blocks. For each block, K and V are
+ *    staged in BLOCK_KV tiles THROUGH the prologue IOps into contiguous
+ *    fp32 buffers that stay cache resident while every row of the block
+ *    consumes them (the prologue runs once per element and block).
+ *  - A KV tile past the causal diagonal of the whole block, or inactive in
+ *    the block mask, is skipped BEFORE staging: none of its K/V elements is
+ *    read and no score is computed. With a sliding-window mask the work per
+ *    query row is O(window) instead of O(seq_k).
+ *  - GQA/MQA (kvGroup > 1): the query heads sharing a KV head are
+ *    processed together, so each KV tile is staged once per group.
+ *  - Scores are scaled, causally masked and passed through the score mod
+ *    in-register; the softmax exponentials of a tile row run through the
+ *    batch cxp::expf kernel.
+ *
+ * Entry points mirror the GPU ones on a CPU stream, with the same argument
+ * order: executeFlashAttentionMma takes the score mod and the block mask,
+ * executeFlashAttention takes kvGroup right after the epilogue.
+ *
+ * Mask requirements match the GPU path (checked in executeFlashAttentionMma):
+ * maskBQ % BLOCK_Q == 0 and maskBKV % BLOCK_KV == 0. */
+
+#include <fused_kernel/algorithms/attention/flash_attention.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fk {
+
+template <typename OT, int HEAD_DIM,
+          typename QIOp, typename KIOp, typename VIOp,
+          typename EpilogueIOp = AttentionIdentityEpilogue,
+          int BLOCK_Q = 32, int BLOCK_KV = 64, typename ScoreModOp = NoScoreMod>
+struct FlashAttentionCpuDPP {
+private:
+    using SelfType = FlashAttentionCpuDPP<OT, HEAD_DIM, QIOp, KIOp, VIOp,
+                                          EpilogueIOp, BLOCK_Q, BLOCK_KV, ScoreModOp>;
+public:
+    FK_STATIC_STRUCT(FlashAttentionCpuDPP, SelfType)
+    static constexpr ParArch PAR_ARCH = ParArch::CPU;
+    static constexpr bool HAS_SCORE_MOD = !std::is_same_v<ScoreModOp, NoScoreMod>;
+
+    static_assert(HEAD_DIM > 0, "HEAD_DIM must be positive");
+    static_assert(BLOCK_Q > 0 && BLOCK_KV > 0, "Tile sizes must be positive");
+    static_assert(isAnyReadType<QIOp>, "Q prologue must be a Read or ReadBack IOp");
+    static_assert(isAnyReadType<KIOp>, "K prologue must be a Read or ReadBack IOp");
+    static_assert(isAnyReadType<VIOp>, "V prologue must be a Read or ReadBack IOp");
+
+    struct Params {
+        QIOp q; KIOp k; VIOp v;
+        OT* o;                   // (batch*heads, seq_q, HEAD_DIM) output
+        int seq_q, seq_k;
+        float scale;             // logit scale, usually rsqrt(HEAD_DIM)
+        bool causal;
+        EpilogueIOp epilogue;    // fused IOp chain on the output (pre-write)
+        ScoreModOp scoreMod;     // flex-attention score_mod / mask_mod
+        BlockSparsity sparse;    // block-sparse tile skipping (nullptr = dense)
+        int kv_group = 1;        // query heads per KV head (GQA/MQA; 1 = MHA)
+    };
+
+private:
+    template <typename IOp>
+    FK_HOST_FUSE float readElem(const IOp& iop, const int x, const int y, const int z) {
+        return low_precision::attnToF32(IOp::Operation::exec(Point{ x, y, z }, iop));
+    }
+
+    template <typename IOp>
+    FK_HOST_FUSE void stageTile(const IOp& iop, const int rowBase, const int rows,
+                                const int bh, float* tile) {
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < HEAD_DIM; ++c) {
+                tile[r * HEAD_DIM + c] = readElem(iop, c, rowBase + r, bh);
+            }
+        }
+    }
+
+    FK_HOST_FUSE bool tileActive(const Params& p, const int bh, const int qBase, const int kvBase) {
+        if (p.sparse.mask == nullptr) return true;
+        const int qb = qBase / p.sparse.maskBQ;
+        const int kb = kvBase / p.sparse.maskBKV;
+        return p.sparse.mask[((long)bh * p.sparse.nQBlocks + qb) * p.sparse.nKVBlocks + kb] != 0;
+    }
+
+    /* One query row against one staged KV tile: scores, masking, score mod
+     * and the online-softmax update of (m, l, oRow). */
+    FK_HOST_FUSE void rowTile(const Params& p, const float* qRow, const int row,
+                              const float* kTile, const float* vTile,
+                              const int kvBase, const int kvRows,
+                              float& m, float& l, float* oRow) {
+        Array<float, BLOCK_KV> s{};
+        float tileMax = -FLT_MAX;
+        for (int j = 0; j < BLOCK_KV; ++j) {
+            const int col = kvBase + j;
+            float sc = -FLT_MAX;
+            if (j < kvRows && !(p.causal && col > row)) {
+                const float* kRow = kTile + j * HEAD_DIM;
+                float dot = 0.f;
+                for (int c = 0; c < HEAD_DIM; ++c) {
+                    dot += qRow[c] * kRow[c];
+                }
+                sc = dot * p.scale;
+                if constexpr (HAS_SCORE_MOD) {
+                    sc = p.scoreMod(sc, row, col);
+                }
+            }
+            s[j] = sc;
+            tileMax = cxp::max::f(tileMax, sc);
+        }
+        if (tileMax == -FLT_MAX) return; // every score masked
+
+        const float mNew = cxp::max::f(m, tileMax);
+        const float corr = cxp::expf::f(m - mNew);
+        for (int j = 0; j < BLOCK_KV; ++j) {
+            s[j] -= mNew; // masked scores stay hugely negative -> exp is 0
+        }
+        const Array<float, BLOCK_KV> pj = cxp::expf::f(s);
+
+        float rowSum = 0.f;
+        for (int c = 0; c < HEAD_DIM; ++c) {
+            oRow[c] *= corr;
+        }
+        for (int j = 0; j < kvRows; ++j) {
+            rowSum += pj[j];
+            const float* vRow = vTile + j * HEAD_DIM;
+            for (int c = 0; c < HEAD_DIM; ++c) {
+                oRow[c] += pj[j] * vRow[c];
+            }
+        }
+        l = l * corr + rowSum;
+        m = mNew;
+    }
+
+public:
+    FK_HOST_FUSE void exec(const Params& p, const int batchHeads) {
+        // GQA/MQA: the kv_group query heads sharing a KV head are processed
+        // together, so each K/V tile is staged once and reused from cache by
+        // every head of the group.
+        const int group = p.kv_group;
+        const int kvHeads = batchHeads / group;
+        std::vector<float> qTile((size_t)group * BLOCK_Q * HEAD_DIM);
+        std::vector<float> oAcc((size_t)group * BLOCK_Q * HEAD_DIM);
+        std::vector<float> m((size_t)group * BLOCK_Q);
+        std::vector<float> l((size_t)group * BLOCK_Q);
+        std::vector<float> kTile(BLOCK_KV * HEAD_DIM);
+        std::vector<float> vTile(BLOCK_KV * HEAD_DIM);
+
+        for (int kvBh = 0; kvBh < kvHeads; ++kvBh) {
+            for (int qBase = 0; qBase < p.seq_q; qBase += BLOCK_Q) {
+                const int qRows = std::min(BLOCK_Q, p.seq_q - qBase);
+                for (int g = 0; g < group; ++g) {
+                    stageTile(p.q, qBase, qRows, kvBh * group + g,
+                              qTile.data() + (size_t)g * BLOCK_Q * HEAD_DIM);
+                }
+                std::fill(oAcc.begin(), oAcc.end(), 0.f);
+                std::fill(m.begin(), m.end(), -FLT_MAX);
+                std::fill(l.begin(), l.end(), 0.f);
+
+                const int kvEnd = p.causal ? std::min(p.seq_k, qBase + qRows) : p.seq_k;
+                for (int kvBase = 0; kvBase < kvEnd; kvBase += BLOCK_KV) {
+                    // BLOCK SPARSITY: tiles inactive for every head of the
+                    // group are never staged nor scored
+                    bool anyActive = false;
+                    for (int g = 0; g < group && !anyActive; ++g) {
+                        anyActive = tileActive(p, kvBh * group + g, qBase, kvBase);
+                    }
+                    if (!anyActive) continue;
+                    const int kvRows = std::min(BLOCK_KV, kvEnd - kvBase);
+                    stageTile(p.k, kvBase, kvRows, kvBh, kTile.data());
+                    stageTile(p.v, kvBase, kvRows, kvBh, vTile.data());
+
+                    for (int g = 0; g < group; ++g) {
+                        if (!tileActive(p, kvBh * group + g, qBase, kvBase)) continue;
+                        for (int r = 0; r < qRows; ++r) {
+                            const size_t gr = (size_t)g * BLOCK_Q + r;
+                            rowTile(p, qTile.data() + gr * HEAD_DIM, qBase + r,
+                                    kTile.data(), vTile.data(), kvBase, kvRows,
+                                    m[gr], l[gr], oAcc.data() + gr * HEAD_DIM);
+                        }
+                    }
+                }
+
+                for (int g = 0; g < group; ++g) {
+                    const int bh = kvBh * group + g;
+                    for (int r = 0; r < qRows; ++r) {
+                        const size_t gr = (size_t)g * BLOCK_Q + r;
+                        const float invL = l[gr] > 0.f ? 1.f / l[gr] : 0.f;
+                        const long oRow = ((long)bh * p.seq_q + qBase + r) * HEAD_DIM;
+                        for (int c = 0; c < HEAD_DIM; ++c) {
+                            // EPILOGUE FUSION: in-register chain, then one write
+                            const float out = (oAcc[gr * HEAD_DIM + c] * invL) | p.epilogue;
+                            p.o[oRow + c] = low_precision::attnFromF32<OT>(out);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+/* IOp-first API on the CPU stream. Same arguments as the GPU
+ * executeFlashAttentionMma: the score mod and the block mask are optional. */
+template <int HEAD_DIM, int BLOCK_Q = 32, int BLOCK_KV = 64,
+          typename OT = float, typename QIOp, typename KIOp, typename VIOp,
+          typename EpilogueIOp = AttentionIdentityEpilogue,
+          typename ScoreModOp = NoScoreMod>
+inline void executeFlashAttentionMma(
+        const QIOp& q, const KIOp& k, const VIOp& v, OT* o,
+        const int batchHeads, const int seqQ, const int seqK,
+        const bool causal, Stream_<ParArch::CPU>&,
+        const float scaleOverride = -1.f, const EpilogueIOp& epilogue = {},
+        const ScoreModOp& scoreMod = {}, const BlockSparsity& sparse = {},
+        const int kvGroup = 1) {
+    using DPP = FlashAttentionCpuDPP<OT, HEAD_DIM, QIOp, KIOp, VIOp,
+                                     EpilogueIOp, BLOCK_Q, BLOCK_KV, ScoreModOp>;
+    if (sparse.mask != nullptr) {
+        // block-sparse mask granularity must contain whole tiles
+        if (sparse.maskBQ % BLOCK_Q != 0 || sparse.maskBKV % BLOCK_KV != 0) {
+            throw std::invalid_argument(
+                "BlockSparsity: maskBQ/maskBKV must be multiples of the tiles (BQ=" +
+                std::to_string(BLOCK_Q) + ", BKV=" + std::to_string(BLOCK_KV) + ")");
+        }
+    }
+    checkKVGroup(batchHeads, kvGroup);
+    const float scale = scaleOverride > 0.f ? scaleOverride
+                                            : 1.f / std::sqrt(static_cast<float>(HEAD_DIM));
+    const typename DPP::Params params{ q, k, v, o, seqQ, seqK, scale, causal,
+                                       epilogue, scoreMod, sparse, kvGroup };
+    DPP::exec(params, batchHeads);
+}
+
+/* Same arguments as the GPU warp executeFlashAttention: kvGroup follows the
+ * epilogue. Runs executeFlashAttentionMma without score mod nor mask. */
+template <int HEAD_DIM, int BLOCK_Q = 32, int BLOCK_KV = 64,
+          typename OT = float, typename QIOp, typename KIOp, typename VIOp,
+          typename EpilogueIOp = AttentionIdentityEpilogue>
+inline void executeFlashAttention(
+        const QIOp& q, const KIOp& k, const VIOp& v, OT* o,
+        const int batchHeads, const int seqQ, const int seqK,
+        const bool causal, Stream_<ParArch::CPU>& stream,
+        const float scaleOverride = -1.f, const EpilogueIOp& epilogue = {},
+        const int kvGroup = 1) {
+    executeFlashAttentionMma<HEAD_DIM, BLOCK_Q, BLOCK_KV>(q, k, v, o, batchHeads, seqQ, seqK, causal,
+                                                          stream, scaleOverride, epilogue, NoScoreMod{},
+                                                          BlockSparsity{}, kvGroup);
+}
+
+} // namespace fk
+
+#endif // FK_ATTENTION_FLASH_ATTENTION_CPU_H
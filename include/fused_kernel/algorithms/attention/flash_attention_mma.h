@@ -111,77 +111,6 @@ constexpr bool isFp8KVRead = false;
 template <typename IOp>
 constexpr bool isInt8KVRead = std::is_same_v<typename IOp::Operation, Int8TokenDequantRead>;
 
-// ---- FLEX ATTENTION: score mods (FlexAttention-style score_mod) ------------
-// A score mod is a tiny device functor applied to each attention score
-// AFTER scaling and bounds/causal masking, BEFORE the online softmax:
-//     s' = mod(s, q_idx, kv_idx)
-// Return -FLT_MAX to mask a position (mask_mod semantics). Composable with
-// everything else (prologues, epilogues, compressed KV, block sparsity).
-struct NoScoreMod {
-    __device__ __forceinline__ float operator()(const float s, const int,
-                                                const int) const { return s; }
-};
-struct ALiBiScoreMod {              // s - slope * (q - k)
-    float slope;
-    __device__ __forceinline__ float operator()(const float s, const int q,
-                                                const int k) const {
-        return s - slope * static_cast<float>(q - k);
-    }
-};
-struct SoftCapScoreMod {            // Gemma-2 style logit soft capping
-    float cap;
-    __device__ __forceinline__ float operator()(const float s, const int,
-                                                const int) const {
-        return cap * tanhf(s / cap);
-    }
-};
-struct SlidingWindowMask {          // mask_mod: keep only last `window` keys
-    int window;
-    __device__ __forceinline__ float operator()(const float s, const int q,
-                                                const int k) const {
-        return (q - k) >= window ? -FLT_MAX : s;
-    }
-};
-
-/* BLOCK-SPARSE ATTENTION: a (bh, nQBlocks, nKVBlocks) uint8 mask at
- * (maskBQ x maskBKV) granularity. Inactive KV tiles are SKIPPED ENTIRELY —
- * no global reads, no mma, no softmax (both bandwidth and compute scale
- * with the sparsity). nullptr = dense. Requirements (checked at launch):
- * maskBQ % BLOCK_Q == 0 and maskBKV % BLOCK_KV == 0. */
-struct BlockSparsity {
-    const unsigned char* mask = nullptr;   // nullptr = dense
-    int nQBlocks = 0, nKVBlocks = 0;
-    int maskBQ = 128, maskBKV = 128;
-};
-
-/* Host helper: build a sliding-window block mask at (blockQ x blockKV)
- * granularity. Tile (qb, kb) is active iff ANY (q, k) pair inside it
- * satisfies causal q >= k AND q - k < window. Finer blocks (e.g. 64 to
- * match the raw-path kernel tiles) skip more tiles -> faster. The exact
- * per-element window edge is enforced by SlidingWindowMask (score mod);
- * compose both: mask for the skip, mod for the edge. */
-inline std::vector<unsigned char>
-makeSlidingWindowBlockMask(const int batchHeads, const int seqQ, const int seqK,
-                           const int window, const int blockQ, const int blockKV) {
-    const int nQB = (seqQ + blockQ - 1) / blockQ;
-    const int nKB = (seqK + blockKV - 1) / blockKV;
-    std::vector<unsigned char> m((size_t)batchHeads * nQB * nKB, 0);
-    for (int qb = 0; qb < nQB; ++qb) {
-        const int qLo = qb * blockQ;
-        const int qHi = ::min(seqQ - 1, qLo + blockQ - 1);
-        for (int kb = 0; kb < nKB; ++kb) {
-            const int kLo = kb * blockKV;
-            // active iff intervals [kLo, kHi] and [qHi-window+1, qHi] overlap
-            // under causality (k <= qHi) — widest query row decides.
-            const bool active = (kLo <= qHi) && (kLo + blockKV - 1 >= qLo - window + 1);
-            if (active)
-                for (int b = 0; b < batchHeads; ++b)
-                    m[((size_t)b * nQB + qb) * nKB + kb] = 1;
-        }
-    }
-    return m;
-}
-
 /* FP8 tensor-core QK^T (kind::f8f6f4 m16n8k32, e4m3xe4m3->f32): Q is
  * quantized per-row IN-KERNEL, K^T runs directly on the raw fp8 KV-cache
  * bytes (the K dequant pass disappears), and qScale[row]*kScale[col] is
@@ -419,6 +348,7 @@ public:
         // d128 bh8 s2048, hiding everything; this is that lever.
         float* partial = nullptr;
         int splits = 1;
+        int kv_group = 1;        // query heads per KV head (GQA/MQA; 1 = MHA)
     };
     // log2-domain softmax is active for these functor types (see softmaxTile);
     // the split combine must interpret stored row-maxes in the same base.
@@ -1348,7 +1278,6 @@ public:
         const int tid = threadIdx.x;
         const int warpId = tid / 32;
         const int laneId = tid % 32;
-        const int bh = blockIdx.y;
         // CAUSAL LOAD-BALANCE: q-block i does O(i) KV tiles of work, so the
         // natural launch order puts the heaviest blocks LAST and leaves a
         // long single-block tail (ncu: achieved occupancy 10.9% vs 33%
@@ -1359,8 +1288,14 @@ public:
         // (A small-grid guard was tried and REVERTED: disabling the reversal
         // below 1024 blocks made bh8 s2048 WORSE, 0.82->0.76 vs FA — even at
         // ~1.4 waves the tail dominates. Reversal is unconditional.)
-        const int qBlockIdx = p.causal ? (int)(gridDim.x - 1 - blockIdx.x)
-                                       : (int)blockIdx.x;
+        const int xIdx = p.causal ? (int)(gridDim.x - 1 - blockIdx.x)
+                                  : (int)blockIdx.x;
+        // GQA/MQA: blockIdx.x interleaves the kv_group query heads that share
+        // one KV head (head fastest), so the group's blocks for a q-block are
+        // launched back to back and stream the same K/V tiles out of L2.
+        const int qBlockIdx = xIdx / p.kv_group;
+        const int bh = (int)blockIdx.y * p.kv_group + xIdx % p.kv_group;
+        const int kvBh = blockIdx.y;
         const int qBlockBase = qBlockIdx * BLOCK_Q;
 
         const uint qThread = swz(((warpId * WARP_Q + laneId % 16) * HEAD_DIM
@@ -1479,8 +1414,8 @@ public:
             // ============= cp.async schedule (fa-5090 v5 staggering) =========
             // K double-buffered, V single-buffered; K[kv+1] is issued right
             // after the QK^T mma so it streams during softmax + PV.
-            const __nv_bfloat16* kPlane = p.k.params.data + (long)bh * p.seq_k * HEAD_DIM;
-            const __nv_bfloat16* vPlane = p.v.params.data + (long)bh * p.seq_k * HEAD_DIM;
+            const __nv_bfloat16* kPlane = p.k.params.data + (long)kvBh * p.seq_k * HEAD_DIM;
+            const __nv_bfloat16* vPlane = p.v.params.data + (long)kvBh * p.seq_k * HEAD_DIM;
             // DEEP_Q_SMEM: KV buffers live after the resident Q tile.
             const auto kBuf = [&](int i) {
                 return Q_RES_B + (uint)(i % 2) * KV_BUF_B; };
@@ -1681,11 +1616,11 @@ public:
             constexpr bool IS_FP8 = isFp8KVRead<KIOp>;
             const int seqK = static_cast<int>(p.k.params.data.dims.height);
             const int8_t* kPlane = reinterpret_cast<const int8_t*>(p.k.params.data.data)
-                                   + (long)bh * seqK * HEAD_DIM;
+                                   + (long)kvBh * seqK * HEAD_DIM;
             const int8_t* vPlane = reinterpret_cast<const int8_t*>(p.v.params.data.data)
-                                   + (long)bh * seqK * HEAD_DIM;
-            const float* kScales = p.k.params.scales + (long)bh * seqK;
-            const float* vScales = p.v.params.scales + (long)bh * seqK;
+                                   + (long)kvBh * seqK * HEAD_DIM;
+            const float* kScales = p.k.params.scales + (long)kvBh * seqK;
+            const float* vScales = p.v.params.scales + (long)kvBh * seqK;
 
             const auto kBuf = [&](int i) { return (uint)(i % 2) * KV_BUF_B; };
             const uint vBufOff = 2 * KV_BUF_B;
@@ -1776,8 +1711,8 @@ public:
 
             float kPre[KV_GROUPS][8], vPre[KV_GROUPS][8];
             if (itBegin < itEnd) {
-                prefetchTile<KV_GROUPS>(p.k, itBegin * BLOCK_KV, p.seq_k, bh, kPre);
-                prefetchTile<KV_GROUPS>(p.v, itBegin * BLOCK_KV, p.seq_k, bh, vPre);
+                prefetchTile<KV_GROUPS>(p.k, itBegin * BLOCK_KV, p.seq_k, kvBh, kPre);
+                prefetchTile<KV_GROUPS>(p.v, itBegin * BLOCK_KV, p.seq_k, kvBh, vPre);
                 storeTile<KV_GROUPS>(smemBytes, kBuf(itBegin), kPre);
                 storeTile<KV_GROUPS>(smemBytes, vBuf(itBegin), vPre);
             }
@@ -1788,8 +1723,8 @@ public:
                 const bool act = tileActive(offKV);
                 const bool nextAct = (kv + 1) < itEnd && tileActive(offKV + BLOCK_KV);
                 if (nextAct) {
-                    prefetchTile<KV_GROUPS>(p.k, offKV + BLOCK_KV, p.seq_k, bh, kPre);
-                    prefetchTile<KV_GROUPS>(p.v, offKV + BLOCK_KV, p.seq_k, bh, vPre);
+                    prefetchTile<KV_GROUPS>(p.k, offKV + BLOCK_KV, p.seq_k, kvBh, kPre);
+                    prefetchTile<KV_GROUPS>(p.v, offKV + BLOCK_KV, p.seq_k, kvBh, vPre);
                 }
 
                 if (act) {
@@ -1896,7 +1831,8 @@ inline void executeFlashAttentionMma(
         const int batchHeads, const int seqQ, const int seqK,
         const bool causal, Stream_<ParArch::GPU_NVIDIA>& stream,
         const float scaleOverride = -1.f, const EpilogueIOp& epilogue = {},
-        const ScoreModOp& scoreMod = {}, const BlockSparsity& sparse = {}) {
+        const ScoreModOp& scoreMod = {}, const BlockSparsity& sparse = {},
+        const int kvGroup = 1) {
     constexpr bool RAW = isRawBf16Read<KIOp> && isRawBf16Read<VIOp>;
     // RAW auto-tile is REGIME-DEPENDENT. Swept exhaustively with REAL data
     // (benchmarks/sweep_tiles.cu, bh in {8,32,64} x s in {2048,4096,8192}
@@ -1971,8 +1907,10 @@ inline void executeFlashAttentionMma(
                 "tiles (BQ=" + std::to_string(BQ) + ", BKV=" + std::to_string(BKV) + ")");
         }
     }
+    checkKVGroup(batchHeads, kvGroup);
     typename DPP::Params params{ q, k, v, o, seqQ, seqK, scale, causal,
                                  epilogue, scoreMod, sparse };
+    params.kv_group = kvGroup;
     const int numQ = (seqQ + BQ - 1) / BQ;
     const dim3 block(DPP::THREADS, 1, 1);
     const int smemBytes = DPP::SMEM_BYTES;
@@ -2025,7 +1963,7 @@ inline void executeFlashAttentionMma(
             params.splits = splits;
         }
     }
-    const dim3 grid(numQ, batchHeads, splits);
+    const dim3 grid(numQ * kvGroup, batchHeads / kvGroup, splits);
     if (splits > 1) {
         auto* splitKernel = launchFlashAttentionMmaDPP_Kernel<
             OT, HEAD_DIM, QIOp, KIOp, VIOp, EpilogueIOp, BQ, BKV, NUM_WARPS,
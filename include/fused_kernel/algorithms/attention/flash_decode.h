@@ -61,6 +61,7 @@ public:
         int seq_k;
         int splits;
         float scale;
+        int kv_group = 1;    // query heads per KV head (GQA/MQA; 1 = MHA)
     };
 
     template <typename IOp>
@@ -119,8 +120,12 @@ public:
     static __device__ void exec(const Params& p) {
         const int lane = threadIdx.x & 31;
         const int warp = threadIdx.x >> 5;
-        const int split = blockIdx.x;
-        const int bh = blockIdx.y;
+        // GQA/MQA: blockIdx.x walks the query heads sharing KV head
+        // blockIdx.z. Those blocks launch back to back over the same KV
+        // chunk, so the group streams each K/V row from DRAM once (L2 hits).
+        const int split = blockIdx.y;
+        const int kvBh = blockIdx.z;
+        const int bh = kvBh * p.kv_group + blockIdx.x;
 
         const int chunk = (p.seq_k + p.splits - 1) / p.splits;
         const int kvBegin = split * chunk;
@@ -152,8 +157,8 @@ public:
 
         for (int t = kvBegin + warp; t < kvEnd; t += NUM_WARPS) {
             float kReg[ELEMS], vReg[ELEMS];
-            loadRow(p.k, lane, t, bh, p.seq_k, kReg);
-            loadRow(p.v, lane, t, bh, p.seq_k, vReg);
+            loadRow(p.k, lane, t, kvBh, p.seq_k, kReg);
+            loadRow(p.v, lane, t, kvBh, p.seq_k, vReg);
             float partialDot = 0.f;
             #pragma unroll
             for (int e = 0; e < ELEMS; ++e) partialDot += qReg[e] * kReg[e];
@@ -310,8 +315,10 @@ inline void executeFlashDecode(
                             nullptr ok if splits==1 */,
         const int batchHeads, const int seqK,
         Stream_<ParArch::GPU_NVIDIA>& stream,
-        const float scaleOverride = -1.f, const int splitsOverride = 0) {
+        const float scaleOverride = -1.f, const int splitsOverride = 0,
+        const int kvGroup = 1) {
     using DPP = FlashDecodeDPP<OT, HEAD_DIM, QIOp, KIOp, VIOp, NUM_WARPS>;
+    checkKVGroup(batchHeads, kvGroup);
     const float scale = scaleOverride > 0.f ? scaleOverride
                                             : rsqrtf(static_cast<float>(HEAD_DIM));
     const int splits = splitsOverride > 0 ? splitsOverride
@@ -322,8 +329,8 @@ inline void executeFlashDecode(
               workspace + (size_t)batchHeads * splits * (HEAD_DIM + 2))
         : nullptr;
     const typename DPP::Params params{ q, k, v, workspace, counters, o,
-                                       seqK, splits, scale };
-    const dim3 grid(splits, batchHeads, 1);
+                                       seqK, splits, scale, kvGroup };
+    const dim3 grid(kvGroup, splits, batchHeads / kvGroup);
     // single kernel: the split merge is FUSED (last-CTA-arrives pattern) —
     // profiling showed the separate 1.4us merge kernel + launch gap was pure
     // overhead at decode latencies.
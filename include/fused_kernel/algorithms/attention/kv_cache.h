@@ -0,0 +1,461 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_ATTENTION_KV_CACHE_H
+#define FK_ATTENTION_KV_CACHE_H
+
+/* KVCache: persistent, paged K/V storage for the attention DPPs.
+ *
+ *  - Storage is a pool of fixed-size PAGES (pageTokens tokens x kvHeads x
+ *    headDim), each a pair of fk::Tensor (K and V) plus per-token scales
+ *    when the layout is quantized. A sequence is a list of pages.
+ *  - append() writes new tokens at the end of a sequence; with
+ *    KVLayout::INT8_PER_TOKEN / FP8_PER_TOKEN the rows are quantized on the
+ *    way in (same per-token recipe as quantizeKVCacheHost).
+ *  - PREFIX SHARING: full pages of sequences appended with token ids are
+ *    published under a hash of their whole token prefix. createSequence()
+ *    with a prompt attaches every cached page that matches the prompt, so
+ *    the caller only recomputes the uncached tail. fork() shares all pages
+ *    of a sequence (parallel sampling, beam search).
+ *  - COPY-ON-WRITE: shared pages are never written; appending into a
+ *    shared partially-filled page copies it first.
+ *  - LRU EVICTION: pages of released sequences stay cached while they are
+ *    published. When allocating a page would exceed the byte budget, the
+ *    least recently used cached page is recycled. Live pages are never
+ *    evicted: if they alone exhaust the budget, append() throws.
+ *  - keys()/values() return a PagedKVRead IOp for one sequence: plane z is
+ *    the KV head, row y the token. It plugs into the attention DPPs as the
+ *    K/V prologue (batchHeads = kvHeads * kvGroup, seqK = length()).
+ *
+ * Pages live in the memory type given at construction; append() inputs and
+ * the quantization run on the host, so quantized layouts need host-readable
+ * K/V input. Data moves with cudaMemcpyDefault for device page memory. */
+
+#include <fused_kernel/algorithms/attention/flash_attention.h>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fk {
+
+template <KVLayout KVL, typename T>
+using KVStorageType = std::conditional_t<KVL == KVLayout::DENSE, T, int8_t>;
+
+// One page as seen from the kernel: data (kvHeads, pageTokens, headDim) and
+// one scale per (head, token) row (nullptr for dense pages).
+template <typename S>
+struct KVPageRef {
+    const S* data;
+    const float* scales;
+};
+
+template <typename S>
+struct PagedKVReadParams {
+    const KVPageRef<S>* table;   // one entry per page of the sequence
+    int pageTokens;
+    int headDim;
+    int kvHeads;
+    int seqLen;
+};
+
+/* PagedKVRead: Read IOp over a page table. exec(thread) returns the fp32
+ * (dequantized) element x of token y in KV head z. */
+template <typename S, KVLayout KVL>
+struct PagedKVRead {
+private:
+    using Parent = ReadOperation<S, PagedKVReadParams<S>, float,
+                                 TF::DISABLED, PagedKVRead<S, KVL>>;
+    using SelfType = PagedKVRead<S, KVL>;
+public:
+    FK_STATIC_STRUCT(PagedKVRead, SelfType)
+    DECLARE_READ_PARENT
+
+    // NOTE: plain static (not FK_HOST_DEVICE_FUSE): fp8 conversion ops are
+    // not constexpr.
+    FK_HOST_DEVICE_STATIC float exec(const Point thread, const ParamsType& params) {
+        const KVPageRef<S> page = params.table[thread.y / params.pageTokens];
+        const long row = (long)thread.z * params.pageTokens + thread.y % params.pageTokens;
+        const S raw = page.data[row * params.headDim + thread.x];
+        if constexpr (KVL == KVLayout::DENSE) {
+            return low_precision::attnToF32(raw);
+        } else if constexpr (KVL == KVLayout::INT8_PER_TOKEN) {
+            return static_cast<float>(raw) * page.scales[row];
+        } else {
+#ifdef FK_HAS_FP8
+            __nv_fp8_e4m3 f8;
+            f8.__x = static_cast<__nv_fp8_storage_t>(raw);
+            return static_cast<float>(f8) * page.scales[row];
+#else
+            static_assert(KVL != KVLayout::FP8_PER_TOKEN, "fp8 KV pages need <cuda_fp8.h>");
+            return 0.f;
+#endif
+        }
+    }
+
+    FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+        return opData.params.headDim;
+    }
+    FK_HOST_DEVICE_FUSE uint num_elems_y(const Point thread, const OperationDataType& opData) {
+        return opData.params.seqLen;
+    }
+    FK_HOST_DEVICE_FUSE uint num_elems_z(const Point thread, const OperationDataType& opData) {
+        return opData.params.kvHeads;
+    }
+    FK_HOST_DEVICE_FUSE uint pitch(const Point thread, const OperationDataType& opData) {
+        return opData.params.headDim * sizeof(S);
+    }
+    FK_HOST_DEVICE_FUSE ActiveThreads getActiveThreads(const OperationDataType& opData) {
+        return { num_elems_x(Point{0,0,0}, opData),
+                 num_elems_y(Point{0,0,0}, opData),
+                 num_elems_z(Point{0,0,0}, opData) };
+    }
+};
+
+template <typename T, KVLayout KVL = KVLayout::DENSE>
+class KVCache {
+public:
+    using StorageType = KVStorageType<KVL, T>;
+    using ReadIOp = decltype(PagedKVRead<StorageType, KVL>::build(PagedKVReadParams<StorageType>{}));
+    using SeqId = int;
+    static constexpr bool QUANTIZED = KVL != KVLayout::DENSE;
+
+    struct Prefix {
+        SeqId id;
+        int cachedTokens;   // tokens already present: recompute from here
+    };
+
+    KVCache(const int kvHeads, const int headDim, const int pageTokens,
+            const size_t byteBudget, const MemType memType = defaultMemType,
+            const int deviceID = 0)
+        : kvHeads_(kvHeads), headDim_(headDim), pageTokens_(pageTokens),
+          byteBudget_(byteBudget), memType_(memType), deviceID_(deviceID) {
+        if (kvHeads < 1 || headDim < 1 || pageTokens < 1) {
+            throw std::invalid_argument("KVCache: kvHeads, headDim and pageTokens must be positive");
+        }
+        if (byteBudget < pageBytes()) {
+            throw std::invalid_argument("KVCache: byte budget smaller than one page (" +
+                                        std::to_string(pageBytes()) + " bytes)");
+        }
+    }
+
+    KVCache(const KVCache&) = delete;
+    KVCache& operator=(const KVCache&) = delete;
+
+    // Bytes of one page: K and V data plus their per-token scales.
+    inline size_t pageBytes() const {
+        const size_t rows = (size_t)kvHeads_ * pageTokens_;
+        return 2 * (rows * headDim_ * sizeof(StorageType) + (QUANTIZED ? rows * sizeof(float) : 0));
+    }
+    inline size_t bytesInUse() const { return pages_.size() * pageBytes(); }
+    inline size_t byteBudget() const { return byteBudget_; }
+    inline int cachedPages() const { return static_cast<int>(lru_.size()); }
+    inline int kvHeads() const { return kvHeads_; }
+    inline int headDim() const { return headDim_; }
+    inline int pageTokens() const { return pageTokens_; }
+
+    SeqId createSequence() {
+        const SeqId id = nextId_++;
+        seqs_.emplace(id, Sequence{});
+        return id;
+    }
+
+    /* New sequence for a prompt: attaches the longest chain of cached full
+     * pages matching the prompt. The caller appends the K/V of tokens
+     * [cachedTokens, n) (with their ids, so they get published too). */
+    Prefix createSequence(const int* tokens, const int n) {
+        const SeqId id = createSequence();
+        Sequence& seq = seqs_.at(id);
+        for (int base = 0; base + pageTokens_ <= n; base += pageTokens_) {
+            const uint64_t h = chainHash(seq.prefixHash, tokens + base);
+            const auto it = published_.find(h);
+            if (it == published_.end() ||
+                !std::equal(tokens + base, tokens + base + pageTokens_,
+                            pages_[it->second].tokens.begin())) {
+                break;
+            }
+            acquire(it->second);
+            seq.pages.push_back(it->second);
+            seq.prefixHash = h;
+            seq.length += pageTokens_;
+        }
+        seq.tablesDirty = true;
+        return { id, seq.length };
+    }
+
+    // Shares every page of src; the first write to a shared page copies it.
+    SeqId fork(const SeqId src) {
+        const Sequence copy = sequence(src);
+        for (const int page : copy.pages) acquire(page);
+        const SeqId id = nextId_++;
+        auto& seq = seqs_.emplace(id, copy).first->second;
+        seq.kTable = {};                         // tables are per sequence
+        seq.vTable = {};
+        seq.tablesDirty = true;
+        return id;
+    }
+
+    /* Appends n tokens. k and v are host-readable (kvHeads, n, headDim)
+     * C-contiguous. With token ids, full pages are published for prefix
+     * sharing; without them the sequence stops publishing. */
+    void append(const SeqId id, const T* k, const T* v, const int n,
+                const int* tokens = nullptr) {
+        Sequence& seq = sequence(id);
+        if (tokens == nullptr) seq.publishable = false;
+        for (int i = 0; i < n;) {
+            const int inPage = seq.length % pageTokens_;
+            if (inPage == 0) {
+                seq.pages.push_back(allocPage());
+                seq.tablesDirty = true;
+            } else if (pages_[seq.pages.back()].refs > 1) {
+                seq.pages.back() = copyOnWrite(seq.pages.back(), inPage);
+                seq.tablesDirty = true;
+            }
+            Page& page = pages_[seq.pages.back()];
+            const int count = std::min(n - i, pageTokens_ - inPage);
+            writeRows(page.k, page.kScale, k, n, i, inPage, count);
+            writeRows(page.v, page.vScale, v, n, i, inPage, count);
+            if (seq.publishable) {
+                seq.pendingTokens.insert(seq.pendingTokens.end(), tokens + i, tokens + i + count);
+            }
+            seq.length += count;
+            i += count;
+            if (seq.length % pageTokens_ == 0) {
+                if (seq.publishable) publish(seq, seq.pages.back());
+                seq.pendingTokens.clear();
+            }
+        }
+    }
+
+    // Drops the sequence. Its published pages stay cached until evicted.
+    void release(const SeqId id) {
+        const Sequence& seq = sequence(id);
+        for (const int page : seq.pages) releasePage(page);
+        seqs_.erase(id);
+    }
+
+    inline int length(const SeqId id) const { return sequence(id).length; }
+
+    inline ReadIOp keys(const SeqId id) { return makeRead(id, false); }
+    inline ReadIOp values(const SeqId id) { return makeRead(id, true); }
+
+private:
+    struct Page {
+        Page(const int headDim, const int pageTokens, const int kvHeads, const MemType type, const int deviceID)
+            : k(headDim, pageTokens, kvHeads, 1, type, deviceID), v(headDim, pageTokens, kvHeads, 1, type, deviceID) {}
+        Tensor<StorageType> k, v;
+        Ptr<ND::_1D, float> kScale, vScale;
+        int refs{ 0 };
+        bool published{ false };
+        uint64_t hash{ 0 };
+        std::vector<int> tokens;                 // ids of a published page
+        std::list<int>::iterator lruPos;
+    };
+
+    struct Sequence {
+        std::vector<int> pages;
+        int length{ 0 };
+        uint64_t prefixHash{ 14695981039346656037ull };
+        bool publishable{ true };
+        std::vector<int> pendingTokens;
+        bool tablesDirty{ true };
+        Ptr<ND::_1D, KVPageRef<StorageType>> kTable, vTable;
+    };
+
+    int kvHeads_, headDim_, pageTokens_;
+    size_t byteBudget_;
+    MemType memType_;
+    int deviceID_;
+    SeqId nextId_{ 0 };
+    std::vector<Page> pages_;
+    std::vector<int> freePages_;                 // unreferenced, unpublished
+    std::list<int> lru_;                         // cached pages, oldest first
+    std::unordered_map<uint64_t, int> published_;
+    std::unordered_map<SeqId, Sequence> seqs_;
+
+    inline Sequence& sequence(const SeqId id) {
+        const auto it = seqs_.find(id);
+        if (it == seqs_.end()) {
+            throw std::invalid_argument("KVCache: unknown sequence " + std::to_string(id));
+        }
+        return it->second;
+    }
+    inline const Sequence& sequence(const SeqId id) const {
+        return const_cast<KVCache*>(this)->sequence(id);
+    }
+
+    inline bool onDevice() const {
+        return memType_ == MemType::Device || memType_ == MemType::DeviceAndPinned;
+    }
+
+    inline void copyBytes(void* dst, const void* src, const size_t bytes) const {
+        if (onDevice()) {
+#if defined(__NVCC__)
+            gpuErrchk(cudaMemcpy(dst, src, bytes, cudaMemcpyDefault));
+#else
+            throw std::runtime_error("KVCache: device pages need a CUDA build");
+#endif
+        } else {
+            std::memcpy(dst, src, bytes);
+        }
+    }
+
+    // FNV-1a over the previous prefix hash and one page of token ids.
+    inline uint64_t chainHash(uint64_t h, const int* tokens) const {
+        for (int t = 0; t < pageTokens_; ++t) {
+            h ^= static_cast<uint32_t>(tokens[t]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    int allocPage() {
+        int idx;
+        if (!freePages_.empty()) {
+            idx = freePages_.back();
+            freePages_.pop_back();
+        } else if (bytesInUse() + pageBytes() <= byteBudget_) {
+            idx = static_cast<int>(pages_.size());
+            Page page(headDim_, pageTokens_, kvHeads_, memType_, deviceID_);
+            if constexpr (QUANTIZED) {
+                const uint rows = static_cast<uint>(kvHeads_ * pageTokens_);
+                page.kScale = Ptr<ND::_1D, float>(rows, 0, memType_, deviceID_);
+                page.vScale = Ptr<ND::_1D, float>(rows, 0, memType_, deviceID_);
+            }
+            pages_.push_back(std::move(page));
+        } else if (!lru_.empty()) {
+            idx = lru_.front();
+            unpublish(idx);
+        } else {
+            throw std::runtime_error("KVCache: byte budget (" + std::to_string(byteBudget_) +
+                                     " bytes) exhausted by live sequences");
+        }
+        pages_[idx].refs = 1;
+        return idx;
+    }
+
+    inline void acquire(const int idx) {
+        Page& page = pages_[idx];
+        if (page.refs++ == 0 && page.published) {
+            lru_.erase(page.lruPos);             // cached -> live again
+        }
+    }
+
+    inline void releasePage(const int idx) {
+        Page& page = pages_[idx];
+        if (--page.refs > 0) return;
+        if (page.published) {
+            page.lruPos = lru_.insert(lru_.end(), idx);
+        } else {
+            freePages_.push_back(idx);
+        }
+    }
+
+    inline void unpublish(const int idx) {
+        Page& page = pages_[idx];
+        lru_.erase(page.lruPos);
+        published_.erase(page.hash);
+        page.published = false;
+        page.tokens.clear();
+    }
+
+    inline void publish(Sequence& seq, const int idx) {
+        seq.prefixHash = chainHash(seq.prefixHash, seq.pendingTokens.data());
+        if (published_.count(seq.prefixHash) != 0) return;   // already cached elsewhere
+        Page& page = pages_[idx];
+        page.published = true;
+        page.hash = seq.prefixHash;
+        page.tokens = seq.pendingTokens;
+        published_.emplace(seq.prefixHash, idx);
+    }
+
+    int copyOnWrite(const int src, const int rows) {
+        const int dst = allocPage();
+        Page& from = pages_[src];
+        Page& to = pages_[dst];
+        for (int h = 0; h < kvHeads_; ++h) {
+            const size_t off = (size_t)h * pageTokens_ * headDim_;
+            const size_t bytes = (size_t)rows * headDim_ * sizeof(StorageType);
+            copyBytes(to.k.ptr().data + off, from.k.ptr().data + off, bytes);
+            copyBytes(to.v.ptr().data + off, from.v.ptr().data + off, bytes);
+            if constexpr (QUANTIZED) {
+                const size_t sOff = (size_t)h * pageTokens_;
+                copyBytes(to.kScale.ptr().data + sOff, from.kScale.ptr().data + sOff, rows * sizeof(float));
+                copyBytes(to.vScale.ptr().data + sOff, from.vScale.ptr().data + sOff, rows * sizeof(float));
+            }
+        }
+        releasePage(src);
+        return dst;
+    }
+
+    // Rows [first, first+count) of src (kvHeads, n, headDim) -> page rows from `slot`.
+    void writeRows(Tensor<StorageType>& data, Ptr<ND::_1D, float>& scales, const T* src,
+                   const int n, const int first, const int slot, const int count) {
+        std::vector<StorageType> staged;
+        std::vector<float> stagedScales;
+        for (int h = 0; h < kvHeads_; ++h) {
+            const T* in = src + ((size_t)h * n + first) * headDim_;
+            const size_t off = ((size_t)h * pageTokens_ + slot) * headDim_;
+            if constexpr (KVL == KVLayout::DENSE) {
+                copyBytes(data.ptr().data + off, in, (size_t)count * headDim_ * sizeof(T));
+            } else {
+                staged.resize((size_t)count * headDim_);
+                stagedScales.resize(count);
+                if constexpr (KVL == KVLayout::INT8_PER_TOKEN) {
+                    quantizeKVCacheHost(in, staged.data(), stagedScales.data(), count, headDim_);
+                } else {
+#ifdef FK_HAS_FP8
+                    quantizeKVCacheFp8Host(in, staged.data(), stagedScales.data(), count, headDim_);
+#else
+                    static_assert(KVL != KVLayout::FP8_PER_TOKEN, "fp8 KV pages need <cuda_fp8.h>");
+#endif
+                }
+                copyBytes(data.ptr().data + off, staged.data(), staged.size());
+                copyBytes(scales.ptr().data + (size_t)h * pageTokens_ + slot,
+                          stagedScales.data(), count * sizeof(float));
+            }
+        }
+    }
+
+    ReadIOp makeRead(const SeqId id, const bool value) {
+        Sequence& seq = sequence(id);
+        if (seq.tablesDirty) {
+            const size_t n = seq.pages.size() > 0 ? seq.pages.size() : 1;
+            std::vector<KVPageRef<StorageType>> kRefs(n), vRefs(n);
+            for (size_t i = 0; i < seq.pages.size(); ++i) {
+                const Page& page = pages_[seq.pages[i]];
+                kRefs[i] = { page.k.ptr().data, QUANTIZED ? page.kScale.ptr().data : nullptr };
+                vRefs[i] = { page.v.ptr().data, QUANTIZED ? page.vScale.ptr().data : nullptr };
+            }
+            if (seq.kTable.getNumElements() < n) {
+                seq.kTable = Ptr<ND::_1D, KVPageRef<StorageType>>(static_cast<uint>(n), 0, memType_, deviceID_);
+                seq.vTable = Ptr<ND::_1D, KVPageRef<StorageType>>(static_cast<uint>(n), 0, memType_, deviceID_);
+            }
+            copyBytes(seq.kTable.ptr().data, kRefs.data(), n * sizeof(KVPageRef<StorageType>));
+            copyBytes(seq.vTable.ptr().data, vRefs.data(), n * sizeof(KVPageRef<StorageType>));
+            seq.tablesDirty = false;
+        }
+        const auto& table = value ? seq.vTable : seq.kTable;
+        return PagedKVRead<StorageType, KVL>::build(PagedKVReadParams<StorageType>{
+            table.ptr().data, pageTokens_, headDim_, kvHeads_, seq.length });
+    }
+};
+
+} // namespace fk
+
+#endif // FK_ATTENTION_KV_CACHE_H
@@ -31,6 +31,12 @@
  * fused preprocessing chain (read.then(Mul...).then(Cast...)) runs
  * in-register at load time, on BOTH passes, with zero extra traffic.
  * Element addressing: thread.x = column, thread.y = row, thread.z = 0.
+ *
+ * CPU: SoftmaxDPP<ParArch::CPU> keeps the same IOp contract. Rows are
+ * independent; each row is scanned once into SOFTMAX_CPU_LANES
+ * interleaved (m, l) states (independent dependency chains, one expf per
+ * element), the lanes are merged, and a fused pass writes exp(x-m)/l using
+ * the batch cxp::expf kernel on full lane groups.
  */
 
 #include <fused_kernel/core/data/ptr_nd.h>
@@ -48,27 +54,37 @@
 
 namespace fk {
 
+#if defined(__NVCC__)
 // Cooperative-DPP exec bodies use __shared__ + barriers: they cannot be
 // constexpr (FK_DEVICE_FUSE). Plain static device inline qualifier:
 #define FK_COOP_DEVICE_FUSE static __device__ __forceinline__ void
+#endif
 
     namespace low_precision {
     template <typename T>
-    FK_DEVICE_CNST float attnToF32(const T &v) {
+    FK_HOST_DEVICE_CNST float attnToF32(const T &v) {
+#if defined(__NVCC__)
         if constexpr (std::is_same_v<T, __half>) {
             return __half2float(v);
         } else {
             return static_cast<float>(v);
         }
+#else
+        return static_cast<float>(v);
+#endif
     }
 
     template <typename T>
-    FK_DEVICE_CNST T attnFromF32(const float &v) {
+    FK_HOST_DEVICE_CNST T attnFromF32(const float &v) {
+#if defined(__NVCC__)
         if constexpr (std::is_same_v<T, __half>) {
             return __float2half(v);
         } else {
             return static_cast<T>(v);
         }
+#else
+        return static_cast<T>(v);
+#endif
     }
     } // namespace low_precision
 
@@ -81,7 +97,7 @@ struct CastLowFPToF32 {
   public:
     FK_STATIC_STRUCT(CastLowFPToF32, SelfType)
     DECLARE_UNARY_PARENT
-    FK_DEVICE_FUSE float exec(const InputType &v) { return low_precision::attnToF32(v); }
+    FK_HOST_DEVICE_FUSE float exec(const InputType &v) { return low_precision::attnToF32(v); }
 };
 
 template <typename OT> struct CastF32ToLowFP {
@@ -92,7 +108,7 @@ template <typename OT> struct CastF32ToLowFP {
   public:
     FK_STATIC_STRUCT(CastF32ToLowFP, SelfType)
     DECLARE_UNARY_PARENT
-    FK_DEVICE_FUSE OT exec(const InputType &v) { return low_precision::attnFromF32<OT>(v); }
+    FK_HOST_DEVICE_FUSE OT exec(const InputType &v) { return low_precision::attnFromF32<OT>(v); }
 };
 
 template <int BLOCK_SIZE_ = 256>
@@ -100,26 +116,104 @@ struct SoftmaxDPPDetails {
     static constexpr int BLOCK_SIZE = BLOCK_SIZE_;
 };
 
+struct OnlineSoftmaxState {
+    float m; // running max
+    float l; // running sum of exp(x - m)
+};
+
+FK_HOST_DEVICE_CNST OnlineSoftmaxState mergeSoftmaxStates(const OnlineSoftmaxState& a,
+                                                          const OnlineSoftmaxState& b) {
+    const float m = cxp::max::f(a.m, b.m);
+    const float la = a.l == 0.f ? 0.f : a.l * cxp::expf::f(a.m - m);
+    const float lb = b.l == 0.f ? 0.f : b.l * cxp::expf::f(b.m - m);
+    return {m, la + lb};
+}
+
 /* InIOp is an INSTANTIABLE Read or ReadBack IOp (possibly a fusion
  * read.then(compute...)): the prologue. Every element enters the
  * algorithm through InIOp::Operation::exec(thread, iop). */
-struct SoftmaxDPP {
-private:
-    using SelfType = SoftmaxDPP;
-    struct OnlineSoftmaxState {
-        float m; // running max
-        float l; // running sum of exp(x - m)
-    };
-
-    FK_DEVICE_FUSE OnlineSoftmaxState mergeSoftmaxStates(const OnlineSoftmaxState& a, const OnlineSoftmaxState& b) {
-        const float m = cxp::max::f(a.m, b.m);
-        const float la = a.l == 0.f ? 0.f : a.l * cxp::expf::f(a.m - m);
-        const float lb = b.l == 0.f ? 0.f : b.l * cxp::expf::f(b.m - m);
-        return {m, la + lb};
+template <ParArch PA = defaultParArch>
+struct SoftmaxDPP;
+
+template <>
+struct SoftmaxDPP<ParArch::CPU> {
+  private:
+    using SelfType = SoftmaxDPP<ParArch::CPU>;
+    static constexpr int SOFTMAX_CPU_LANES = 8;
+
+    // Single-exp online update: only a new maximum rescales the sum.
+    // Kept scalar on purpose: a branch-free group update (lane-wise max, one
+    // batch expf, select) only vectorizes while its lane loops stay loops.
+    // GCC -O3 unrolls them completely first, and the batch expf goes scalar.
+    // At the default -O3 -march=native it was ~20% slower than this update.
+    FK_HOST_FUSE void update(OnlineSoftmaxState& st, const float v) {
+        if (v > st.m) {
+            st.l = st.l * cxp::expf::f(st.m - v) + 1.f;
+            st.m = v;
+        } else {
+            st.l += cxp::expf::f(v - st.m);
+        }
     }
 
   public:
     FK_STATIC_STRUCT(SoftmaxDPP, SelfType)
+    static constexpr ParArch PAR_ARCH = ParArch::CPU;
+
+    template <typename SoftmaxDetails, typename InIOp, typename OutIOp>
+    FK_HOST_FUSE void exec(const SoftmaxDetails&, const InIOp& input, const OutIOp& output) {
+        const int width = InIOp::Operation::num_elems_x(Point{0, 0, 0}, input);
+        const int height = InIOp::Operation::num_elems_y(Point{0, 0, 0}, input);
+        const int vecWidth = width - (width % SOFTMAX_CPU_LANES);
+
+        for (int row = 0; row < height; ++row) {
+            OnlineSoftmaxState lanes[SOFTMAX_CPU_LANES];
+            for (int i = 0; i < SOFTMAX_CPU_LANES; ++i) {
+                lanes[i] = {-FLT_MAX, 0.f};
+            }
+            // PROLOGUE: element read through the IOp (pass 1)
+            for (int x = 0; x < vecWidth; x += SOFTMAX_CPU_LANES) {
+                for (int i = 0; i < SOFTMAX_CPU_LANES; ++i) {
+                    update(lanes[i], InIOp::Operation::exec(Point{x + i, row, 0}, input));
+                }
+            }
+            for (int x = vecWidth; x < width; ++x) {
+                update(lanes[x - vecWidth], InIOp::Operation::exec(Point{x, row, 0}, input));
+            }
+            OnlineSoftmaxState st = lanes[0];
+            for (int i = 1; i < SOFTMAX_CPU_LANES; ++i) {
+                st = mergeSoftmaxStates(st, lanes[i]);
+            }
+            // A row of -inf never adds to l: it is written as zeros, not NaN
+            const float invL = st.l > 0.f ? 1.f / st.l : 0.f;
+
+            // Full lane groups go through the batch expf kernel
+            for (int x = 0; x < vecWidth; x += SOFTMAX_CPU_LANES) {
+                Array<float, SOFTMAX_CPU_LANES> shifted{};
+                for (int i = 0; i < SOFTMAX_CPU_LANES; ++i) {
+                    shifted[i] = InIOp::Operation::exec(Point{x + i, row, 0}, input) - st.m;
+                }
+                const Array<float, SOFTMAX_CPU_LANES> e = cxp::expf::f(shifted);
+                for (int i = 0; i < SOFTMAX_CPU_LANES; ++i) {
+                    OutIOp::Operation::exec(Point{x + i, row, 0}, e[i] * invL, output);
+                }
+            }
+            for (int x = vecWidth; x < width; ++x) {
+                const float result = cxp::expf::f(InIOp::Operation::exec(Point{x, row, 0}, input) - st.m) * invL;
+                OutIOp::Operation::exec(Point{x, row, 0}, result, output);
+            }
+        }
+    }
+};
+
+#if defined(__NVCC__)
+template <>
+struct SoftmaxDPP<ParArch::GPU_NVIDIA> {
+  private:
+    using SelfType = SoftmaxDPP<ParArch::GPU_NVIDIA>;
+
+  public:
+    FK_STATIC_STRUCT(SoftmaxDPP, SelfType)
+    static constexpr ParArch PAR_ARCH = ParArch::GPU_NVIDIA;
 
     template <typename SoftmaxDetails, typename InIOp, typename OutIOp>
     FK_COOP_DEVICE_FUSE exec(const SoftmaxDetails& p, const InIOp& input, const OutIOp& output) {
@@ -147,7 +241,8 @@ private:
             __syncthreads();
         }
         const float m = states[0].m;
-        const float invL = 1.f / states[0].l;
+        // A row of -inf never adds to l: it is written as zeros, not NaN
+        const float invL = states[0].l > 0.f ? 1.f / states[0].l : 0.f;
 
         for (int x = tid; x < width; x += SoftmaxDetails::BLOCK_SIZE) {
             const float result = cxp::expf::f(InIOp::Operation::exec(Point{x, row, 0}, input) - m) * invL;
@@ -175,9 +270,18 @@ inline void executeSoftmax(const InIOp& input, const OutIOp& output,
     const SoftmaxDPPDetails<BLOCK_SIZE> details{};
     const dim3 grid(InIOp::Operation::num_elems_y(Point{0,0,0}, input), 1, 1);
     const dim3 block(BLOCK_SIZE, 1, 1);
-    launchDPP_Kernel<SoftmaxDPP><<<grid, block, 0, stream.getCUDAStream()>>>(details, input, NullType{}, output);
+    launchDPP_Kernel<SoftmaxDPP<ParArch::GPU_NVIDIA>>
+        <<<grid, block, 0, stream.getCUDAStream()>>>(details, input, NullType{}, output);
     gpuErrchk(cudaGetLastError());
 }
+#endif // defined(__NVCC__)
+
+template <int BLOCK_SIZE, typename InIOp, typename OutIOp>
+inline void executeSoftmax(const InIOp& input, const OutIOp& output,
+                           Stream_<ParArch::CPU>&) {
+    const SoftmaxDPPDetails<BLOCK_SIZE> details{};
+    SoftmaxDPP<ParArch::CPU>::exec(details, input, output);
+}
 
 } // namespace fk
 
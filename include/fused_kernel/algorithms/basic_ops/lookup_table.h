@@ -0,0 +1,174 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_LOOKUP_TABLE_H
+#define FK_LOOKUP_TABLE_H
+
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/operation_model/operation_model.h>
+#include <fused_kernel/core/utils/vector_utils.h>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+LookupTable: replaces a per pixel chain of Unary and Binary IOps on 8 to 16
+bit unsigned pixels by one table read per channel.
+
+A gamma curve, a tone mapping curve or a Cast, Mul, Sub, SaturateCast
+chain on uchar or ushort pixels computes the same few thousand results
+again and again. LookupTable<I, BITS>::bake evaluates the chain once for
+every input value, 2^BITS of them, stores the results in a table and
+returns a LookupTableOp IOp that gives the same outputs:
+
+    Ptr1D<float> table;
+    const auto lut = LookupTable<ushort3, 10>::bake(table, stream,
+        Cast<ushort3, float3>::build(), Mul<float3>::build(scale), toneMap);
+    executeOperations<TransformDPP<PA>>(stream, read, lut, write);
+
+The chain must work channel by channel: output channel c can only depend
+on input channel c, which holds for the element wise operations. bake
+evaluates multi channel chains again with a different value in each
+channel, and throws std::invalid_argument when a channel mixing IOp, like
+a VectorReorder or a color matrix, gives other results. Channel c
+of input value v is at table[c * 2^BITS + v]. Inputs larger than
+2^BITS - 1 read the last entry. 256 entries per channel stay in L1 on
+CPU, and on GPU the table goes through the read-only data cache.
+*/
+
+namespace fk {
+
+template <typename I, typename O, int BITS>
+struct LookupTableOp {
+private:
+    using SelfType = LookupTableOp<I, O, BITS>;
+public:
+    FK_STATIC_STRUCT(LookupTableOp, SelfType)
+    using Parent = BinaryOperation<I, RawPtr<ND::_1D, VBase<O>>, O, SelfType>;
+    DECLARE_BINARY_PARENT
+    static constexpr uint VALUES = 1u << BITS;
+
+    FK_HOST_DEVICE_FUSE OutputType exec(const InputType input, const ParamsType& params) {
+        return exec_helper(std::make_index_sequence<cn<I>>{}, input, params);
+    }
+
+private:
+    template <size_t... Idx>
+    FK_HOST_DEVICE_FUSE OutputType exec_helper(const std::index_sequence<Idx...>&,
+                                               const InputType input, const ParamsType& params) {
+        if constexpr (cn<O> == 1) {
+            return lookup(0, vector_at::f(0, input), params);
+        } else {
+            return make_<O>(lookup(Idx, vector_at::f(Idx, input), params)...);
+        }
+    }
+
+    FK_HOST_DEVICE_FUSE VBase<O> lookup(const uint channel, const VBase<I> value, const ParamsType& params) {
+        uint index = static_cast<uint>(value);
+        if constexpr (BITS < sizeof(VBase<I>) * 8) {
+            index = index < VALUES ? index : VALUES - 1;
+        }
+        const VBase<O>* const entry = params.data + channel * VALUES + index;
+#if defined(__CUDA_ARCH__)
+        return __ldg(entry);
+#else
+        return *entry;
+#endif
+    }
+};
+
+template <typename I, int BITS = static_cast<int>(sizeof(VBase<I>) * 8)>
+struct LookupTable {
+    FK_STATIC_STRUCT(LookupTable, LookupTable)
+    static_assert(std::is_integral_v<VBase<I>> && std::is_unsigned_v<VBase<I>>,
+                  "LookupTable indexes by unsigned integer pixels");
+    static_assert(BITS > 0 && BITS <= 16 && BITS <= static_cast<int>(sizeof(VBase<I>) * 8),
+                  "LookupTable supports up to 16 bit inputs, and no more bits than the input type");
+    static constexpr uint VALUES = 1u << BITS;
+
+    template <typename... IOps>
+    using OutputType = std::decay_t<decltype((std::declval<I>() | ... | std::declval<IOps>()))>;
+
+    // Evaluates iOps on every input value into table, (re)allocated and uploaded
+    // as needed, and returns the IOp that replaces iOps in a pipeline
+    template <typename StreamType, typename... IOps>
+    FK_HOST_FUSE auto bake(Ptr1D<VBase<OutputType<IOps...>>>& table, StreamType& stream, const IOps&... iOps) {
+        static_assert(sizeof...(IOps) > 0, "LookupTable needs the IOps to evaluate");
+        static_assert(((opIs<UnaryType, IOps> || opIs<BinaryType, IOps>) && ...),
+                      "LookupTable can only replace Unary and Binary IOps");
+        using O = OutputType<IOps...>;
+        static_assert(cn<O> == cn<I>, "LookupTable IOps must keep the number of channels");
+        using Entry = VBase<O>;
+
+        // A CPU launch reads table.ptr() directly, so the table must live in host
+        // memory, whatever defaultMemType is in this translation unit
+        constexpr bool CPU_STREAM = StreamType::parArch() == ParArch::CPU;
+        const uint entries = VALUES * cn<O>;
+        if (table.dims().width != entries) {
+            const MemType type = table.dims().width != 0 ? table.getMemType() :
+                                 (CPU_STREAM ? MemType::Host : defaultMemType);
+            table = Ptr1D<Entry>(entries, 0, type, table.getDeviceID());
+        }
+        if constexpr (CPU_STREAM) {
+            if (table.getMemType() != MemType::Host && table.getMemType() != MemType::HostPinned) {
+                throw std::invalid_argument("LookupTable: the table must be in host memory for CPU streams");
+            }
+        } else if (table.getMemType() == MemType::Device) {
+            throw std::invalid_argument("LookupTable: the table must be host accessible, use MemType::DeviceAndPinned on GPUs");
+        }
+        Entry* const host = table.getMemType() == MemType::DeviceAndPinned ? table.ptrPinned().data : table.ptr().data;
+        for (uint value = 0; value < VALUES; ++value) {
+            const O result = (make_set<I>(static_cast<VBase<I>>(value)) | ... | iOps);
+            for (uint channel = 0; channel < cn<O>; ++channel) {
+                host[channel * VALUES + value] = vector_at::f(static_cast<int>(channel), result);
+            }
+        }
+        if constexpr (cn<O> > 1) {
+            // make_set filled every channel with the same value, which hides channel mixing
+            constexpr uint STEP = VALUES / cn<I> > 0 ? VALUES / cn<I> : 1;
+            for (uint value = 0; value < VALUES; ++value) {
+                const I input = shiftedChannels(std::make_index_sequence<cn<I>>{}, value, STEP);
+                const O result = (input | ... | iOps);
+                for (uint channel = 0; channel < cn<O>; ++channel) {
+                    const uint index = static_cast<uint>(vector_at::f(static_cast<int>(channel), input));
+                    if (!sameEntry(host[channel * VALUES + index], vector_at::f(static_cast<int>(channel), result))) {
+                        throw std::invalid_argument("LookupTable: the IOps mix channels, output channel c must only depend on input channel c");
+                    }
+                }
+            }
+        }
+        if constexpr (!CPU_STREAM) {
+            table.upload(stream);
+        }
+        return LookupTableOp<I, O, BITS>::build(table.ptr());
+    }
+
+private:
+    // Channel c holds (value + c * step) mod 2^BITS
+    template <size_t... Idx>
+    FK_HOST_FUSE I shiftedChannels(const std::index_sequence<Idx...>&, const uint value, const uint step) {
+        return make_<I>(static_cast<VBase<I>>((value + static_cast<uint>(Idx) * step) % VALUES)...);
+    }
+
+    // Equal, or both NaN
+    template <typename Entry>
+    FK_HOST_FUSE bool sameEntry(const Entry& a, const Entry& b) {
+        return a == b || (a != a && b != b);
+    }
+};
+
+} // namespace fk
+
+#endif // FK_LOOKUP_TABLE_H
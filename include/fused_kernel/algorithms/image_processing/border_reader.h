@@ -330,6 +330,17 @@ FK_HOST_DEVICE_FUSE OutputType exec(const Point thread, const ParamsType& params
 #undef BORDER_READER_DETAILS
 #undef BORDER_READER_EXEC
 
+    template <typename Operation>
+    struct IsBorderReader : std::false_type {};
+
+    template <BorderType BT, typename ParamsType, typename BackIOp, typename Enabler>
+    struct IsBorderReader<BorderReader<BT, ParamsType, BackIOp, Enabler>> : std::true_type {};
+
+    // A BorderReader with its BackIOp. Inside the image it returns the BackIOp value
+    // for any BorderType, so callers that know a coordinate is inside can read the BackIOp
+    template <typename IOp>
+    constexpr bool isCompleteBorderReader = IsBorderReader<typename IOp::Operation>::value && isAnyCompleteReadType<IOp>;
+
 }
 
 #endif // FK_BORDER_READER_CUH
\ No newline at end of file
@@ -16,6 +16,7 @@
 #define FK_BOX_FILTER_FAST_H
 
 #include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/image_processing/neighborhood.h>
 #include <fused_kernel/core/data/point.h>
 #include <fused_kernel/core/execution_model/parallel_architectures.h>
 #include <fused_kernel/core/execution_model/stream.h>
@@ -57,10 +58,6 @@ struct BoxFilterQuadDPP<ParArch::CPU, T, EX, EY, KW, KH> {
 private:
     using SelfType = BoxFilterQuadDPP<ParArch::CPU, T, EX, EY, KW, KH>;
 
-    FK_HOST_FUSE int clamp(const int value, const int upper) {
-        return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-    }
-
 public:
     FK_STATIC_STRUCT(BoxFilterQuadDPP, SelfType)
     static constexpr ParArch PAR_ARCH = ParArch::CPU;
@@ -101,23 +98,23 @@ public:
         const auto& combine = get<0>(compute);
         const auto& normalize = get<2>(compute);
 
-        for (int y = 0; y < details.height; ++y) {
-            for (int x = 0; x < details.width; ++x) {
-                float sum = 0.f;
-                for (int ky = 0; ky < kernelHeight; ++ky) {
-                    for (int kx = 0; kx < kernelWidth; ++kx) {
-                        const Point source{
-                            clamp(x + kx - details.anchorX, details.width),
-                            clamp(y + ky - details.anchorY, details.height), 0};
-                        const float value =
-                            InIOp::Operation::exec(source, input);
-                        sum = make_tuple(sum, value) | combine;
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height, kernelWidth, kernelHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int x, const int y, const auto inside) {
+            float sum = 0.f;
+            for (int ky = 0; ky < kernelHeight; ++ky) {
+                for (int kx = 0; kx < kernelWidth; ++kx) {
+                    const float value = NeighborhoodRead::at(
+                        inside, input, details.width, details.height,
+                        x + kx - details.anchorX, y + ky - details.anchorY);
+                    sum = make_tuple(sum, value) | combine;
                 }
-                const float mean = sum | normalize;
-                OutIOp::Operation::exec(Point{x, y, 0}, mean, output);
             }
-        }
+            const float mean = sum | normalize;
+            OutIOp::Operation::exec(Point{x, y, 0}, mean, output);
+        });
     }
 };
 
@@ -199,57 +196,65 @@ public:
         if (span > MAX_SPAN) return;
         const int firstColumn = x0 - details.anchorX;
 
-        auto clamp = [](const int value, const int upper) {
-            return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-        };
-        auto readSource = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
-
-        float columnsSum[MAX_SPAN];
-        #pragma unroll
-        for (int index = 0; index < span; ++index) {
-            float sum = 0.f;
-            for (int ky = 0; ky < kernelHeight; ++ky) {
-                sum = make_tuple(
-                    sum, readSource(firstColumn + index,
-                                    y0 + ky - details.anchorY)) | combine;
-            }
-            columnsSum[index] = sum;
-        }
+        // Whole tiles are interior or frame, so the branch is warp uniform
+        // except along the frame, and interior tiles read without border handling
+        const auto tile = [&](const auto inside) {
+            auto readSource = [&](const int x, const int y) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, x, y);
+            };
 
-        #pragma unroll
-        for (int localY = 0; localY < EY; ++localY) {
-            const int y = y0 + localY;
-            if (y >= details.height) break;
+            float columnsSum[MAX_SPAN];
             #pragma unroll
-            for (int localX = 0; localX < EX; ++localX) {
-                const int x = x0 + localX;
-                if (x >= details.width) break;
+            for (int index = 0; index < span; ++index) {
                 float sum = 0.f;
-                for (int kx = 0; kx < kernelWidth; ++kx) {
+                for (int ky = 0; ky < kernelHeight; ++ky) {
                     sum = make_tuple(
-                        sum, columnsSum[localX + kx]) | combine;
+                        sum, readSource(firstColumn + index,
+                                        y0 + ky - details.anchorY)) | combine;
                 }
-                const float mean = sum | normalize;
-                OutIOp::Operation::exec(Point{x, y, 0}, mean, output);
+                columnsSum[index] = sum;
             }
 
-            if (localY + 1 < EY && y + 1 < details.height) {
-                const int top = y - details.anchorY;
-                const int bottom = top + kernelHeight;
+            #pragma unroll
+            for (int localY = 0; localY < EY; ++localY) {
+                const int y = y0 + localY;
+                if (y >= details.height) break;
                 #pragma unroll
-                for (int index = 0; index < span; ++index) {
-                    const float withBottom = make_tuple(
-                        columnsSum[index],
-                        readSource(firstColumn + index, bottom)) | combine;
-                    columnsSum[index] = make_tuple(
-                        withBottom,
-                        readSource(firstColumn + index, top)) | subtract;
+                for (int localX = 0; localX < EX; ++localX) {
+                    const int x = x0 + localX;
+                    if (x >= details.width) break;
+                    float sum = 0.f;
+                    for (int kx = 0; kx < kernelWidth; ++kx) {
+                        sum = make_tuple(
+                            sum, columnsSum[localX + kx]) | combine;
+                    }
+                    const float mean = sum | normalize;
+                    OutIOp::Operation::exec(Point{x, y, 0}, mean, output);
+                }
+
+                if (localY + 1 < EY && y + 1 < details.height) {
+                    const int top = y - details.anchorY;
+                    const int bottom = top + kernelHeight;
+                    #pragma unroll
+                    for (int index = 0; index < span; ++index) {
+                        const float withBottom = make_tuple(
+                            columnsSum[index],
+                            readSource(firstColumn + index, bottom)) | combine;
+                        columnsSum[index] = make_tuple(
+                            withBottom,
+                            readSource(firstColumn + index, top)) | subtract;
+                    }
                 }
             }
+        };
+        if (NeighborhoodInterior::of(details.width, details.height,
+                                     kernelWidth, kernelHeight,
+                                     details.anchorX, details.anchorY)
+                .contains(x0, y0, EX, EY)) {
+            tile(std::true_type{});
+        } else {
+            tile(std::false_type{});
         }
 #endif // defined(__CUDA_ARCH__)
     }
@@ -22,6 +22,7 @@
 #include <fused_kernel/algorithms/image_processing/raw_image.h>
 #include <fused_kernel/algorithms/image_processing/itu_color.h>
 #include <fused_kernel/algorithms/basic_ops/algebraic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
 #include <fused_kernel/algorithms/basic_ops/vector_ops.h>
 
 namespace fk {
@@ -101,7 +102,7 @@ namespace fk {
         using Parent = UnaryOperation<T, T, SaturateDepth<T, CD>>;
         DECLARE_UNARY_PARENT
         FK_HOST_DEVICE_FUSE OutputType exec(const InputType input) {
-            return Saturate<float>::exec(input, { { 0.f, static_cast<float>(maxDepthValue<CD>) } });
+            return Saturate<T>::exec(input, make_<VectorType_t<VBase<T>, 2>>(0.f, static_cast<float>(maxDepthValue<CD>)));
         }
     };
 
@@ -147,6 +148,24 @@ namespace fk {
         }
     };
 
+    // Rounds a fixed point value with ccFixedPointBits fractional bits, and saturates it to CD
+    template <ColorDepth CD>
+    struct SaturateFixedPoint {
+    private:
+        using SelfType = SaturateFixedPoint<CD>;
+    public:
+        FK_STATIC_STRUCT(SaturateFixedPoint, SelfType)
+        using Parent = UnaryOperation<int, ColorDepthPixelBaseType<CD>, SaturateFixedPoint<CD>>;
+        DECLARE_UNARY_PARENT
+        FK_HOST_DEVICE_FUSE OutputType exec(const InputType input) {
+            static_assert(std::is_integral_v<OutputType>, "SaturateFixedPoint only works with integer color depths.");
+            constexpr int half = 1 << (ccFixedPointBits - 1);
+            constexpr int maxDepth = static_cast<int>(maxDepthValue<CD>);
+            const int value = (input + half) >> ccFixedPointBits;
+            return static_cast<OutputType>(value < 0 ? 0 : (value > maxDepth ? maxDepth : value));
+        }
+    };
+
     template <ColorDepth CD, ColorRange CR, ColorPrimitives CP>
     struct ConvertYUVToRGB {
     private:
@@ -173,6 +192,31 @@ namespace fk {
         }
     };
 
+    // Integer only version of ConvertYUVToRGB, for 8 to 12 bit pixels. Returns the saturated
+    // RGB pixel, which is within 1 LSB of the rounded and saturated result of ConvertYUVToRGB
+    template <ColorDepth CD, ColorRange CR, ColorPrimitives CP>
+    struct ConvertYUVToRGBFixedPoint {
+    private:
+        using SelfType = ConvertYUVToRGBFixedPoint<CD, CR, CP>;
+        using Parent = UnaryOperation<ColorDepthPixelType<CD>, ColorDepthPixelType<CD>, SelfType>;
+    public:
+        FK_STATIC_STRUCT(ConvertYUVToRGBFixedPoint, SelfType)
+        DECLARE_UNARY_PARENT
+        static_assert(std::is_integral_v<ColorDepthPixelBaseType<CD>>,
+                      "ColorArithmetic::FixedPoint only works with integer color depths.");
+        FK_HOST_DEVICE_FUSE OutputType exec(const InputType input) {
+            constexpr M3x3Int m = ccMatrixFixedPoint<CR, CP, ColorConversionDir::YCbCr2RGB, CD>;
+            constexpr int CSub = static_cast<int>(subCoefficients<CD>.chroma);
+            constexpr int YSub = CR == ColorRange::Limited ? static_cast<int>(subCoefficients<CD>.luma) : 0;
+            const int y = static_cast<int>(input.x) - YSub;
+            const int u = static_cast<int>(input.y) - CSub;
+            const int v = static_cast<int>(input.z) - CSub;
+            return { SaturateFixedPoint<CD>::exec((m.x.x * y) + (m.x.y * u) + (m.x.z * v)),
+                     SaturateFixedPoint<CD>::exec((m.y.x * y) + (m.y.y * u) + (m.y.z * v)),
+                     SaturateFixedPoint<CD>::exec((m.z.x * y) + (m.z.y * u) + (m.z.z * v)) };
+        }
+    };
+
     template <ColorDepth CD, ColorRange CR, ColorPrimitives CP>
     struct ConvertRGBToYUV {
     private:
@@ -199,6 +243,55 @@ namespace fk {
         }
     };
 
+    // Integer only version of ConvertRGBToYUV, for 8 to 12 bit pixels. Returns the saturated
+    // YUV pixel, which is within 1 LSB of the rounded and saturated result of ConvertRGBToYUV
+    template <ColorDepth CD, ColorRange CR, ColorPrimitives CP>
+    struct ConvertRGBToYUVFixedPoint {
+    private:
+        using SelfType = ConvertRGBToYUVFixedPoint<CD, CR, CP>;
+        using Parent = UnaryOperation<ColorDepthPixelType<CD>, ColorDepthPixelType<CD>, SelfType>;
+    public:
+        FK_STATIC_STRUCT(ConvertRGBToYUVFixedPoint, SelfType)
+        DECLARE_UNARY_PARENT
+        static_assert(std::is_integral_v<ColorDepthPixelBaseType<CD>>,
+                      "ColorArithmetic::FixedPoint only works with integer color depths.");
+        FK_HOST_DEVICE_FUSE OutputType exec(const InputType input) {
+            constexpr M3x3Int m = ccMatrixFixedPoint<CR, CP, ColorConversionDir::RGB2YCbCr, CD>;
+            // The offsets are added before the rounding shift
+            constexpr int CAdd = static_cast<int>(subCoefficients<CD>.chroma) << ccFixedPointBits;
+            constexpr int YAdd = CR == ColorRange::Limited ?
+                                 static_cast<int>(subCoefficients<CD>.luma) << ccFixedPointBits : 0;
+            const int r = static_cast<int>(input.x);
+            const int g = static_cast<int>(input.y);
+            const int b = static_cast<int>(input.z);
+            return { SaturateFixedPoint<CD>::exec((m.x.x * r) + (m.x.y * g) + (m.x.z * b) + YAdd),
+                     SaturateFixedPoint<CD>::exec((m.y.x * r) + (m.y.y * g) + (m.y.z * b) + CAdd),
+                     SaturateFixedPoint<CD>::exec((m.z.x * r) + (m.z.y * g) + (m.z.z * b) + CAdd) };
+        }
+    };
+
+    // ConvertYUVToRGB or ConvertYUVToRGBFixedPoint, followed by what it takes to return O
+    // with either ColorArithmetic: the saturation to CD and to O after the float conversion,
+    // or the cast to O after the fixed point one. Switching CA keeps the output type.
+    template <ColorDepth CD, ColorRange CR, ColorPrimitives CP, typename O, ColorArithmetic CA = ColorArithmetic::Float>
+    struct YUVToRGBConversion {
+        static_assert(cn<O> == 3, "YUVToRGBConversion returns RGB pixels");
+        using type = std::conditional_t<std::is_same_v<O, float3>,
+                                        ConvertYUVToRGB<CD, CR, CP>,
+                                        FusedOperation<Unary<ConvertYUVToRGB<CD, CR, CP>>,
+                                                       Unary<SaturateDepth<float3, CD>>,
+                                                       Unary<SaturateCast<float3, O>>>>;
+    };
+
+    template <ColorDepth CD, ColorRange CR, ColorPrimitives CP, typename O>
+    struct YUVToRGBConversion<CD, CR, CP, O, ColorArithmetic::FixedPoint> {
+        static_assert(cn<O> == 3, "YUVToRGBConversion returns RGB pixels");
+        using type = std::conditional_t<std::is_same_v<O, ColorDepthPixelType<CD>>,
+                                        ConvertYUVToRGBFixedPoint<CD, CR, CP>,
+                                        FusedOperation<Unary<ConvertYUVToRGBFixedPoint<CD, CR, CP>>,
+                                                       Unary<Cast<ColorDepthPixelType<CD>, O>>>>;
+    };
+
     template <PixelFormat PF>
     class Image;
 
@@ -421,7 +514,11 @@ namespace fk {
         COLOR_BGR2GRAY = 6,
         COLOR_RGB2GRAY = 7,
         COLOR_BGRA2GRAY = 10,
-        COLOR_RGBA2GRAY = 11
+        COLOR_RGBA2GRAY = 11,
+        // From the pixels of ReadYUV<NV12>, or ReadYUV<P010> with ColorDepth::p10bit.
+        // BT.601 limited range, like OpenCV
+        COLOR_YUV2RGB_NV12 = 90,
+        COLOR_YUV2BGR_NV12 = 91
     };
 
     template <ColorConversionCodes value>
@@ -434,75 +531,92 @@ namespace fk {
                                   CCC_t<ColorConversionCodes::COLOR_BGR2RGB>,   CCC_t<ColorConversionCodes::COLOR_RGB2BGR>,
                                   CCC_t<ColorConversionCodes::COLOR_BGRA2RGBA>, CCC_t<ColorConversionCodes::COLOR_RGBA2BGRA>,
                                   CCC_t<ColorConversionCodes::COLOR_RGB2GRAY>,  CCC_t<ColorConversionCodes::COLOR_RGBA2GRAY>,
-                                  CCC_t<ColorConversionCodes::COLOR_BGR2GRAY>,  CCC_t<ColorConversionCodes::COLOR_BGRA2GRAY>>;
+                                  CCC_t<ColorConversionCodes::COLOR_BGR2GRAY>,  CCC_t<ColorConversionCodes::COLOR_BGRA2GRAY>,
+                                  CCC_t<ColorConversionCodes::COLOR_YUV2RGB_NV12>, CCC_t<ColorConversionCodes::COLOR_YUV2BGR_NV12>>;
 
     template <ColorConversionCodes CODE>
     static constexpr bool isSuportedCCC = one_of_v<CCC_t<CODE>, SupportedCCC>;
 
-    template <ColorConversionCodes CODE, typename I, typename O, ColorDepth CD = ColorDepth::p8bit>
+    // CA selects the arithmetic of the YUV codes, and is ignored by the rest
+    template <ColorConversionCodes CODE, typename I, typename O, ColorDepth CD = ColorDepth::p8bit,
+              ColorArithmetic CA = ColorArithmetic::Float>
     struct ColorConversionType{
         static_assert(isSuportedCCC<CODE>, "Color conversion code not supported");
     };
 
     // Will work for COLOR_RGB2RGBA too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2BGRA, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2BGRA, I, O, CD, CA> {
         using type = AddOpaqueAlpha<I, CD>;
     };
 
     // Will work for COLOR_RGBA2RGB too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2BGR, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2BGR, I, O, CD, CA> {
         using type = Discard<I, VectorType_t<VBase<I>, 3>>;
     };
 
     // Will work for ColorConversionCodes::COLOR_RGB2BGRA too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2RGBA, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2RGBA, I, O, CD, CA> {
         using type = FusedOperation<Unary<VectorReorder<I, 2, 1, 0>>, Unary<AddOpaqueAlpha<I, CD>>>;
     };
 
     // Will work for COLOR_RGBA2BGR too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2RGB, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2RGB, I, O, CD, CA> {
         using type = FusedOperation<Unary<VectorReorder<I, 2, 1, 0, 3>>,
                            Unary<Discard<I, VectorType_t<VBase<I>, 3>>>>;
     };
 
     // Will work for ColorConversionCodes::COLOR_RGB2BGR too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2RGB, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2RGB, I, O, CD, CA> {
         using type = VectorReorder<I, 2, 1, 0>;
     };
 
     // Will work for COLOR_RGBA2BGRA too
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2RGBA, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2RGBA, I, O, CD, CA> {
         using type = VectorReorder<I, 2, 1, 0, 3>;
     };
 
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_RGB2GRAY, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_RGB2GRAY, I, O, CD, CA> {
         using type = RGB2Gray<I, O>;
     };
 
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2GRAY, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGR2GRAY, I, O, CD, CA> {
         using type = FusedOperation<Unary<VectorReorder<I, 2, 1, 0>>, Unary<RGB2Gray<I, O>>>;
     };
 
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_RGBA2GRAY, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_RGBA2GRAY, I, O, CD, CA> {
         using type = RGB2Gray<I, O>;
     };
 
-    template <typename I, typename O, ColorDepth CD>
-    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2GRAY, I, O, CD> {
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_BGRA2GRAY, I, O, CD, CA> {
         using type = FusedOperation<Unary<VectorReorder<I, 2, 1, 0, 3>>, Unary<RGB2Gray<I, O>>>;
     };
 
-    template <ColorConversionCodes code, typename I, typename O, ColorDepth CD = ColorDepth::p8bit>
-    using ColorConversion = typename ColorConversionType<code, I, O, CD>::type;
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_YUV2RGB_NV12, I, O, CD, CA> {
+        static_assert(std::is_same_v<I, ColorDepthPixelType<CD>>, "The input must be the pixel type of CD");
+        using type = typename YUVToRGBConversion<CD, ColorRange::Limited, ColorPrimitives::bt601, O, CA>::type;
+    };
+
+    template <typename I, typename O, ColorDepth CD, ColorArithmetic CA>
+    struct ColorConversionType<ColorConversionCodes::COLOR_YUV2BGR_NV12, I, O, CD, CA> {
+        static_assert(std::is_same_v<I, ColorDepthPixelType<CD>>, "The input must be the pixel type of CD");
+        using type = FusedOperation<Unary<typename YUVToRGBConversion<CD, ColorRange::Limited, ColorPrimitives::bt601, O, CA>::type>,
+                                    Unary<VectorReorder<O, 2, 1, 0>>>;
+    };
+
+    template <ColorConversionCodes code, typename I, typename O, ColorDepth CD = ColorDepth::p8bit,
+              ColorArithmetic CA = ColorArithmetic::Float>
+    using ColorConversion = typename ColorConversionType<code, I, O, CD, CA>::type;
 
 } // namespace fk
 
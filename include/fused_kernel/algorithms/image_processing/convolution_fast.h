@@ -15,6 +15,7 @@
 #ifndef FK_CONVOLUTION_FAST_H
 #define FK_CONVOLUTION_FAST_H
 
+#include <fused_kernel/algorithms/image_processing/neighborhood.h>
 #include <fused_kernel/core/execution_model/operation_model/operation_model.h>
 #include <fused_kernel/core/execution_model/parallel_architectures.h>
 #include <fused_kernel/core/execution_model/stream.h>
@@ -60,10 +61,6 @@ struct ConvQuadDPP<ParArch::CPU, T, EX, EY, KW, KH> {
 private:
     using SelfType = ConvQuadDPP<ParArch::CPU, T, EX, EY, KW, KH>;
 
-    FK_HOST_FUSE int clamp(const int value, const int upper) {
-        return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-    }
-
 public:
     FK_STATIC_STRUCT(ConvQuadDPP, SelfType)
     static constexpr ParArch PAR_ARCH = ParArch::CPU;
@@ -101,27 +98,27 @@ public:
         const int kernelHeight = KH > 0 ? KH : details.kernelHeight;
         const auto& multiply = get<0>(compute);
         const auto& combine = get<1>(compute);
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
-
-        for (int y = 0; y < details.height; ++y) {
-            for (int x = 0; x < details.width; ++x) {
-                float value = 0.f;
-                for (int ky = 0; ky < kernelHeight; ++ky) {
-                    for (int kx = 0; kx < kernelWidth; ++kx) {
-                        const float product = make_tuple(
-                            details.coefficients[ky * kernelWidth + kx],
-                            source(x + kx - details.anchorX,
-                                   y + ky - details.anchorY)) | multiply;
-                        value = make_tuple(value, product) | combine;
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height, kernelWidth, kernelHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int x, const int y, const auto inside) {
+            auto source = [&](const int sx, const int sy) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, sx, sy);
+            };
+            float value = 0.f;
+            for (int ky = 0; ky < kernelHeight; ++ky) {
+                for (int kx = 0; kx < kernelWidth; ++kx) {
+                    const float product = make_tuple(
+                        details.coefficients[ky * kernelWidth + kx],
+                        source(x + kx - details.anchorX,
+                               y + ky - details.anchorY)) | multiply;
+                    value = make_tuple(value, product) | combine;
                 }
-                OutIOp::Operation::exec(Point{x, y, 0}, value, output);
             }
-        }
+            OutIOp::Operation::exec(Point{x, y, 0}, value, output);
+        });
     }
 };
 
@@ -198,65 +195,73 @@ public:
         if (span > MAX_SPAN) return;
         const int rowsNeeded = EY + kernelHeight - 1;
         const int firstColumn = x0 - details.anchorX;
-        auto clamp = [](const int value, const int upper) {
-            return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-        };
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
-
-        float accumulated[EY][EX];
-        #pragma unroll
-        for (int localY = 0; localY < EY; ++localY) {
+        // Whole tiles are interior or frame, so the branch is warp uniform
+        // except along the frame, and interior tiles read without border handling
+        const auto tile = [&](const auto inside) {
+            auto source = [&](const int x, const int y) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, x, y);
+            };
+
+            float accumulated[EY][EX];
             #pragma unroll
-            for (int localX = 0; localX < EX; ++localX) {
-                accumulated[localY][localX] = 0.f;
+            for (int localY = 0; localY < EY; ++localY) {
+                #pragma unroll
+                for (int localX = 0; localX < EX; ++localX) {
+                    accumulated[localY][localX] = 0.f;
+                }
             }
-        }
 
-        #pragma unroll
-        for (int row = 0; row < rowsNeeded; ++row) {
-            float sourceRow[MAX_SPAN];
-            #pragma unroll
-            for (int index = 0; index < span; ++index) {
-                sourceRow[index] = source(
-                    firstColumn + index,
-                    y0 - details.anchorY + row);
-            }
             #pragma unroll
-            for (int localY = 0; localY < EY; ++localY) {
-                const int ky = row - localY;
-                if (ky < 0 || ky >= kernelHeight ||
-                    y0 + localY >= details.height) continue;
+            for (int row = 0; row < rowsNeeded; ++row) {
+                float sourceRow[MAX_SPAN];
                 #pragma unroll
-                for (int kx = 0; kx < kernelWidth; ++kx) {
-                    const float coefficient =
-                        details.coefficients[ky * kernelWidth + kx];
+                for (int index = 0; index < span; ++index) {
+                    sourceRow[index] = source(
+                        firstColumn + index,
+                        y0 - details.anchorY + row);
+                }
+                #pragma unroll
+                for (int localY = 0; localY < EY; ++localY) {
+                    const int ky = row - localY;
+                    if (ky < 0 || ky >= kernelHeight ||
+                        y0 + localY >= details.height) continue;
                     #pragma unroll
-                    for (int localX = 0; localX < EX; ++localX) {
-                        const float product = make_tuple(
-                            coefficient,
-                            sourceRow[localX + kx]) | multiply;
-                        accumulated[localY][localX] = make_tuple(
-                            accumulated[localY][localX], product) | combine;
+                    for (int kx = 0; kx < kernelWidth; ++kx) {
+                        const float coefficient =
+                            details.coefficients[ky * kernelWidth + kx];
+                        #pragma unroll
+                        for (int localX = 0; localX < EX; ++localX) {
+                            const float product = make_tuple(
+                                coefficient,
+                                sourceRow[localX + kx]) | multiply;
+                            accumulated[localY][localX] = make_tuple(
+                                accumulated[localY][localX], product) | combine;
+                        }
                     }
                 }
             }
-        }
 
-        #pragma unroll
-        for (int localY = 0; localY < EY; ++localY) {
-            const int y = y0 + localY;
-            if (y >= details.height) break;
             #pragma unroll
-            for (int localX = 0; localX < EX; ++localX) {
-                const int x = x0 + localX;
-                if (x >= details.width) break;
-                OutIOp::Operation::exec(
-                    Point{x, y, 0}, accumulated[localY][localX], output);
+            for (int localY = 0; localY < EY; ++localY) {
+                const int y = y0 + localY;
+                if (y >= details.height) break;
+                #pragma unroll
+                for (int localX = 0; localX < EX; ++localX) {
+                    const int x = x0 + localX;
+                    if (x >= details.width) break;
+                    OutIOp::Operation::exec(
+                        Point{x, y, 0}, accumulated[localY][localX], output);
+                }
             }
+        };
+        if (NeighborhoodInterior::of(details.width, details.height,
+                                     kernelWidth, kernelHeight,
+                                     details.anchorX, details.anchorY)
+                .contains(x0, y0, EX, EY)) {
+            tile(std::true_type{});
+        } else {
+            tile(std::false_type{});
         }
 #endif // defined(__CUDA_ARCH__)
     }
@@ -19,9 +19,12 @@
 #include <fused_kernel/algorithms/image_processing/color_conversion.h>
 #include <fused_kernel/algorithms/image_processing/crop.h>
 #include <fused_kernel/algorithms/image_processing/deinterlace.h>
+#include <fused_kernel/algorithms/image_processing/image_pyramid.h>
 #include <fused_kernel/algorithms/image_processing/interpolation.h>
+#include <fused_kernel/algorithms/image_processing/remap.h>
 #include <fused_kernel/algorithms/image_processing/resize.h>
 #include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/algorithms/image_processing/separable_resize.h>
 #include <fused_kernel/algorithms/image_processing/warping.h>
 #include <fused_kernel/algorithms/image_processing/box_filter_fast.h>
 #include <fused_kernel/algorithms/image_processing/morphology_fast.h>
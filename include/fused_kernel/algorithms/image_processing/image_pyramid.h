@@ -0,0 +1,170 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_IMAGE_PYRAMID_H
+#define FK_IMAGE_PYRAMID_H
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/separable_resize.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+/*
+ImagePyramid: N downscaled versions of one source, computed as a cascade.
+
+One Resize pipeline per scale reads the full resolution source N times.
+executePyramid resizes the source into the first level only, and every
+other level from the previous one, so the source is read once and each
+level reads a smaller image. The levels are resized with
+SeparableResizeDPP, in float, and the float levels are kept in
+intermediate buffers that executePyramid (re)allocates as needed.
+
+Every level has its own output pipeline, a Write IOp that receives the
+float pixel. Compute IOps such as a normalization or a SaturateCast are
+fused into it with FusedOperation:
+
+    const auto details = ImagePyramid::geometric<6>(Size(960, 540), 0.75f);
+    std::array<Ptr2D<float3>, 5> levels;
+    executePyramid<SeparableResizeDPP<ParArch::CPU>>(stream, details, levels, readIOp,
+        FusedOperation<>::build(SaturateCast<float3, uchar3>::build(), PerThreadWrite<ND::_2D, uchar3>::build(out0)),
+        ...);
+
+A level resized from the previous level is not bit exact with a direct
+resize of the source: with AREA taps and integer factors it is the same
+box average, with LINEAR taps it is a smoother image.
+*/
+
+namespace fk {
+
+template <size_t LEVELS>
+struct PyramidDetails {
+    static_assert(LEVELS > 0, "A pyramid needs at least one level");
+    std::array<Size, LEVELS> sizes;
+    SeparableResizeMode mode;
+};
+
+struct ImagePyramid {
+    FK_STATIC_STRUCT(ImagePyramid, ImagePyramid)
+
+    template <size_t LEVELS>
+    FK_HOST_FUSE PyramidDetails<LEVELS> details(const std::array<Size, LEVELS>& sizes,
+                                                const SeparableResizeMode mode = SeparableResizeMode::AUTO) {
+        for (size_t i = 0; i < LEVELS; ++i) {
+            if (sizes[i].width <= 0 || sizes[i].height <= 0) {
+                throw std::invalid_argument("ImagePyramid: level sizes must be positive");
+            }
+            if (i > 0 && (sizes[i].width > sizes[i - 1].width || sizes[i].height > sizes[i - 1].height)) {
+                throw std::invalid_argument("ImagePyramid: a level can not be larger than the previous one");
+            }
+        }
+        return { sizes, mode };
+    }
+
+    // LEVELS levels starting at firstSize, each one scale times the previous
+    template <size_t LEVELS>
+    FK_HOST_FUSE PyramidDetails<LEVELS> geometric(const Size& firstSize, const float scale,
+                                                  const SeparableResizeMode mode = SeparableResizeMode::AUTO) {
+        if (!(scale > 0.f && scale <= 1.f)) {
+            throw std::invalid_argument("ImagePyramid: the scale between levels must be in (0, 1]");
+        }
+        std::array<Size, LEVELS> sizes{};
+        double factor = 1.;
+        for (size_t i = 0; i < LEVELS; ++i) {
+            sizes[i] = Size(std::max(1, static_cast<int>(std::lround(firstSize.width * factor))),
+                            std::max(1, static_cast<int>(std::lround(firstSize.height * factor))));
+            factor *= scale;
+        }
+        return details(sizes, mode);
+    }
+};
+
+template <typename PixelType, typename LevelIOp>
+struct PyramidLevelWriteParams {
+    RawPtr<ND::_2D, PixelType> level;
+    LevelIOp output;
+};
+
+// Stores the resized pixel in the level buffer the next level reads, and
+// sends it to the output pipeline of the level
+template <typename PixelType, typename LevelIOp>
+struct PyramidLevelWrite {
+private:
+    using SelfType = PyramidLevelWrite<PixelType, LevelIOp>;
+public:
+    FK_STATIC_STRUCT(PyramidLevelWrite, SelfType)
+    using Parent = WriteOperation<PixelType, PyramidLevelWriteParams<PixelType, LevelIOp>,
+                                  PixelType, TF::DISABLED, SelfType>;
+    DECLARE_WRITE_PARENT_BASIC
+
+    template <uint ELEMS_PER_THREAD = 1>
+    FK_HOST_DEVICE_FUSE void exec(const Point thread,
+                                  const ThreadFusionType<InputType, ELEMS_PER_THREAD, InputType> input,
+                                  const ParamsType& params) {
+        *PtrAccessor<ND::_2D>::point(thread, params.level) = input;
+        LevelIOp::Operation::exec(thread, input, params.output);
+    }
+    FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+        return opData.params.level.dims.width;
+    }
+    FK_HOST_DEVICE_FUSE uint pitch(const Point thread, const OperationDataType& opData) {
+        return opData.params.level.dims.pitch;
+    }
+    FK_HOST_FUSE InstantiableType build(const RawPtr<ND::_2D, PixelType>& level, const LevelIOp& output) {
+        return { { { level, output } } };
+    }
+};
+
+template <typename ReadIOp>
+using PyramidPixel = float_<cn<typename ReadIOp::Operation::OutputType>>;
+
+namespace pyramid_detail {
+    template <typename DPP, size_t LEVEL, size_t LEVELS, typename PixelType, typename StreamType,
+              typename InIOp, typename LevelIOp, typename... LevelIOps>
+    FK_HOST_FUSE void cascade(StreamType& stream, const PyramidDetails<LEVELS>& details,
+                              std::array<Ptr2D<PixelType>, LEVELS - 1>& levels, const InIOp& input,
+                              const LevelIOp& levelIOp, const LevelIOps&... levelIOps) {
+        static_assert(opIs<WriteType, LevelIOp>, "Each pyramid level output must be a Write IOp");
+        const auto resize = SeparableResize<>::details(input, details.sizes[LEVEL], details.mode);
+        if constexpr (LEVEL + 1 == LEVELS) {
+            executeSeparableResize<DPP>(stream, resize, input, levelIOp);
+        } else {
+            Ptr2D<PixelType>& level = levels[LEVEL];
+            const Size size = details.sizes[LEVEL];
+            if (level.dims().width != static_cast<uint>(size.width) || level.dims().height != static_cast<uint>(size.height)) {
+                constexpr MemType type = DPP::PAR_ARCH == ParArch::CPU ? MemType::Host : MemType::Device;
+                level = Ptr2D<PixelType>(size.width, size.height, 0, type, level.getDeviceID());
+            }
+            executeSeparableResize<DPP>(stream, resize, input,
+                                        PyramidLevelWrite<PixelType, LevelIOp>::build(level.ptr(), levelIOp));
+            cascade<DPP, LEVEL + 1>(stream, details, levels, PerThreadRead<ND::_2D, PixelType>::build(level),
+                                    levelIOps...);
+        }
+    }
+} // namespace pyramid_detail
+
+// Computes every level of details from readIOp, and writes level i with levelIOps[i]
+template <typename DPP, size_t LEVELS, typename StreamType, typename ReadIOp, typename... LevelIOps>
+FK_HOST_FUSE void executePyramid(StreamType& stream, const PyramidDetails<LEVELS>& details,
+                                 std::array<Ptr2D<PyramidPixel<ReadIOp>>, LEVELS - 1>& levels,
+                                 const ReadIOp& readIOp, const LevelIOps&... levelIOps) {
+    static_assert(sizeof...(LevelIOps) == LEVELS, "executePyramid needs one output Write IOp per level");
+    pyramid_detail::cascade<DPP, 0>(stream, details, levels, readIOp, levelIOps...);
+}
+
+} // namespace fk
+
+#endif // FK_IMAGE_PYRAMID_H
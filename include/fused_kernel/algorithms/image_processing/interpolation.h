@@ -30,6 +30,11 @@ namespace fk {
 
     enum class InterpolationType {
         INTER_LINEAR = 1,
+        // Bilinear with 11 bit fixed-point weights for 8 and 16 bit integer sources.
+        // It returns the source pixel type, rounded to the nearest integer, so
+        // uchar3 to uchar3 pipelines need no float conversion nor SaturateCast,
+        // and it is bit exact on every backend.
+        INTER_LINEAR_EXACT = 5,
         NONE = 17
     };
 
@@ -39,6 +44,34 @@ namespace fk {
     template <>
     struct InterpolationParameters<InterpolationType::INTER_LINEAR> {};
 
+    template <>
+    struct InterpolationParameters<InterpolationType::INTER_LINEAR_EXACT> {};
+
+    // The 2x2 source pixels around a coordinate, shared by the bilinear interpolations
+    struct BilinearSlice {
+        FK_STATIC_STRUCT(BilinearSlice, BilinearSlice)
+        FK_HOST_DEVICE_FUSE int floor(const float coord) {
+#ifdef __CUDA_ARCH__
+            return __float2int_rd(coord);
+#else
+            return static_cast<int>(cxp::floor::f(coord));
+#endif
+        }
+
+        template <typename BackIOp>
+        FK_HOST_DEVICE_FUSE auto read(const int x1, const int y1, const BackIOp& backIOp) {
+            const Size srcSize = NumElems::size(Point{0,0,0}, backIOp);
+            const int x2_read = cxp::min::f(x1 + 1, srcSize.width - 1);
+            const int y2_read = cxp::min::f(y1 + 1, srcSize.height - 1);
+
+            using PixelType = decltype(BackIOp::Operation::exec(Point{ x1, y1, 0 }, backIOp));
+            return Slice2x2<PixelType>{ BackIOp::Operation::exec(Point{ x1, y1, 0 }, backIOp),
+                                        BackIOp::Operation::exec(Point{ x2_read, y1, 0 }, backIOp),
+                                        BackIOp::Operation::exec(Point{ x1, y2_read, 0 }, backIOp),
+                                        BackIOp::Operation::exec(Point{ x2_read, y2_read, 0 }, backIOp) };
+        }
+    };
+
     template <enum InterpolationType IType, typename BackIOp_>
     struct InterpolateComplete;
 
@@ -71,54 +104,116 @@ namespace fk {
             const float src_x = input.x;
             const float src_y = input.y;
 
-#ifdef __CUDA_ARCH__
-            const int x1 = __float2int_rd(src_x);
-            const int y1 = __float2int_rd(src_y);
-#else
-            const int x1 = static_cast<int>(cxp::floor::f(src_x));
-            const int y1 = static_cast<int>(cxp::floor::f(src_y));
-#endif
+            const int x1 = BilinearSlice::floor(src_x);
+            const int y1 = BilinearSlice::floor(src_y);
             const int x2 = x1 + 1;
             const int y2 = y1 + 1;
 
-            const Size srcSize = NumElems::size(Point{0,0,0}, backIOp);
-            const int x2_read = cxp::min::f(x2, srcSize.width - 1);
-            const int y2_read = cxp::min::f(y2, srcSize.height - 1);
-
-            const Slice2x2<Point> readPoints{ {x1, y1, 0},
-                                              {x2_read, y1, 0},
-                                              {x1, y2_read, 0},
-                                              {x2_read, y2_read, 0} };
-
             // Read the 4 pixels from backIOp Read or ReadBack Operation
-            const auto src_reg0x0 = BackIOp::Operation::exec(readPoints._0x0, backIOp);
-            const auto src_reg1x0 = BackIOp::Operation::exec(readPoints._1x0, backIOp);
-            const auto src_reg0x1 = BackIOp::Operation::exec(readPoints._0x1, backIOp);
-            const auto src_reg1x1 = BackIOp::Operation::exec(readPoints._1x1, backIOp);
+            const auto src = BilinearSlice::read(x1, y1, backIOp);
 
             // Compute the interpolated pixel and return it
-            return (src_reg0x0 * ((x2 - src_x) * (y2 - src_y))) +
-                   (src_reg1x0 * ((src_x - x1) * (y2 - src_y))) +
-                   (src_reg0x1 * ((x2 - src_x) * (src_y - y1))) +
-                   (src_reg1x1 * ((src_x - x1) * (src_y - y1)));
+            return (src._0x0 * ((x2 - src_x) * (y2 - src_y))) +
+                   (src._1x0 * ((src_x - x1) * (y2 - src_y))) +
+                   (src._0x1 * ((x2 - src_x) * (src_y - y1))) +
+                   (src._1x1 * ((src_x - x1) * (src_y - y1)));
         }
     };
 
-    template <InterpolationType IT>
-    struct Interpolate;
+    template <typename BackIOp_>
+    struct InterpolateComplete<InterpolationType::INTER_LINEAR_EXACT, BackIOp_> {
+        static_assert(isCompleteOperation<BackIOp_>, "NewBackIOp must be a complete operation.");
+    private:
+        using SelfType = InterpolateComplete<InterpolationType::INTER_LINEAR_EXACT, BackIOp_>;
+        using BackIOpOutputType = typename BackIOp_::Operation::OutputType;
+        static_assert(std::is_integral_v<VBase<BackIOpOutputType>> && sizeof(VBase<BackIOpOutputType>) <= 2,
+                      "INTER_LINEAR_EXACT interpolates 8 and 16 bit integer pixels");
+        // 8 bit pixels times the 2^22 total weight fit in 31 bits, 16 bit pixels need 39
+        using AccType = std::conditional_t<sizeof(VBase<BackIOpOutputType>) == 1, int, long long>;
+        static constexpr int COEF_BITS = 11;
+        static constexpr int COEF_ONE = 1 << COEF_BITS;
+    public:
+        FK_STATIC_STRUCT(InterpolateComplete, SelfType)
+        using Parent = TernaryOperation<float2, InterpolationParameters<InterpolationType::INTER_LINEAR_EXACT>,
+                                        BackIOp_, BackIOpOutputType,
+                                        SelfType>;
+        DECLARE_TERNARY_PARENT
 
-    template <>
-    struct Interpolate<InterpolationType::INTER_LINEAR> {
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+            return BackIOp::Operation::num_elems_x(thread, opData.backIOp);
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_y(const Point thread, const OperationDataType& opData) {
+            return BackIOp::Operation::num_elems_y(thread, opData.backIOp);
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_z(const Point, const OperationDataType&) {
+            return 1;
+        }
+
+        FK_HOST_DEVICE_FUSE OutputType exec(const InputType input, const ParamsType&, const BackIOp& backIOp) {
+            const int x1 = BilinearSlice::floor(input.x);
+            const int y1 = BilinearSlice::floor(input.y);
+            // The fractions times 2^11 are exact in float, so the weights do not
+            // depend on how each backend rounds or contracts float operations
+            const int wx = static_cast<int>((input.x - static_cast<float>(x1)) * static_cast<float>(COEF_ONE) + 0.5f);
+            const int wy = static_cast<int>((input.y - static_cast<float>(y1)) * static_cast<float>(COEF_ONE) + 0.5f);
+
+            // The four weights are computed once and shared by all the channels
+            const Slice2x2<AccType> weights{ static_cast<AccType>((COEF_ONE - wx) * (COEF_ONE - wy)),
+                                             static_cast<AccType>(wx * (COEF_ONE - wy)),
+                                             static_cast<AccType>((COEF_ONE - wx) * wy),
+                                             static_cast<AccType>(wx * wy) };
+            const auto src = BilinearSlice::read(x1, y1, backIOp);
+            return blend(std::make_index_sequence<cn<OutputType>>{}, src, weights);
+        }
+
+    private:
+        // One multiply-add chain per channel, in the scalar type, which the
+        // compiler vectorizes across channels. The weights add up to 2^22, so the
+        // rounded result is in the range of the source type.
+        template <size_t Idx>
+        FK_HOST_DEVICE_FUSE VBase<OutputType> blendChannel(const Slice2x2<BackIOpOutputType>& src,
+                                                           const Slice2x2<AccType>& weights) {
+            const AccType sum = static_cast<AccType>(channel<Idx>(src._0x0)) * weights._0x0 +
+                                static_cast<AccType>(channel<Idx>(src._1x0)) * weights._1x0 +
+                                static_cast<AccType>(channel<Idx>(src._0x1)) * weights._0x1 +
+                                static_cast<AccType>(channel<Idx>(src._1x1)) * weights._1x1;
+            return static_cast<VBase<OutputType>>((sum + (AccType{1} << (2 * COEF_BITS - 1))) >> (2 * COEF_BITS));
+        }
+
+        template <size_t Idx>
+        FK_HOST_DEVICE_FUSE VBase<OutputType> channel(const BackIOpOutputType& pixel) {
+            if constexpr (vector_type<BackIOpOutputType>) {
+                return static_get<Idx>(pixel);
+            } else {
+                return pixel;
+            }
+        }
+
+        template <size_t... Idx>
+        FK_HOST_DEVICE_FUSE OutputType blend(const std::index_sequence<Idx...>&, const Slice2x2<BackIOpOutputType>& src,
+                                             const Slice2x2<AccType>& weights) {
+            if constexpr (vector_type<OutputType>) {
+                return make_<OutputType>(blendChannel<Idx>(src, weights)...);
+            } else {
+                return blendChannel<0>(src, weights);
+            }
+        }
+    };
+
+    template <InterpolationType IT>
+    struct Interpolate {
     private:
-        using SelfType = Interpolate<InterpolationType::INTER_LINEAR>;
+        using SelfType = Interpolate<IT>;
     public:
         FK_STATIC_STRUCT(Interpolate, SelfType)
         using InputType = float2;
         using OutputType = NullType;
-        using ParamsType = InterpolationParameters<InterpolationType::INTER_LINEAR>;
+        using ParamsType = InterpolationParameters<IT>;
         using BackIOp = NullType;
         using InstanceType = TernaryType;
-        using OperationDataType = OperationData<Interpolate<InterpolationType::INTER_LINEAR>>;
+        using OperationDataType = OperationData<Interpolate<IT>>;
         using InstantiableType = Ternary<SelfType>;
         static constexpr bool IS_FUSED_OP = false;
 
@@ -135,7 +230,7 @@ namespace fk {
 
         template <typename NewBackIOp>
         FK_HOST_FUSE auto build(const NewBackIOp& newBackIOp) {
-            return InterpolateComplete<InterpolationType::INTER_LINEAR, NewBackIOp>::build(ParamsType{}, newBackIOp);
+            return InterpolateComplete<IT, NewBackIOp>::build(ParamsType{}, newBackIOp);
         }
     };
 } // namespace fk
@@ -263,6 +263,31 @@ namespace fk {
     // utests/algorithm/image_processing/utest_color_conversion.h
     template <ColorRange CR, ColorPrimitives CP, ColorConversionDir CCD, ColorDepth CD>
     constexpr M3x3Float ccMatrix = computeMatrix<CR, CP, CCD, CD>();
+
+    // --- Fixed point conversion ---
+    // Float computes the conversion in float (ConvertYUVToRGB, ConvertRGBToYUV). FixedPoint
+    // computes it with integer coefficients scaled by 2^ccFixedPointBits, the way hardware
+    // and software video decoders do (ConvertYUVToRGBFixedPoint, ConvertRGBToYUVFixedPoint).
+    // ColorConversion takes it as a parameter of its YUV codes.
+    enum class ColorArithmetic { Float, FixedPoint };
+
+    // 14 fractional bits keep the rounding error of the coefficients below 0.4 LSB for
+    // 12 bit pixels, and the products of 12 bit values by them inside 32 bit integers
+    constexpr int ccFixedPointBits = 14;
+
+    constexpr int toFixedPoint(const float value) {
+        const float scaled = value * static_cast<float>(1 << ccFixedPointBits);
+        return static_cast<int>(scaled < 0.f ? scaled - 0.5f : scaled + 0.5f);
+    }
+
+    constexpr int3 toFixedPoint(const float3& row) {
+        return { toFixedPoint(row.x), toFixedPoint(row.y), toFixedPoint(row.z) };
+    }
+
+    template <ColorRange CR, ColorPrimitives CP, ColorConversionDir CCD, ColorDepth CD>
+    constexpr M3x3Int ccMatrixFixedPoint{ toFixedPoint(ccMatrix<CR, CP, CCD, CD>.x),
+                                          toFixedPoint(ccMatrix<CR, CP, CCD, CD>.y),
+                                          toFixedPoint(ccMatrix<CR, CP, CCD, CD>.z) };
 } // namespace fk
 
 #endif
\ No newline at end of file
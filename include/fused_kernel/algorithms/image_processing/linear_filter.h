@@ -92,8 +92,6 @@ struct LinearFilterDPP<ParArch::CPU, DPPDetails> {
 private:
     using SelfType = LinearFilterDPP<ParArch::CPU, DPPDetails>;
     using T = typename DPPDetails::ValueType;
-    using Stage = NeighborhoodDPPStage<
-        typename DPPDetails::NeighborhoodPolicy>;
 
 public:
     FK_STATIC_STRUCT(LinearFilterDPP, SelfType)
@@ -117,28 +115,31 @@ public:
         if (!DPPDetails::valid(details)) return;
         const auto& image = get<0>(reads);
         const auto& coefficients = get<1>(reads);
-        for (int oy = 0; oy < details.height; ++oy) {
-            for (int ox = 0; ox < details.width; ++ox) {
-                T accumulator{};
-                for (int ky = 0; ky < details.kernelHeight; ++ky) {
-                    for (int kx = 0; kx < details.kernelWidth; ++kx) {
-                        const T value = Stage::readReplicate(
-                            details.width, details.height, image,
-                            ox + kx - details.anchorX,
-                            oy + ky - details.anchorY);
-                        const T coefficient =
-                            std::decay_t<decltype(coefficients)>::Operation::exec(
-                                Point{kx, ky, 0}, coefficients);
-                        const T product =
-                            make_tuple(value, coefficient) | multiply;
-                        accumulator =
-                            make_tuple(accumulator, product) | accumulate;
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height,
+            details.kernelWidth, details.kernelHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int ox, const int oy, const auto inside) {
+            T accumulator{};
+            for (int ky = 0; ky < details.kernelHeight; ++ky) {
+                for (int kx = 0; kx < details.kernelWidth; ++kx) {
+                    const T value = NeighborhoodRead::at(
+                        inside, image, details.width, details.height,
+                        ox + kx - details.anchorX,
+                        oy + ky - details.anchorY);
+                    const T coefficient =
+                        std::decay_t<decltype(coefficients)>::Operation::exec(
+                            Point{kx, ky, 0}, coefficients);
+                    const T product =
+                        make_tuple(value, coefficient) | multiply;
+                    accumulator =
+                        make_tuple(accumulator, product) | accumulate;
                 }
-                WriteIOp::Operation::exec(Point{ox, oy, 0},
-                                          accumulator, output);
             }
-        }
+            WriteIOp::Operation::exec(Point{ox, oy, 0},
+                                      accumulator, output);
+        });
     }
 };
 
@@ -184,7 +185,7 @@ public:
         const int tileX = blockIdx.x * DPPDetails::TILE_WIDTH;
         const int tileY = blockIdx.y * DPPDetails::TILE_HEIGHT;
 
-        Stage::stageReplicate(
+        Stage::stageBordered(
             details.width, details.height,
             details.kernelWidth, details.kernelHeight,
             details.anchorX, details.anchorY, image, halo);
@@ -15,6 +15,7 @@
 #ifndef FK_MEDIAN_FAST_H
 #define FK_MEDIAN_FAST_H
 
+#include <fused_kernel/algorithms/image_processing/neighborhood.h>
 #include <fused_kernel/core/execution_model/operation_model/operation_model.h>
 #include <fused_kernel/core/execution_model/parallel_architectures.h>
 #include <fused_kernel/core/execution_model/stream.h>
@@ -187,10 +188,6 @@ struct MedianQuadDPP<ParArch::CPU, T, EX, EY, KW, KH> {
 private:
     using SelfType = MedianQuadDPP<ParArch::CPU, T, EX, EY, KW, KH>;
 
-    FK_HOST_FUSE int clamp(const int value, const int upper) {
-        return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-    }
-
 public:
     FK_STATIC_STRUCT(MedianQuadDPP, SelfType)
     static constexpr ParArch PAR_ARCH = ParArch::CPU;
@@ -226,28 +223,28 @@ public:
 
         const int kernelWidth = KW > 0 ? KW : details.kernelWidth;
         const int kernelHeight = KH > 0 ? KH : details.kernelHeight;
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
-
-        for (int y = 0; y < details.height; ++y) {
-            for (int x = 0; x < details.width; ++x) {
-                T values[FK_MEDIAN_SORT_SIZE];
-                int count = 0;
-                for (int ky = 0; ky < kernelHeight; ++ky) {
-                    for (int kx = 0; kx < kernelWidth; ++kx) {
-                        values[count++] = source(
-                            x + kx - details.anchorX,
-                            y + ky - details.anchorY);
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height, kernelWidth, kernelHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int x, const int y, const auto inside) {
+            auto source = [&](const int sx, const int sy) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, sx, sy);
+            };
+            T values[FK_MEDIAN_SORT_SIZE];
+            int count = 0;
+            for (int ky = 0; ky < kernelHeight; ++ky) {
+                for (int kx = 0; kx < kernelWidth; ++kx) {
+                    values[count++] = source(
+                        x + kx - details.anchorX,
+                        y + ky - details.anchorY);
                 }
-                const T value = median_detail::median(
-                    values, count, kernelWidth, kernelHeight, compute);
-                OutIOp::Operation::exec(Point{x, y, 0}, value, output);
             }
-        }
+            const T value = median_detail::median(
+                values, count, kernelWidth, kernelHeight, compute);
+            OutIOp::Operation::exec(Point{x, y, 0}, value, output);
+        });
     }
 };
 
@@ -315,36 +312,44 @@ public:
         const int y0 = (workItem / columns) * EY;
         if (x0 >= details.width || y0 >= details.height) return;
 
-        auto clamp = [](const int value, const int upper) {
-            return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-        };
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
+        // Whole tiles are interior or frame, so the branch is warp uniform
+        // except along the frame, and interior tiles read without border handling
+        const auto tile = [&](const auto inside) {
+            auto source = [&](const int x, const int y) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, x, y);
+            };
 
-        #pragma unroll
-        for (int localY = 0; localY < EY; ++localY) {
-            const int y = y0 + localY;
-            if (y >= details.height) break;
             #pragma unroll
-            for (int localX = 0; localX < EX; ++localX) {
-                const int x = x0 + localX;
-                if (x >= details.width) break;
-                T values[FK_MEDIAN_SORT_SIZE];
-                int count = 0;
-                for (int ky = 0; ky < kernelHeight; ++ky) {
-                    for (int kx = 0; kx < kernelWidth; ++kx) {
-                        values[count++] = source(
-                            x + kx - details.anchorX,
-                            y + ky - details.anchorY);
+            for (int localY = 0; localY < EY; ++localY) {
+                const int y = y0 + localY;
+                if (y >= details.height) break;
+                #pragma unroll
+                for (int localX = 0; localX < EX; ++localX) {
+                    const int x = x0 + localX;
+                    if (x >= details.width) break;
+                    T values[FK_MEDIAN_SORT_SIZE];
+                    int count = 0;
+                    for (int ky = 0; ky < kernelHeight; ++ky) {
+                        for (int kx = 0; kx < kernelWidth; ++kx) {
+                            values[count++] = source(
+                                x + kx - details.anchorX,
+                                y + ky - details.anchorY);
+                        }
                     }
+                    const T value = median_detail::median(
+                        values, count, kernelWidth, kernelHeight, compute);
+                    OutIOp::Operation::exec(Point{x, y, 0}, value, output);
                 }
-                const T value = median_detail::median(
-                    values, count, kernelWidth, kernelHeight, compute);
-                OutIOp::Operation::exec(Point{x, y, 0}, value, output);
             }
+        };
+        if (NeighborhoodInterior::of(details.width, details.height,
+                                     kernelWidth, kernelHeight,
+                                     details.anchorX, details.anchorY)
+                .contains(x0, y0, EX, EY)) {
+            tile(std::true_type{});
+        } else {
+            tile(std::false_type{});
         }
 #endif // defined(__CUDA_ARCH__)
     }
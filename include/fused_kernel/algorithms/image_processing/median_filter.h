@@ -127,8 +127,6 @@ struct MedianFilterDPP<ParArch::CPU, DPPDetails> {
 private:
     using SelfType = MedianFilterDPP<ParArch::CPU, DPPDetails>;
     using T = typename DPPDetails::ValueType;
-    using Stage = NeighborhoodDPPStage<
-        typename DPPDetails::NeighborhoodPolicy>;
     using Window = NeighborhoodWindow<T, DPPDetails::WINDOW_CAPACITY>;
 
 public:
@@ -154,22 +152,25 @@ public:
                       "Selection output must match the image value type");
         if (!DPPDetails::valid(details)) return;
 
-        for (int oy = 0; oy < details.height; ++oy) {
-            for (int ox = 0; ox < details.width; ++ox) {
-                Window window{};
-                for (int wy = 0; wy < details.windowHeight; ++wy) {
-                    for (int wx = 0; wx < details.windowWidth; ++wx) {
-                        window.values[window.count++] = Stage::readReplicate(
-                            details.width, details.height, input,
-                            ox + wx - details.anchorX,
-                            oy + wy - details.anchorY);
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height,
+            details.windowWidth, details.windowHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int ox, const int oy, const auto inside) {
+            Window window{};
+            for (int wy = 0; wy < details.windowHeight; ++wy) {
+                for (int wx = 0; wx < details.windowWidth; ++wx) {
+                    window.values[window.count++] = NeighborhoodRead::at(
+                        inside, input, details.width, details.height,
+                        ox + wx - details.anchorX,
+                        oy + wy - details.anchorY);
                 }
-                const T selected = window | selection;
-                WriteIOp::Operation::exec(
-                    Point{ox, oy, 0}, selected, output);
             }
-        }
+            const T selected = window | selection;
+            WriteIOp::Operation::exec(
+                Point{ox, oy, 0}, selected, output);
+        });
     }
 };
 
@@ -207,7 +208,7 @@ public:
 
         __shared__ T halo[DPPDetails::MAX_HALO_WIDTH *
                           DPPDetails::MAX_HALO_HEIGHT];
-        Stage::stageReplicate(
+        Stage::stageBordered(
             details.width, details.height,
             details.windowWidth, details.windowHeight,
             details.anchorX, details.anchorY, input, halo);
@@ -15,6 +15,7 @@
 #ifndef FK_MORPHOLOGY_FAST_H
 #define FK_MORPHOLOGY_FAST_H
 
+#include <fused_kernel/algorithms/image_processing/neighborhood.h>
 #include <fused_kernel/core/execution_model/operation_model/operation_model.h>
 #include <fused_kernel/core/execution_model/parallel_architectures.h>
 #include <fused_kernel/core/execution_model/stream.h>
@@ -58,10 +59,6 @@ struct MorphQuadDPP<ParArch::CPU, T, EX, EY, KW, KH> {
 private:
     using SelfType = MorphQuadDPP<ParArch::CPU, T, EX, EY, KW, KH>;
 
-    FK_HOST_FUSE int clamp(const int value, const int upper) {
-        return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-    }
-
 public:
     FK_STATIC_STRUCT(MorphQuadDPP, SelfType)
     static constexpr ParArch PAR_ARCH = ParArch::CPU;
@@ -99,28 +96,28 @@ public:
 
         const int kernelWidth = KW > 0 ? KW : details.kernelWidth;
         const int kernelHeight = KH > 0 ? KH : details.kernelHeight;
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
-
-        for (int y = 0; y < details.height; ++y) {
-            for (int x = 0; x < details.width; ++x) {
-                T value = source(x - details.anchorX,
-                                 y - details.anchorY);
-                for (int ky = 0; ky < kernelHeight; ++ky) {
-                    for (int kx = 0; kx < kernelWidth; ++kx) {
-                        if (kx == 0 && ky == 0) continue;
-                        value = make_tuple(
-                            value,
-                            source(x + kx - details.anchorX,
-                                   y + ky - details.anchorY)) | reduce;
-                    }
+        const auto interior = NeighborhoodInterior::of(
+            details.width, details.height, kernelWidth, kernelHeight,
+            details.anchorX, details.anchorY);
+        interior.forEach(details.width, details.height,
+                         [&](const int x, const int y, const auto inside) {
+            auto source = [&](const int sx, const int sy) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, sx, sy);
+            };
+            T value = source(x - details.anchorX,
+                             y - details.anchorY);
+            for (int ky = 0; ky < kernelHeight; ++ky) {
+                for (int kx = 0; kx < kernelWidth; ++kx) {
+                    if (kx == 0 && ky == 0) continue;
+                    value = make_tuple(
+                        value,
+                        source(x + kx - details.anchorX,
+                               y + ky - details.anchorY)) | reduce;
                 }
-                OutIOp::Operation::exec(Point{x, y, 0}, value, output);
             }
-        }
+            OutIOp::Operation::exec(Point{x, y, 0}, value, output);
+        });
     }
 };
 
@@ -197,44 +194,52 @@ public:
         const int span = EX + kernelWidth - 1;
         if (span > MAX_SPAN) return;
         const int firstColumn = x0 - details.anchorX;
-        auto clamp = [](const int value, const int upper) {
-            return value < 0 ? 0 : (value >= upper ? upper - 1 : value);
-        };
-        auto source = [&](const int x, const int y) {
-            return InIOp::Operation::exec(
-                Point{clamp(x, details.width),
-                      clamp(y, details.height), 0}, input);
-        };
+        // Whole tiles are interior or frame, so the branch is warp uniform
+        // except along the frame, and interior tiles read without border handling
+        const auto tile = [&](const auto inside) {
+            auto source = [&](const int x, const int y) {
+                return NeighborhoodRead::at(inside, input, details.width,
+                                            details.height, x, y);
+            };
 
-        #pragma unroll
-        for (int localY = 0; localY < EY; ++localY) {
-            const int y = y0 + localY;
-            if (y >= details.height) break;
-            T columnsReduced[MAX_SPAN];
             #pragma unroll
-            for (int index = 0; index < span; ++index) {
-                T value = source(firstColumn + index,
-                                 y - details.anchorY);
-                for (int ky = 1; ky < kernelHeight; ++ky) {
-                    value = make_tuple(
-                        value,
-                        source(firstColumn + index,
-                               y + ky - details.anchorY)) | reduce;
+            for (int localY = 0; localY < EY; ++localY) {
+                const int y = y0 + localY;
+                if (y >= details.height) break;
+                T columnsReduced[MAX_SPAN];
+                #pragma unroll
+                for (int index = 0; index < span; ++index) {
+                    T value = source(firstColumn + index,
+                                     y - details.anchorY);
+                    for (int ky = 1; ky < kernelHeight; ++ky) {
+                        value = make_tuple(
+                            value,
+                            source(firstColumn + index,
+                                   y + ky - details.anchorY)) | reduce;
+                    }
+                    columnsReduced[index] = value;
                 }
-                columnsReduced[index] = value;
-            }
 
-            #pragma unroll
-            for (int localX = 0; localX < EX; ++localX) {
-                const int x = x0 + localX;
-                if (x >= details.width) break;
-                T value = columnsReduced[localX];
-                for (int kx = 1; kx < kernelWidth; ++kx) {
-                    value = make_tuple(
-                        value, columnsReduced[localX + kx]) | reduce;
+                #pragma unroll
+                for (int localX = 0; localX < EX; ++localX) {
+                    const int x = x0 + localX;
+                    if (x >= details.width) break;
+                    T value = columnsReduced[localX];
+                    for (int kx = 1; kx < kernelWidth; ++kx) {
+                        value = make_tuple(
+                            value, columnsReduced[localX + kx]) | reduce;
+                    }
+                    OutIOp::Operation::exec(Point{x, y, 0}, value, output);
                 }
-                OutIOp::Operation::exec(Point{x, y, 0}, value, output);
             }
+        };
+        if (NeighborhoodInterior::of(details.width, details.height,
+                                     kernelWidth, kernelHeight,
+                                     details.anchorX, details.anchorY)
+                .contains(x0, y0, EX, EY)) {
+            tile(std::true_type{});
+        } else {
+            tile(std::false_type{});
         }
 #endif // defined(__CUDA_ARCH__)
     }
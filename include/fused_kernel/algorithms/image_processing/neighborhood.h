@@ -15,11 +15,106 @@
 #ifndef FK_NEIGHBORHOOD_DPP_H
 #define FK_NEIGHBORHOOD_DPP_H
 
+#include <fused_kernel/algorithms/image_processing/border_reader.h>
 #include <fused_kernel/core/data/point.h>
 #include <fused_kernel/core/utils/utils.h>
 
+#include <type_traits>
+
 namespace fk {
 
+// Outputs [x0, x1) x [y0, y1) whose whole window is inside the image. Their
+// reads need no border handling, only the frame around them does.
+struct NeighborhoodInterior {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+
+    FK_HOST_DEVICE_FUSE NeighborhoodInterior of(const int width, const int height,
+                                                const int windowWidth, const int windowHeight,
+                                                const int anchorX, const int anchorY) {
+        // Clamped to the image, so that the frame loops never visit outputs outside of it
+        // when the window is larger than the image on one axis only
+        const int x0 = clampTo(anchorX, 0, width);
+        const int y0 = clampTo(anchorY, 0, height);
+        return {x0, y0, clampTo(width - windowWidth + anchorX + 1, x0, width),
+                clampTo(height - windowHeight + anchorY + 1, y0, height)};
+    }
+
+    FK_HOST_DEVICE_FUSE int clampTo(const int value, const int low, const int high) {
+        return value < low ? low : (value > high ? high : value);
+    }
+
+    // Every output of the w x h block at (x, y) is interior
+    FK_HOST_DEVICE_CNST bool contains(const int x, const int y,
+                                      const int w = 1, const int h = 1) const {
+        return x >= x0 && y >= y0 && x + w <= x1 && y + h <= y1;
+    }
+
+    // Calls body(x, y, std::true_type{}) for the interior outputs and
+    // body(x, y, std::false_type{}) for the frame, in row major order
+    template <typename Body>
+    FK_HOST_CNST void forEach(const int width, const int height, const Body& body) const {
+        for (int y = 0; y < height; ++y) {
+            if (y < y0 || y >= y1) {
+                for (int x = 0; x < width; ++x) body(x, y, std::false_type{});
+                continue;
+            }
+            for (int x = 0; x < x0; ++x) body(x, y, std::false_type{});
+            for (int x = x0; x < x1; ++x) body(x, y, std::true_type{});
+            for (int x = x1; x < width; ++x) body(x, y, std::false_type{});
+        }
+    }
+};
+
+struct NeighborhoodRead {
+    FK_STATIC_STRUCT(NeighborhoodRead, NeighborhoodRead)
+
+    // Coordinates known to be inside the image, read without clamping. A
+    // BorderReader is bypassed, its BackIOp gives the same value there
+    template <typename ReadIOp>
+    FK_HOST_DEVICE_FUSE auto interior(const ReadIOp& input, const int x, const int y) {
+        if constexpr (isCompleteBorderReader<ReadIOp>) {
+            using BackIOp = typename ReadIOp::Operation::BackIOp;
+            return BackIOp::Operation::exec(Point{x, y, 0}, input.backIOp);
+        } else {
+            return ReadIOp::Operation::exec(Point{x, y, 0}, input);
+        }
+    }
+
+    template <typename ReadIOp>
+    FK_HOST_DEVICE_FUSE auto replicate(const ReadIOp& input, const int width, const int height,
+                                       int x, int y) {
+        x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+        y = y < 0 ? 0 : (y >= height ? height - 1 : y);
+        return ReadIOp::Operation::exec(Point{x, y, 0}, input);
+    }
+
+    // Coordinates that may be outside the image. A BorderReader gets them as they
+    // are, so that its BorderType applies, any other reader gets them replicated
+    template <typename ReadIOp>
+    FK_HOST_DEVICE_FUSE auto frame(const ReadIOp& input, const int width, const int height,
+                                   const int x, const int y) {
+        if constexpr (isCompleteBorderReader<ReadIOp>) {
+            return ReadIOp::Operation::exec(Point{x, y, 0}, input);
+        } else {
+            return replicate(input, width, height, x, y);
+        }
+    }
+
+    // interior() or frame(), chosen at compile time by the tag of NeighborhoodInterior::forEach
+    template <bool INTERIOR, typename ReadIOp>
+    FK_HOST_DEVICE_FUSE auto at(const std::bool_constant<INTERIOR>, const ReadIOp& input,
+                                const int width, const int height, const int x, const int y) {
+        if constexpr (INTERIOR) {
+            return interior(input, x, y);
+        } else {
+            return frame(input, width, height, x, y);
+        }
+    }
+};
+
 template <typename T, int TILE_W, int TILE_H,
           int MAX_WINDOW_W, int MAX_WINDOW_H>
 struct NeighborhoodDPPPolicy {
@@ -63,25 +158,23 @@ public:
     }
 
     template <typename ReadIOp>
-    FK_HOST_DEVICE_STATIC T readReplicate(const int width,
-                                          const int height,
-                                          const ReadIOp& input,
-                                          int x, int y) {
-        x = x < 0 ? 0 : (x >= width ? width - 1 : x);
-        y = y < 0 ? 0 : (y >= height ? height - 1 : y);
-        return ReadIOp::Operation::exec(Point{x, y, 0}, input);
+    FK_HOST_DEVICE_STATIC T readBordered(const int width,
+                                         const int height,
+                                         const ReadIOp& input,
+                                         int x, int y) {
+        return NeighborhoodRead::frame(input, width, height, x, y);
     }
 
 #if defined(__NVCC__)
     template <typename ReadIOp>
-    FK_DEVICE_STATIC void stageReplicate(const int width,
-                                         const int height,
-                                         const int windowWidth,
-                                         const int windowHeight,
-                                         const int anchorX,
-                                         const int anchorY,
-                                         const ReadIOp& input,
-                                         T* halo) {
+    FK_DEVICE_STATIC void stageBordered(const int width,
+                                        const int height,
+                                        const int windowWidth,
+                                        const int windowHeight,
+                                        const int anchorX,
+                                        const int anchorY,
+                                        const ReadIOp& input,
+                                        T* halo) {
         const int haloWidth = Policy::TILE_WIDTH + windowWidth - 1;
         const int haloHeight = Policy::TILE_HEIGHT + windowHeight - 1;
         const int tileX = blockIdx.x * Policy::TILE_WIDTH;
@@ -90,11 +183,22 @@ public:
         const int originY = tileY - anchorY;
         const int tid = threadIdx.y * blockDim.x + threadIdx.x;
         const int threads = blockDim.x * blockDim.y;
+        // Block uniform: only the tiles of the frame go through border handling
+        if (originX >= 0 && originY >= 0 &&
+            originX + haloWidth <= width && originY + haloHeight <= height) {
+            for (int index = tid; index < haloWidth * haloHeight;
+                 index += threads) {
+                halo[index] = NeighborhoodRead::interior(
+                    input, originX + index % haloWidth,
+                    originY + index / haloWidth);
+            }
+            return;
+        }
         for (int index = tid; index < haloWidth * haloHeight;
              index += threads) {
             const int y = index / haloWidth;
             const int x = index % haloWidth;
-            halo[index] = readReplicate(
+            halo[index] = readBordered(
                 width, height, input, originX + x, originY + y);
         }
     }
@@ -0,0 +1,270 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_REMAP
+#define FK_REMAP
+
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/operation_model/operation_model.h>
+#include <fused_kernel/algorithms/image_processing/interpolation.h>
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/algorithms/image_processing/warping.h>
+
+#include <climits>
+#include <stdexcept>
+
+/*
+Remap: a ReadBack operation that reads, for each output pixel, the source
+coordinate from a precomputed map, and interpolates the source there.
+
+Warping and Resize compute the source coordinate of every pixel, a
+perspective Warping including a division, in every launch. When the
+geometry does not change between frames, RemapTable::bake() evaluates it
+once into a map with the output size, and the per pixel work becomes one
+map load plus the interpolation.
+
+Maps are either float2, or short2 fixed-point coordinates with
+RemapParams::mapScale = 2^-fractionalBits, half the bytes per pixel. The
+baker picks the most fractional bits the source size allows (4 for a
+1920 pixels wide source). Coordinates outside the source are stored as
+negative values, and produce the default value: 0 for Warping, the
+background value for Resize with aspect ratio preservation.
+
+    Ptr2D<short2> map;
+    const auto warp = PerThreadRead<ND::_2D, uchar3>::build(frame).then(Warping<WarpType::Perspective>::build(params));
+    const auto remap = RemapTable::bake(warp, map, stream);
+    // every frame
+    executeOperations<TransformDPP<>>(stream, PerThreadRead<ND::_2D, uchar3>::build(frame), remap, write);
+
+The map is owned by the caller and must outlive the launches that use it.
+*/
+
+namespace fk {
+    template <typename MapT, typename DefaultType>
+    struct RemapParams {
+        RawPtr<ND::_2D, MapT> map;
+        float mapScale; // 1 for float2 maps, 2^-fractionalBits for short2 maps
+        DefaultType defaultValue;
+    };
+
+    template <typename MapT, typename BackIOp_>
+    struct RemapComplete {
+        static_assert(isAnyCompleteReadType<BackIOp_>, "BackIOp must be a complete type for this specialization");
+        static_assert(std::is_same_v<MapT, float2> || std::is_same_v<MapT, short2>,
+                      "Remap maps are either float2 or short2 fixed-point");
+    private:
+        using SelfType = RemapComplete<MapT, BackIOp_>;
+        using DefaultType = float_<cn<typename BackIOp_::Operation::ReadDataType>>;
+    public:
+        FK_STATIC_STRUCT(RemapComplete, SelfType)
+        using Parent = ReadBackOperation<typename BackIOp_::Operation::ReadDataType,
+                                         RemapParams<MapT, DefaultType>,
+                                         BackIOp_,
+                                         DefaultType,
+                                         SelfType>;
+        DECLARE_READBACK_PARENT
+        FK_HOST_DEVICE_FUSE OutputType exec(const Point thread, const ParamsType& params, const BackIOp& backIOp) {
+            const MapT entry = *PtrAccessor<ND::_2D>::cr_point(thread, params.map);
+            float2 coord;
+            if constexpr (std::is_same_v<MapT, float2>) {
+                coord = entry;
+            } else {
+                coord = make_<float2>(entry.x * params.mapScale, entry.y * params.mapScale);
+            }
+            const Size sourceSize(BackIOp::Operation::num_elems_x(thread, backIOp),
+                                  BackIOp::Operation::num_elems_y(thread, backIOp));
+            if ((coord.x >= 0.f && coord.x < sourceSize.width) && (coord.y >= 0.f && coord.y < sourceSize.height)) {
+                return InterpolateComplete<InterpolationType::INTER_LINEAR, BackIOp_>::exec(coord, {}, backIOp);
+            } else {
+                return params.defaultValue;
+            }
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point, const OperationDataType& opData) {
+            return opData.params.map.dims.width;
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_y(const Point, const OperationDataType& opData) {
+            return opData.params.map.dims.height;
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_z(const Point, const OperationDataType&) {
+            return 1;
+        }
+
+        FK_HOST_DEVICE_FUSE ActiveThreads getActiveThreads(const OperationDataType& opData) {
+            return { num_elems_x(Point{0,0,0}, opData), num_elems_y(Point{0,0,0}, opData), num_elems_z(Point{0,0,0}, opData) };
+        }
+    };
+
+    template <typename MapT = float2, typename DefaultType = NullType>
+    struct Remap {
+    private:
+        using SelfType = Remap<MapT, DefaultType>;
+    public:
+        FK_STATIC_STRUCT(Remap, SelfType)
+        using Parent = IncompleteReadBackOperation<NullType,
+                                                   RemapParams<MapT, DefaultType>,
+                                                   NullType,
+                                                   NullType,
+                                                   SelfType>;
+        DECLARE_INCOMPLETEREADBACK_PARENT
+
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point, const OperationDataType& opData) {
+            return opData.params.map.dims.width;
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_y(const Point, const OperationDataType& opData) {
+            return opData.params.map.dims.height;
+        }
+
+        FK_HOST_DEVICE_FUSE uint num_elems_z(const Point, const OperationDataType&) {
+            return 1;
+        }
+
+        FK_HOST_FUSE auto build(const ParamsType& params) {
+            return InstantiableType{ {params, {}} };
+        }
+
+        template <typename DefaultType_>
+        FK_HOST_FUSE auto build(const RawPtr<ND::_2D, MapT>& map, const float mapScale, const DefaultType_& defaultValue) {
+            return Remap<MapT, DefaultType_>::build(RemapParams<MapT, DefaultType_>{ map, mapScale, defaultValue });
+        }
+
+        template <typename BackIOp>
+        FK_HOST_FUSE auto build(const BackIOp& backIOp, const InstantiableType& iOp) {
+            static_assert(isCompleteOperation<BackIOp>, "BackIOp must be a complete IOp");
+            static_assert(std::is_same_v<float_<cn<typename BackIOp::Operation::ReadDataType>>, DefaultType>,
+                          "Default value type and the interpolated source type must be the same.");
+            return ReadBack<RemapComplete<MapT, BackIOp>>{ {iOp.params, backIOp} };
+        }
+    };
+
+    struct RemapTable {
+        FK_STATIC_STRUCT(RemapTable, RemapTable)
+
+        // Bakes the source coordinates of a Warping into map, and returns the Remap IOp reading it
+        template <typename MapT, WarpType WT, typename BackIOp, typename StreamType>
+        FK_HOST_FUSE auto bake(const ReadBack<Warping<WT, BackIOp>>& iOp, Ptr2D<MapT>& map, StreamType& stream) {
+            using DefaultType = typename Warping<WT, BackIOp>::OutputType;
+            const Size srcSize = NumElems::size(Point{ 0, 0, 0 }, iOp.backIOp);
+            const auto& params = iOp.params;
+            const float mapScale = fill(params.dstSize, srcSize, map, stream, [&params, &srcSize](const Point thread) {
+                const float2 coord = WarpingCoords<WT>::exec(thread, params);
+                return inside(coord, srcSize) ? coord : make_<float2>(-1.f, -1.f);
+            });
+            return Remap<MapT>::build(map.ptr(), mapScale, make_set<DefaultType>(0.f));
+        }
+
+        // Bakes the source coordinates of a Resize into map, and returns the Remap IOp reading it.
+        // Remap interpolates with INTER_LINEAR, so only INTER_LINEAR Resizes can be baked.
+        template <typename MapT, AspectRatio AR, typename BackIOp, typename StreamType>
+        FK_HOST_FUSE auto bake(const ReadBack<ResizeComplete<AR, BackIOp>>& iOp, Ptr2D<MapT>& map, StreamType& stream) {
+            static_assert(std::is_same_v<typename BackIOp::Operation,
+                                         InterpolateComplete<InterpolationType::INTER_LINEAR, typename BackIOp::Operation::BackIOp>>,
+                          "RemapTable: only INTER_LINEAR Resizes can be baked into a Remap");
+            using DefaultType = typename ResizeComplete<AR, BackIOp>::OutputType;
+            const Size srcSize = NumElems::size(Point{ 0, 0, 0 }, iOp.backIOp);
+            const auto& params = iOp.params;
+            const float mapScale = fill(params.dstSize, srcSize, map, stream, [&params, &srcSize](const Point thread) {
+                Point resized = thread;
+                if constexpr (AR != AspectRatio::IGNORE_AR) {
+                    if (thread.x < params.x1 || thread.x > params.x2 || thread.y < params.y1 || thread.y > params.y2) {
+                        return make_<float2>(-1.f, -1.f);
+                    }
+                    resized = Point{ thread.x - params.x1, thread.y - params.y1, 0 };
+                }
+                const float2 coord = make_<float2>(resized.x * params.src_conv_factors.x,
+                                                   resized.y * params.src_conv_factors.y);
+                return inside(coord, srcSize) ? coord : make_<float2>(-1.f, -1.f);
+            });
+            if constexpr (AR == AspectRatio::IGNORE_AR) {
+                return Remap<MapT>::build(map.ptr(), mapScale, make_set<DefaultType>(0.f));
+            } else {
+                return Remap<MapT>::build(map.ptr(), mapScale, params.defaultValue);
+            }
+        }
+
+        // Number of fractional bits of a short2 map for a source of this size
+        FK_HOST_FUSE int fractionalBits(const Size& srcSize) {
+            const int side = cxp::max::f(srcSize.width, srcSize.height);
+            if (side > 32768) {
+                throw std::invalid_argument("RemapTable: short2 maps support sources up to 32768 pixels per side");
+            }
+            int bits = 0;
+            while (bits < 15 && (side << (bits + 1)) <= 32768) {
+                ++bits;
+            }
+            return bits;
+        }
+
+    private:
+        FK_HOST_FUSE bool inside(const float2& coord, const Size& srcSize) {
+            return coord.x >= 0.f && coord.x < srcSize.width && coord.y >= 0.f && coord.y < srcSize.height;
+        }
+
+        // Writes coordOf(thread) for every pixel of a dstSize map, reallocating it if the size
+        // differs, uploads it, and returns the mapScale of the map
+        template <typename MapT, typename StreamType, typename CoordFunc>
+        FK_HOST_FUSE float fill(const Size& dstSize, const Size& srcSize, Ptr2D<MapT>& map,
+                                StreamType& stream, const CoordFunc& coordOf) {
+            // A CPU launch reads map.ptr() directly, so the map must live in host
+            // memory, whatever defaultMemType is in this translation unit
+            constexpr bool CPU_STREAM = StreamType::parArch() == ParArch::CPU;
+            if (map.dims().width != static_cast<uint>(dstSize.width) || map.dims().height != static_cast<uint>(dstSize.height)) {
+                const MemType type = map.dims().width != 0 ? map.getMemType() :
+                                     (CPU_STREAM ? MemType::Host : defaultMemType);
+                map = Ptr2D<MapT>(dstSize.width, dstSize.height, 0, type, map.getDeviceID());
+            }
+            if constexpr (CPU_STREAM) {
+                if (map.getMemType() != MemType::Host && map.getMemType() != MemType::HostPinned) {
+                    throw std::invalid_argument("RemapTable: the map must be in host memory for CPU streams");
+                }
+            } else if (map.getMemType() == MemType::Device) {
+                throw std::invalid_argument("RemapTable: the map must be host accessible, use MemType::DeviceAndPinned on GPUs");
+            }
+            const RawPtr<ND::_2D, MapT> host = map.getMemType() == MemType::DeviceAndPinned ? map.ptrPinned() : map.ptr();
+            float mapScale = 1.f;
+            int bits = 0;
+            if constexpr (std::is_same_v<MapT, short2>) {
+                bits = fractionalBits(srcSize);
+                mapScale = 1.f / static_cast<float>(1 << bits);
+            }
+            for (int y = 0; y < dstSize.height; ++y) {
+                for (int x = 0; x < dstSize.width; ++x) {
+                    const Point thread{ x, y, 0 };
+                    const float2 coord = coordOf(thread);
+                    if constexpr (std::is_same_v<MapT, float2>) {
+                        *PtrAccessor<ND::_2D>::point(thread, host) = coord;
+                    } else if (coord.x < 0.f) {
+                        *PtrAccessor<ND::_2D>::point(thread, host) = make_<short2>(SHRT_MIN, SHRT_MIN);
+                    } else {
+                        // Rounding must not take an inside coordinate to the source border
+                        const int maxX = (srcSize.width << bits) - 1;
+                        const int maxY = (srcSize.height << bits) - 1;
+                        const int fx = cxp::min::f(static_cast<int>(cxp::round::f(coord.x * (1 << bits))), maxX);
+                        const int fy = cxp::min::f(static_cast<int>(cxp::round::f(coord.y * (1 << bits))), maxY);
+                        *PtrAccessor<ND::_2D>::point(thread, host) =
+                            make_<short2>(static_cast<short>(fx), static_cast<short>(fy));
+                    }
+                }
+            }
+            if constexpr (!CPU_STREAM) {
+                map.upload(stream);
+            }
+            return mapScale;
+        }
+    };
+} // namespace fk
+#endif
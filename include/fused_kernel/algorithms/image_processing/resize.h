@@ -75,7 +75,8 @@ namespace fk {
         using SelfType = ResizeComplete<AR, BackIOp_>;
     public:
         FK_STATIC_STRUCT(ResizeComplete, SelfType)
-        using DefaultType = float_<cn<typename BackIOp_::Operation::OutputType>>;
+        // float_<cn> for INTER_LINEAR, the source pixel type for INTER_LINEAR_EXACT
+        using DefaultType = typename BackIOp_::Operation::OutputType;
         using Parent = ReadBackOperation<typename BackIOp_::Operation::OutputType,
                                          ResizeParams<AR, DefaultType>,
                                          BackIOp_,
@@ -137,6 +138,8 @@ namespace fk {
         DECLARE_INCOMPLETEREADBACK_PARENT
         template <typename BackIOp_>
         using NewInstantiableType = ResizeComplete<AR, Ternary<InterpolateComplete<IType, BackIOp_>>>;
+        template <typename BackIOp_>
+        using NewOutputType = typename InterpolateComplete<IType, BackIOp_>::OutputType;
 
         FK_HOST_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
             return opData.params.dstSize.width;
@@ -151,7 +154,7 @@ namespace fk {
         template <typename NewBackIOp>
         FK_HOST_FUSE auto build(const NewBackIOp& backIOp, const InstantiableType& iOp) {
             static_assert(isCompleteOperation<NewBackIOp>, "NewBackIOp must be a complete IOp");
-            using NewDefaultType = float_<cn<typename NewBackIOp::Operation::OutputType>>;
+            using NewDefaultType = NewOutputType<NewBackIOp>;
             static_assert(std::is_same_v<NewDefaultType, DefaultType>, "Default value type and Op::OutputType must be the same.");
             return build(backIOp, iOp.params.dstSize, iOp.params.defaultValue);
         }
@@ -163,7 +166,7 @@ namespace fk {
 
         template <typename NewBackIOp>
         FK_HOST_FUSE auto build(const NewBackIOp& backIOp, const Size& dstSize,
-                                const VectorType_t<float, cn<typename NewBackIOp::Operation::OutputType>>& backgroundValue) {
+                                const NewOutputType<NewBackIOp>& backgroundValue) {
             static_assert(isCompleteOperation<NewBackIOp>, "NewBackIOp must be a complete IOp");
             const Size srcSize = NumElems::size(Point{0,0,0}, backIOp);
             const Size targetSize = compute_target_size(srcSize, dstSize);
@@ -171,13 +174,13 @@ namespace fk {
             const double cfx = static_cast<double>(targetSize.width) / srcSize.width;
             const double cfy = static_cast<double>(targetSize.height) / srcSize.height;
 
-            using NewOutputType = float_<cn<typename NewBackIOp::Operation::OutputType>>;
+            using BackgroundType = NewOutputType<NewBackIOp>;
 
             if constexpr (AR == AspectRatio::PRESERVE_AR_LEFT) {
                 const int x1 = 0; // Always 0 to make sure the image is adjusted to the left
                 const int y1 = static_cast<int>((dstSize.height - targetSize.height) / 2);
 
-                const ResizeParams<AR, NewOutputType> resizeParams{
+                const ResizeParams<AR, BackgroundType> resizeParams{
                 dstSize,
                 { static_cast<float>(1.0 / cfx), static_cast<float>(1.0 / cfy) },
                 x1,
@@ -191,7 +194,7 @@ namespace fk {
                 const int x1 = static_cast<int>((dstSize.width - targetSize.width) / 2);
                 const int y1 = static_cast<int>((dstSize.height - targetSize.height) / 2);
 
-                const ResizeParams<AR, NewOutputType> resizeParams{
+                const ResizeParams<AR, BackgroundType> resizeParams{
                 dstSize,
                 { static_cast<float>(1.0 / cfx), static_cast<float>(1.0 / cfy) },
                 x1,
@@ -233,11 +236,11 @@ namespace fk {
         }
     };
 
-    template <>
-    struct Resize<InterpolationType::INTER_LINEAR, AspectRatio::IGNORE_AR, NullType> {
+    template <InterpolationType IT>
+    struct Resize<IT, AspectRatio::IGNORE_AR, NullType> {
     private:
-        using SelfType = Resize<InterpolationType::INTER_LINEAR, AspectRatio::IGNORE_AR>;
-        static constexpr InterpolationType IType{ InterpolationType::INTER_LINEAR };
+        using SelfType = Resize<IT, AspectRatio::IGNORE_AR>;
+        static constexpr InterpolationType IType{ IT };
     public:
         FK_STATIC_STRUCT(Resize, SelfType)
         using Parent = IncompleteReadBackOperation<NullType,
@@ -247,7 +250,7 @@ namespace fk {
                                                    SelfType>;
         DECLARE_INCOMPLETEREADBACK_PARENT
         template <typename NewBackIOp>
-        using NewInstantiableType = ResizeComplete<AspectRatio::IGNORE_AR, Ternary<InterpolateComplete<InterpolationType::INTER_LINEAR, NewBackIOp>>>;
+        using NewInstantiableType = ResizeComplete<AspectRatio::IGNORE_AR, Ternary<InterpolateComplete<IT, NewBackIOp>>>;
 
         FK_HOST_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
             return opData.params.dstSize.width;
@@ -0,0 +1,345 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_SEPARABLE_RESIZE_H
+#define FK_SEPARABLE_RESIZE_H
+
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/core/execution_model/parallel_architectures.h>
+#include <fused_kernel/core/execution_model/stream.h>
+#include <fused_kernel/core/utils/vector_utils.h>
+
+#include <algorithm>
+#include <vector>
+
+/*
+SeparableResizeDPP: resize as a horizontal pass followed by a vertical pass.
+
+The Resize ReadBack gathers 4 source pixels per output pixel, so a large
+downscale skips most of the source (aliasing), and the CPU reads the same
+source rows again for every output row. SeparableResizeDPP computes the
+weights of each axis independently, either bilinear (LINEAR, same
+coordinates as Resize) or box averaging of the covered source pixels
+(AREA). AUTO uses AREA on the axes downscaled by 2 or more.
+
+On CPU each source row goes through the horizontal pass once, into a ring
+of cached rows as large as the vertical taps, and every output row
+combines the cached rows. On GPU every thread computes one output pixel
+with the same weights.
+
+The geometry comes from Resize: the details keep its ResizeParams, so the
+AspectRatio policies, their target rectangle and background value are the
+same. The pipeline is a Read IOp of the source, Unary or Binary IOps
+applied to the resized float pixel, and a Write IOp.
+
+    const auto details = SeparableResize<AspectRatio::PRESERVE_AR>::details(readIOp, Size(224, 224), background);
+    executeSeparableResize<SeparableResizeDPP<ParArch::CPU>>(stream, details, readIOp, normalize, writeIOp);
+*/
+
+namespace fk {
+
+enum class SeparableResizeMode { AUTO = 0, LINEAR = 1, AREA = 2 };
+
+// Source taps of one axis: output index i reads the source indices [first(i), last(i)]
+struct SeparableResizeAxis {
+    float factor;   // source pixels per output pixel, ResizeParams::src_conv_factors
+    int srcLength;
+    SeparableResizeMode mode;
+
+    FK_HOST_DEVICE_CNST int first(const int i) const {
+        return static_cast<int>(cxp::floor::f(i * factor));
+    }
+    FK_HOST_DEVICE_CNST int last(const int i) const {
+        if (mode == SeparableResizeMode::AREA) {
+            const int end = ceil((i + 1) * factor);
+            return cxp::max::f(cxp::min::f(end, srcLength) - 1, first(i));
+        } else {
+            return cxp::min::f(first(i) + 1, srcLength - 1);
+        }
+    }
+    FK_HOST_DEVICE_CNST float weight(const int i, const int s) const {
+        const float begin = i * factor;
+        if (mode == SeparableResizeMode::AREA) {
+            const float end = cxp::min::f((i + 1) * factor, static_cast<float>(srcLength));
+            const float covered = cxp::min::f(static_cast<float>(s + 1), end) - cxp::max::f(static_cast<float>(s), begin);
+            return covered / (end - begin);
+        } else {
+            const int x1 = first(i);
+            if (last(i) == x1) {
+                return 1.f;
+            }
+            return s == x1 ? (x1 + 1) - begin : begin - x1;
+        }
+    }
+    FK_HOST_DEVICE_FUSE int ceil(const float value) {
+        return -static_cast<int>(cxp::floor::f(-value));
+    }
+    // Upper bound of last(i) - first(i) + 1
+    FK_HOST_DEVICE_CNST int maxTaps() const {
+        return mode == SeparableResizeMode::AREA ? ceil(factor) + 1 : 2;
+    }
+};
+
+template <AspectRatio AR, typename DefaultType>
+struct SeparableResizeDetails {
+    ResizeParams<AR, DefaultType> resize;
+    SeparableResizeAxis axisX;
+    SeparableResizeAxis axisY;
+
+    // Output rectangle the source is resized into, the rest is the background value
+    FK_HOST_DEVICE_CNST int targetX() const {
+        if constexpr (AR == AspectRatio::IGNORE_AR) { return 0; } else { return resize.x1; }
+    }
+    FK_HOST_DEVICE_CNST int targetY() const {
+        if constexpr (AR == AspectRatio::IGNORE_AR) { return 0; } else { return resize.y1; }
+    }
+    FK_HOST_DEVICE_CNST int targetWidth() const {
+        if constexpr (AR == AspectRatio::IGNORE_AR) { return resize.dstSize.width; } else { return resize.x2 - resize.x1 + 1; }
+    }
+    FK_HOST_DEVICE_CNST int targetHeight() const {
+        if constexpr (AR == AspectRatio::IGNORE_AR) { return resize.dstSize.height; } else { return resize.y2 - resize.y1 + 1; }
+    }
+};
+
+template <AspectRatio AR = AspectRatio::IGNORE_AR>
+struct SeparableResize {
+    FK_STATIC_STRUCT(SeparableResize, SeparableResize)
+
+    template <typename ReadIOp>
+    FK_HOST_FUSE auto details(const ReadIOp& readIOp, const Size& dstSize,
+                              const SeparableResizeMode mode = SeparableResizeMode::AUTO) {
+        static_assert(AR == AspectRatio::IGNORE_AR, "Aspect ratio preserving resizes need a background value");
+        return fromResize(readIOp, Resize<InterpolationType::INTER_LINEAR, AR>::build(readIOp, dstSize).params, mode);
+    }
+
+    template <typename ReadIOp>
+    FK_HOST_FUSE auto details(const ReadIOp& readIOp, const Size& dstSize,
+                              const float_<cn<typename ReadIOp::Operation::OutputType>>& backgroundValue,
+                              const SeparableResizeMode mode = SeparableResizeMode::AUTO) {
+        static_assert(AR != AspectRatio::IGNORE_AR, "IGNORE_AR resizes do not have a background value");
+        return fromResize(readIOp, Resize<InterpolationType::INTER_LINEAR, AR>::build(readIOp, dstSize, backgroundValue).params, mode);
+    }
+
+private:
+    template <typename ReadIOp, typename DefaultType>
+    FK_HOST_FUSE auto fromResize(const ReadIOp& readIOp, const ResizeParams<AR, DefaultType>& params,
+                                 const SeparableResizeMode mode) {
+        static_assert(isAnyCompleteReadType<ReadIOp>, "SeparableResize requires a complete Read IOp");
+        const Size srcSize = NumElems::size(Point{ 0, 0, 0 }, readIOp);
+        const auto resolve = [mode](const float factor) {
+            if (mode != SeparableResizeMode::AUTO) {
+                return mode;
+            }
+            return factor >= 2.f ? SeparableResizeMode::AREA : SeparableResizeMode::LINEAR;
+        };
+        return SeparableResizeDetails<AR, DefaultType>{
+            params,
+            { params.src_conv_factors.x, srcSize.width, resolve(params.src_conv_factors.x) },
+            { params.src_conv_factors.y, srcSize.height, resolve(params.src_conv_factors.y) } };
+    }
+};
+
+struct SeparableResizeChain {
+    FK_STATIC_STRUCT(SeparableResizeChain, SeparableResizeChain)
+
+    // Applies the compute IOps to value, and writes it with the last IOp
+    template <typename T, typename IOp, typename... IOps>
+    FK_HOST_DEVICE_FUSE void write(const Point thread, const T& value, const IOp& iOp, const IOps&... iOps) {
+        if constexpr (sizeof...(IOps) == 0) {
+            static_assert(isAnyWriteType<IOp>, "The last IOp of a SeparableResizeDPP pipeline must be a Write IOp");
+            IOp::Operation::exec(thread, value, iOp);
+        } else {
+            static_assert(opIs<UnaryType, IOp> || opIs<BinaryType, IOp>,
+                          "SeparableResizeDPP compute IOps must be Unary or Binary");
+            write(thread, value | iOp, iOps...);
+        }
+    }
+
+    template <AspectRatio AR, typename DefaultType>
+    FK_HOST_DEVICE_FUSE DefaultType background(const SeparableResizeDetails<AR, DefaultType>& details) {
+        if constexpr (AR == AspectRatio::IGNORE_AR) {
+            return make_set<DefaultType>(0.f);
+        } else {
+            return details.resize.defaultValue;
+        }
+    }
+};
+
+template <ParArch PA>
+struct SeparableResizeDPP;
+
+template <>
+struct SeparableResizeDPP<ParArch::CPU> {
+private:
+    using SelfType = SeparableResizeDPP<ParArch::CPU>;
+public:
+    FK_STATIC_STRUCT(SeparableResizeDPP, SelfType)
+    static constexpr ParArch PAR_ARCH = ParArch::CPU;
+
+    template <AspectRatio AR, typename DefaultType, typename InIOp, typename... IOps>
+    FK_HOST_FUSE void exec(const SeparableResizeDetails<AR, DefaultType>& details,
+                           const InIOp& input, const IOps&... iOps) {
+        static_assert(isAnyCompleteReadType<InIOp>, "SeparableResizeDPP requires a complete Read IOp");
+        using PixelType = float_<cn<typename InIOp::Operation::OutputType>>;
+        static_assert(std::is_same_v<PixelType, DefaultType>, "Default value type and resized pixel type must be the same");
+
+        const int dstWidth = details.resize.dstSize.width;
+        const int dstHeight = details.resize.dstSize.height;
+        const int targetX = details.targetX();
+        const int targetY = details.targetY();
+        const int targetWidth = details.targetWidth();
+        const int targetHeight = details.targetHeight();
+        const SeparableResizeAxis& axisX = details.axisX;
+        const SeparableResizeAxis& axisY = details.axisY;
+
+        // Horizontal taps of every output column, computed once
+        const int tapsX = axisX.maxTaps();
+        std::vector<int> firstX(targetWidth);
+        std::vector<int> countX(targetWidth);
+        std::vector<float> weightsX(static_cast<size_t>(targetWidth) * tapsX);
+        for (int x = 0; x < targetWidth; ++x) {
+            firstX[x] = axisX.first(x);
+            countX[x] = axisX.last(x) - firstX[x] + 1;
+            for (int k = 0; k < countX[x]; ++k) {
+                weightsX[static_cast<size_t>(x) * tapsX + k] = axisX.weight(x, firstX[x] + k);
+            }
+        }
+
+        // Ring of horizontally resized source rows. Source rows are requested in
+        // increasing order, so a ring larger than the vertical taps computes each once
+        const int ringSize = axisY.maxTaps() + 1;
+        std::vector<PixelType> ring(static_cast<size_t>(ringSize) * targetWidth);
+        std::vector<int> ringRow(ringSize, -1);
+        const auto cachedRow = [&](const int srcY) -> const PixelType* {
+            const int slot = srcY % ringSize;
+            PixelType* const row = ring.data() + static_cast<size_t>(slot) * targetWidth;
+            if (ringRow[slot] != srcY) {
+                for (int x = 0; x < targetWidth; ++x) {
+                    PixelType sum = make_set<PixelType>(0.f);
+                    const float* const weights = weightsX.data() + static_cast<size_t>(x) * tapsX;
+                    for (int k = 0; k < countX[x]; ++k) {
+                        const auto pixel = InIOp::Operation::exec(Point{ firstX[x] + k, srcY, 0 }, input);
+                        sum = sum + cxp::cast<PixelType>::f(pixel) * weights[k];
+                    }
+                    row[x] = sum;
+                }
+                ringRow[slot] = srcY;
+            }
+            return row;
+        };
+
+        const PixelType background = SeparableResizeChain::background(details);
+        std::vector<PixelType> outputRow(targetWidth);
+        for (int y = 0; y < dstHeight; ++y) {
+            const int ty = y - targetY;
+            if (ty < 0 || ty >= targetHeight) {
+                for (int x = 0; x < dstWidth; ++x) {
+                    SeparableResizeChain::write(Point{ x, y, 0 }, background, iOps...);
+                }
+                continue;
+            }
+            std::fill(outputRow.begin(), outputRow.end(), make_set<PixelType>(0.f));
+            const int firstY = axisY.first(ty);
+            const int lastY = axisY.last(ty);
+            for (int srcY = firstY; srcY <= lastY; ++srcY) {
+                const PixelType* const row = cachedRow(srcY);
+                const float weight = axisY.weight(ty, srcY);
+                for (int x = 0; x < targetWidth; ++x) {
+                    outputRow[x] = outputRow[x] + row[x] * weight;
+                }
+            }
+            for (int x = 0; x < dstWidth; ++x) {
+                const int tx = x - targetX;
+                const PixelType value = (tx < 0 || tx >= targetWidth) ? background : outputRow[tx];
+                SeparableResizeChain::write(Point{ x, y, 0 }, value, iOps...);
+            }
+        }
+    }
+};
+
+#if defined(__NVCC__)
+template <>
+struct SeparableResizeDPP<ParArch::GPU_NVIDIA> {
+private:
+    using SelfType = SeparableResizeDPP<ParArch::GPU_NVIDIA>;
+public:
+    FK_STATIC_STRUCT(SeparableResizeDPP, SelfType)
+    static constexpr ParArch PAR_ARCH = ParArch::GPU_NVIDIA;
+    static constexpr uint BLOCK_X = 32;
+    static constexpr uint BLOCK_Y = 8;
+
+    template <AspectRatio AR, typename DefaultType, typename InIOp, typename... IOps>
+    FK_DEVICE_FUSE void exec(const SeparableResizeDetails<AR, DefaultType>& details,
+                             const InIOp& input, const IOps&... iOps) {
+        static_assert(isAnyCompleteReadType<InIOp>, "SeparableResizeDPP requires a complete Read IOp");
+        using PixelType = float_<cn<typename InIOp::Operation::OutputType>>;
+        static_assert(std::is_same_v<PixelType, DefaultType>, "Default value type and resized pixel type must be the same");
+#if defined(__CUDA_ARCH__)
+        const int x = static_cast<int>(blockIdx.x * blockDim.x + threadIdx.x);
+        const int y = static_cast<int>(blockIdx.y * blockDim.y + threadIdx.y);
+        if (x >= details.resize.dstSize.width || y >= details.resize.dstSize.height) return;
+
+        const int tx = x - details.targetX();
+        const int ty = y - details.targetY();
+        if (tx < 0 || tx >= details.targetWidth() || ty < 0 || ty >= details.targetHeight()) {
+            SeparableResizeChain::write(Point{ x, y, 0 }, SeparableResizeChain::background(details), iOps...);
+            return;
+        }
+        const SeparableResizeAxis& axisX = details.axisX;
+        const SeparableResizeAxis& axisY = details.axisY;
+        const int firstX = axisX.first(tx);
+        const int lastX = axisX.last(tx);
+        PixelType value = make_set<PixelType>(0.f);
+        for (int srcY = axisY.first(ty); srcY <= axisY.last(ty); ++srcY) {
+            PixelType rowSum = make_set<PixelType>(0.f);
+            for (int srcX = firstX; srcX <= lastX; ++srcX) {
+                const auto pixel = InIOp::Operation::exec(Point{ srcX, srcY, 0 }, input);
+                rowSum = rowSum + cxp::cast<PixelType>::f(pixel) * axisX.weight(tx, srcX);
+            }
+            value = value + rowSum * axisY.weight(ty, srcY);
+        }
+        SeparableResizeChain::write(Point{ x, y, 0 }, value, iOps...);
+#endif // defined(__CUDA_ARCH__)
+    }
+};
+
+template <typename DPP, typename Details, typename... IOps>
+__global__ void launchSeparableResizeDPP_Kernel(const __grid_constant__ Details details,
+                                                const __grid_constant__ IOps... iOps) {
+    DPP::exec(details, iOps...);
+}
+
+template <typename DPP, typename Details, typename... IOps>
+FK_HOST_FUSE void executeSeparableResize(Stream_<ParArch::GPU_NVIDIA>& stream, const Details& details,
+                                         const IOps&... iOps) {
+    static_assert(DPP::PAR_ARCH == ParArch::GPU_NVIDIA,
+                  "GPU stream requires the NVIDIA SeparableResizeDPP specialization");
+    const dim3 block(DPP::BLOCK_X, DPP::BLOCK_Y);
+    const dim3 grid((details.resize.dstSize.width + DPP::BLOCK_X - 1) / DPP::BLOCK_X,
+                    (details.resize.dstSize.height + DPP::BLOCK_Y - 1) / DPP::BLOCK_Y);
+    launchSeparableResizeDPP_Kernel<DPP, Details, IOps...><<<grid, block, 0, stream.getCUDAStream()>>>(details, iOps...);
+    gpuErrchk(cudaGetLastError());
+}
+#endif // defined(__NVCC__)
+
+template <typename DPP, typename Details, typename... IOps>
+FK_HOST_FUSE void executeSeparableResize(Stream_<ParArch::CPU>&, const Details& details, const IOps&... iOps) {
+    static_assert(DPP::PAR_ARCH == ParArch::CPU,
+                  "CPU stream requires the CPU SeparableResizeDPP specialization");
+    DPP::exec(details, iOps...);
+}
+
+} // namespace fk
+
+#endif // FK_SEPARABLE_RESIZE_H
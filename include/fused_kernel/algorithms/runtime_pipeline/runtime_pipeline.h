@@ -0,0 +1,661 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_RUNTIME_PIPELINE_H
+#define FK_RUNTIME_PIPELINE_H
+
+/* RuntimePipeline: per-pixel pipelines assembled at runtime, on the CPU.
+ *
+ * A pipeline is a type-erased operation graph: an input pixel format, a
+ * linear list of RtNode (an RtOp plus up to four per-channel float params)
+ * and an output pixel format. It can be built in code with add(), or parsed
+ * from a text config (parse()), so new preprocessing chains can be deployed
+ * without recompiling:
+ *
+ *     input  u8c3
+ *     swap_rb
+ *     mul    0.0039215686
+ *     sub    0.485 0.456 0.406
+ *     div    0.229 0.224 0.225
+ *     output f32c3
+ *
+ * LOWERING. Nothing is compiled at runtime. RtKernelRegistry holds
+ * precompiled SUPER-KERNELS: row functions generated from ordinary fused
+ * IOps (FusedOperation of Cast + the ops of a given RtOp sequence) for one
+ * input and output format, with params taken from the nodes at runtime.
+ * compile() picks the registered super-kernel that covers the whole graph,
+ * or else the one covering the longest prefix (writing float rows). A load
+ * kernel (no ops) exists for every input format, so a prefix always
+ * matches. The uncovered tail runs through a per-row interpreter: one
+ * dispatch per node and row, then a tight loop over the row calling the
+ * same fk Operations, never a virtual call per pixel. A final store
+ * converts the float row to the output format (saturating for u8).
+ *
+ * Super-kernels for common DNN preprocessing chains are registered by
+ * default; applications add their own hot chains with
+ * RtKernelRegistry::instance().add<I, O, RtOp...>(name). Graphs only known
+ * at runtime can be specialized with jitCompile() from runtime_pipeline_jit.h,
+ * which compiles the whole chain into a super-kernel once (cached on disk)
+ * and registers it.
+ *
+ * Images must be host accessible; rows are processed sequentially. */
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/logical.h>
+#include <fused_kernel/algorithms/basic_ops/math.h>
+#include <fused_kernel/algorithms/image_processing/color_conversion.h>
+#include <fused_kernel/core/constexpr_libs/constexpr_saturate.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/operation_model/fused_operation.h>
+#include <fused_kernel/core/utils/type_to_string.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fk {
+
+    enum class RtPixelType { U8, F32 };
+
+    struct RtFormat {
+        RtPixelType type{ RtPixelType::F32 };
+        uint channels{ 1 };
+
+        constexpr bool operator==(const RtFormat& other) const {
+            return type == other.type && channels == other.channels;
+        }
+        constexpr bool operator!=(const RtFormat& other) const { return !(*this == other); }
+    };
+
+    template <typename T>
+    struct RtFormatOf;
+    template <> struct RtFormatOf<uchar> { static constexpr RtFormat value{ RtPixelType::U8, 1 }; };
+    template <> struct RtFormatOf<uchar3> { static constexpr RtFormat value{ RtPixelType::U8, 3 }; };
+    template <> struct RtFormatOf<uchar4> { static constexpr RtFormat value{ RtPixelType::U8, 4 }; };
+    template <> struct RtFormatOf<float> { static constexpr RtFormat value{ RtPixelType::F32, 1 }; };
+    template <> struct RtFormatOf<float3> { static constexpr RtFormat value{ RtPixelType::F32, 3 }; };
+    template <> struct RtFormatOf<float4> { static constexpr RtFormat value{ RtPixelType::F32, 4 }; };
+
+    enum class RtOp : uint8_t {
+        ADD, SUB, MUL, DIV, MAX, MIN,   // per-channel param
+        ABS, SQRT, EXP, LN,             // no params
+        SWAP_RB,                        // RGB <-> BGR, 3 or 4 channels
+        RGB2GRAY                        // 3 or 4 channels -> 1
+    };
+
+    struct RtNode {
+        RtOp op{ RtOp::ADD };
+        std::array<float, 4> params{};
+    };
+
+    // Type-erased view of a host 2D image
+    struct RtImage {
+        void* data{ nullptr };
+        uint width{ 0 };
+        uint height{ 0 };
+        uint pitch{ 0 };
+        RtFormat format{};
+    };
+
+    template <typename T>
+    inline RtImage toRtImage(const Ptr2D<T>& image) {
+        if (image.getMemType() == MemType::Device) {
+            throw std::invalid_argument("RuntimePipeline: images must be host accessible");
+        }
+        const RawPtr<ND::_2D, T> raw = image.ptr();
+        return { raw.data, raw.dims.width, raw.dims.height, raw.dims.pitch, RtFormatOf<T>::value };
+    }
+
+    // Processes one row: width pixels from inRow to outRow
+    using RtRowFunction = void (*)(const void* inRow, void* outRow, uint width, const RtNode* nodes);
+
+    struct RtSuperKernel {
+        std::string name;
+        RtFormat input;
+        std::vector<RtOp> ops;
+        RtFormat output;
+        RtRowFunction row{ nullptr };
+    };
+
+    namespace rt_detail {
+        inline const char* toString(const RtOp op) {
+            switch (op) {
+            case RtOp::ADD: return "add";
+            case RtOp::SUB: return "sub";
+            case RtOp::MUL: return "mul";
+            case RtOp::DIV: return "div";
+            case RtOp::MAX: return "max";
+            case RtOp::MIN: return "min";
+            case RtOp::ABS: return "abs";
+            case RtOp::SQRT: return "sqrt";
+            case RtOp::EXP: return "exp";
+            case RtOp::LN: return "ln";
+            case RtOp::SWAP_RB: return "swap_rb";
+            case RtOp::RGB2GRAY: return "rgb2gray";
+            }
+            return "unknown";
+        }
+
+        inline std::string toString(const RtFormat& format) {
+            return std::string(format.type == RtPixelType::U8 ? "u8c" : "f32c") + std::to_string(format.channels);
+        }
+
+        // C++ spelling of the pixel type, for generated sources
+        inline std::string typeName(const RtFormat& format) {
+            const bool u8 = format.type == RtPixelType::U8;
+            switch (format.channels) {
+            case 1: return u8 ? typeToString<uchar>() : typeToString<float>();
+            case 3: return u8 ? typeToString<uchar3>() : typeToString<float3>();
+            default: return u8 ? typeToString<uchar4>() : typeToString<float4>();
+            }
+        }
+
+        inline uint paramCount(const RtOp op) {
+            return static_cast<uint8_t>(op) <= static_cast<uint8_t>(RtOp::MIN) ? 1 : 0;
+        }
+
+        // Channels after op, 0 if op can not take inChannels
+        inline uint outputChannels(const RtOp op, const uint inChannels) {
+            switch (op) {
+            case RtOp::SWAP_RB: return inChannels >= 3 ? inChannels : 0;
+            case RtOp::RGB2GRAY: return inChannels >= 3 ? 1 : 0;
+            default: return inChannels;
+            }
+        }
+
+        template <typename T>
+        FK_HOST_CNST T param(const RtNode& node) {
+            if constexpr (cn<T> == 1) {
+                return node.params[0];
+            } else if constexpr (cn<T> == 3) {
+                return make_<T>(node.params[0], node.params[1], node.params[2]);
+            } else {
+                return make_<T>(node.params[0], node.params[1], node.params[2], node.params[3]);
+            }
+        }
+
+        // The fk IOp implementing an RtOp on float vector type T
+        template <RtOp OP, typename T, typename = void>
+        struct NodeIOp {
+            static constexpr bool valid = false;
+        };
+
+#define FK_RT_BINARY_NODE(OP, OPERATION) \
+        template <typename T> \
+        struct NodeIOp<OP, T> { \
+            static constexpr bool valid = true; \
+            using OutputType = T; \
+            FK_HOST_FUSE auto build(const RtNode& node) { return OPERATION<T>::build(param<T>(node)); } \
+        };
+#define FK_RT_UNARY_NODE(OP, OPERATION) \
+        template <typename T> \
+        struct NodeIOp<OP, T> { \
+            static constexpr bool valid = true; \
+            using OutputType = T; \
+            FK_HOST_FUSE auto build(const RtNode&) { return OPERATION<T>::build(); } \
+        };
+
+        FK_RT_BINARY_NODE(RtOp::ADD, Add)
+        FK_RT_BINARY_NODE(RtOp::SUB, Sub)
+        FK_RT_BINARY_NODE(RtOp::MUL, Mul)
+        FK_RT_BINARY_NODE(RtOp::DIV, Div)
+        FK_RT_BINARY_NODE(RtOp::MAX, Max)
+        FK_RT_BINARY_NODE(RtOp::MIN, Min)
+        FK_RT_UNARY_NODE(RtOp::ABS, Abs)
+        FK_RT_UNARY_NODE(RtOp::SQRT, Sqrt)
+        FK_RT_UNARY_NODE(RtOp::EXP, Exp)
+        FK_RT_UNARY_NODE(RtOp::LN, Ln)
+#undef FK_RT_BINARY_NODE
+#undef FK_RT_UNARY_NODE
+
+        template <typename T>
+        struct NodeIOp<RtOp::SWAP_RB, T, std::enable_if_t<(cn<T> >= 3)>> {
+            static constexpr bool valid = true;
+            using OutputType = T;
+            FK_HOST_FUSE auto build(const RtNode&) {
+                if constexpr (cn<T> == 3) {
+                    return ColorConversion<ColorConversionCodes::COLOR_BGR2RGB, T, T>::build();
+                } else {
+                    return ColorConversion<ColorConversionCodes::COLOR_BGRA2RGBA, T, T>::build();
+                }
+            }
+        };
+
+        template <typename T>
+        struct NodeIOp<RtOp::RGB2GRAY, T, std::enable_if_t<(cn<T> >= 3)>> {
+            static constexpr bool valid = true;
+            using OutputType = float;
+            FK_HOST_FUSE auto build(const RtNode&) { return RGB2Gray<T, float>::build(); }
+        };
+
+        // Output type and IOps of a compile-time RtOp sequence starting at type T
+        template <typename T, RtOp... OPS>
+        struct NodeChain {
+            using OutputType = T;
+            FK_HOST_FUSE auto build(const RtNode*) { return Tuple<>{}; }
+        };
+
+        template <typename T, RtOp OP, RtOp... OPS>
+        struct NodeChain<T, OP, OPS...> {
+            static_assert(NodeIOp<OP, T>::valid, "RtOp not available for this number of channels");
+            using Next = NodeChain<typename NodeIOp<OP, T>::OutputType, OPS...>;
+            using OutputType = typename Next::OutputType;
+            FK_HOST_FUSE auto build(const RtNode* nodes) {
+                return tuple_cat(make_tuple(NodeIOp<OP, T>::build(nodes[0])), Next::build(nodes + 1));
+            }
+        };
+
+        template <typename O, typename T>
+        FK_HOST_CNST O store(const T value) {
+            if constexpr (std::is_same_v<O, T>) {
+                return value;
+            } else {
+                return cxp::saturate_cast<O>::f(value);
+            }
+        }
+
+        // Super-kernel row: Cast to float, the fused ops, store. The IOps
+        // are built once per row from the runtime params.
+        template <typename I, typename O, RtOp... OPS>
+        void superKernelRow(const void* inRow, void* outRow, const uint width, const RtNode* nodes) {
+            using F = VectorType_t<float, cn<I>>;
+            const I* const in = static_cast<const I*>(inRow);
+            O* const out = static_cast<O*>(outRow);
+            if constexpr (sizeof...(OPS) == 0) {
+                for (uint x = 0; x < width; ++x) {
+                    out[x] = store<O>(Cast<I, F>::exec(in[x]));
+                }
+            } else {
+                const auto fusedIOp = apply([](const auto&... iOps) {
+                    return FusedOperation<>::build(Cast<I, F>::build(), iOps...);
+                }, NodeChain<F, OPS...>::build(nodes));
+                for (uint x = 0; x < width; ++x) {
+                    out[x] = store<O>(in[x] | fusedIOp);
+                }
+            }
+        }
+
+        // Interpreter: one node over a float row holding CN channels per pixel.
+        // Channel reducing ops write in place, never ahead of the read position.
+        template <RtOp OP, uint CN>
+        inline uint interpretNode(const RtNode& node, float* row, const uint width) {
+            using T = VectorType_t<float, CN>;
+            if constexpr (NodeIOp<OP, T>::valid) {
+                using O = typename NodeIOp<OP, T>::OutputType;
+                const auto iOp = NodeIOp<OP, T>::build(node);
+                const T* const in = reinterpret_cast<const T*>(row);
+                O* const out = reinterpret_cast<O*>(row);
+                for (uint x = 0; x < width; ++x) {
+                    const T value = in[x];
+                    out[x] = value | iOp;
+                }
+                return cn<O>;
+            } else {
+                throw std::logic_error(std::string("RuntimePipeline: ") + toString(OP) +
+                                       " not available for " + std::to_string(CN) + " channels");
+            }
+        }
+
+        template <uint CN>
+        inline uint interpretNode(const RtNode& node, float* row, const uint width) {
+            switch (node.op) {
+            case RtOp::ADD: return interpretNode<RtOp::ADD, CN>(node, row, width);
+            case RtOp::SUB: return interpretNode<RtOp::SUB, CN>(node, row, width);
+            case RtOp::MUL: return interpretNode<RtOp::MUL, CN>(node, row, width);
+            case RtOp::DIV: return interpretNode<RtOp::DIV, CN>(node, row, width);
+            case RtOp::MAX: return interpretNode<RtOp::MAX, CN>(node, row, width);
+            case RtOp::MIN: return interpretNode<RtOp::MIN, CN>(node, row, width);
+            case RtOp::ABS: return interpretNode<RtOp::ABS, CN>(node, row, width);
+            case RtOp::SQRT: return interpretNode<RtOp::SQRT, CN>(node, row, width);
+            case RtOp::EXP: return interpretNode<RtOp::EXP, CN>(node, row, width);
+            case RtOp::LN: return interpretNode<RtOp::LN, CN>(node, row, width);
+            case RtOp::SWAP_RB: return interpretNode<RtOp::SWAP_RB, CN>(node, row, width);
+            case RtOp::RGB2GRAY: return interpretNode<RtOp::RGB2GRAY, CN>(node, row, width);
+            }
+            throw std::logic_error("RuntimePipeline: unknown RtOp");
+        }
+
+        // Returns the number of channels in the row after the node
+        inline uint interpretNode(const RtNode& node, float* row, const uint width, const uint channels) {
+            switch (channels) {
+            case 1: return interpretNode<1>(node, row, width);
+            case 3: return interpretNode<3>(node, row, width);
+            case 4: return interpretNode<4>(node, row, width);
+            }
+            throw std::logic_error("RuntimePipeline: unsupported number of channels");
+        }
+
+        template <typename O>
+        void storeRow(const void* inRow, void* outRow, const uint width, const RtNode*) {
+            using F = VectorType_t<float, cn<O>>;
+            const F* const in = static_cast<const F*>(inRow);
+            O* const out = static_cast<O*>(outRow);
+            for (uint x = 0; x < width; ++x) {
+                out[x] = store<O>(in[x]);
+            }
+        }
+
+        inline RtRowFunction storeFunction(const RtFormat& format) {
+            const bool u8 = format.type == RtPixelType::U8;
+            switch (format.channels) {
+            case 1: return u8 ? &storeRow<uchar> : &storeRow<float>;
+            case 3: return u8 ? &storeRow<uchar3> : &storeRow<float3>;
+            case 4: return u8 ? &storeRow<uchar4> : &storeRow<float4>;
+            }
+            throw std::invalid_argument("RuntimePipeline: unsupported output format " + toString(format));
+        }
+    } // namespace rt_detail
+
+    class RtKernelRegistry {
+    public:
+        static inline RtKernelRegistry& instance() {
+            static RtKernelRegistry registry;
+            return registry;
+        }
+
+        inline void add(RtSuperKernel kernel) {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_kernels.push_back(std::move(kernel));
+        }
+
+        // Precompiles the RtOp sequence OPS from I to O. O is either the
+        // output format of full pipelines or a float format that feeds the
+        // interpreter.
+        template <typename I, typename O, RtOp... OPS>
+        inline void add(std::string name) {
+            using Chain = rt_detail::NodeChain<VectorType_t<float, cn<I>>, OPS...>;
+            static_assert(cn<typename Chain::OutputType> == cn<O>, "Output type channels do not match the RtOp sequence");
+            add(RtSuperKernel{ std::move(name), RtFormatOf<I>::value, { OPS... }, RtFormatOf<O>::value,
+                               &rt_detail::superKernelRow<I, O, OPS...> });
+        }
+
+        inline std::vector<RtSuperKernel> kernels() const {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            return m_kernels;
+        }
+
+    private:
+        RtKernelRegistry() {
+            addLoad<uchar>(); addLoad<uchar3>(); addLoad<uchar4>();
+            addLoad<float>(); addLoad<float3>(); addLoad<float4>();
+            // Normalization chains, optionally after an RGB <-> BGR swap
+            addNormalize<uchar, float>();
+            addNormalize<uchar3, float3>();
+            addNormalize<uchar4, float4>();
+            add<uchar3, float3, RtOp::SWAP_RB, RtOp::MUL, RtOp::SUB>("u8c3_swap_mul_sub");
+            add<uchar3, float3, RtOp::SWAP_RB, RtOp::SUB, RtOp::DIV>("u8c3_swap_sub_div");
+            add<uchar3, float3, RtOp::SWAP_RB, RtOp::MUL, RtOp::SUB, RtOp::DIV>("u8c3_swap_mul_sub_div");
+            add<uchar3, float, RtOp::RGB2GRAY>("u8c3_gray");
+            add<uchar3, float, RtOp::RGB2GRAY, RtOp::MUL>("u8c3_gray_mul");
+        }
+
+        template <typename I>
+        void addLoad() {
+            add<I, VectorType_t<float, cn<I>>>("load_" + rt_detail::toString(RtFormatOf<I>::value));
+        }
+
+        template <typename I, typename O>
+        void addNormalize() {
+            const std::string prefix = rt_detail::toString(RtFormatOf<I>::value);
+            add<I, O, RtOp::MUL>(prefix + "_mul");
+            add<I, O, RtOp::MUL, RtOp::SUB>(prefix + "_mul_sub");
+            add<I, O, RtOp::SUB, RtOp::DIV>(prefix + "_sub_div");
+            add<I, O, RtOp::MUL, RtOp::SUB, RtOp::DIV>(prefix + "_mul_sub_div");
+        }
+
+        mutable std::mutex m_mutex;
+        std::vector<RtSuperKernel> m_kernels;
+    };
+
+    // How a RuntimePipeline was lowered
+    struct RtPlan {
+        RtSuperKernel kernel;           // covers nodes [0, kernel.ops.size())
+        size_t interpretedNodes{ 0 };   // tail run by the interpreter
+        bool direct{ false };           // kernel writes the output image
+    };
+
+    class RuntimePipeline {
+    public:
+        RuntimePipeline(const RtFormat& input, const RtFormat& output)
+            : m_input(input), m_output(output), m_channels(input.channels) {
+            checkFormat(input);
+            checkFormat(output);
+        }
+
+        // params: one value per channel
+        inline RuntimePipeline& add(const RtOp op, const std::array<float, 4>& params = {}) {
+            const uint channels = rt_detail::outputChannels(op, m_channels);
+            if (channels == 0) {
+                throw std::invalid_argument(std::string("RuntimePipeline: ") + rt_detail::toString(op) +
+                                            " needs 3 or 4 channels, got " + std::to_string(m_channels));
+            }
+            m_nodes.push_back({ op, params });
+            m_channels = channels;
+            m_plan.reset();
+            return *this;
+        }
+
+        // Same param for every channel
+        inline RuntimePipeline& add(const RtOp op, const float param) {
+            return add(op, { param, param, param, param });
+        }
+
+        inline const std::vector<RtNode>& nodes() const { return m_nodes; }
+        inline RtFormat input() const { return m_input; }
+        inline RtFormat output() const { return m_output; }
+
+        /* One statement per line, '#' starts a comment:
+         *   input  <format>            formats: u8c1 u8c3 u8c4 f32c1 f32c3 f32c4
+         *   output <format>
+         *   <op> [value | v0 .. v<channels - 1>]
+         * A single value applies to every channel, otherwise there is one
+         * value per channel of the op input. input and output are required,
+         * input before the first op. */
+        static inline RuntimePipeline parse(const std::string& config) {
+            std::istringstream lines(config);
+            std::string line;
+            bool hasInput = false, hasOutput = false;
+            RtFormat input{}, output{};
+            std::vector<std::pair<RtOp, std::vector<float>>> ops;
+            size_t lineNumber = 0;
+            while (std::getline(lines, line)) {
+                ++lineNumber;
+                const size_t comment = line.find('#');
+                if (comment != std::string::npos) line.resize(comment);
+                std::istringstream tokens(line);
+                std::string keyword;
+                if (!(tokens >> keyword)) continue;
+                const auto fail = [&](const std::string& what) {
+                    return std::invalid_argument("RuntimePipeline::parse line " + std::to_string(lineNumber) + ": " + what);
+                };
+                if (keyword == "input" || keyword == "output") {
+                    std::string name;
+                    if (!(tokens >> name)) throw fail("missing format");
+                    const RtFormat format = parseFormat(name);
+                    if (format.channels == 0) throw fail("unknown format " + name);
+                    if (keyword == "input") {
+                        if (!ops.empty()) throw fail("input must come before the operations");
+                        input = format;
+                        hasInput = true;
+                    } else {
+                        output = format;
+                        hasOutput = true;
+                    }
+                    continue;
+                }
+                RtOp op{};
+                if (!parseOp(keyword, op)) throw fail("unknown operation " + keyword);
+                std::vector<float> values;
+                float value;
+                while (tokens >> value) values.push_back(value);
+                if (!tokens.eof()) throw fail("invalid parameter");
+                ops.emplace_back(op, std::move(values));
+            }
+            if (!hasInput || !hasOutput) {
+                throw std::invalid_argument("RuntimePipeline::parse: input and output formats are required");
+            }
+            RuntimePipeline pipeline(input, output);
+            for (const auto& [op, values] : ops) {
+                const std::string what = std::string("RuntimePipeline::parse: ") + rt_detail::toString(op);
+                if (rt_detail::paramCount(op) == 0) {
+                    if (!values.empty()) throw std::invalid_argument(what + " takes no parameters");
+                } else if (values.size() != 1 && values.size() != pipeline.m_channels) {
+                    throw std::invalid_argument(what + " takes 1 or " + std::to_string(pipeline.m_channels) +
+                                                " values, got " + std::to_string(values.size()));
+                }
+                if (values.size() == 1) {
+                    pipeline.add(op, values[0]);
+                } else {
+                    std::array<float, 4> params{};
+                    for (size_t i = 0; i < values.size(); ++i) params[i] = values[i];
+                    pipeline.add(op, params);
+                }
+            }
+            pipeline.compile();
+            return pipeline;
+        }
+
+        // Lowers the graph onto the registered super-kernels. Called by
+        // execute() when the graph changed since the last compile().
+        inline const RtPlan& compile() {
+            if (m_channels != m_output.channels) {
+                throw std::invalid_argument("RuntimePipeline: pipeline produces " + std::to_string(m_channels) +
+                                            " channels, output format " + rt_detail::toString(m_output));
+            }
+            const RtSuperKernel* best = nullptr;
+            bool bestDirect = false;
+            const std::vector<RtSuperKernel> kernels = RtKernelRegistry::instance().kernels();
+            for (const RtSuperKernel& kernel : kernels) {
+                if (kernel.input != m_input || kernel.ops.size() > m_nodes.size()) continue;
+                bool prefix = true;
+                for (size_t i = 0; i < kernel.ops.size() && prefix; ++i) {
+                    prefix = kernel.ops[i] == m_nodes[i].op;
+                }
+                if (!prefix) continue;
+                const bool direct = kernel.ops.size() == m_nodes.size() && kernel.output == m_output;
+                // Anything else has to hand a float row to the interpreter
+                if (!direct && kernel.output.type != RtPixelType::F32) continue;
+                if (best == nullptr || (direct && !bestDirect) ||
+                    (direct == bestDirect && kernel.ops.size() > best->ops.size())) {
+                    best = &kernel;
+                    bestDirect = direct;
+                }
+            }
+            if (best == nullptr) {
+                throw std::invalid_argument("RuntimePipeline: no kernel registered for input " + rt_detail::toString(m_input));
+            }
+            m_plan = RtPlan{ *best, m_nodes.size() - best->ops.size(), bestDirect };
+            m_store = bestDirect ? nullptr : rt_detail::storeFunction(m_output);
+            return *m_plan;
+        }
+
+        inline void execute(const RtImage& input, const RtImage& output) {
+            if (input.format != m_input || output.format != m_output) {
+                throw std::invalid_argument("RuntimePipeline: image formats do not match the pipeline");
+            }
+            if (input.width != output.width || input.height != output.height) {
+                throw std::invalid_argument("RuntimePipeline: input and output sizes differ");
+            }
+            if (!m_plan) compile();
+            const RtPlan& plan = *m_plan;
+            const RtNode* const tail = m_nodes.data() + plan.kernel.ops.size();
+            if (!plan.direct && m_row.size() < input.width) {
+                m_row.resize(input.width);
+            }
+            float* const row = reinterpret_cast<float*>(m_row.data());
+            const auto* const in = static_cast<const uint8_t*>(input.data);
+            auto* const out = static_cast<uint8_t*>(output.data);
+            for (uint y = 0; y < input.height; ++y) {
+                const void* const inRow = in + static_cast<size_t>(y) * input.pitch;
+                void* const outRow = out + static_cast<size_t>(y) * output.pitch;
+                if (plan.direct) {
+                    plan.kernel.row(inRow, outRow, input.width, m_nodes.data());
+                    continue;
+                }
+                plan.kernel.row(inRow, row, input.width, m_nodes.data());
+                uint channels = plan.kernel.output.channels;
+                for (size_t i = 0; i < plan.interpretedNodes; ++i) {
+                    channels = rt_detail::interpretNode(tail[i], row, input.width, channels);
+                }
+                m_store(row, outRow, input.width, nullptr);
+            }
+        }
+
+        template <typename I, typename O>
+        inline void execute(const Ptr2D<I>& input, const Ptr2D<O>& output) {
+            execute(toRtImage(input), toRtImage(output));
+        }
+
+        // One line summary of the lowering, for logs
+        inline std::string describe() {
+            const RtPlan& plan = m_plan ? *m_plan : compile();
+            std::string result = "super-kernel " + plan.kernel.name + " (" + std::to_string(plan.kernel.ops.size()) + " ops)";
+            if (plan.interpretedNodes > 0) {
+                result += ", interpreted:";
+                for (size_t i = plan.kernel.ops.size(); i < m_nodes.size(); ++i) {
+                    result += std::string(" ") + rt_detail::toString(m_nodes[i].op);
+                }
+            }
+            if (!plan.direct) {
+                result += ", store " + rt_detail::toString(m_output);
+            }
+            return result;
+        }
+
+    private:
+        static inline void checkFormat(const RtFormat& format) {
+            if (format.channels != 1 && format.channels != 3 && format.channels != 4) {
+                throw std::invalid_argument("RuntimePipeline: unsupported format " + rt_detail::toString(format));
+            }
+        }
+
+        static inline RtFormat parseFormat(const std::string& name) {
+            for (const RtPixelType type : { RtPixelType::U8, RtPixelType::F32 }) {
+                for (const uint channels : { 1u, 3u, 4u }) {
+                    const RtFormat format{ type, channels };
+                    if (rt_detail::toString(format) == name) return format;
+                }
+            }
+            return { RtPixelType::U8, 0 };
+        }
+
+        static inline bool parseOp(const std::string& name, RtOp& op) {
+            for (uint8_t i = 0; i <= static_cast<uint8_t>(RtOp::RGB2GRAY); ++i) {
+                if (name == rt_detail::toString(static_cast<RtOp>(i))) {
+                    op = static_cast<RtOp>(i);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        RtFormat m_input;
+        RtFormat m_output;
+        uint m_channels;
+        std::vector<RtNode> m_nodes;
+        std::optional<RtPlan> m_plan;
+        RtRowFunction m_store{ nullptr };
+        std::vector<float4> m_row;  // float row of up to 4 channels per pixel
+    };
+
+} // namespace fk
+
+#endif // FK_RUNTIME_PIPELINE_H
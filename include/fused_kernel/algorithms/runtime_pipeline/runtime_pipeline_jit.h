@@ -0,0 +1,61 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_RUNTIME_PIPELINE_JIT_H
+#define FK_RUNTIME_PIPELINE_JIT_H
+
+/* Specializes a RuntimePipeline with the CpuJit. Kept apart from
+ * runtime_pipeline.h, which needs no compiler nor dlopen at runtime: only
+ * the users of this header link FKL::cpu_jit. */
+
+#include <fused_kernel/algorithms/runtime_pipeline/runtime_pipeline.h>
+#include <fused_kernel/core/execution_model/cpu_jit.h>
+
+#include <string>
+#include <vector>
+
+namespace fk {
+
+    // As pipeline.compile(), but a graph without a direct super-kernel is
+    // compiled into one by jit and registered, so later pipelines with the
+    // same formats and RtOp sequence find it too.
+    inline const RtPlan& jitCompile(RuntimePipeline& pipeline, CpuJit& jit) {
+        const RtPlan& plan = pipeline.compile();
+        if (plan.direct) return plan;
+        const RtFormat input = pipeline.input();
+        const RtFormat output = pipeline.output();
+        std::string name = "jit_" + rt_detail::toString(input);
+        std::string ops;
+        std::vector<RtOp> sequence;
+        for (const RtNode& node : pipeline.nodes()) {
+            name += std::string("_") + rt_detail::toString(node.op);
+            ops += ", static_cast<fk::RtOp>(" + std::to_string(static_cast<uint8_t>(node.op)) + ")";
+            sequence.push_back(node.op);
+        }
+        name += "_" + rt_detail::toString(output);
+        const std::string body =
+            "#include <fused_kernel/algorithms/runtime_pipeline/runtime_pipeline.h>\n\n"
+            "extern \"C\" __attribute__((visibility(\"default\")))\n"
+            "void fk_rt_super_kernel(const void* inRow, void* outRow, unsigned int width, const fk::RtNode* nodes) {\n"
+            "    fk::rt_detail::superKernelRow<" + rt_detail::typeName(input) + ", " +
+            rt_detail::typeName(output) + ops + ">(inRow, outRow, width, nodes);\n"
+            "}\n";
+        RtKernelRegistry::instance().add(RtSuperKernel{ std::move(name), input, std::move(sequence), output,
+            reinterpret_cast<RtRowFunction>(jit.load(body, "fk_rt_super_kernel")) });
+        return pipeline.compile();
+    }
+
+} // namespace fk
+
+#endif // FK_RUNTIME_PIPELINE_JIT_H
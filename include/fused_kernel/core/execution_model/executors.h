@@ -23,9 +23,17 @@
 #include <fused_kernel/algorithms/basic_ops/set.h>
 #include <fused_kernel/core/execution_model/stream.h>
 
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
 #if defined(__NVCC__)
 #include <fused_kernel/core/execution_model/executor_details/executor_kernels.h>
 #endif
+#if defined(FK_ENABLE_PROFILER) && FK_ENABLE_PROFILER
+#include <fused_kernel/core/execution_model/profiler.h>
+#endif
 
 namespace fk {
 
@@ -49,18 +57,73 @@ namespace fk {
         FK_HOST_FUSE void applyExecuteOperations_helper(Tuple<StreamT, Args...>& argTuple) {
             apply(Child::template executeOperations_helper<Args...>, argTuple);
         }
+
+        // The inactive planes of a batch get the default value through the compute IOps,
+        // so it is only a constant when all the IOps after the read are Unary, Binary
+        // or the final Write
+        template <typename IOp>
+        static constexpr bool isConstantOnInactivePlanes =
+            opIs<UnaryType, IOp> || opIs<BinaryType, IOp> || opIs<WriteType, IOp>;
+
+        template <ParArch PA, typename T, typename IOp, typename... IOps>
+        FK_HOST_FUSE void fillInactivePlanes(Stream_<PA>& stream, const T& value, const ActiveThreads& tail,
+                                             const int firstPlane, const IOp& iOp, const IOps&... iOps) {
+            if constexpr (sizeof...(IOps) == 0) {
+                Child::executeOperations_helper(stream, ReadSet<T>::build(value, tail),
+                                                PlaneOffsetWrite<typename IOp::Operation>::build(iOp, firstPlane));
+            } else {
+                fillInactivePlanes(stream, value | iOp, tail, firstPlane, iOps...);
+            }
+        }
+
+        // Launches only the first usedPlanes planes of a CONDITIONAL_WITH_DEFAULT batch read,
+        // and fills the rest with one launch of a constant, unless the caller skips them
+        template <ParArch PA, typename ReadIOp, typename... IOps>
+        FK_HOST_FUSE void executeActivePlanes(Stream_<PA>& stream, const ReadIOp& readIOp, const IOps&... iOps) {
+            constexpr bool CONSTANT_TAIL = (isConstantOnInactivePlanes<IOps> && ...);
+            const bool skip = readIOp.params.inactivePlanes == InactivePlanes::SKIP;
+            if (!CONSTANT_TAIL && !skip) {
+                auto fullArgs = tuple_cat(forward_as_tuple(stream), make_tuple(readIOp, iOps...));
+                applyExecuteOperations_helper(fullArgs);
+                return;
+            }
+            const ActiveThreads planes = readIOp.params.activeThreads;
+            const uint usedPlanes = static_cast<uint>(cxp::max::f(0, cxp::min::f(readIOp.params.usedPlanes,
+                                                                                static_cast<int>(planes.z))));
+            if (usedPlanes > 0) {
+                ReadIOp activeRead = readIOp;
+                activeRead.params.activeThreads.z = usedPlanes;
+                auto fullArgs = tuple_cat(forward_as_tuple(stream), make_tuple(activeRead, iOps...));
+                applyExecuteOperations_helper(fullArgs);
+            }
+            if constexpr (CONSTANT_TAIL) {
+                if (!skip && usedPlanes < planes.z) {
+                    const ActiveThreads tail{ planes.x, planes.y, planes.z - usedPlanes };
+                    fillInactivePlanes(stream, readIOp.params.default_value, tail,
+                                       static_cast<int>(usedPlanes), iOps...);
+                }
+            }
+        }
       public:
         template <ParArch PA, typename... IOps>
         FK_HOST_FUSE void executeOperationsBase_helper(Stream_<PA>& stream, const IOps&... iOps) {
             const auto fb_iOps = BackFuser::fuse_back(iOps...);
-            auto fullArgs = tuple_cat(forward_as_tuple(stream), fb_iOps);
-            applyExecuteOperations_helper(fullArgs);
+            using ReadIOp = std::decay_t<decltype(get<0>(fb_iOps))>;
+            if constexpr (hasInactivePlanes<typename ReadIOp::Operation>) {
+                apply([&stream](const auto&... fbIOps) { executeActivePlanes(stream, fbIOps...); }, fb_iOps);
+            } else {
+                auto fullArgs = tuple_cat(forward_as_tuple(stream), fb_iOps);
+                applyExecuteOperations_helper(fullArgs);
+            }
         }
 
         FK_STATIC_STRUCT(BaseExecutor, BaseExecutor)
 
         template <enum ParArch PA, typename... IOps>
         FK_HOST_FUSE void executeOperations(Stream_<PA>& stream, const IOps&... iOps) {
+#if defined(FK_ENABLE_PROFILER) && FK_ENABLE_PROFILER
+            const auto profileScope = ProfileScope<PA>::template make<Child>(stream, iOps...);
+#endif
             executeOperationsBase_helper(stream, iOps...);
         }
 
@@ -234,10 +297,59 @@ FK_HOST_FUSE void executeOperations(const std::array<Ptr2D<I>, Batch>& input, co
         template <typename... IOpSequenceTypes>
         FK_HOST_FUSE void executeOperations(Stream_<ParArch::CPU> &stream,
                                             const IOpSequenceTypes &...iOpSequences) {
+#if defined(FK_ENABLE_PROFILER) && FK_ENABLE_PROFILER
+            const auto profileScope = ProfileScope<ParArch::CPU>::template make<SelfType>(stream, iOpSequences...);
+#endif
             executeOperations_helper(stream, iOpSequences...);
         }
     };
 
+    // Plane table of CompactedBatchTransformDPP: per-plane extents of the
+    // read IOp, prefix-summed into work items
+    struct CompactedBatchPlanes {
+        FK_STATIC_STRUCT(CompactedBatchPlanes, CompactedBatchPlanes)
+        template <typename ReadIOp>
+        FK_HOST_FUSE std::vector<CompactedPlane> build(const ReadIOp& readIOp, uint& workItems) {
+            using ReadOperation = typename ReadIOp::Operation;
+            const uint numPlanes = readIOp.getActiveThreads().z;
+            std::vector<CompactedPlane> planes(numPlanes);
+            uint64_t items = 0;
+            for (uint z = 0; z < numPlanes; ++z) {
+                const Point thread{ 0, 0, static_cast<int>(z) };
+                const uint width = ReadOperation::num_elems_x(thread, readIOp);
+                const uint height = ReadOperation::num_elems_y(thread, readIOp);
+                planes[z] = CompactedPlane{ static_cast<uint>(items), width };
+                items += static_cast<uint64_t>(width) * height;
+            }
+            if (items > UINT_MAX) {
+                throw std::invalid_argument("CompactedBatchTransformDPP: more than 2^32 - 1 pixels in the batch");
+            }
+            workItems = static_cast<uint>(items);
+            return planes;
+        }
+    };
+
+    template <>
+    struct Executor<CompactedBatchTransformDPP<ParArch::CPU>> {
+    private:
+        using Child = Executor<CompactedBatchTransformDPP<ParArch::CPU>>;
+        using Parent = BaseExecutor<Child>;
+        template <typename... IOps>
+        FK_HOST_FUSE void executeOperations_helper(Stream_<ParArch::CPU>&, const IOps&... iOps) {
+            CompactedBatchTransformDPPDetails details{};
+            const std::vector<CompactedPlane> planes = CompactedBatchPlanes::build(get_arg<0>(iOps...), details.workItems);
+            details.planes = planes.data();
+            details.numPlanes = static_cast<uint>(planes.size());
+            CompactedBatchTransformDPP<ParArch::CPU>::exec(details, iOps...);
+        }
+    public:
+        FK_STATIC_STRUCT(Executor, Child)
+        FK_HOST_FUSE ParArch parArch() {
+            return ParArch::CPU;
+        }
+        DECLARE_EXECUTOR_PARENT_IMPL
+    };
+
 #if defined(__NVCC__)
     struct ComputeBestSolutionBase {
         FK_HOST_FUSE uint computeDiscardedThreads(const uint width, const uint height, const uint blockDimx, const uint blockDimy) {
@@ -406,9 +518,46 @@ FK_HOST_FUSE void executeOperations(const std::array<Ptr2D<I>, Batch>& input, co
         }
         template <typename... IOpSequenceTypes>
         FK_HOST_FUSE void executeOperations(Stream_<ParArch::GPU_NVIDIA>& stream, const IOpSequenceTypes&... iOpSequences) {
+#if defined(FK_ENABLE_PROFILER) && FK_ENABLE_PROFILER
+            const auto profileScope = ProfileScope<ParArch::GPU_NVIDIA>::template make<SelfType>(stream, iOpSequences...);
+#endif
             executeOperations_helper(stream, iOpSequences...);
         }
     };
+
+    template <>
+    struct Executor<CompactedBatchTransformDPP<ParArch::GPU_NVIDIA>> {
+    private:
+        using Child = Executor<CompactedBatchTransformDPP<ParArch::GPU_NVIDIA>>;
+        using Parent = BaseExecutor<Child>;
+        template <typename... IOps>
+        FK_HOST_FUSE void executeOperations_helper(Stream_<ParArch::GPU_NVIDIA>& stream_, const IOps&... iOps) {
+            const cudaStream_t stream = stream_.getCUDAStream();
+            CompactedBatchTransformDPPDetails details{};
+            const std::vector<CompactedPlane> planes = CompactedBatchPlanes::build(get_arg<0>(iOps...), details.workItems);
+            details.numPlanes = static_cast<uint>(planes.size());
+            if (details.workItems == 0) return;
+            // Stream ordered, so the table lives exactly as long as the kernel
+            const size_t bytes = sizeof(CompactedPlane) * planes.size();
+            CompactedPlane* devicePlanes{ nullptr };
+            gpuErrchk(cudaMallocAsync(&devicePlanes, bytes, stream));
+            gpuErrchk(cudaMemcpyAsync(devicePlanes, planes.data(), bytes, cudaMemcpyHostToDevice, stream));
+            details.planes = devicePlanes;
+
+            constexpr uint blockSize = 256;
+            const dim3 block{ blockSize, 1, 1 };
+            const dim3 grid{ (details.workItems + blockSize - 1) / blockSize, 1, 1 };
+            launchCompactedBatchTransformDPP_Kernel<ParArch::GPU_NVIDIA><<<grid, block, 0, stream>>>(details, iOps...);
+            gpuErrchk(cudaGetLastError());
+            gpuErrchk(cudaFreeAsync(devicePlanes, stream));
+        }
+    public:
+        FK_STATIC_STRUCT(Executor, Child)
+        FK_HOST_FUSE ParArch parArch() {
+            return ParArch::GPU_NVIDIA;
+        }
+        DECLARE_EXECUTOR_PARENT_IMPL
+    };
 #endif
 } // namespace fk
 
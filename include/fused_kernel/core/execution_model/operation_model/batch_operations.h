@@ -87,6 +87,12 @@ namespace fk {
     // ################### START BATCH READ #####################
     enum class PlanePolicy { PROCESS_ALL = 0, CONDITIONAL_WITH_DEFAULT = 1 };
 
+    // With CONDITIONAL_WITH_DEFAULT, the executors only launch the first usedPlanes
+    // planes. The rest of the planes are either filled with the default value passed
+    // through the compute IOps (FILL), or not written at all (SKIP). Set it on the
+    // read IOp passed to the executor, fusing batch IOps resets it to FILL.
+    enum class InactivePlanes { FILL = 0, SKIP = 1 };
+
     template <size_t BATCH, enum PlanePolicy PP, typename OpParamsType, typename DefaultType = NullType>
     struct BatchReadParams;
 
@@ -96,6 +102,7 @@ namespace fk {
         int usedPlanes;
         DefaultType default_value;
         ActiveThreads activeThreads;
+        InactivePlanes inactivePlanes{ InactivePlanes::FILL };
     };
 
     template <size_t BATCH, typename Operation>
@@ -456,6 +463,14 @@ namespace fk {
             return BatchReadType::build(paramsStore);
         }
     };
+    // Batch reads whose planes from usedPlanes on are inactive
+    template <typename T, typename = void>
+    struct HasInactivePlanes : std::false_type {};
+    template <typename T>
+    struct HasInactivePlanes<T, std::void_t<decltype(T::PP)>>
+        : std::integral_constant<bool, T::PP == PlanePolicy::CONDITIONAL_WITH_DEFAULT> {};
+    template <typename T>
+    static constexpr bool hasInactivePlanes = HasInactivePlanes<T>::value;
     // ##################### END BATCH_READ #####################
 
 
@@ -511,6 +526,45 @@ namespace fk {
         }
     };
 
+    // Write with thread.z shifted by planeOffset, used by the executors to
+    // fill the inactive planes of a batch with a grid of only those planes
+    template <typename WriteOp>
+    struct PlaneOffsetWriteParams {
+        OperationData<WriteOp> write;
+        int planeOffset;
+    };
+
+    template <typename WriteOp>
+    struct PlaneOffsetWrite {
+    private:
+        using SelfType = PlaneOffsetWrite<WriteOp>;
+    public:
+        FK_STATIC_STRUCT(PlaneOffsetWrite, SelfType)
+        using Parent = WriteOperation<typename WriteOp::InputType, PlaneOffsetWriteParams<WriteOp>,
+                                      typename WriteOp::WriteDataType, TF::DISABLED, PlaneOffsetWrite<WriteOp>>;
+        DECLARE_WRITE_PARENT_BASIC
+
+        template <uint ELEMS_PER_THREAD = 1>
+        FK_HOST_DEVICE_FUSE void exec(const Point thread,
+            const ThreadFusionType<InputType, ELEMS_PER_THREAD, InputType> input,
+            const ParamsType& params) {
+            WriteOp::exec(shift(thread, params), input, params.write);
+        }
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+            return WriteOp::num_elems_x(shift(thread, opData.params), opData.params.write);
+        }
+        FK_HOST_DEVICE_FUSE uint pitch(const Point thread, const OperationDataType& opData) {
+            return WriteOp::pitch(shift(thread, opData.params), opData.params.write);
+        }
+        FK_HOST_FUSE InstantiableType build(const OperationData<WriteOp>& write, const int planeOffset) {
+            return { { { write, planeOffset } } };
+        }
+    private:
+        FK_HOST_DEVICE_FUSE Point shift(const Point thread, const ParamsType& params) {
+            return Point{ thread.x, thread.y, thread.z + params.planeOffset };
+        }
+    };
+
 // MEMORY OPERATION BATCH BUILDERS
 
 // BATCH BUILDERS FOR READ AND READBACK OPERATIONS
@@ -0,0 +1,263 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_DYNAMIC_BATCH_OPERATIONS_H
+#define FK_DYNAMIC_BATCH_OPERATIONS_H
+
+#include <fused_kernel/core/execution_model/operation_model/batch_operations.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+
+#include <stdexcept>
+#include <vector>
+
+/*
+DynamicBatchRead: a BatchRead whose batch size is a runtime value.
+
+BatchRead<PP, BATCH, Op> stores one OperationData per plane by value in its
+params, so every batch size is a different type (a new kernel) and the whole
+array travels in the kernel arguments. DynamicBatchRead<PP, Op> instead keeps
+a RawPtr to a 1D buffer of OperationData<Op>, indexed with thread.z, plus the
+batch size. There is one instantiation per Op, for any batch size, and the
+kernel arguments do not grow with the batch.
+
+The buffer is a Ptr1D<OperationData<Op>> owned by the caller, reused between
+launches: Host memory for the CPU, Device or DeviceAndPinned memory for GPUs.
+build() fills it from a std::vector of IOps (through the pinned copy and an
+upload for DeviceAndPinned), growing it when the batch does not fit. The
+caller keeps it alive, and does not refill it, until the launch is finished.
+
+DynamicBatchRead has no static BATCH member, so the IOp fuser treats it as a
+regular read and the following operations see thread.z as the plane index.
+Only complete operations are supported.
+
+    DynamicBatchRead<PlanePolicy::PROCESS_ALL>::build(iOps, planes, stream)
+    DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT>::build(iOps, usedPlanes, defaultValue, planes, stream)
+*/
+
+namespace fk {
+
+    template <enum PlanePolicy PP, typename Operation, typename DefaultType = NullType>
+    struct DynamicBatchReadParams;
+
+    template <typename Operation, typename DefaultType>
+    struct DynamicBatchReadParams<PlanePolicy::CONDITIONAL_WITH_DEFAULT, Operation, DefaultType> {
+        RawPtr<ND::_1D, OperationData<Operation>> opData;
+        int usedPlanes;
+        DefaultType default_value;
+        ActiveThreads activeThreads;
+        InactivePlanes inactivePlanes{ InactivePlanes::FILL };
+    };
+
+    template <typename Operation>
+    struct DynamicBatchReadParams<PlanePolicy::PROCESS_ALL, Operation, NullType> {
+        RawPtr<ND::_1D, OperationData<Operation>> opData;
+        ActiveThreads activeThreads;
+    };
+
+    template <PlanePolicy PP = PlanePolicy::PROCESS_ALL, typename Operation = void>
+    struct DynamicBatchRead;
+
+    template <typename Op>
+    struct DynamicBatchRead<PlanePolicy::PROCESS_ALL, Op> {
+        static_assert(isCompleteOperation<Op>,
+            "The IOp passed as template parameter is not a complete operation");
+    private:
+        using SelfType = DynamicBatchRead<PlanePolicy::PROCESS_ALL, Op>;
+    public:
+        FK_STATIC_STRUCT(DynamicBatchRead, SelfType)
+        using Operation = Op;
+        static constexpr PlanePolicy PP = PlanePolicy::PROCESS_ALL;
+
+        using ParamsType = DynamicBatchReadParams<PP, Operation>;
+        using ReadDataType = typename Operation::ReadDataType;
+        using InstanceType = ReadType;
+        using OutputType = typename Operation::OutputType;
+        using OperationDataType = OperationData<SelfType>;
+        using InstantiableType = Read<SelfType>;
+        static constexpr bool IS_FUSED_OP = Operation::IS_FUSED_OP;
+        static constexpr bool THREAD_FUSION = Operation::THREAD_FUSION;
+
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+            return Operation::num_elems_x(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE uint num_elems_y(const Point thread, const OperationDataType& opData) {
+            return Operation::num_elems_y(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE uint num_elems_z(const Point thread, const OperationDataType& opData) {
+            return opData.params.activeThreads.z;
+        }
+        FK_HOST_DEVICE_FUSE uint pitch(const Point thread, const OperationDataType& opData) {
+            return Operation::pitch(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE ActiveThreads getActiveThreads(const OperationDataType& opData) {
+            return opData.params.activeThreads;
+        }
+
+        template <uint ELEMS_PER_THREAD = 1>
+        FK_HOST_DEVICE_FUSE auto exec(const Point thread, const OperationDataType& opData) {
+            return exec<ELEMS_PER_THREAD>(thread, opData.params);
+        }
+        template <uint ELEMS_PER_THREAD = 1>
+        FK_HOST_DEVICE_FUSE auto exec(const Point thread, const ParamsType& params) {
+            if constexpr (THREAD_FUSION) {
+                return Operation::template exec<ELEMS_PER_THREAD>(thread, params.opData.data[thread.z]);
+            } else {
+                return Operation::exec(thread, params.opData.data[thread.z]);
+            }
+        }
+        FK_HOST_FUSE InstantiableType build(const OperationDataType& opData) {
+            return InstantiableType{ opData };
+        }
+        FK_HOST_FUSE InstantiableType build(const ParamsType& params) {
+            return InstantiableType{ {params} };
+        }
+    };
+
+    template <typename Op>
+    struct DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT, Op> {
+        static_assert(isCompleteOperation<Op>,
+            "The IOp passed as template parameter is not a complete operation");
+    private:
+        using SelfType = DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT, Op>;
+    public:
+        FK_STATIC_STRUCT(DynamicBatchRead, SelfType)
+        using Operation = Op;
+        static constexpr PlanePolicy PP = PlanePolicy::CONDITIONAL_WITH_DEFAULT;
+
+        using ParamsType = DynamicBatchReadParams<PP, Operation, typename Operation::OutputType>;
+        using ReadDataType = typename Operation::ReadDataType;
+        using InstanceType = ReadType;
+        using OutputType = typename Operation::OutputType;
+        using OperationDataType = OperationData<SelfType>;
+        using InstantiableType = Read<SelfType>;
+        static constexpr bool IS_FUSED_OP = Operation::IS_FUSED_OP;
+        static constexpr bool THREAD_FUSION = false;
+
+        FK_HOST_DEVICE_FUSE uint num_elems_x(const Point thread, const OperationDataType& opData) {
+            return Operation::num_elems_x(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE uint num_elems_y(const Point thread, const OperationDataType& opData) {
+            return Operation::num_elems_y(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE uint num_elems_z(const Point thread, const OperationDataType& opData) {
+            return opData.params.activeThreads.z;
+        }
+        FK_HOST_DEVICE_FUSE uint pitch(const Point thread, const OperationDataType& opData) {
+            return Operation::pitch(thread, opData.params.opData.data[thread.z]);
+        }
+        FK_HOST_DEVICE_FUSE ActiveThreads getActiveThreads(const OperationDataType& opData) {
+            return opData.params.activeThreads;
+        }
+
+        template <uint ELEMS_PER_THREAD = 1>
+        FK_HOST_DEVICE_FUSE auto exec(const Point thread, const OperationDataType& opData) {
+            return exec<ELEMS_PER_THREAD>(thread, opData.params);
+        }
+        template <uint ELEMS_PER_THREAD = 1>
+        FK_HOST_DEVICE_FUSE auto exec(const Point thread, const ParamsType& params) {
+            if (params.usedPlanes <= thread.z) {
+                return params.default_value;
+            } else {
+                return Operation::exec(thread, params.opData.data[thread.z]);
+            }
+        }
+        FK_HOST_FUSE InstantiableType build(const OperationDataType& opData) {
+            return InstantiableType{ opData };
+        }
+        FK_HOST_FUSE InstantiableType build(const ParamsType& params) {
+            return InstantiableType{ {params} };
+        }
+    };
+
+    struct DynamicBatchUtils {
+        FK_STATIC_STRUCT(DynamicBatchUtils, DynamicBatchUtils)
+
+        // Copies the IOps into planes, reallocating it if it is too small, and
+        // returns the maximum plane size
+        template <typename IOp, typename StreamType>
+        FK_HOST_FUSE ActiveThreads fill(const std::vector<IOp>& iOps,
+                                        Ptr1D<OperationData<typename IOp::Operation>>& planes,
+                                        StreamType& stream) {
+            using Operation = typename IOp::Operation;
+            if (iOps.empty()) {
+                throw std::invalid_argument("DynamicBatchRead: the batch is empty");
+            }
+            // A CPU launch reads planes.ptr() directly, so planes must live in host
+            // memory, whatever defaultMemType is in this translation unit
+            constexpr bool CPU_STREAM = StreamType::parArch() == ParArch::CPU;
+            const uint batch = static_cast<uint>(iOps.size());
+            if (planes.dims().width < batch) {
+                const MemType type = planes.dims().width != 0 ? planes.getMemType() :
+                                     (CPU_STREAM ? MemType::Host : defaultMemType);
+                planes = Ptr1D<OperationData<Operation>>(batch, 0, type, planes.getDeviceID());
+            }
+            if constexpr (CPU_STREAM) {
+                if (planes.getMemType() != MemType::Host && planes.getMemType() != MemType::HostPinned) {
+                    throw std::invalid_argument("DynamicBatchRead: planes must be in host memory for CPU streams");
+                }
+            } else if (planes.getMemType() == MemType::Device) {
+                throw std::invalid_argument("DynamicBatchRead: planes must be host accessible, use MemType::DeviceAndPinned on GPUs");
+            }
+            OperationData<Operation>* const host = planes.getMemType() == MemType::DeviceAndPinned ?
+                                                   planes.ptrPinned().data : planes.ptr().data;
+            uint maxWidth{ 0 };
+            uint maxHeight{ 0 };
+            for (uint i = 0; i < batch; ++i) {
+                host[i] = iOps[i];
+                maxWidth = cxp::max::f(maxWidth, Operation::num_elems_x(Point{ 0, 0, 0 }, iOps[i]));
+                maxHeight = cxp::max::f(maxHeight, Operation::num_elems_y(Point{ 0, 0, 0 }, iOps[i]));
+            }
+            if constexpr (!CPU_STREAM) {
+                planes.upload(stream);
+            }
+            return ActiveThreads{ maxWidth, maxHeight, batch };
+        }
+    };
+
+    template <>
+    struct DynamicBatchRead<PlanePolicy::PROCESS_ALL, void> {
+    private:
+        using SelfType = DynamicBatchRead<PlanePolicy::PROCESS_ALL, void>;
+    public:
+        FK_STATIC_STRUCT(DynamicBatchRead, SelfType)
+        template <typename IOp, typename StreamType>
+        FK_HOST_FUSE auto build(const std::vector<IOp>& iOps, Ptr1D<OperationData<typename IOp::Operation>>& planes,
+                                StreamType& stream) {
+            using BatchReadType = DynamicBatchRead<PlanePolicy::PROCESS_ALL, typename IOp::Operation>;
+            const ActiveThreads activeThreads = DynamicBatchUtils::fill(iOps, planes, stream);
+            return BatchReadType::build(typename BatchReadType::ParamsType{ planes.ptr(), activeThreads });
+        }
+    };
+
+    template <>
+    struct DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT, void> {
+    private:
+        using SelfType = DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT, void>;
+    public:
+        FK_STATIC_STRUCT(DynamicBatchRead, SelfType)
+        // The grid covers iOps.size() planes, those from usedPlanes on return defaultValue
+        template <typename IOp, typename DefaultType, typename StreamType>
+        FK_HOST_FUSE auto build(const std::vector<IOp>& iOps, const int& usedPlanes, const DefaultType& defaultValue,
+                                Ptr1D<OperationData<typename IOp::Operation>>& planes, StreamType& stream) {
+            using Operation = typename IOp::Operation;
+            using BatchReadType = DynamicBatchRead<PlanePolicy::CONDITIONAL_WITH_DEFAULT, Operation>;
+            const ActiveThreads activeThreads = DynamicBatchUtils::fill(iOps, planes, stream);
+            return BatchReadType::build(typename BatchReadType::ParamsType{ planes.ptr(), usedPlanes,
+                cxp::cast<typename Operation::OutputType>::f(defaultValue), activeThreads });
+        }
+    };
+
+} // namespace fk
+
+#endif // FK_DYNAMIC_BATCH_OPERATIONS_H
@@ -0,0 +1,460 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#ifndef FK_PROFILER_H
+#define FK_PROFILER_H
+
+/* Per-pipeline execution profiler for BaseExecutor::executeOperations.
+ *
+ * Compiled in only with FK_ENABLE_PROFILER=1 (CMake: ENABLE_PROFILER); with
+ * the default of 0 the executors contain no profiling code at all. When
+ * compiled in, Profiler::enable() switches recording on at runtime and a
+ * disabled profiler costs one relaxed atomic load per executeOperations.
+ *
+ * Each executeOperations call is recorded against its pipeline, identified
+ * by the executor and IOp types (typeToString): call count, active-thread
+ * volume, bytes read and written and wall / stream time. Bytes come from the
+ * RawPtr dims of the Read and Write IOps; Read or Write IOps without a
+ * RawPtr (fused, batch or ReadBack IOps) count active threads times their
+ * ReadDataType / WriteDataType. On CPU the stream is synchronous, so stream
+ * time equals wall time; on GPU it is measured with CUDA events, which
+ * synchronizes the stream after every profiled launch.
+ *
+ * Totals per pipeline are kept in atomics; individual calls go to a
+ * fixed-size lock-free ring buffer (the newest RING_CAPACITY calls) that
+ * chromeTrace() dumps in the Chrome trace event format (chrome://tracing,
+ * Perfetto). */
+
+#ifndef FK_ENABLE_PROFILER
+#define FK_ENABLE_PROFILER 0
+#endif
+
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/core/execution_model/operation_model/operation_types.h>
+#include <fused_kernel/core/execution_model/parallel_architectures.h>
+#include <fused_kernel/core/execution_model/stream.h>
+#include <fused_kernel/core/utils/type_to_string.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fk {
+
+    struct PipelineTraffic {
+        uint64_t activeThreads{ 0 };
+        uint64_t bytesRead{ 0 };
+        uint64_t bytesWritten{ 0 };
+    };
+
+    // Running totals of one pipeline type
+    struct PipelineProfile {
+        std::string signature;
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> activeThreads{ 0 };
+        std::atomic<uint64_t> bytesRead{ 0 };
+        std::atomic<uint64_t> bytesWritten{ 0 };
+        std::atomic<uint64_t> wallNs{ 0 };
+        std::atomic<uint64_t> streamNs{ 0 };
+
+        explicit PipelineProfile(std::string signature_) : signature(std::move(signature_)) {}
+    };
+
+    struct PipelineSummary {
+        std::string signature;
+        uint64_t calls;
+        uint64_t activeThreads;
+        uint64_t bytesRead;
+        uint64_t bytesWritten;
+        double wallMs;
+        double streamMs;
+    };
+
+    struct ProfileEvent {
+        PipelineProfile* pipeline{ nullptr };
+        uint64_t threadId{ 0 };
+        uint64_t startNs{ 0 };      // since the profiler epoch
+        uint64_t wallNs{ 0 };
+        uint64_t streamNs{ 0 };
+        PipelineTraffic traffic{};
+    };
+
+    class Profiler {
+    public:
+        static constexpr size_t RING_CAPACITY = size_t{ 1 } << 14;
+
+        static inline Profiler& instance() {
+            static Profiler profiler;
+            return profiler;
+        }
+
+        static inline bool enabled() { return instance().m_enabled.load(std::memory_order_relaxed); }
+        static inline void enable(const bool on = true) { instance().m_enabled.store(on, std::memory_order_relaxed); }
+
+        // One PipelineProfile per executor + IOp types, registered on first use
+        template <typename Executor, typename... IOps>
+        static inline PipelineProfile& pipeline() {
+            static PipelineProfile* const profile = instance().registerPipeline(signature<Executor, IOps...>());
+            return *profile;
+        }
+
+        template <typename Executor, typename... IOps>
+        static inline std::string signature() {
+            std::string text = typeToString<Executor>() + "(";
+            const std::array<std::string, sizeof...(IOps)> names{ typeToString<IOps>()... };
+            for (size_t i = 0; i < names.size(); ++i) {
+                text += (i ? ", " : "") + names[i];
+            }
+            return text + ")";
+        }
+
+        inline uint64_t nowNs() const {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_epoch).count());
+        }
+
+        static inline uint64_t threadId() {
+            return static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        }
+
+        // Lock-free: a writer claims a slot with fetch_add and publishes it with
+        // a per-slot sequence number, odd while the event is being written. The
+        // event is stored as atomic words, so a reader copying a slot that is
+        // being rewritten sees a changed sequence rather than a data race.
+        inline void record(const ProfileEvent& event) {
+            PipelineProfile& p = *event.pipeline;
+            p.calls.fetch_add(1, std::memory_order_relaxed);
+            p.activeThreads.fetch_add(event.traffic.activeThreads, std::memory_order_relaxed);
+            p.bytesRead.fetch_add(event.traffic.bytesRead, std::memory_order_relaxed);
+            p.bytesWritten.fetch_add(event.traffic.bytesWritten, std::memory_order_relaxed);
+            p.wallNs.fetch_add(event.wallNs, std::memory_order_relaxed);
+            p.streamNs.fetch_add(event.streamNs, std::memory_order_relaxed);
+
+            const uint64_t index = m_head.fetch_add(1, std::memory_order_relaxed);
+            Slot& slot = m_ring[index & (RING_CAPACITY - 1)];
+            uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            do {
+                // Already holds a newer call: this one is out of the ring anyway
+                if (sequence >= 2 * index + 2) return;
+                // A write RING_CAPACITY calls older is still in progress: rather
+                // than wait for it, this event is lost
+                if (sequence & 1) {
+                    m_lost.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            } while (!slot.sequence.compare_exchange_weak(sequence, 2 * index + 1, std::memory_order_relaxed));
+            std::atomic_thread_fence(std::memory_order_release);
+            uint64_t words[EVENT_WORDS];
+            std::memcpy(words, &event, sizeof(ProfileEvent));
+            for (size_t i = 0; i < EVENT_WORDS; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+        }
+
+        // Retained events, oldest first. A slot still being written with its
+        // event is retried, one not yet claimed or reused by a newer call skipped.
+        inline std::vector<ProfileEvent> events() const {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            const uint64_t first = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+            std::vector<ProfileEvent> result;
+            result.reserve(static_cast<size_t>(head - first));
+            for (uint64_t index = first; index < head; ++index) {
+                const Slot& slot = m_ring[index & (RING_CAPACITY - 1)];
+                while (true) {
+                    const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                    // Only waits for the few stores of this very event
+                    if (before == 2 * index + 1) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if (before != 2 * index + 2) break;
+                    uint64_t words[EVENT_WORDS];
+                    for (size_t i = 0; i < EVENT_WORDS; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                        ProfileEvent event;
+                        std::memcpy(&event, words, sizeof(ProfileEvent));
+                        result.push_back(event);
+                    }
+                    break;
+                }
+            }
+            return result;
+        }
+
+        // Calls that are not in events(): pushed out of the ring by newer calls,
+        // or lost to a slot still being written by a call RING_CAPACITY older
+        inline uint64_t droppedEvents() const {
+            const uint64_t head = m_head.load(std::memory_order_relaxed);
+            return (head > RING_CAPACITY ? head - RING_CAPACITY : 0) + m_lost.load(std::memory_order_relaxed);
+        }
+
+        inline std::vector<PipelineSummary> summary() const {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            std::vector<PipelineSummary> result;
+            for (const auto& p : m_pipelines) {
+                const uint64_t calls = p->calls.load(std::memory_order_relaxed);
+                if (calls == 0) continue;
+                result.push_back({ p->signature, calls, p->activeThreads.load(std::memory_order_relaxed),
+                                   p->bytesRead.load(std::memory_order_relaxed),
+                                   p->bytesWritten.load(std::memory_order_relaxed),
+                                   p->wallNs.load(std::memory_order_relaxed) * 1e-6,
+                                   p->streamNs.load(std::memory_order_relaxed) * 1e-6 });
+            }
+            return result;
+        }
+
+        // Clears totals and events; pipelines stay registered. Not to be
+        // called while other threads are recording.
+        inline void reset() {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            for (auto& p : m_pipelines) {
+                p->calls = 0;
+                p->activeThreads = 0;
+                p->bytesRead = 0;
+                p->bytesWritten = 0;
+                p->wallNs = 0;
+                p->streamNs = 0;
+            }
+            for (size_t i = 0; i < RING_CAPACITY; ++i) m_ring[i].sequence.store(0, std::memory_order_relaxed);
+            m_lost.store(0, std::memory_order_relaxed);
+            m_head.store(0, std::memory_order_release);
+        }
+
+        inline std::string chromeTrace() const {
+            std::ostringstream os;
+            os << "{\"traceEvents\": [";
+            bool first = true;
+            for (const ProfileEvent& e : events()) {
+                os << (first ? "\n" : ",\n") << "  {\"name\": \"" << escape(e.pipeline->signature)
+                   << "\", \"cat\": \"fkl\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.threadId
+                   << ", \"ts\": " << e.startNs / 1000. << ", \"dur\": " << e.wallNs / 1000.
+                   << ", \"args\": {\"active_threads\": " << e.traffic.activeThreads
+                   << ", \"bytes_read\": " << e.traffic.bytesRead
+                   << ", \"bytes_written\": " << e.traffic.bytesWritten
+                   << ", \"stream_us\": " << e.streamNs / 1000. << "}}";
+                first = false;
+            }
+            os << "\n], \"displayTimeUnit\": \"ns\"}\n";
+            return os.str();
+        }
+
+        inline void writeChromeTrace(const std::string& fileName) const {
+            std::ofstream file(fileName);
+            if (!file) {
+                throw std::runtime_error("Profiler: cannot open " + fileName);
+            }
+            file << chromeTrace();
+        }
+
+    private:
+        static_assert(std::is_trivially_copyable_v<ProfileEvent> && sizeof(ProfileEvent) % sizeof(uint64_t) == 0,
+                      "ProfileEvent is copied through the ring as 64 bit words");
+        static constexpr size_t EVENT_WORDS = sizeof(ProfileEvent) / sizeof(uint64_t);
+
+        struct Slot {
+            std::atomic<uint64_t> sequence{ 0 };    // 2 * index + 2 once written, odd while writing
+            std::atomic<uint64_t> words[EVENT_WORDS]{};
+        };
+
+        std::atomic<bool> m_enabled{ false };
+        std::atomic<uint64_t> m_head{ 0 };
+        std::atomic<uint64_t> m_lost{ 0 };
+        std::unique_ptr<Slot[]> m_ring{ new Slot[RING_CAPACITY] };
+        const std::chrono::steady_clock::time_point m_epoch{ std::chrono::steady_clock::now() };
+        mutable std::mutex m_registryMutex;
+        std::vector<std::unique_ptr<PipelineProfile>> m_pipelines;
+
+        Profiler() = default;
+
+        inline PipelineProfile* registerPipeline(std::string signature) {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            m_pipelines.push_back(std::make_unique<PipelineProfile>(std::move(signature)));
+            return m_pipelines.back().get();
+        }
+
+        // Same escaping as the JSON of BenchmarkReport: control characters are written as \u00XX
+        static inline std::string escape(const std::string& s) {
+            std::string out;
+            for (const char c : s) {
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+                    out += code;
+                    continue;
+                }
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+    };
+
+    namespace profiler_detail {
+        template <typename T>
+        struct IsRawPtr : std::false_type {};
+        template <ND D, typename T>
+        struct IsRawPtr<RawPtr<D, T>> : std::true_type {};
+
+        template <typename T>
+        struct IsIOpSequence : std::false_type {};
+        template <typename... IOps>
+        struct IsIOpSequence<IOpSequence<IOps...>> : std::true_type {};
+
+        template <ND D, typename T>
+        inline uint64_t rawPtrBytes(const RawPtr<D, T>& ptr) {
+            return static_cast<uint64_t>(PtrImpl<D, T>::getNumElements(ptr.dims)) * sizeof(T);
+        }
+
+        template <typename IOp>
+        inline uint64_t ioBytes(const IOp& iOp, const uint64_t activeThreads) {
+            if constexpr (requires { iOp.params; } && IsRawPtr<std::decay_t<decltype(iOp.params)>>::value) {
+                return rawPtrBytes(iOp.params);
+            } else if constexpr (isAnyReadType<IOp> && requires { typename IOp::Operation::ReadDataType; }) {
+                return activeThreads * sizeof(typename IOp::Operation::ReadDataType);
+            } else if constexpr (isAnyWriteType<IOp> && requires { typename IOp::Operation::WriteDataType; }) {
+                return activeThreads * sizeof(typename IOp::Operation::WriteDataType);
+            } else {
+                return 0;
+            }
+        }
+    } // namespace profiler_detail
+
+    // Divergent batches pass one IOpSequence per plane group: their traffic
+    // is the sum of the traffic of each sequence
+    template <typename FirstIOp, typename... IOps>
+    inline PipelineTraffic pipelineTraffic(const FirstIOp& firstIOp, const IOps&... iOps) {
+        PipelineTraffic traffic;
+        if constexpr (profiler_detail::IsIOpSequence<FirstIOp>::value) {
+            const auto add = [&](const auto& iOpSequence) {
+                const PipelineTraffic t = apply([](const auto&... seqIOps) { return pipelineTraffic(seqIOps...); },
+                                                iOpSequence.iOps);
+                traffic.activeThreads += t.activeThreads;
+                traffic.bytesRead += t.bytesRead;
+                traffic.bytesWritten += t.bytesWritten;
+            };
+            add(firstIOp);
+            (add(iOps), ...);
+            return traffic;
+        }
+        if constexpr (requires { firstIOp.getActiveThreads(); }) {
+            const ActiveThreads at = firstIOp.getActiveThreads();
+            traffic.activeThreads = static_cast<uint64_t>(at.x) * at.y * at.z;
+        }
+        const auto account = [&](const auto& iOp) {
+            using IOp = std::decay_t<decltype(iOp)>;
+            if constexpr (isAnyReadType<IOp>) {
+                traffic.bytesRead += profiler_detail::ioBytes(iOp, traffic.activeThreads);
+            } else if constexpr (isAnyWriteType<IOp>) {
+                traffic.bytesWritten += profiler_detail::ioBytes(iOp, traffic.activeThreads);
+            }
+        };
+        account(firstIOp);
+        (account(iOps), ...);
+        return traffic;
+    }
+
+    // Records one executeOperations call on destruction; inert when the
+    // profiler is disabled at construction.
+    template <ParArch PA>
+    class ProfileScope {
+        PipelineProfile* m_pipeline{ nullptr };
+        ProfileEvent m_event{};
+    public:
+        template <typename Executor, typename... IOps>
+        static inline ProfileScope make(Stream_<PA>& stream, const IOps&... iOps) {
+            if (!Profiler::enabled()) return ProfileScope{};
+            return ProfileScope(stream, Profiler::pipeline<Executor, IOps...>(), pipelineTraffic(iOps...));
+        }
+
+        ProfileScope() = default;
+        ProfileScope(Stream_<PA>&, PipelineProfile& pipeline, const PipelineTraffic& traffic) : m_pipeline(&pipeline) {
+            m_event.pipeline = &pipeline;
+            m_event.threadId = Profiler::threadId();
+            m_event.traffic = traffic;
+            m_event.startNs = Profiler::instance().nowNs();
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&& other) noexcept : m_pipeline(other.m_pipeline), m_event(other.m_event) {
+            other.m_pipeline = nullptr;
+        }
+        ~ProfileScope() {
+            if (m_pipeline == nullptr) return;
+            m_event.wallNs = Profiler::instance().nowNs() - m_event.startNs;
+            m_event.streamNs = m_event.wallNs;
+            Profiler::instance().record(m_event);
+        }
+    };
+
+#if defined(__NVCC__)
+    template <>
+    class ProfileScope<ParArch::GPU_NVIDIA> {
+        PipelineProfile* m_pipeline{ nullptr };
+        ProfileEvent m_event{};
+        cudaStream_t m_stream{};
+        cudaEvent_t m_start{}, m_stop{};
+    public:
+        template <typename Executor, typename... IOps>
+        static inline ProfileScope make(Stream_<ParArch::GPU_NVIDIA>& stream, const IOps&... iOps) {
+            if (!Profiler::enabled()) return ProfileScope{};
+            return ProfileScope(stream, Profiler::pipeline<Executor, IOps...>(), pipelineTraffic(iOps...));
+        }
+
+        ProfileScope() = default;
+        ProfileScope(Stream_<ParArch::GPU_NVIDIA>& stream, PipelineProfile& pipeline, const PipelineTraffic& traffic)
+            : m_pipeline(&pipeline), m_stream(stream.getCUDAStream()) {
+            m_event.pipeline = &pipeline;
+            m_event.threadId = Profiler::threadId();
+            m_event.traffic = traffic;
+            gpuErrchk(cudaEventCreate(&m_start));
+            gpuErrchk(cudaEventCreate(&m_stop));
+            m_event.startNs = Profiler::instance().nowNs();
+            gpuErrchk(cudaEventRecord(m_start, m_stream));
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&& other) noexcept
+            : m_pipeline(other.m_pipeline), m_event(other.m_event), m_stream(other.m_stream),
+              m_start(other.m_start), m_stop(other.m_stop) {
+            other.m_pipeline = nullptr;
+        }
+        ~ProfileScope() {
+            if (m_pipeline == nullptr) return;
+            float ms = 0.f;
+            gpuErrchk(cudaEventRecord(m_stop, m_stream));
+            gpuErrchk(cudaEventSynchronize(m_stop));
+            m_event.wallNs = Profiler::instance().nowNs() - m_event.startNs;
+            gpuErrchk(cudaEventElapsedTime(&ms, m_start, m_stop));
+            m_event.streamNs = static_cast<uint64_t>(static_cast<double>(ms) * 1e6);
+            gpuErrchk(cudaEventDestroy(m_start));
+            gpuErrchk(cudaEventDestroy(m_stop));
+            Profiler::instance().record(m_event);
+        }
+    };
+#endif // defined(__NVCC__)
+
+} // namespace fk
+
+#endif // FK_PROFILER_H
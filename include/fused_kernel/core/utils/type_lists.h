@@ -18,6 +18,7 @@
 #ifndef FK_TYPE_LIST
 #define FK_TYPE_LIST
 
+#include <array>
 #include <utility>
 #include <type_traits>
 #include <fused_kernel/core/utils/utils.h>
@@ -143,30 +144,24 @@ namespace fk { // namespace fused kernel
     struct TypeIndex;
 
     /**
-     * @struct TypeIndex<T, TypeList<T, Types...>>
-     * @brief TypeIndex especialization that implements the case when T is
-     * the same type as the first type in TypeList.
+     * @struct TypeIndex<T, TypeList<Types...>>
+     * @brief TypeIndex especialization that finds the first position of T in TypeList.
      *
-     * This the stop condition of the recursive algorithm.
+     * The comparison is expanded once over the whole list and searched in a constexpr
+     * lambda, so there is no recursive instantiation per element.
      */
     template <typename T, typename... Types>
-    struct TypeIndex<T, TypeList<T, Types...>> {
-        static constexpr size_t value = 0;
-    };
-
-    /**
-     * @struct TypeIndex<T, TypeList<U, Types...>>
-     * @brief TypeIndex especialization that implements the case when T is
-     * not the same type as the first type in TypeList.
-     *
-     * If T is not the same type as the first Type in TypeList, U, then we define value to be 1 + 
-     * whatever is expanded by TypeIndex<T, TypeList<Types...>>::value which will evaluate the 
-     * TypeList minus U type.
-     */
-    template <typename T, typename U, typename... Types>
-    struct TypeIndex<T, TypeList<U, Types...>> {
-        static_assert(one_of<T, TypeList<U, Types...>>::value == true, "The type is not on the type list");
-        static constexpr size_t value = 1 + TypeIndex<T, TypeList<Types...>>::value;
+    struct TypeIndex<T, TypeList<Types...>> {
+        static_assert(one_of<T, TypeList<Types...>>::value == true, "The type is not on the type list");
+        static constexpr size_t value = []() {
+            constexpr std::array<bool, sizeof...(Types)> isSame{ std::is_same_v<T, Types>... };
+            for (size_t i = 0; i < sizeof...(Types); ++i) {
+                if (isSame[i]) {
+                    return i;
+                }
+            }
+            return sizeof...(Types);
+        }();
     };
 
     /**
@@ -211,20 +206,15 @@ namespace fk { // namespace fused kernel
         using type = TypeList<T>;
     };
 
-    template <size_t Index, typename T, typename Head>
-    struct InsertType<Index, T, TypeList<Head>> {
-        using type = std::conditional_t<Index == 0,
-            TypeList<T, Head>,
-            TypeList<Head, T>
-        >;
-    };
-
-    template <size_t Index, typename T, typename Head, typename... Tail>
-    struct InsertType<Index, T, TypeList<Head, Tail...>> {
-        using type = std::conditional_t<Index == 0,
-                                        TypeList<T, Head, Tail...>,
-                                        TypeListCat_t<TypeList<Head>, typename InsertType<Index - 1, T, TypeList<Tail...>>::type>
-                                       >;
+    template <size_t Index, typename T, typename... Types>
+    struct InsertType<Index, T, TypeList<Types...>> {
+        static_assert(Index <= sizeof...(Types), "Index out of range");
+    private:
+        template <size_t... PreIdx, size_t... PostIdx>
+        static TypeList<TypeAt_t<PreIdx, TypeList<Types...>>..., T, TypeAt_t<Index + PostIdx, TypeList<Types...>>...>
+        insert(const std::index_sequence<PreIdx...>&, const std::index_sequence<PostIdx...>&);
+    public:
+        using type = decltype(insert(std::make_index_sequence<Index>{}, std::make_index_sequence<sizeof...(Types) - Index>{}));
     };
 
     template <size_t Index, typename T, typename TypeList>
@@ -239,53 +229,53 @@ namespace fk { // namespace fused kernel
     template <size_t Index, typename... Types>
     struct RemoveType;
 
-    template <typename Head, typename... Tail>
-    struct RemoveType<0, TypeList<Head, Tail...>> {
-        using type = TypeList<Tail...>; // Remove the first type
-    };
-
-    template <size_t Index, typename Head, typename... Tail>
-    struct RemoveType<Index, TypeList<Head, Tail...>> {
-        static_assert(Index < TypeList<Head, Tail...>::size, "Index out of range");
-        using type = TypeListCat_t<TypeList<Head>, typename RemoveType<Index - 1, TypeList<Tail...>>::type>;
+    template <size_t Index, typename... Types>
+    struct RemoveType<Index, TypeList<Types...>> {
+        static_assert(Index < sizeof...(Types), "Index out of range");
+    private:
+        template <size_t... PreIdx, size_t... PostIdx>
+        static TypeList<TypeAt_t<PreIdx, TypeList<Types...>>..., TypeAt_t<Index + 1 + PostIdx, TypeList<Types...>>...>
+        remove(const std::index_sequence<PreIdx...>&, const std::index_sequence<PostIdx...>&);
+    public:
+        using type = decltype(remove(std::make_index_sequence<Index>{}, std::make_index_sequence<sizeof...(Types) - Index - 1>{}));
     };
 
     template <size_t Index, typename TypeList>
     using RemoveType_t = typename RemoveType<Index, TypeList>::type;
 
-    template <typename T, typename Restriction, typename TypeList, bool last, T currentInt, T... integers>
+    // Flat filtering: the restriction is evaluated once per type into a constexpr array,
+    // and the resulting integer sequence is expanded from it in a single step. This keeps
+    // the instantiation depth constant, independently of the TypeList size.
+    template <typename T, typename Restriction, typename TypeList>
     struct RestrictedIntegerSequenceBuilder;
 
-    template <typename T, typename Restriction, typename TypeList, T currentInt, T... integers>
-    struct RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, false, currentInt, integers...> {
-        static_assert(TypeList::size > 0, "Can't generate an integer sequence for an empty TypeList");
-        using type = std::conditional_t<(sizeof...(integers) > 0),
-            std::conditional_t <TypeList::size == currentInt + 1,
-                std::conditional_t<Restriction::template complies<TypeAt_t<currentInt, TypeList>>(),
-                    std::integer_sequence<T, integers..., currentInt>,
-                    std::integer_sequence<T, integers...>>,
-                std::conditional_t<Restriction::template complies<TypeAt_t<currentInt, TypeList>>(),
-                    typename RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, currentInt + 1 == TypeList::size, currentInt + 1, integers..., currentInt>::type,
-                    typename RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, currentInt + 1 == TypeList::size, currentInt + 1, integers...>::type>>,
-            std::conditional_t<TypeList::size == 1,
-                std::conditional_t<Restriction::template complies<TypeAt_t<currentInt, TypeList>>(),
-                    std::integer_sequence<T, currentInt>,
-                    std::integer_sequence<T>>,
-                std::conditional_t<Restriction::template complies<TypeAt_t<currentInt, TypeList>>(),
-                    typename RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, currentInt + 1 == TypeList::size, currentInt + 1, currentInt>::type,
-                    typename RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, currentInt + 1 == TypeList::size, currentInt + 1>::type>>>;
-    };
-
-    template <typename T, typename Restriction, typename TypeList, T currentInt, T... integers>
-    struct RestrictedIntegerSequenceBuilder<T, Restriction, TypeList, true, currentInt, integers...> {
-        using type = std::conditional_t<(sizeof...(integers) > 0), std::integer_sequence<T,integers...>, std::integer_sequence<T>>;
+    template <typename T, typename Restriction, typename... Types>
+    struct RestrictedIntegerSequenceBuilder<T, Restriction, TypeList<Types...>> {
+        static_assert(sizeof...(Types) > 0, "Can't generate an integer sequence for an empty TypeList");
+    private:
+        static constexpr std::array<bool, sizeof...(Types)> complies{ Restriction::template complies<Types>()... };
+        static constexpr size_t count = (static_cast<size_t>(Restriction::template complies<Types>()) + ...);
+        static constexpr std::array<T, (count > 0 ? count : 1)> integers = []() {
+            std::array<T, (count > 0 ? count : 1)> result{};
+            size_t j = 0;
+            for (size_t i = 0; i < sizeof...(Types); ++i) {
+                if (complies[i]) {
+                    result[j++] = static_cast<T>(i);
+                }
+            }
+            return result;
+        }();
+        template <size_t... Js>
+        static std::integer_sequence<T, integers[Js]...> expand(const std::index_sequence<Js...>&);
+    public:
+        using type = decltype(expand(std::make_index_sequence<count>{}));
     };
 
     template <typename T, typename TypeRestriction, typename TypeList>
-    using filtered_integer_sequence_t = typename RestrictedIntegerSequenceBuilder<T, TypeRestriction, TypeList, false, 0>::type;
+    using filtered_integer_sequence_t = typename RestrictedIntegerSequenceBuilder<T, TypeRestriction, TypeList>::type;
 
     template <typename TypeRestriction, typename TypeList>
-    using filtered_index_sequence_t = typename RestrictedIntegerSequenceBuilder<size_t, TypeRestriction, TypeList, false, 0>::type;
+    using filtered_index_sequence_t = typename RestrictedIntegerSequenceBuilder<size_t, TypeRestriction, TypeList>::type;
 
 } // namespace fk
 
@@ -0,0 +1,158 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/image_pyramid.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+using namespace fk;
+
+namespace {
+
+unsigned char sourceValue(const int x, const int y) {
+    return static_cast<unsigned char>((x * 17 + y * 29 + 3) % 251);
+}
+
+// Mean of the factor x factor source block of an output pixel
+double blockMean(const int x, const int y, const int factor) {
+    double sum = 0.;
+    for (int sy = y * factor; sy < (y + 1) * factor; ++sy) {
+        for (int sx = x * factor; sx < (x + 1) * factor; ++sx) {
+            sum += sourceValue(sx, sy);
+        }
+    }
+    return sum / (factor * factor);
+}
+
+template <typename T>
+std::vector<T> toHost(const Ptr2D<T>& image) {
+    std::vector<T> values;
+    for (int y = 0; y < static_cast<int>(image.dims().height); ++y) {
+        for (int x = 0; x < static_cast<int>(image.dims().width); ++x) {
+            values.push_back(image.at(Point{ x, y, 0 }));
+        }
+    }
+    return values;
+}
+
+struct PyramidOutputs {
+    std::vector<float> level0;
+    std::vector<unsigned char> level1;
+    std::vector<float> level2;
+    bool levelsReused;
+};
+
+// 64x48 source into 32x24, 16x12 and 8x6 levels, each level with its own pipeline
+template <ParArch PA>
+PyramidOutputs runPyramid() {
+    constexpr bool GPU = PA == ParArch::GPU_NVIDIA;
+    const MemType memType = GPU ? MemType::DeviceAndPinned : MemType::Host;
+    Ptr2D<unsigned char> source(64, 48, 0, memType);
+    for (int y = 0; y < 48; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            source.at(Point{ x, y, 0 }) = sourceValue(x, y);
+        }
+    }
+    Ptr2D<float> out0(32, 24, 0, memType);
+    Ptr2D<unsigned char> out1(16, 12, 0, memType);
+    Ptr2D<float> out2(8, 6, 0, memType);
+    Stream_<PA> stream;
+#if defined(__NVCC__)
+    if constexpr (GPU) source.upload(stream);
+#endif
+    const auto read = PerThreadRead<ND::_2D, unsigned char>::build(source);
+    const auto details = ImagePyramid::geometric<3>(Size(32, 24), 0.5f, SeparableResizeMode::AREA);
+    std::array<Ptr2D<float>, 2> levels;
+    const auto run = [&] {
+        executePyramid<SeparableResizeDPP<PA>>(stream, details, levels, read,
+            PerThreadWrite<ND::_2D, float>::build(out0),
+            FusedOperation<>::build(SaturateCast<float, unsigned char>::build(),
+                                    PerThreadWrite<ND::_2D, unsigned char>::build(out1)),
+            FusedOperation<>::build(Mul<float>::build(0.5f), PerThreadWrite<ND::_2D, float>::build(out2)));
+    };
+    run();
+    const float* const first = levels[0].ptr().data;
+    run();
+#if defined(__NVCC__)
+    if constexpr (GPU) {
+        out0.download(stream);
+        out1.download(stream);
+        out2.download(stream);
+    }
+#endif
+    stream.sync();
+    return { toHost(out0), toHost(out1), toHost(out2), levels[0].ptr().data == first };
+}
+
+bool verifyCpu(const PyramidOutputs& outputs) {
+    bool ok = outputs.levelsReused;
+    for (int y = 0; y < 24; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            ok = std::fabs(outputs.level0[y * 32 + x] - blockMean(x, y, 2)) < 1e-3 && ok;
+        }
+    }
+    for (int y = 0; y < 12; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            ok = std::abs(outputs.level1[y * 16 + x] - static_cast<int>(std::lround(blockMean(x, y, 4)))) <= 1 && ok;
+        }
+    }
+    for (int y = 0; y < 6; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            ok = std::fabs(outputs.level2[y * 8 + x] - 0.5 * blockMean(x, y, 8)) < 1e-3 && ok;
+        }
+    }
+    return ok;
+}
+
+bool verifySizes() {
+    const auto details = ImagePyramid::geometric<4>(Size(1000, 600), 0.8f);
+    bool ok = details.sizes[1].width == 800 && details.sizes[1].height == 480 &&
+              details.sizes[3].width == 512 && details.sizes[3].height == 307;
+    try {
+        ImagePyramid::details(std::array<Size, 2>{ Size(10, 10), Size(20, 5) });
+        ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+    return ok;
+}
+
+} // namespace
+
+int launch() {
+    bool ok = true;
+    const PyramidOutputs cpu = runPyramid<ParArch::CPU>();
+    const bool cpuOk = verifyCpu(cpu);
+    std::printf("ImagePyramid cascade area levels CPU %s\n", cpuOk ? "PASS" : "FAIL");
+    ok = cpuOk && ok;
+#if defined(__NVCC__)
+    const PyramidOutputs gpu = runPyramid<ParArch::GPU_NVIDIA>();
+    const bool gpuOk = verifyCpu(gpu);
+    std::printf("ImagePyramid cascade area levels GPU %s\n", gpuOk ? "PASS" : "FAIL");
+    ok = gpuOk && ok;
+#endif
+    const bool sizesOk = verifySizes();
+    std::printf("ImagePyramid level sizes %s\n", sizesOk ? "PASS" : "FAIL");
+    ok = sizesOk && ok;
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,166 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/separable_resize.h>
+#include <fused_kernel/core/data/ptr_nd.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace fk;
+
+namespace {
+
+unsigned char sourceValue(const int x, const int y) {
+    return static_cast<unsigned char>((x * 17 + y * 29 + 3) % 251);
+}
+
+Ptr2D<unsigned char> makeSource(const int width, const int height, const MemType memType) {
+    Ptr2D<unsigned char> source(width, height, 0, memType);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            source.at(Point{ x, y, 0 }) = sourceValue(x, y);
+        }
+    }
+    return source;
+}
+
+// Box average of the source area covered by an output pixel, in double
+double areaOracle(const int srcWidth, const int srcHeight, const float fx, const float fy, const int x, const int y) {
+    const double x0 = x * fx, x1 = std::min<double>((x + 1) * fx, srcWidth);
+    const double y0 = y * fy, y1 = std::min<double>((y + 1) * fy, srcHeight);
+    double sum = 0.;
+    for (int sy = static_cast<int>(std::floor(y0)); sy < static_cast<int>(std::ceil(y1)); ++sy) {
+        for (int sx = static_cast<int>(std::floor(x0)); sx < static_cast<int>(std::ceil(x1)); ++sx) {
+            const double coverX = std::min<double>(sx + 1, x1) - std::max<double>(sx, x0);
+            const double coverY = std::min<double>(sy + 1, y1) - std::max<double>(sy, y0);
+            sum += coverX * coverY * sourceValue(sx, sy);
+        }
+    }
+    return sum / ((x1 - x0) * (y1 - y0));
+}
+
+// Runs the DPP on PA, and returns the output on the host
+template <ParArch PA, AspectRatio AR, typename... Args>
+std::vector<float> runSeparable(const int srcWidth, const int srcHeight, const Size dstSize,
+                                const SeparableResizeMode mode, const float scale, const Args&... background) {
+    constexpr bool GPU = PA == ParArch::GPU_NVIDIA;
+    const MemType memType = GPU ? MemType::DeviceAndPinned : MemType::Host;
+    Ptr2D<unsigned char> source = makeSource(srcWidth, srcHeight, memType);
+    Ptr2D<float> output(dstSize.width, dstSize.height, 0, memType);
+    Stream_<PA> stream;
+#if defined(__NVCC__)
+    if constexpr (GPU) source.upload(stream);
+#endif
+    const auto read = PerThreadRead<ND::_2D, unsigned char>::build(source);
+    const auto details = SeparableResize<AR>::details(read, dstSize, background..., mode);
+    executeSeparableResize<SeparableResizeDPP<PA>>(stream, details, read, Mul<float>::build(scale),
+                                                    PerThreadWrite<ND::_2D, float>::build(output));
+#if defined(__NVCC__)
+    if constexpr (GPU) output.download(stream);
+#endif
+    stream.sync();
+    std::vector<float> values;
+    for (int y = 0; y < dstSize.height; ++y) {
+        for (int x = 0; x < dstSize.width; ++x) {
+            values.push_back(output.at(Point{ x, y, 0 }));
+        }
+    }
+    return values;
+}
+
+// The same geometry with the Resize ReadBack and TransformDPP on the CPU
+template <AspectRatio AR, typename... Args>
+std::vector<float> runResize(const int srcWidth, const int srcHeight, const Size dstSize, const float scale,
+                             const Args&... background) {
+    Ptr2D<unsigned char> source = makeSource(srcWidth, srcHeight, MemType::Host);
+    Ptr2D<float> output(dstSize.width, dstSize.height, 0, MemType::Host);
+    Stream_<ParArch::CPU> stream;
+    executeOperations<TransformDPP<ParArch::CPU>>(stream,
+        Resize<InterpolationType::INTER_LINEAR, AR>::build(PerThreadRead<ND::_2D, unsigned char>::build(source),
+                                                           dstSize, background...),
+        Mul<float>::build(scale), PerThreadWrite<ND::_2D, float>::build(output));
+    std::vector<float> values;
+    for (int y = 0; y < dstSize.height; ++y) {
+        for (int x = 0; x < dstSize.width; ++x) {
+            values.push_back(output.at(Point{ x, y, 0 }));
+        }
+    }
+    return values;
+}
+
+float maxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+    float diff = 0.f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        diff = std::max(diff, std::fabs(a[i] - b[i]));
+    }
+    return diff;
+}
+
+template <AspectRatio AR, typename... Args>
+bool verifyLinear(const int srcWidth, const int srcHeight, const Size dstSize, const char* name,
+                  const Args&... background) {
+    const auto cpu = runSeparable<ParArch::CPU, AR>(srcWidth, srcHeight, dstSize, SeparableResizeMode::LINEAR, 2.f, background...);
+    const auto reference = runResize<AR>(srcWidth, srcHeight, dstSize, 2.f, background...);
+    bool ok = maxDifference(cpu, reference) < 1e-3f;
+#if defined(__NVCC__)
+    const auto gpu = runSeparable<ParArch::GPU_NVIDIA, AR>(srcWidth, srcHeight, dstSize, SeparableResizeMode::LINEAR, 2.f, background...);
+    ok = maxDifference(gpu, cpu) < 1e-3f && ok;
+#endif
+    std::printf("SeparableResize %-24s %dx%d -> %dx%d %s\n", name, srcWidth, srcHeight,
+                dstSize.width, dstSize.height, ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+bool verifyArea(const int srcWidth, const int srcHeight, const Size dstSize, const char* name) {
+    const auto cpu = runSeparable<ParArch::CPU, AspectRatio::IGNORE_AR>(srcWidth, srcHeight, dstSize,
+                                                                        SeparableResizeMode::AUTO, 1.f);
+    const float fx = static_cast<float>(1.0 / (static_cast<double>(dstSize.width) / srcWidth));
+    const float fy = static_cast<float>(1.0 / (static_cast<double>(dstSize.height) / srcHeight));
+    bool ok = true;
+    for (int y = 0; y < dstSize.height; ++y) {
+        for (int x = 0; x < dstSize.width; ++x) {
+            const double expected = areaOracle(srcWidth, srcHeight, fx, fy, x, y);
+            ok = std::fabs(cpu[static_cast<size_t>(y) * dstSize.width + x] - expected) < 1e-2 && ok;
+        }
+    }
+#if defined(__NVCC__)
+    const auto gpu = runSeparable<ParArch::GPU_NVIDIA, AspectRatio::IGNORE_AR>(srcWidth, srcHeight, dstSize,
+                                                                               SeparableResizeMode::AUTO, 1.f);
+    ok = maxDifference(gpu, cpu) < 1e-3f && ok;
+#endif
+    std::printf("SeparableResize %-24s %dx%d -> %dx%d %s\n", name, srcWidth, srcHeight,
+                dstSize.width, dstSize.height, ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int launch() {
+    bool ok = true;
+    ok = verifyLinear<AspectRatio::IGNORE_AR>(50, 40, Size(80, 30), "linear-ignore-ar") && ok;
+    ok = verifyLinear<AspectRatio::IGNORE_AR>(97, 61, Size(64, 64), "linear-downscale") && ok;
+    ok = verifyLinear<AspectRatio::PRESERVE_AR>(90, 40, Size(64, 64), "linear-preserve-ar", 7.f) && ok;
+    ok = verifyArea(64, 48, Size(16, 12), "area-integer-factor") && ok;
+    ok = verifyArea(403, 257, Size(23, 19), "area-fractional-factor") && ok;
+    ok = verifyArea(300, 40, Size(30, 12), "area-anisotropic") && ok;
+    return ok ? 0 : -1;
+}
@@ -127,5 +127,19 @@ int launch() {
 
     static_assert(IndexListAllUnary::size() == 0, "Incorrect index");
 
+    // Long lists used to grow exponentially in instantiations
+    using U = fk::Unary<fk::Cast<float, int>>;
+    using B = fk::Binary<fk::Add<float>>;
+    using LongList = fk::TypeList<U, B, U, B, U, B, U, B, U, B, U, B, U, B, U, B,
+                                  U, B, U, B, U, B, U, B, U, B, U, B, U, B, U, B,
+                                  U, B, U, B, U, B, U, B, U, B, U, B, U, B, U, B>;
+
+    using IndexListLong = fk::filtered_index_sequence_t<fk::NotIsUnaryRestriction, LongList>;
+
+    static_assert(IndexListLong::size() == 24, "Incorrect sequence size");
+    static_assert(fk::get_index<0, IndexListLong> == 1, "Incorrect index");
+    static_assert(fk::get_index<12, IndexListLong> == 25, "Incorrect index");
+    static_assert(fk::get_index<23, IndexListLong> == 47, "Incorrect index");
+
     return 0;
 }
\ No newline at end of file
@@ -17,11 +17,14 @@
 #include <tests/main.h>
 
 #include <fused_kernel/algorithms/attention/flash_attention.h>
+#include <fused_kernel/algorithms/attention/flash_attention_mma.h>
+#include <fused_kernel/algorithms/attention/flash_decode.h>
 #include <fused_kernel/algorithms/basic_ops/arithmetic.h>
 
 #include <cmath>
 #include <iostream>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 using namespace fk;
@@ -270,6 +273,104 @@ static void testFusedPrologue() {
     cudaFree(q); cudaFree(k); cudaFree(v); cudaFree(o);
 }
 
+// ---- GQA / MQA: K/V hold batch*kvHeads planes, query head h reads KV head
+// h / group. The oracle repeats each KV head for its group, which is what
+// GQA models otherwise materialize.
+static std::vector<double> repeatKV(const std::vector<double>& kv, const int bh,
+                                    const int group, const size_t plane) {
+    std::vector<double> rep((size_t)bh * plane);
+    for (int h = 0; h < bh; ++h)
+        for (size_t i = 0; i < plane; ++i) rep[h * plane + i] = kv[(h / group) * plane + i];
+    return rep;
+}
+
+template <typename T>
+static T* toDevice(const std::vector<T>& host) {
+    T* device;
+    gpuErrchk(cudaMalloc(&device, host.size() * sizeof(T)));
+    gpuErrchk(cudaMemcpy(device, host.data(), host.size() * sizeof(T), cudaMemcpyHostToDevice));
+    return device;
+}
+
+// Random inputs, in T, and their values in double (after the rounding to T)
+template <typename T>
+static void randomInputs(const size_t n, std::mt19937& rng, std::vector<T>& values,
+                         std::vector<double>& exact) {
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    values.resize(n);
+    exact.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_same_v<T, __nv_bfloat16>) {
+            values[i] = __float2bfloat16(dist(rng));
+            exact[i] = __bfloat162float(values[i]);
+        } else {
+            values[i] = dist(rng);
+            exact[i] = values[i];
+        }
+    }
+}
+
+enum class GQAKernel { Warp, Mma, Decode };
+
+// Runs one of the GPU attention kernels with kvHeads < qHeads. Decode uses seqQ = 1.
+// Mma reads bf16 inputs (its raw cp.async schedule), the others read float.
+template <GQAKernel KERNEL, int HEAD_DIM>
+static void testGroupedQuery(const char* name, const int batch, const int qHeads, const int kvHeads,
+                             int seqQ, const int seqK, const bool causal, const double tol,
+                             const unsigned seed) {
+    using T = std::conditional_t<KERNEL == GQAKernel::Mma, __nv_bfloat16, float>;
+    if constexpr (KERNEL == GQAKernel::Decode) seqQ = 1;
+    const int group = qHeads / kvHeads;
+    const int bh = batch * qHeads, kvBh = batch * kvHeads;
+    const size_t nQ = (size_t)bh * seqQ * HEAD_DIM, nK = (size_t)kvBh * seqK * HEAD_DIM;
+    std::mt19937 rng(seed);
+    std::vector<T> hq, hk, hv;
+    std::vector<double> dq, dk, dv, ref;
+    randomInputs(nQ, rng, hq, dq);
+    randomInputs(nK, rng, hk, dk);
+    randomInputs(nK, rng, hv, dv);
+    const size_t plane = (size_t)seqK * HEAD_DIM;
+    cpuAttention(dq, repeatKV(dk, bh, group, plane), repeatKV(dv, bh, group, plane), ref, bh, seqQ,
+                 seqK, HEAD_DIM, 1.0 / std::sqrt((double)HEAD_DIM), causal);
+
+    T* q = toDevice(hq);
+    T* k = toDevice(hk);
+    T* v = toDevice(hv);
+    float* o;
+    gpuErrchk(cudaMalloc(&o, nQ * sizeof(float)));
+    const auto qIOp = makeAttentionRead(q, bh, seqQ, HEAD_DIM);
+    const auto kIOp = makeAttentionRead(k, kvBh, seqK, HEAD_DIM);
+    const auto vIOp = makeAttentionRead(v, kvBh, seqK, HEAD_DIM);
+
+    Stream stream;
+    float* workspace = nullptr;
+    if constexpr (KERNEL == GQAKernel::Warp) {
+        executeFlashAttention<HEAD_DIM>(qIOp, kIOp, vIOp, o, bh, seqQ, seqK, causal, stream, -1.f,
+                                        AttentionIdentityEpilogue{}, group);
+    } else if constexpr (KERNEL == GQAKernel::Mma) {
+        executeFlashAttentionMma<HEAD_DIM>(qIOp, kIOp, vIOp, o, bh, seqQ, seqK, causal, stream, -1.f,
+                                           AttentionIdentityEpilogue{}, NoScoreMod{}, BlockSparsity{},
+                                           group);
+    } else {
+        // Several splits, so that the fused merge also runs per query head
+        constexpr int SPLITS = 4;
+        const size_t floats = flashDecodeWorkspaceFloats(bh, SPLITS, HEAD_DIM);
+        gpuErrchk(cudaMalloc(&workspace, floats * sizeof(float)));
+        gpuErrchk(cudaMemset(workspace, 0, floats * sizeof(float)));
+        executeFlashDecode<HEAD_DIM>(qIOp, kIOp, vIOp, o, workspace, bh, seqK, stream, -1.f, SPLITS,
+                                     group);
+    }
+    stream.sync();
+
+    std::vector<float> got(nQ);
+    gpuErrchk(cudaMemcpy(got.data(), o, nQ * sizeof(float), cudaMemcpyDeviceToHost));
+    cudaFree(q); cudaFree(k); cudaFree(v); cudaFree(o); cudaFree(workspace);
+
+    double maxErr = 0.0;
+    for (size_t i = 0; i < nQ; ++i) maxErr = std::max(maxErr, std::abs((double)got[i] - ref[i]));
+    report(name, maxErr, tol);
+}
+
 int launch() {
     testDense<64>("FA dense d64 b2 s64 causal", 2, 64, 64, true, 5e-6, 1);
     testDense<64>("FA dense d64 ragged s67/s131", 2, 67, 131, false, 5e-6, 2);
@@ -279,6 +380,13 @@ int launch() {
     testInt8KV<64>("FA int8-KV d64 ragged s50/s100", 2, 50, 100, false, 5e-6, 6);
     testFusedEpilogue();
     testFusedPrologue();
+    testGroupedQuery<GQAKernel::Warp, 64>("FA GQA 8q/2kv heads causal", 2, 8, 2, 40, 72, true, 5e-6, 30);
+    testGroupedQuery<GQAKernel::Warp, 32>("FA MQA 4q/1kv heads", 2, 4, 1, 33, 65, false, 5e-6, 31);
+    // bf16 inputs, and P rounded to bf16 before the PV product
+    testGroupedQuery<GQAKernel::Mma, 64>("FA mma GQA 8q/2kv heads causal", 1, 8, 2, 128, 128, true, 2e-2, 32);
+    testGroupedQuery<GQAKernel::Mma, 64>("FA mma MQA 4q/1kv heads", 2, 4, 1, 64, 128, false, 2e-2, 33);
+    testGroupedQuery<GQAKernel::Decode, 64>("FA decode GQA 8q/2kv heads", 2, 8, 2, 1, 300, false, 5e-6, 34);
+    testGroupedQuery<GQAKernel::Decode, 128>("FA decode MQA 8q/1kv heads", 1, 8, 1, 1, 257, false, 5e-6, 35);
     if (failures == 0) { return 0; }
     std::cout << failures << " attention test(s) FAILED" << std::endl;
     return -1;
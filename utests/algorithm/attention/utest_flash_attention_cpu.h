@@ -0,0 +1,271 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/attention/flash_attention_cpu.h>
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace fk;
+
+using ScoreFn = std::function<double(double, int, int)>;
+
+// double-precision oracle: O = softmax(mod(scale * Q K^T) [causal]) V
+// mod returns -inf to mask a position; a fully masked row outputs 0.
+static void refAttention(const std::vector<double>& q, const std::vector<double>& k,
+                         const std::vector<double>& v, std::vector<double>& o,
+                         const int bh, const int seqQ, const int seqK, const int d,
+                         const double scale, const bool causal, const ScoreFn& mod) {
+    o.assign((size_t)bh * seqQ * d, 0.0);
+    std::vector<double> s(seqK);
+    for (int b = 0; b < bh; ++b) {
+        const double* Q = q.data() + (size_t)b * seqQ * d;
+        const double* K = k.data() + (size_t)b * seqK * d;
+        const double* V = v.data() + (size_t)b * seqK * d;
+        double* O = o.data() + (size_t)b * seqQ * d;
+        for (int i = 0; i < seqQ; ++i) {
+            const int kEnd = causal ? std::min(seqK, i + 1) : seqK;
+            double m = -INFINITY;
+            for (int j = 0; j < kEnd; ++j) {
+                double dot = 0.0;
+                for (int c = 0; c < d; ++c) dot += Q[(size_t)i*d+c] * K[(size_t)j*d+c];
+                s[j] = mod(dot * scale, i, j);
+                m = std::max(m, s[j]);
+            }
+            if (m == -INFINITY) continue;
+            double l = 0.0;
+            for (int j = 0; j < kEnd; ++j) { s[j] = std::exp(s[j] - m); l += s[j]; }
+            for (int j = 0; j < kEnd; ++j) {
+                const double pj = s[j] / l;
+                for (int c = 0; c < d; ++c) O[(size_t)i*d+c] += pj * V[(size_t)j*d+c];
+            }
+        }
+    }
+}
+
+static int failures = 0;
+
+static void report(const char* name, const double maxErr, const double tol) {
+    if (maxErr > tol) {
+        std::cout << "FAIL " << name << ": maxErr=" << maxErr << " tol=" << tol << std::endl;
+        ++failures;
+    } else {
+        std::cout << "Running test " << name << ": Success!! (maxErr=" << maxErr << ")" << std::endl;
+    }
+}
+
+static double maxAbsErr(const std::vector<float>& got, const std::vector<double>& ref) {
+    double maxErr = 0.0;
+    for (size_t i = 0; i < got.size(); ++i)
+        maxErr = std::max(maxErr, std::abs((double)got[i] - ref[i]));
+    return maxErr;
+}
+
+struct Inputs {
+    std::vector<float> q, k, v;
+    std::vector<double> dq, dk, dv;
+};
+
+static Inputs makeInputs(const int bh, const int seqQ, const int seqK, const int d,
+                         const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    Inputs in;
+    const size_t nQ = (size_t)bh * seqQ * d, nK = (size_t)bh * seqK * d;
+    in.q.resize(nQ); in.k.resize(nK); in.v.resize(nK);
+    for (auto& x : in.q) x = dist(rng);
+    for (auto& x : in.k) x = dist(rng);
+    for (auto& x : in.v) x = dist(rng);
+    in.dq.assign(in.q.begin(), in.q.end());
+    in.dk.assign(in.k.begin(), in.k.end());
+    in.dv.assign(in.v.begin(), in.v.end());
+    return in;
+}
+
+template <int HEAD_DIM, typename ScoreModOp = NoScoreMod>
+static void testCase(const char* name, const int bh, const int seqQ, const int seqK,
+                     const bool causal, const ScoreModOp& scoreMod, const ScoreFn& refMod,
+                     const unsigned seed, const BlockSparsity& sparse = {}) {
+    const Inputs in = makeInputs(bh, seqQ, seqK, HEAD_DIM, seed);
+    std::vector<double> ref;
+    refAttention(in.dq, in.dk, in.dv, ref, bh, seqQ, seqK, HEAD_DIM,
+                 1.0 / std::sqrt((double)HEAD_DIM), causal, refMod);
+
+    std::vector<float> got((size_t)bh * seqQ * HEAD_DIM, -1.f);
+    Stream_<ParArch::CPU> stream;
+    executeFlashAttentionMma<HEAD_DIM>(makeAttentionRead(in.q.data(), bh, seqQ, HEAD_DIM),
+                                       makeAttentionRead(in.k.data(), bh, seqK, HEAD_DIM),
+                                       makeAttentionRead(in.v.data(), bh, seqK, HEAD_DIM),
+                                       got.data(), bh, seqQ, seqK, causal, stream,
+                                       -1.f, AttentionIdentityEpilogue{}, scoreMod, sparse);
+    report(name, maxAbsErr(got, ref), 5e-6);
+}
+
+static double identityMod(const double s, const int, const int) { return s; }
+
+static void testSlidingWindow() {
+    // Block mask (skip) + SlidingWindowMask (exact edge) vs the windowed oracle.
+    // The mask granularity (32 x 64) matches the default CPU tiles.
+    constexpr int HEAD_DIM = 32, BH = 2, SQ = 200, SK = 200, WINDOW = 48;
+    const std::vector<unsigned char> mask =
+        makeSlidingWindowBlockMask(BH, SQ, SK, WINDOW, 32, 64);
+    const BlockSparsity sparse{ mask.data(), (SQ + 31) / 32, (SK + 63) / 64, 32, 64 };
+    const ScoreFn windowMod = [](const double s, const int q, const int k) {
+        return (q - k) >= WINDOW ? -INFINITY : s;
+    };
+    testCase<HEAD_DIM>("FA cpu sliding window w48 block-sparse", BH, SQ, SK, true,
+                       SlidingWindowMask{ WINDOW }, windowMod, 11, sparse);
+
+    // A mask that disables every tile of the second head: its output is 0.
+    std::vector<unsigned char> halfMask(mask);
+    std::fill(halfMask.begin() + halfMask.size() / 2, halfMask.end(), 0);
+    const BlockSparsity halfSparse{ halfMask.data(), sparse.nQBlocks, sparse.nKVBlocks, 32, 64 };
+    const Inputs in = makeInputs(BH, SQ, SK, HEAD_DIM, 12);
+    std::vector<float> got((size_t)BH * SQ * HEAD_DIM, -1.f);
+    Stream_<ParArch::CPU> stream;
+    executeFlashAttentionMma<HEAD_DIM>(makeAttentionRead(in.q.data(), BH, SQ, HEAD_DIM),
+                                       makeAttentionRead(in.k.data(), BH, SK, HEAD_DIM),
+                                       makeAttentionRead(in.v.data(), BH, SK, HEAD_DIM),
+                                       got.data(), BH, SQ, SK, true, stream,
+                                       -1.f, AttentionIdentityEpilogue{}, SlidingWindowMask{ WINDOW },
+                                       halfSparse);
+    double maxAbs = 0.0;
+    for (size_t i = got.size() / 2; i < got.size(); ++i)
+        maxAbs = std::max(maxAbs, std::abs((double)got[i]));
+    report("FA cpu fully masked head writes zeros", maxAbs, 0.0);
+
+    // Mask granularity finer than the tiles is rejected.
+    bool thrown = false;
+    try {
+        const BlockSparsity bad{ mask.data(), sparse.nQBlocks, sparse.nKVBlocks, 16, 64 };
+        executeFlashAttentionMma<HEAD_DIM>(makeAttentionRead(in.q.data(), BH, SQ, HEAD_DIM),
+                                           makeAttentionRead(in.k.data(), BH, SK, HEAD_DIM),
+                                           makeAttentionRead(in.v.data(), BH, SK, HEAD_DIM),
+                                           got.data(), BH, SQ, SK, true, stream,
+                                           -1.f, AttentionIdentityEpilogue{}, NoScoreMod{}, bad);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    report("FA cpu rejects mask finer than tiles", thrown ? 0.0 : 1.0, 0.0);
+}
+
+static void testInt8KVAndEpilogue() {
+    // int8 per-token K/V prologue + Mul(2).then(Add(0.5)) epilogue
+    constexpr int HEAD_DIM = 64, BH = 2, SQ = 50, SK = 100;
+    const Inputs in = makeInputs(BH, SQ, SK, HEAD_DIM, 13);
+    const size_t nK = in.k.size(), nTok = (size_t)BH * SK;
+    std::vector<int8_t> k8(nK), v8(nK);
+    std::vector<float> kSc(nTok), vSc(nTok);
+    quantizeKVCacheHost(in.k.data(), k8.data(), kSc.data(), (int)nTok, HEAD_DIM);
+    quantizeKVCacheHost(in.v.data(), v8.data(), vSc.data(), (int)nTok, HEAD_DIM);
+
+    std::vector<double> dkD(nK), dvD(nK), ref;
+    for (size_t i = 0; i < nK; ++i) dkD[i] = (double)k8[i] * kSc[i / HEAD_DIM];
+    for (size_t i = 0; i < nK; ++i) dvD[i] = (double)v8[i] * vSc[i / HEAD_DIM];
+    refAttention(in.dq, dkD, dvD, ref, BH, SQ, SK, HEAD_DIM,
+                 1.0 / std::sqrt((double)HEAD_DIM), false, identityMod);
+    for (auto& x : ref) x = 2.0 * x + 0.5;
+
+    std::vector<float> got(in.q.size());
+    Stream_<ParArch::CPU> stream;
+    const auto epilogue = Mul<float>::build(2.f).then(Add<float>::build(0.5f));
+    executeFlashAttention<HEAD_DIM>(makeAttentionRead(in.q.data(), BH, SQ, HEAD_DIM),
+                                    makeInt8KVRead(k8.data(), kSc.data(), BH, SK, HEAD_DIM),
+                                    makeInt8KVRead(v8.data(), vSc.data(), BH, SK, HEAD_DIM),
+                                    got.data(), BH, SQ, SK, false, stream, -1.f, epilogue);
+    report("FA cpu int8-KV prologue + fused epilogue", maxAbsErr(got, ref), 1e-5);
+}
+
+static void testGroupedQuery(const char* name, const int batch, const int qHeads,
+                             const int kvHeads, const bool causal, const unsigned seed) {
+    // K/V hold batch*kvHeads planes; the oracle repeats each KV head for
+    // its kvGroup query heads (what GQA models otherwise materialize).
+    constexpr int HEAD_DIM = 32, SQ = 40, SK = 72;
+    const int group = qHeads / kvHeads;
+    const int bh = batch * qHeads, kvBh = batch * kvHeads;
+    const Inputs in = makeInputs(bh, SQ, SK, HEAD_DIM, seed);
+    const size_t kvPlane = (size_t)SK * HEAD_DIM;
+    std::vector<double> dkRep((size_t)bh * kvPlane), dvRep((size_t)bh * kvPlane), ref;
+    for (int h = 0; h < bh; ++h)
+        for (size_t i = 0; i < kvPlane; ++i) {
+            dkRep[h * kvPlane + i] = in.dk[(h / group) * kvPlane + i];
+            dvRep[h * kvPlane + i] = in.dv[(h / group) * kvPlane + i];
+        }
+    refAttention(in.dq, dkRep, dvRep, ref, bh, SQ, SK, HEAD_DIM,
+                 1.0 / std::sqrt((double)HEAD_DIM), causal, identityMod);
+
+    std::vector<float> got(in.q.size());
+    Stream_<ParArch::CPU> stream;
+    executeFlashAttentionMma<HEAD_DIM>(makeAttentionRead(in.q.data(), bh, SQ, HEAD_DIM),
+                                       makeAttentionRead(in.k.data(), kvBh, SK, HEAD_DIM),
+                                       makeAttentionRead(in.v.data(), kvBh, SK, HEAD_DIM),
+                                       got.data(), bh, SQ, SK, causal, stream, -1.f,
+                                       AttentionIdentityEpilogue{}, NoScoreMod{}, BlockSparsity{},
+                                       group);
+    report(name, maxAbsErr(got, ref), 5e-6);
+
+    // Same call form as the GPU warp API: kvGroup right after the epilogue
+    for (auto& x : ref) x = 2.0 * x + 0.5;
+    const float scale = 1.f / std::sqrt(static_cast<float>(HEAD_DIM));
+    const auto epilogue = Mul<float>::build(2.f).then(Add<float>::build(0.5f));
+    executeFlashAttention<HEAD_DIM>(makeAttentionRead(in.q.data(), bh, SQ, HEAD_DIM),
+                                    makeAttentionRead(in.k.data(), kvBh, SK, HEAD_DIM),
+                                    makeAttentionRead(in.v.data(), kvBh, SK, HEAD_DIM),
+                                    got.data(), bh, SQ, SK, causal, stream, scale, epilogue, group);
+    report((std::string(name) + " (scale, epilogue, kvGroup)").c_str(), maxAbsErr(got, ref), 1e-5);
+}
+
+static void testGroupedQueryRejectsBadGroup() {
+    constexpr int HEAD_DIM = 32;
+    const Inputs in = makeInputs(6, 8, 8, HEAD_DIM, 21);
+    std::vector<float> got(in.q.size());
+    Stream_<ParArch::CPU> stream;
+    bool thrown = false;
+    try {
+        executeFlashAttention<HEAD_DIM>(makeAttentionRead(in.q.data(), 6, 8, HEAD_DIM),
+                                        makeAttentionRead(in.k.data(), 6, 8, HEAD_DIM),
+                                        makeAttentionRead(in.v.data(), 6, 8, HEAD_DIM),
+                                        got.data(), 6, 8, 8, false, stream, -1.f,
+                                        AttentionIdentityEpilogue{}, 4);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    report("FA cpu rejects kvGroup not dividing batchHeads", thrown ? 0.0 : 1.0, 0.0);
+}
+
+int launch() {
+    testCase<64>("FA cpu dense d64 b2 s64 causal", 2, 64, 64, true, NoScoreMod{}, identityMod, 1);
+    testCase<64>("FA cpu dense d64 ragged s67/s131", 2, 67, 131, false, NoScoreMod{}, identityMod, 2);
+    testCase<32>("FA cpu dense d32 cross s32->s96", 2, 32, 96, false, NoScoreMod{}, identityMod, 3);
+    testCase<32>("FA cpu ALiBi slope 0.25 causal", 2, 80, 80, true, ALiBiScoreMod{ 0.25f },
+                 [](const double s, const int q, const int k) { return s - 0.25 * (q - k); }, 4);
+    testCase<32>("FA cpu SoftCap 0.5", 2, 40, 70, false, SoftCapScoreMod{ 0.5f },
+                 [](const double s, const int, const int) { return 0.5 * std::tanh(s / 0.5); }, 5);
+    testSlidingWindow();
+    testInt8KVAndEpilogue();
+    testGroupedQuery("FA cpu GQA 8q/2kv heads causal", 2, 8, 2, true, 22);
+    testGroupedQuery("FA cpu MQA 4q/1kv heads", 2, 4, 1, false, 23);
+    testGroupedQueryRejectsBadGroup();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " attention test(s) FAILED" << std::endl;
+    return -1;
+}
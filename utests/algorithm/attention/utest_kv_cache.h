@@ -0,0 +1,266 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/attention/flash_attention_cpu.h>
+#include <fused_kernel/algorithms/attention/kv_cache.h>
+
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace fk;
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr int KV_HEADS = 2;
+constexpr int HEAD_DIM = 16;
+constexpr int PAGE = 8;
+
+// (KV_HEADS, n, HEAD_DIM) C-contiguous random K or V block.
+static std::vector<float> randomKV(const int n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<float> kv((size_t)KV_HEADS * n * HEAD_DIM);
+    for (auto& x : kv) x = dist(rng);
+    return kv;
+}
+
+// Reads a sequence back through its Read IOp as (KV_HEADS, len, HEAD_DIM).
+template <typename IOp>
+static std::vector<float> readBack(const IOp& iop, const int len) {
+    std::vector<float> out((size_t)KV_HEADS * len * HEAD_DIM);
+    for (int h = 0; h < KV_HEADS; ++h)
+        for (int t = 0; t < len; ++t)
+            for (int c = 0; c < HEAD_DIM; ++c)
+                out[((size_t)h * len + t) * HEAD_DIM + c] =
+                    IOp::Operation::exec(Point{ c, t, h }, iop);
+    return out;
+}
+
+// Concatenates (KV_HEADS, n_i, HEAD_DIM) blocks along the token axis.
+static std::vector<float> concatTokens(const std::vector<std::vector<float>>& blocks,
+                                       const std::vector<int>& lens) {
+    const int total = std::accumulate(lens.begin(), lens.end(), 0);
+    std::vector<float> out((size_t)KV_HEADS * total * HEAD_DIM);
+    for (int h = 0; h < KV_HEADS; ++h) {
+        int t0 = 0;
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            for (int t = 0; t < lens[b]; ++t)
+                for (int c = 0; c < HEAD_DIM; ++c)
+                    out[((size_t)h * total + t0 + t) * HEAD_DIM + c] =
+                        blocks[b][((size_t)h * lens[b] + t) * HEAD_DIM + c];
+            t0 += lens[b];
+        }
+    }
+    return out;
+}
+
+static float maxAbsDiff(const std::vector<float>& a, const std::vector<float>& b) {
+    float m = a.size() == b.size() ? 0.f : INFINITY;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) m = std::max(m, std::abs(a[i] - b[i]));
+    return m;
+}
+
+static void testAppendAcrossPages() {
+    std::mt19937 rng(1);
+    KVCache<float> cache(KV_HEADS, HEAD_DIM, PAGE, 1 << 20, MemType::Host);
+    const auto id = cache.createSequence();
+    const std::vector<int> lens{ 5, 7, 1, 12 };   // crosses page edges unevenly
+    std::vector<std::vector<float>> ks, vs;
+    for (const int n : lens) {
+        ks.push_back(randomKV(n, rng));
+        vs.push_back(randomKV(n, rng));
+        cache.append(id, ks.back().data(), vs.back().data(), n);
+    }
+    check("KVCache append across pages (length)", cache.length(id) == 25);
+    check("KVCache append across pages (K)",
+          maxAbsDiff(readBack(cache.keys(id), 25), concatTokens(ks, lens)) == 0.f);
+    check("KVCache append across pages (V)",
+          maxAbsDiff(readBack(cache.values(id), 25), concatTokens(vs, lens)) == 0.f);
+    check("KVCache allocates whole pages", cache.bytesInUse() == 4 * cache.pageBytes());
+}
+
+static void testPrefixSharing() {
+    std::mt19937 rng(2);
+    KVCache<float> cache(KV_HEADS, HEAD_DIM, PAGE, 1 << 20, MemType::Host);
+    std::vector<int> prompt(20);
+    std::iota(prompt.begin(), prompt.end(), 100);
+    const auto k = randomKV(20, rng), v = randomKV(20, rng);
+
+    const auto a = cache.createSequence(prompt.data(), 20);
+    check("KVCache cold prompt has no cached prefix", a.cachedTokens == 0);
+    cache.append(a.id, k.data(), v.data(), 20, prompt.data());
+    const size_t bytesA = cache.bytesInUse();
+
+    // Same prompt while A is alive: the two full pages are shared.
+    const auto b = cache.createSequence(prompt.data(), 20);
+    check("KVCache warm prompt reuses full pages", b.cachedTokens == 16);
+    check("KVCache shared prefix allocates nothing", cache.bytesInUse() == bytesA);
+    const std::vector<float> kA = readBack(cache.keys(a.id), 16);
+    check("KVCache shared prefix reads identical K",
+          maxAbsDiff(readBack(cache.keys(b.id), 16), kA) == 0.f);
+
+    // A diverging prompt shares only the first page.
+    std::vector<int> other(prompt);
+    other[10] = -1;
+    const auto c = cache.createSequence(other.data(), 20);
+    check("KVCache diverging prompt shares the common pages", c.cachedTokens == 8);
+
+    // Released pages stay cached and serve a later request.
+    cache.release(a.id);
+    cache.release(b.id);
+    cache.release(c.id);
+    check("KVCache released prefix pages stay cached", cache.cachedPages() == 2);
+    const auto d = cache.createSequence(prompt.data(), 20);
+    check("KVCache cached prefix survives release", d.cachedTokens == 16 &&
+          maxAbsDiff(readBack(cache.keys(d.id), 16), kA) == 0.f);
+}
+
+static void testForkCopyOnWrite() {
+    std::mt19937 rng(3);
+    KVCache<float> cache(KV_HEADS, HEAD_DIM, PAGE, 1 << 20, MemType::Host);
+    const auto base = cache.createSequence();
+    const auto k = randomKV(11, rng), v = randomKV(11, rng);
+    cache.append(base, k.data(), v.data(), 11);
+    const std::vector<float> before = readBack(cache.values(base), 11);
+
+    const auto child = cache.fork(base);
+    const size_t bytesShared = cache.bytesInUse();
+    const auto k2 = randomKV(3, rng), v2 = randomKV(3, rng);
+    cache.append(child, k2.data(), v2.data(), 3);
+    check("KVCache fork copies the shared tail page on write",
+          cache.bytesInUse() == bytesShared + cache.pageBytes());
+    check("KVCache fork leaves the parent untouched",
+          maxAbsDiff(readBack(cache.values(base), 11), before) == 0.f && cache.length(base) == 11);
+    check("KVCache fork sees parent prefix + own tokens",
+          maxAbsDiff(readBack(cache.values(child), 14), concatTokens({ v, v2 }, { 11, 3 })) == 0.f);
+}
+
+static void testLruEviction() {
+    std::mt19937 rng(4);
+    KVCache<float> probe(KV_HEADS, HEAD_DIM, PAGE, 1 << 20, MemType::Host);
+    const size_t budget = 3 * probe.pageBytes();
+    KVCache<float> cache(KV_HEADS, HEAD_DIM, PAGE, budget, MemType::Host);
+
+    // Three one-page prompts fill the budget, then get released (cached).
+    std::vector<std::vector<int>> prompts(4, std::vector<int>(PAGE));
+    for (int p = 0; p < 4; ++p) std::iota(prompts[p].begin(), prompts[p].end(), 1000 * p);
+    const auto k = randomKV(PAGE, rng), v = randomKV(PAGE, rng);
+    for (int p = 0; p < 3; ++p) {
+        const auto s = cache.createSequence(prompts[p].data(), PAGE);
+        cache.append(s.id, k.data(), v.data(), PAGE, prompts[p].data());
+        cache.release(s.id);
+    }
+    // Touch prompt 0 so prompt 1 becomes the least recently used.
+    cache.release(cache.createSequence(prompts[0].data(), PAGE).id);
+
+    const auto s = cache.createSequence(prompts[3].data(), PAGE);
+    cache.append(s.id, k.data(), v.data(), PAGE, prompts[3].data());
+    check("KVCache stays within the byte budget", cache.bytesInUse() <= budget);
+    int hits[3];
+    for (int p = 0; p < 3; ++p) {
+        const auto q = cache.createSequence(prompts[p].data(), PAGE);
+        hits[p] = q.cachedTokens;
+        cache.release(q.id);
+    }
+    check("KVCache evicts the least recently used page",
+          hits[0] == PAGE && hits[1] == 0 && hits[2] == PAGE);
+
+    // Live pages are never evicted: a fourth live page cannot fit.
+    const auto x = cache.createSequence(prompts[0].data(), PAGE);
+    const auto y = cache.createSequence(prompts[2].data(), PAGE);
+    bool thrown = false;
+    try {
+        const auto z = cache.createSequence();
+        cache.append(z, k.data(), v.data(), 1);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check("KVCache throws when live sequences exhaust the budget", thrown);
+    cache.release(x.id);
+    cache.release(y.id);
+}
+
+static void testInt8PagesFeedAttention() {
+    // Quantized pages dequantize like quantizeKVCacheHost, and the paged IOps
+    // drive the CPU FlashAttention exactly like contiguous int8 K/V.
+    std::mt19937 rng(5);
+    constexpr int SEQ = 37, SQ = 4;
+    KVCache<float, KVLayout::INT8_PER_TOKEN> cache(KV_HEADS, HEAD_DIM, PAGE, 1 << 20, MemType::Host);
+    const auto k = randomKV(SEQ, rng), v = randomKV(SEQ, rng);
+    // appended in two chunks: tokens [0, 20) and [20, 37) of every head
+    std::vector<float> k2((size_t)KV_HEADS * 17 * HEAD_DIM), v2(k2.size());
+    for (int h = 0; h < KV_HEADS; ++h)
+        for (int t = 0; t < 17; ++t)
+            for (int c = 0; c < HEAD_DIM; ++c) {
+                k2[((size_t)h * 17 + t) * HEAD_DIM + c] = k[((size_t)h * SEQ + 20 + t) * HEAD_DIM + c];
+                v2[((size_t)h * 17 + t) * HEAD_DIM + c] = v[((size_t)h * SEQ + 20 + t) * HEAD_DIM + c];
+            }
+    std::vector<float> k1((size_t)KV_HEADS * 20 * HEAD_DIM), v1(k1.size());
+    for (int h = 0; h < KV_HEADS; ++h)
+        for (int t = 0; t < 20; ++t)
+            for (int c = 0; c < HEAD_DIM; ++c) {
+                k1[((size_t)h * 20 + t) * HEAD_DIM + c] = k[((size_t)h * SEQ + t) * HEAD_DIM + c];
+                v1[((size_t)h * 20 + t) * HEAD_DIM + c] = v[((size_t)h * SEQ + t) * HEAD_DIM + c];
+            }
+    const auto seq = cache.createSequence();
+    cache.append(seq, k1.data(), v1.data(), 20);
+    cache.append(seq, k2.data(), v2.data(), 17);
+
+    std::vector<int8_t> k8(k.size()), v8(v.size());
+    std::vector<float> kSc((size_t)KV_HEADS * SEQ), vSc(kSc.size());
+    quantizeKVCacheHost(k.data(), k8.data(), kSc.data(), KV_HEADS * SEQ, HEAD_DIM);
+    quantizeKVCacheHost(v.data(), v8.data(), vSc.data(), KV_HEADS * SEQ, HEAD_DIM);
+    const auto kRef = makeInt8KVRead(k8.data(), kSc.data(), KV_HEADS, SEQ, HEAD_DIM);
+    check("KVCache int8 pages dequantize like quantizeKVCacheHost",
+          maxAbsDiff(readBack(cache.keys(seq), SEQ), readBack(kRef, SEQ)) == 0.f);
+
+    // GQA: 2 query heads per KV head, queries attend the whole cache.
+    std::vector<float> q = randomKV(2 * SQ, rng);   // (2 * KV_HEADS, SQ, HEAD_DIM)
+    std::vector<float> oPaged(q.size()), oRef(q.size());
+    Stream_<ParArch::CPU> stream;
+    const auto qIOp = makeAttentionRead(q.data(), 2 * KV_HEADS, SQ, HEAD_DIM);
+    executeFlashAttention<HEAD_DIM>(qIOp, cache.keys(seq), cache.values(seq), oPaged.data(),
+                                    2 * KV_HEADS, SQ, SEQ, false, stream, -1.f,
+                                    AttentionIdentityEpilogue{}, 2);
+    executeFlashAttention<HEAD_DIM>(qIOp, kRef,
+                                    makeInt8KVRead(v8.data(), vSc.data(), KV_HEADS, SEQ, HEAD_DIM),
+                                    oRef.data(), 2 * KV_HEADS, SQ, SEQ, false, stream, -1.f,
+                                    AttentionIdentityEpilogue{}, 2);
+    check("KVCache paged int8 IOps drive FlashAttention", maxAbsDiff(oPaged, oRef) == 0.f);
+}
+
+int launch() {
+    testAppendAcrossPages();
+    testPrefixSharing();
+    testForkCopyOnWrite();
+    testLruEviction();
+    testInt8PagesFeedAttention();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " KV cache test(s) FAILED" << std::endl;
+    return -1;
+}
@@ -12,7 +12,6 @@
    See the License for the specific language governing permissions and
    limitations under the License. */
 
-#define __ONLY_CU__ // This file is only generated and compiled with nvcc, not with the host compiler
 #include <tests/main.h>
 
 #include <fused_kernel/algorithms/attention/softmax.h>
@@ -20,6 +19,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -27,31 +27,54 @@ using namespace fk;
 
 static int failures = 0;
 
+// Runs softmax on the PA backend and returns the output in host order.
+// The prologue (if any) is applied to the read IOp by `decorate`.
+template <ParArch PA, typename Decorate>
+static std::vector<float> runSoftmax(const std::vector<float>& host, const int width, const int height,
+                                     const Decorate& decorate) {
+    constexpr bool GPU = PA == ParArch::GPU_NVIDIA;
+    const MemType memoryType = GPU ? MemType::DeviceAndPinned : MemType::Host;
+
+    Ptr2D<float> input(width, height, 0, memoryType);
+    Ptr2D<float> output(width, height, 0, memoryType);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            input.at(Point{x, y, 0}) = host[(size_t)y*width+x];
+        }
+    }
+
+    Stream_<PA> stream;
+#if defined(__NVCC__)
+    if constexpr (GPU) input.upload(stream);
+#endif
+    const auto inIOp = decorate(PerThreadRead<ND::_2D, float>::build(input.ptr()));
+    const auto outIOp = PerThreadWrite<ND::_2D, float>::build(output.ptr());
+    executeSoftmax<256>(inIOp, outIOp, stream);
+#if defined(__NVCC__)
+    if constexpr (GPU) output.download(stream);
+#endif
+    stream.sync();
+
+    std::vector<float> got((size_t)width * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            got[(size_t)y*width+x] = output.at(Point{x, y, 0});
+        }
+    }
+    return got;
+}
+
+template <ParArch PA>
 static void runCase(const char* name, const int width, const int height,
                     const float lo, const float hi, const double tol,
                     const unsigned seed) {
     std::mt19937 rng(seed);
     std::uniform_real_distribution<float> dist(lo, hi);
 
-    Ptr2D<float> input(width, height, 0, MemType::Device);
-    Ptr2D<float> output(width, height, 0, MemType::Device);
-
     std::vector<float> host((size_t)width * height);
     for (auto& v : host) v = dist(rng);
-    gpuErrchk(cudaMemcpy2D(input.ptr().data, input.ptr().dims.pitch,
-                           host.data(), width * sizeof(float),
-                           width * sizeof(float), height, cudaMemcpyHostToDevice));
 
-    Stream stream;
-    const auto inIOp = PerThreadRead<ND::_2D, float>::build(input.ptr());
-    const auto outIOp = PerThreadWrite<ND::_2D, float>::build(output.ptr());
-    executeSoftmax<256>(inIOp, outIOp, stream);
-    stream.sync();
-
-    std::vector<float> got((size_t)width * height);
-    gpuErrchk(cudaMemcpy2D(got.data(), width * sizeof(float),
-                           output.ptr().data, output.ptr().dims.pitch,
-                           width * sizeof(float), height, cudaMemcpyDeviceToHost));
+    const auto got = runSoftmax<PA>(host, width, height, [](const auto& read) { return read; });
 
     double maxErr = 0.0;
     for (int y = 0; y < height; ++y) {
@@ -80,32 +103,18 @@ static void runCase(const char* name, const int width, const int height,
 // PROLOGUE: input enters through a Read IOp fused with a compute chain.
 // softmax(2*x + 1) == softmax(2*x) (row-constant shift cancels), and
 // softmax over 2*x differs from softmax over x -> both effects verified.
+template <ParArch PA>
 static void runPrologueCase(const char* name, const int width, const int height,
                             const double tol, const unsigned seed) {
     std::mt19937 rng(seed);
     std::uniform_real_distribution<float> dist(-4.f, 4.f);
 
-    Ptr2D<float> input(width, height, 0, MemType::Device);
-    Ptr2D<float> output(width, height, 0, MemType::Device);
-
     std::vector<float> host((size_t)width * height);
     for (auto& v : host) v = dist(rng);
-    gpuErrchk(cudaMemcpy2D(input.ptr().data, input.ptr().dims.pitch,
-                           host.data(), width * sizeof(float),
-                           width * sizeof(float), height, cudaMemcpyHostToDevice));
-
-    Stream stream;
-    const auto inIOp = PerThreadRead<ND::_2D, float>::build(input.ptr())
-                           .then(Mul<float>::build(2.f))
-                           .then(Add<float>::build(1.f));
-    const auto outIOp = PerThreadWrite<ND::_2D, float>::build(output.ptr());
-    executeSoftmax<256>(inIOp, outIOp, stream);
-    stream.sync();
 
-    std::vector<float> got((size_t)width * height);
-    gpuErrchk(cudaMemcpy2D(got.data(), width * sizeof(float),
-                           output.ptr().data, output.ptr().dims.pitch,
-                           width * sizeof(float), height, cudaMemcpyDeviceToHost));
+    const auto got = runSoftmax<PA>(host, width, height, [](const auto& read) {
+        return read.then(Mul<float>::build(2.f)).then(Add<float>::build(1.f));
+    });
 
     double maxErr = 0.0;
     for (int y = 0; y < height; ++y) {
@@ -125,11 +134,48 @@ static void runPrologueCase(const char* name, const int width, const int height,
     }
 }
 
+// Fully masked rows (every score -inf) have no distribution: they must come
+// out as zeros, not NaN. A partially masked row is a softmax over the rest.
+template <ParArch PA>
+static void runMaskedRowsCase(const char* name, const int width) {
+    constexpr float NEG_INF = -std::numeric_limits<float>::infinity();
+    std::vector<float> host((size_t)width * 2, NEG_INF);
+    for (int x = 0; x < width; x += 3) host[(size_t)width + x] = 0.25f * x;
+
+    const auto got = runSoftmax<PA>(host, width, 2, [](const auto& read) { return read; });
+
+    bool ok = true;
+    double rowSum = 0.0;
+    for (int x = 0; x < width; ++x) {
+        ok &= got[(size_t)x] == 0.f;
+        const float v = got[(size_t)width + x];
+        ok &= !std::isnan(v) && (x % 3 != 0 ? v == 0.f : v > 0.f);
+        rowSum += v;
+    }
+    ok &= std::abs(rowSum - 1.0) <= 1e-5;
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+template <ParArch PA>
+static void runAllCases() {
+    runCase<PA>("Softmax f32 7x3", 7, 3, -4.f, 4.f, 1e-6, 1);
+    runCase<PA>("Softmax f32 256x16 (block-sized)", 256, 16, -8.f, 8.f, 1e-6, 2);
+    runCase<PA>("Softmax f32 1000x8 (strided non-pow2)", 1000, 8, -8.f, 8.f, 1e-6, 3);
+    runCase<PA>("Softmax f32 stability |x|<=500", 333, 5, -500.f, 500.f, 1e-6, 4);
+    runCase<PA>("Softmax f32 single column", 1, 4, -4.f, 4.f, 1e-6, 6);
+    runPrologueCase<PA>("Softmax prologue ReadIOp.then(Mul(2)).then(Add(1)) 100x6", 100, 6, 1e-6, 5);
+    runMaskedRowsCase<PA>("Softmax -inf rows 37x2", 37);
+}
+
 int launch() {
-    runCase("Softmax f32 7x3", 7, 3, -4.f, 4.f, 1e-6, 1);
-    runCase("Softmax f32 256x16 (block-sized)", 256, 16, -8.f, 8.f, 1e-6, 2);
-    runCase("Softmax f32 1000x8 (strided non-pow2)", 1000, 8, -8.f, 8.f, 1e-6, 3);
-    runCase("Softmax f32 stability |x|<=500", 333, 5, -500.f, 500.f, 1e-6, 4);
-    runPrologueCase("Softmax prologue ReadIOp.then(Mul(2)).then(Add(1)) 100x6", 100, 6, 1e-6, 5);
+    runAllCases<ParArch::CPU>();
+#if defined(__NVCC__)
+    runAllCases<ParArch::GPU_NVIDIA>();
+#endif
     return failures == 0 ? 0 : -1;
 }
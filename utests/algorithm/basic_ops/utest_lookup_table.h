@@ -0,0 +1,176 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/lookup_table.h>
+#include <fused_kernel/algorithms/basic_ops/math.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/basic_ops/vector_ops.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <iostream>
+#include <stdexcept>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+// uchar3 gamma 1/2.2 as exp(ln(x) / 2.2), through the table and computed per pixel
+static bool gammaMatches(CpuStream& stream) {
+    fk::Ptr2D<uchar3> source(64, 16, 0, fk::MemType::Host);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = fk::make_<uchar3>(static_cast<uchar>(x * 4 + y % 4),
+                static_cast<uchar>(255 - x - y), static_cast<uchar>((x * y) % 256));
+        }
+    }
+    const auto toFloat = fk::Cast<uchar3, float3>::build();
+    const auto normalize = fk::Mul<float3>::build(fk::make_set<float3>(1.f / 255.f));
+    const auto ln = fk::Ln<float3>::build();
+    const auto exponent = fk::Mul<float3>::build(fk::make_set<float3>(1.f / 2.2f));
+    const auto exp = fk::Exp<float3>::build();
+    const auto scale = fk::Mul<float3>::build(fk::make_set<float3>(255.f));
+    const auto saturate = fk::SaturateCast<float3, uchar3>::build();
+
+    fk::Ptr1D<uchar> table;
+    const auto lut = fk::LookupTable<uchar3>::bake(table, stream, toFloat, normalize, ln, exponent, exp, scale, saturate);
+    static_assert(std::is_same_v<typename std::decay_t<decltype(lut)>::Operation::OutputType, uchar3>);
+
+    fk::Ptr2D<uchar3> direct(64, 16, 0, fk::MemType::Host);
+    fk::Ptr2D<uchar3> gathered(64, 16, 0, fk::MemType::Host);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    fk::executeOperations<CpuDPP>(stream, read, toFloat, normalize, ln, exponent, exp, scale, saturate,
+                                  fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(direct));
+    fk::executeOperations<CpuDPP>(stream, read, lut, fk::PerThreadWrite<fk::ND::_2D, uchar3>::build(gathered));
+    stream.sync();
+    bool ok = table.dims().width == 256 * 3 && table.getMemType() == fk::MemType::Host;
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            const uchar3 a = direct.at(fk::Point{ x, y, 0 });
+            const uchar3 b = gathered.at(fk::Point{ x, y, 0 });
+            ok = ok && a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+    }
+    return ok;
+}
+
+// 10 bit HDR values in ushort, scaled to float; values above 1023 read the last entry
+static bool tenBitMatches(CpuStream& stream) {
+    const auto toFloat = fk::Cast<ushort, float>::build();
+    const auto scale = fk::Mul<float>::build(1.f / 1023.f);
+    const auto offset = fk::Sub<float>::build(0.5f);
+    fk::Ptr1D<float> table;
+    const auto lut = fk::LookupTable<ushort, 10>::bake(table, stream, toFloat, scale, offset);
+    bool ok = table.dims().width == 1024;
+    for (uint value = 0; value < 1024; ++value) {
+        const ushort v = static_cast<ushort>(value);
+        ok = ok && (v | lut) == (v | toFloat | scale | offset);
+    }
+    const ushort outOfRange = 4000;
+    ok = ok && (outOfRange | lut) == (static_cast<ushort>(1023) | toFloat | scale | offset);
+    return ok;
+}
+
+// Full 16 bit domain per channel, and the table is reused when baked again
+static bool sixteenBitReused(CpuStream& stream) {
+    const auto toFloat = fk::Cast<ushort2, float2>::build();
+    const auto scale = fk::Mul<float2>::build(fk::make_<float2>(2.f, -1.f));
+    fk::Ptr1D<float> table;
+    fk::LookupTable<ushort2>::bake(table, stream, toFloat, scale);
+    const float* const first = table.ptr().data;
+    const auto lut = fk::LookupTable<ushort2>::bake(table, stream, toFloat, fk::Mul<float2>::build(fk::make_<float2>(3.f, 1.f)));
+    const float2 result = fk::make_<ushort2>(65535, 7) | lut;
+    return table.dims().width == 65536 * 2 && table.ptr().data == first &&
+           result.x == 3.f * 65535.f && result.y == 7.f;
+}
+
+// A chain that swaps channels passes the static_asserts, but can not be a per channel table
+static bool swapRejected(CpuStream& stream) {
+    const auto toFloat = fk::Cast<uchar3, float3>::build();
+    const auto swap = fk::VectorReorder<float3, 2, 1, 0>::build();
+    const auto scale = fk::Mul<float3>::build(fk::make_set<float3>(0.5f));
+    fk::Ptr1D<float> table;
+    try {
+        fk::LookupTable<uchar3>::bake(table, stream, toFloat, swap, scale);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+#if defined(__NVCC__)
+// The same gamma table read through __ldg by the GPU TransformDPP
+static bool gammaMatchesGPU() {
+    fk::Stream_<fk::ParArch::GPU_NVIDIA> stream;
+    fk::Ptr2D<uchar> source(256, 4, 0, fk::MemType::DeviceAndPinned);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            source.at(fk::Point{ x, y, 0 }) = static_cast<uchar>((x + y * 67) % 256);
+        }
+    }
+    source.upload(stream);
+    const auto toFloat = fk::Cast<uchar, float>::build();
+    const auto normalize = fk::Mul<float>::build(1.f / 255.f);
+    const auto ln = fk::Ln<float>::build();
+    const auto exponent = fk::Mul<float>::build(1.f / 2.2f);
+    const auto exp = fk::Exp<float>::build();
+    const auto scale = fk::Mul<float>::build(255.f);
+    const auto saturate = fk::SaturateCast<float, uchar>::build();
+
+    fk::Ptr1D<uchar> table;
+    const auto lut = fk::LookupTable<uchar>::bake(table, stream, toFloat, normalize, ln, exponent, exp, scale, saturate);
+    fk::Ptr2D<uchar> gathered(256, 4, 0, fk::MemType::DeviceAndPinned);
+    fk::executeOperations<fk::TransformDPP<fk::ParArch::GPU_NVIDIA>>(stream,
+        fk::PerThreadRead<fk::ND::_2D, uchar>::build(source), lut,
+        fk::PerThreadWrite<fk::ND::_2D, uchar>::build(gathered));
+    gathered.download(stream);
+    stream.sync();
+
+    // The host copy of the table holds the chain evaluated on the host
+    bool ok = table.getMemType() == fk::MemType::DeviceAndPinned;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            const uchar value = source.at(fk::Point{ x, y, 0 });
+            ok = ok && gathered.at(fk::Point{ x, y, 0 }) == table.at(fk::Point{ value, 0, 0 });
+        }
+    }
+    return ok;
+}
+#endif
+
+int launch() {
+    CpuStream stream;
+    check("lookup_table_gamma_uchar3", gammaMatches(stream));
+    check("lookup_table_10bit", tenBitMatches(stream));
+    check("lookup_table_16bit_reuse", sixteenBitReused(stream));
+    check("lookup_table_rejects_channel_swap", swapRejected(stream));
+#if defined(__NVCC__)
+    check("lookup_table_gamma_gpu", gammaMatchesGPU());
+#endif
+    return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,120 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/math.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+// Multi-channel pixels take the batch kernels of cxp::expf and cxp::logf
+static_assert(cxp::hasBatchExec<fk::math_detail::ExpFunc, fk::Array<float, 4>>);
+static_assert(cxp::hasBatchExec<fk::math_detail::LnFunc, fk::Array<float, 4>>);
+
+constexpr int WIDTH = 509;
+constexpr int HEIGHT = 7;
+
+// Distance in ULP between two floats. NaN only matches NaN, and infinities only themselves.
+static int64_t ulpDistance(const float a, const float b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<int64_t>::max();
+    }
+    const auto ordered = [](const float f) {
+        const int64_t bits = cxp::bit_cast<int>(f);
+        return bits < 0 ? static_cast<int64_t>(INT32_MIN) - bits : bits;
+    };
+    const int64_t d = ordered(a) - ordered(b);
+    return d < 0 ? -d : d;
+}
+
+// Inputs spread over [lo, hi], one different value per channel
+static fk::Ptr2D<float4> makeInput(const float lo, const float hi) {
+    fk::Ptr2D<float4> input(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    constexpr int COUNT = WIDTH * HEIGHT * 4;
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            float v[4];
+            for (int c = 0; c < 4; ++c) {
+                const int i = ((y * WIDTH + x) * 4 + c) * 7919 % COUNT;
+                v[c] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(COUNT - 1);
+            }
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), input.ptr()) = fk::make_<float4>(v[0], v[1], v[2], v[3]);
+        }
+    }
+    return input;
+}
+
+// Runs Op<float4> through the CPU TransformDPP and compares every channel with scalar(x)
+template <typename DPP, typename IOp, typename Scalar>
+static bool matchesScalar(CpuStream& stream, const fk::Ptr2D<float4>& input, const IOp& iOp,
+                          const Scalar& scalar, const int64_t maxUlp) {
+    fk::Ptr2D<float4> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::executeOperations<DPP>(stream, fk::PerThreadRead<fk::ND::_2D, float4>::build(input), iOp,
+                               fk::PerThreadWrite<fk::ND::_2D, float4>::build(output));
+    stream.sync();
+    int64_t worst = 0;
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            const float4 in = input.at(fk::Point(x, y, 0));
+            const float4 out = output.at(fk::Point(x, y, 0));
+            worst = std::max({ worst, ulpDistance(out.x, scalar(in.x)), ulpDistance(out.y, scalar(in.y)),
+                               ulpDistance(out.z, scalar(in.z)), ulpDistance(out.w, scalar(in.w)) });
+        }
+    }
+    if (worst > maxUlp) {
+        std::cout << "max error " << worst << " ULP, the bound is " << maxUlp << std::endl;
+    }
+    return worst <= maxUlp;
+}
+
+int launch() {
+    CpuStream stream;
+    using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+    using CpuTFDPP = fk::TransformDPP<fk::ParArch::CPU, fk::TF::ENABLED>;
+    const auto stdExp = [](const float x) { return std::exp(x); };
+    const auto stdLog = [](const float x) { return std::log(x); };
+
+    // Overflow, gradual underflow and the whole finite range in between
+    const fk::Ptr2D<float4> expInput = makeInput(-104.f, 89.f);
+    check("exp_float4_cpu_dpp_1ulp", matchesScalar<CpuDPP>(stream, expInput, fk::Exp<float4>::build(), stdExp, 1));
+    check("exp_float4_cpu_dpp_thread_fusion_1ulp",
+          matchesScalar<CpuTFDPP>(stream, expInput, fk::Exp<float4>::build(), stdExp, 1));
+
+    // Negative inputs give NaN and zero gives -inf
+    const fk::Ptr2D<float4> logInput = makeInput(-1.f, 1.e6f);
+    check("ln_float4_cpu_dpp_3ulp", matchesScalar<CpuDPP>(stream, logInput, fk::Ln<float4>::build(), stdLog, 3));
+    const fk::Ptr2D<float4> smallLogInput = makeInput(0.f, 1.e-30f);
+    check("ln_float4_cpu_dpp_small_3ulp",
+          matchesScalar<CpuDPP>(stream, smallLogInput, fk::Ln<float4>::build(), stdLog, 3));
+    return failures == 0 ? 0 : -1;
+}
@@ -19,6 +19,7 @@
 #include <fused_kernel/core/utils/type_to_string.h>
 #include <tests/operation_test_utils.h>
 #include <fused_kernel/algorithms/image_processing/image.h>
+#include <fused_kernel/fused_kernel.h>
 
 // Test PixelFormatTraits for UYVY
 void testUYVYPixelFormatTraits() {
@@ -771,6 +772,160 @@ void testConvertRGBToYUV() {
     };
 }
 
+namespace fk {
+// Compares FixedPointOp with FloatOp on a grid of pixels of CD, after rounding and
+// saturating the Float result the way an image of color depth CD would store it
+template <ColorDepth CD,
+          template <ColorDepth, ColorRange, ColorPrimitives> class FloatOp,
+          template <ColorDepth, ColorRange, ColorPrimitives> class FixedPointOp,
+          ColorRange CR, ColorPrimitives CP>
+inline bool testFixedPointConversion_helper() {
+    using PixelType = ColorDepthPixelType<CD>;
+    using PixelBaseType = ColorDepthPixelBaseType<CD>;
+    constexpr int maxVal = static_cast<int>(maxDepthValue<CD>);
+    // Around 40 values per channel, always including 0 and maxVal
+    constexpr int step = (maxVal + 39) / 40;
+
+    int maxError{0};
+    const auto values = [](const int i) { return i > maxVal ? maxVal : i; };
+    for (int a = 0; a < maxVal + step; a += step) {
+        for (int b = 0; b < maxVal + step; b += step) {
+            for (int c = 0; c < maxVal + step; c += step) {
+                const PixelType pixel = make_<PixelType>(static_cast<PixelBaseType>(values(a)),
+                                                         static_cast<PixelBaseType>(values(b)),
+                                                         static_cast<PixelBaseType>(values(c)));
+                const float3 expected = FloatOp<CD, CR, CP>::exec(pixel);
+                const PixelType got = FixedPointOp<CD, CR, CP>::exec(pixel);
+                maxError = std::max({ maxError,
+                                      std::abs(static_cast<int>(got.x) - static_cast<int>(storeComponent<CD>(expected.x))),
+                                      std::abs(static_cast<int>(got.y) - static_cast<int>(storeComponent<CD>(expected.y))),
+                                      std::abs(static_cast<int>(got.z) - static_cast<int>(storeComponent<CD>(expected.z))) });
+            }
+        }
+    }
+    if (maxError > 1) {
+        std::cout << "\033[31m" << typeToString<FixedPointOp<CD, CR, CP>>()
+                  << " differs from " << typeToString<FloatOp<CD, CR, CP>>() << " by " << maxError << " LSB"
+                  << "\033[0m" << std::endl;
+    }
+    return maxError <= 1;
+}
+
+template <ColorDepth CD,
+          template <ColorDepth, ColorRange, ColorPrimitives> class FloatOp,
+          template <ColorDepth, ColorRange, ColorPrimitives> class FixedPointOp,
+          ColorPrimitives CP>
+inline bool testFixedPointConversionRanges() {
+    const bool full = testFixedPointConversion_helper<CD, FloatOp, FixedPointOp, ColorRange::Full, CP>();
+    const bool limited = testFixedPointConversion_helper<CD, FloatOp, FixedPointOp, ColorRange::Limited, CP>();
+    return full && limited;
+}
+
+template <ColorDepth CD, ColorPrimitives CP>
+inline bool testFixedPointConversionDirections() {
+    return testFixedPointConversionRanges<CD, ConvertYUVToRGB, ConvertYUVToRGBFixedPoint, CP>() &&
+           testFixedPointConversionRanges<CD, ConvertRGBToYUV, ConvertRGBToYUVFixedPoint, CP>();
+}
+
+template <ColorDepth CD>
+inline bool testFixedPointConversionPrimitives() {
+    const bool bt601 = testFixedPointConversionDirections<CD, ColorPrimitives::bt601>();
+    const bool bt709 = testFixedPointConversionDirections<CD, ColorPrimitives::bt709>();
+    const bool bt2020 = testFixedPointConversionDirections<CD, ColorPrimitives::bt2020>();
+    return bt601 && bt709 && bt2020;
+}
+
+// Reads a PF image with ReadYUV and converts it with the CODE ColorConversion, once per
+// ColorArithmetic. Both must have the same OutputType and stay within 1 LSB of each other.
+template <PixelFormat PF, ColorConversionCodes CODE>
+inline bool testReadYUVColorConversion_helper() {
+    constexpr ColorDepth CD = PixelFormatTraits<PF>::depth;
+    using PixelType = ColorDepthPixelType<CD>;
+    using BaseType = ColorDepthPixelBaseType<CD>;
+    using FloatCC = ColorConversion<CODE, PixelType, PixelType, CD, ColorArithmetic::Float>;
+    using FixedPointCC = ColorConversion<CODE, PixelType, PixelType, CD, ColorArithmetic::FixedPoint>;
+    static_assert(std::is_same_v<typename FloatCC::OutputType, PixelType>);
+    static_assert(std::is_same_v<typename FixedPointCC::OutputType, PixelType>);
+
+    constexpr uint width = 32;
+    constexpr uint height = 16;
+    Image<PF> image(width, height, MemType::Host);
+    const Ptr<ND::_2D, BaseType> data = image.getData();
+    const int maxVal = static_cast<int>(maxDepthValue<CD>);
+    // Luma and interleaved chroma planes, covering the whole range of CD
+    for (uint y = 0; y < data.dims().height; ++y) {
+        for (uint x = 0; x < data.dims().width; ++x) {
+            const int value = static_cast<int>((x * 37 + y * 101) % 256) * maxVal / 255;
+            *PtrAccessor<ND::_2D>::point(Point(x, y, 0), data.ptr()) = static_cast<BaseType>(value);
+        }
+    }
+
+    Stream_<ParArch::CPU> stream;
+    Ptr<ND::_2D, PixelType> floatOutput(width, height, 0, MemType::Host);
+    Ptr<ND::_2D, PixelType> fixedPointOutput(width, height, 0, MemType::Host);
+    executeOperations<TransformDPP<ParArch::CPU>>(stream, ReadYUV<PF>::build(image), FloatCC::build(),
+                                                  PerThreadWrite<ND::_2D, PixelType>::build(floatOutput));
+    executeOperations<TransformDPP<ParArch::CPU>>(stream, ReadYUV<PF>::build(image), FixedPointCC::build(),
+                                                  PerThreadWrite<ND::_2D, PixelType>::build(fixedPointOutput));
+    stream.sync();
+
+    int maxError{0};
+    for (uint y = 0; y < height; ++y) {
+        for (uint x = 0; x < width; ++x) {
+            const PixelType a = floatOutput.at(x, y);
+            const PixelType b = fixedPointOutput.at(x, y);
+            maxError = std::max({ maxError,
+                                  std::abs(static_cast<int>(a.x) - static_cast<int>(b.x)),
+                                  std::abs(static_cast<int>(a.y) - static_cast<int>(b.y)),
+                                  std::abs(static_cast<int>(a.z) - static_cast<int>(b.z)) });
+        }
+    }
+    if (maxError > 1) {
+        std::cout << "\033[31m" << typeToString<FixedPointCC>() << " differs from "
+                  << typeToString<FloatCC>() << " by " << maxError << " LSB" << "\033[0m" << std::endl;
+    }
+    return maxError <= 1;
+}
+} // namespace fk
+
+// Test that ColorArithmetic::FixedPoint stays within 1 LSB of ColorArithmetic::Float
+void testFixedPointColorConversion() {
+    const std::string testName = "FixedPointColorConversion";
+    testCases[testName] = [testName]() {
+        using namespace fk;
+        std::cout << "Running test for " << "\033[1;33m" << testName << "\033[1;33m" << ": ";
+        const bool correct = testFixedPointConversionPrimitives<ColorDepth::p8bit>() &&
+                             testFixedPointConversionPrimitives<ColorDepth::p10bit>() &&
+                             testFixedPointConversionPrimitives<ColorDepth::p12bit>();
+        if (correct) {
+            std::cout << "\033[32m" << "Success!!" << "\033[0m" << std::endl;
+        } else {
+            std::cout << "\033[31m" << "FAIL!!" << "\033[0m" << std::endl;
+        }
+        return correct;
+    };
+}
+
+// Test that ColorConversion of the NV12 and P010 pixels gives the same type for both ColorArithmetic
+void testReadYUVColorConversion() {
+    const std::string testName = "ReadYUVColorConversion";
+    testCases[testName] = [testName]() {
+        using namespace fk;
+        std::cout << "Running test for " << "\033[1;33m" << testName << "\033[1;33m" << ": ";
+        const bool correct =
+            testReadYUVColorConversion_helper<PixelFormat::NV12, ColorConversionCodes::COLOR_YUV2RGB_NV12>() &&
+            testReadYUVColorConversion_helper<PixelFormat::NV12, ColorConversionCodes::COLOR_YUV2BGR_NV12>() &&
+            testReadYUVColorConversion_helper<PixelFormat::P010, ColorConversionCodes::COLOR_YUV2RGB_NV12>() &&
+            testReadYUVColorConversion_helper<PixelFormat::P010, ColorConversionCodes::COLOR_YUV2BGR_NV12>();
+        if (correct) {
+            std::cout << "\033[32m" << "Success!!" << "\033[0m" << std::endl;
+        } else {
+            std::cout << "\033[31m" << "FAIL!!" << "\033[0m" << std::endl;
+        }
+        return correct;
+    };
+}
+
 START_ADDING_TESTS
 // Test UYVY pixel format traits
 testUYVYPixelFormatTraits();
@@ -803,6 +958,8 @@ testSaturateDenormalizePixel();
 testReadYUV();
 testTransformationMatrixValues();
 testConvertRGBToYUV();
+testFixedPointColorConversion();
+testReadYUVColorConversion();
 STOP_ADDING_TESTS
 
 int launch() {
@@ -0,0 +1,182 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/resize.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+constexpr uint SRC_W = 37;
+constexpr uint SRC_H = 29;
+constexpr uint DST_W = 64;
+constexpr uint DST_H = 20;
+
+static uchar sourceValue(const uint x, const uint y) {
+    return static_cast<uchar>((x * 37 + y * 91 + x * y) % 256);
+}
+
+// Plain integer bilinear with 11 bit weights, the reference for the uchar path
+static int reference(const fk::Ptr2D<uchar>& source, const float src_x, const float src_y) {
+    const int x1 = static_cast<int>(std::floor(src_x));
+    const int y1 = static_cast<int>(std::floor(src_y));
+    const int x2 = std::min(x1 + 1, static_cast<int>(SRC_W) - 1);
+    const int y2 = std::min(y1 + 1, static_cast<int>(SRC_H) - 1);
+    const int wx = static_cast<int>((src_x - x1) * 2048.f + 0.5f);
+    const int wy = static_cast<int>((src_y - y1) * 2048.f + 0.5f);
+    const auto at = [&source](const int x, const int y) {
+        return static_cast<int>(*fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), source.ptr()));
+    };
+    const int top = at(x1, y1) * (2048 - wx) + at(x2, y1) * wx;
+    const int bottom = at(x1, y2) * (2048 - wx) + at(x2, y2) * wx;
+    return (top * (2048 - wy) + bottom * wy + (1 << 21)) >> 22;
+}
+
+template <typename T>
+static bool sameOutputs(const fk::Ptr2D<T>& a, const fk::Ptr2D<T>& b) {
+    bool same = true;
+    for (uint y = 0; y < DST_H; ++y) {
+        for (uint x = 0; x < DST_W; ++x) {
+            const T va = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), a.ptr());
+            const T vb = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), b.ptr());
+            same &= std::memcmp(&va, &vb, sizeof(T)) == 0;
+        }
+    }
+    return same;
+}
+
+#if defined(__NVCC__)
+// The same INTER_LINEAR_EXACT resize on the GPU TransformDPP
+template <typename T>
+static fk::Ptr2D<T> resizeOnGPU(const fk::Ptr2D<T>& source) {
+    fk::Stream_<fk::ParArch::GPU_NVIDIA> stream;
+    fk::Ptr2D<T> d_source(SRC_W, SRC_H, 0, fk::MemType::DeviceAndPinned);
+    for (uint y = 0; y < SRC_H; ++y) {
+        for (uint x = 0; x < SRC_W; ++x) {
+            d_source.at(fk::Point(x, y, 0)) = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), source.ptr());
+        }
+    }
+    d_source.upload(stream);
+    fk::Ptr2D<T> output(DST_W, DST_H, 0, fk::MemType::DeviceAndPinned);
+    fk::executeOperations<fk::TransformDPP<fk::ParArch::GPU_NVIDIA>>(stream,
+        fk::Resize<fk::InterpolationType::INTER_LINEAR_EXACT>::build(
+            fk::PerThreadRead<fk::ND::_2D, T>::build(d_source), fk::Size(DST_W, DST_H)),
+        fk::PerThreadWrite<fk::ND::_2D, T>::build(output));
+    output.download(stream);
+    stream.sync();
+    return output;
+}
+#endif
+
+static void testUchar(CpuStream& stream) {
+    fk::Ptr2D<uchar> source(SRC_W, SRC_H, 0, fk::MemType::Host);
+    for (uint y = 0; y < SRC_H; ++y) {
+        for (uint x = 0; x < SRC_W; ++x) {
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), source.ptr()) = sourceValue(x, y);
+        }
+    }
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(source);
+    // INTER_LINEAR_EXACT returns uchar, written without any conversion
+    fk::Ptr2D<uchar> exact(DST_W, DST_H, 0, fk::MemType::Host);
+    fk::Ptr2D<float> linear(DST_W, DST_H, 0, fk::MemType::Host);
+    const auto resize = fk::Resize<fk::InterpolationType::INTER_LINEAR_EXACT>::build(read, fk::Size(DST_W, DST_H));
+    static_assert(std::is_same_v<typename std::decay_t<decltype(resize)>::Operation::OutputType, uchar>);
+    fk::executeOperations<CpuDPP>(stream, resize, fk::PerThreadWrite<fk::ND::_2D, uchar>::build(exact));
+    fk::executeOperations<CpuDPP>(stream,
+        fk::Resize<fk::InterpolationType::INTER_LINEAR>::build(read, fk::Size(DST_W, DST_H)),
+        fk::PerThreadWrite<fk::ND::_2D, float>::build(linear));
+
+    const float fx = static_cast<float>(1.0 / (static_cast<double>(DST_W) / SRC_W));
+    const float fy = static_cast<float>(1.0 / (static_cast<double>(DST_H) / SRC_H));
+    bool matchesReference = true;
+    bool closeToFloat = true;
+    for (uint y = 0; y < DST_H; ++y) {
+        for (uint x = 0; x < DST_W; ++x) {
+            const int value = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), exact.ptr());
+            const float floatValue = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), linear.ptr());
+            matchesReference &= value == reference(source, x * fx, y * fy);
+            // Rounding, plus the weights quantization of up to 2^-12 per axis
+            closeToFloat &= std::fabs(static_cast<float>(value) - floatValue) <= 0.5f + 255.f / 2048.f;
+        }
+    }
+    check("uchar INTER_LINEAR_EXACT matches the integer reference", matchesReference);
+    check("uchar INTER_LINEAR_EXACT is the rounded float interpolation", closeToFloat);
+
+    // With PRESERVE_AR the background is a uchar too
+    fk::Ptr2D<uchar> letterbox(DST_W, DST_H, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream,
+        fk::Resize<fk::InterpolationType::INTER_LINEAR_EXACT, fk::AspectRatio::PRESERVE_AR>::build(
+            read, fk::Size(DST_W, DST_H), static_cast<uchar>(7)),
+        fk::PerThreadWrite<fk::ND::_2D, uchar>::build(letterbox));
+    check("uchar INTER_LINEAR_EXACT PRESERVE_AR background",
+          *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(0, 0, 0), letterbox.ptr()) == 7);
+#if defined(__NVCC__)
+    check("uchar INTER_LINEAR_EXACT is bit exact on the GPU", sameOutputs(exact, resizeOnGPU(source)));
+#endif
+}
+
+static void testUshort3(CpuStream& stream) {
+    // Full range 16 bit pixels must not overflow the accumulators
+    fk::Ptr2D<ushort3> source(SRC_W, SRC_H, 0, fk::MemType::Host);
+    for (uint y = 0; y < SRC_H; ++y) {
+        for (uint x = 0; x < SRC_W; ++x) {
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), source.ptr()) =
+                fk::make_<ushort3>(65535, static_cast<ushort>((x & 1) * 65535), static_cast<ushort>(x * 1000 + y));
+        }
+    }
+    fk::Ptr2D<ushort3> output(DST_W, DST_H, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream,
+        fk::Resize<fk::InterpolationType::INTER_LINEAR_EXACT>::build(
+            fk::PerThreadRead<fk::ND::_2D, ushort3>::build(source), fk::Size(DST_W, DST_H)),
+        fk::PerThreadWrite<fk::ND::_2D, ushort3>::build(output));
+    bool ok = true;
+    for (uint y = 0; y < DST_H; ++y) {
+        for (uint x = 0; x < DST_W; ++x) {
+            const ushort3 value = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), output.ptr());
+            ok &= value.x == 65535;
+        }
+    }
+    const ushort3 first = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(0, 0, 0), output.ptr());
+    check("ushort3 INTER_LINEAR_EXACT keeps full range pixels", ok && first.y == 0 && first.z == 0);
+#if defined(__NVCC__)
+    check("ushort3 INTER_LINEAR_EXACT is bit exact on the GPU",
+          sameOutputs(output, resizeOnGPU(source)));
+#endif
+}
+
+int launch() {
+    CpuStream stream;
+    testUchar(stream);
+    testUshort3(stream);
+    return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,220 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/border_reader.h>
+#include <fused_kernel/algorithms/image_processing/box_filter_fast.h>
+#include <fused_kernel/algorithms/image_processing/neighborhood.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+// Every output is visited once, and tagged interior exactly when its window is inside the image
+static bool splitMatchesWindows(const int width, const int height, const int windowWidth,
+                                const int windowHeight, const int anchorX, const int anchorY) {
+    const auto interior = fk::NeighborhoodInterior::of(width, height, windowWidth, windowHeight, anchorX, anchorY);
+    std::vector<int> visits(static_cast<size_t>(width) * height, 0);
+    bool ok = true;
+    interior.forEach(width, height, [&](const int x, const int y, const auto inside) {
+        ++visits[static_cast<size_t>(y) * width + x];
+        const bool windowInside = x - anchorX >= 0 && y - anchorY >= 0 &&
+                                  x - anchorX + windowWidth <= width && y - anchorY + windowHeight <= height;
+        ok = ok && decltype(inside)::value == windowInside && interior.contains(x, y) == windowInside;
+    });
+    for (const int count : visits) {
+        ok = ok && count == 1;
+    }
+    return ok;
+}
+
+struct BoxCase {
+    int width;
+    int height;
+    int windowWidth;
+    int windowHeight;
+    int anchorX;
+    int anchorY;
+};
+
+static float sourceValue(const int x, const int y) {
+    return static_cast<float>((x * 13 + y * 7) % 19);
+}
+
+// How a coordinate outside the image is sampled: replicated, reflected without
+// repeating the edge, or a constant
+enum class OracleBorder { REPLICATE, REFLECT_101, CONSTANT };
+constexpr float CONSTANT_BORDER = 100.f;
+
+static int reflect101(int i, const int size) {
+    while (i < 0 || i >= size) {
+        i = size == 1 ? 0 : (i < 0 ? -i : 2 * size - 2 - i);
+    }
+    return i;
+}
+
+static float borderValue(const BoxCase& c, const OracleBorder border, const int x, const int y) {
+    switch (border) {
+    case OracleBorder::REFLECT_101:
+        return sourceValue(reflect101(x, c.width), reflect101(y, c.height));
+    case OracleBorder::CONSTANT:
+        return x < 0 || y < 0 || x >= c.width || y >= c.height ? CONSTANT_BORDER : sourceValue(x, y);
+    default:
+        return sourceValue(std::clamp(x, 0, c.width - 1), std::clamp(y, 0, c.height - 1));
+    }
+}
+
+// Box filter computed directly from the definition
+static std::vector<float> boxOracle(const BoxCase& c, const OracleBorder border = OracleBorder::REPLICATE) {
+    std::vector<float> values;
+    for (int y = 0; y < c.height; ++y) {
+        for (int x = 0; x < c.width; ++x) {
+            float sum = 0.f;
+            for (int ky = 0; ky < c.windowHeight; ++ky) {
+                for (int kx = 0; kx < c.windowWidth; ++kx) {
+                    sum += borderValue(c, border, x + kx - c.anchorX, y + ky - c.anchorY);
+                }
+            }
+            values.push_back(sum * (1.f / (c.windowWidth * c.windowHeight)));
+        }
+    }
+    return values;
+}
+
+// The output is allocated one row taller than the image, and the extra row must stay
+// untouched: the frame loops can not write outside of the image
+template <fk::ParArch PA, typename MakeInput>
+static std::vector<float> boxFilter(const BoxCase& c, const MakeInput& makeInput) {
+    constexpr bool GPU = PA == fk::ParArch::GPU_NVIDIA;
+    const fk::MemType memoryType = GPU ? fk::MemType::DeviceAndPinned : fk::MemType::Host;
+    constexpr float GUARD = -1.f;
+    fk::Ptr2D<float> source(c.width, c.height, 0, memoryType);
+    fk::Ptr2D<float> output(c.width, c.height + 1, 0, memoryType);
+    for (int y = 0; y <= c.height; ++y) {
+        for (int x = 0; x < c.width; ++x) {
+            if (y < c.height) {
+                source.at(fk::Point{ x, y, 0 }) = sourceValue(x, y);
+            }
+            output.at(fk::Point{ x, y, 0 }) = GUARD;
+        }
+    }
+    fk::Stream_<PA> stream;
+#if defined(__NVCC__)
+    if constexpr (GPU) {
+        source.upload(stream);
+        output.upload(stream);
+    }
+#endif
+    const fk::BoxFilterQuadDetails details{ c.width, c.height, c.windowWidth, c.windowHeight, c.anchorX, c.anchorY };
+    const auto compute = fk::make_tuple(fk::Add<float, float, float, fk::UnaryType>::build(),
+                                        fk::Sub<float, float, float, fk::UnaryType>::build(),
+                                        fk::Mul<float>::build(1.f / (c.windowWidth * c.windowHeight)));
+    const auto read = fk::PerThreadRead<fk::ND::_2D, float>::build(source);
+    // The image rows of the taller output buffer
+    fk::RawPtr<fk::ND::_2D, float> image = output.ptr();
+    image.dims.height = static_cast<uint>(c.height);
+    const auto write = fk::PerThreadWrite<fk::ND::_2D, float>::build(image);
+    using DPP = fk::BoxFilterQuadDPP<PA, float>;
+    fk::executeBoxFilterQuad<DPP>(stream, details, makeInput(read), compute, write);
+#if defined(__NVCC__)
+    if constexpr (GPU) output.download(stream);
+#endif
+    stream.sync();
+    std::vector<float> values;
+    for (int y = 0; y < c.height; ++y) {
+        for (int x = 0; x < c.width; ++x) {
+            values.push_back(output.at(fk::Point{ x, y, 0 }));
+        }
+    }
+    for (int x = 0; x < c.width; ++x) {
+        if (output.at(fk::Point{ x, c.height, 0 }) != GUARD) {
+            values.clear();
+        }
+    }
+    return values;
+}
+
+static bool sameValues(const std::vector<float>& a, const std::vector<float>& b) {
+    bool same = a.size() == b.size();
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = std::fabs(a[i] - b[i]) <= 1e-4f;
+    }
+    return same;
+}
+
+int launch() {
+    const auto interior = fk::NeighborhoodInterior::of(10, 8, 3, 3, 1, 1);
+    check("interior_bounds", interior.x0 == 1 && interior.y0 == 1 && interior.x1 == 9 && interior.y1 == 7);
+    check("interior_block", interior.contains(1, 1, 8, 6) && !interior.contains(1, 1, 9, 6));
+    check("split_centered", splitMatchesWindows(17, 11, 5, 3, 2, 1));
+    check("split_corner_anchor", splitMatchesWindows(13, 9, 4, 4, 0, 3));
+    check("split_window_larger_than_image", splitMatchesWindows(3, 2, 7, 5, 3, 2));
+    check("split_window_wider_than_image", splitMatchesWindows(2, 20, 7, 1, 3, 0));
+    check("split_window_taller_than_image", splitMatchesWindows(20, 2, 1, 7, 0, 3));
+
+    static_assert(fk::isCompleteBorderReader<decltype(fk::BorderReader<fk::BorderType::REFLECT_101>::build(
+        fk::PerThreadRead<fk::ND::_2D, float>::build(fk::RawPtr<fk::ND::_2D, float>{})))>);
+    static_assert(!fk::isCompleteBorderReader<fk::Read<fk::PerThreadRead<fk::ND::_2D, float>>>);
+
+    const auto plain = [](const auto& read) { return read; };
+    const auto replicate = [](const auto& read) { return fk::BorderReader<fk::BorderType::REPLICATE>::build(read); };
+    const auto reflect101 = [](const auto& read) { return fk::BorderReader<fk::BorderType::REFLECT_101>::build(read); };
+    const auto constant = [](const auto& read) {
+        return fk::BorderReader<fk::BorderType::CONSTANT>::build(read, CONSTANT_BORDER);
+    };
+
+    const BoxCase cases[] = { { 23, 5, 3, 3, 1, 1 }, { 23, 5, 7, 7, 3, 3 },
+                              { 2, 20, 7, 1, 3, 0 }, { 20, 2, 1, 7, 0, 3 } };
+    bool same = true;
+    bool matchesOracle = true;
+    bool reflect101Frame = true;
+    bool constantFrame = true;
+    for (const BoxCase& c : cases) {
+        const auto bypassed = boxFilter<fk::ParArch::CPU>(c, replicate);
+        same = same && bypassed == boxFilter<fk::ParArch::CPU>(c, plain);
+        matchesOracle = matchesOracle && sameValues(bypassed, boxOracle(c));
+        // The frame reads go through the BorderReader, so its BorderType applies there
+        const auto reflected = boxFilter<fk::ParArch::CPU>(c, reflect101);
+        const auto constantBorder = boxFilter<fk::ParArch::CPU>(c, constant);
+        reflect101Frame = reflect101Frame && sameValues(reflected, boxOracle(c, OracleBorder::REFLECT_101));
+        constantFrame = constantFrame && sameValues(constantBorder, boxOracle(c, OracleBorder::CONSTANT));
+#if defined(__NVCC__)
+        matchesOracle = matchesOracle && sameValues(boxFilter<fk::ParArch::GPU_NVIDIA>(c, replicate), bypassed) &&
+                        sameValues(boxFilter<fk::ParArch::GPU_NVIDIA>(c, plain), bypassed);
+        reflect101Frame = reflect101Frame && sameValues(boxFilter<fk::ParArch::GPU_NVIDIA>(c, reflect101), reflected);
+        constantFrame = constantFrame && sameValues(boxFilter<fk::ParArch::GPU_NVIDIA>(c, constant), constantBorder);
+#endif
+    }
+    check("border_reader_interior_bypass", same);
+    check("box_filter_window_larger_than_image_axis", matchesOracle);
+    check("border_reader_frame_reflect_101", reflect101Frame);
+    check("border_reader_frame_constant", constantFrame);
+    return failures == 0 ? 0 : -1;
+}
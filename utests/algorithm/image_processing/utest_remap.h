@@ -0,0 +1,137 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/algorithms/image_processing/remap.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cmath>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+static fk::Ptr2D<uchar3> makeSource(const uint width, const uint height, const uint seed = 0) {
+    fk::Ptr2D<uchar3> source(width, height, 0, fk::MemType::Host);
+    for (uint y = 0; y < height; ++y) {
+        for (uint x = 0; x < width; ++x) {
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), source.ptr()) =
+                fk::make_<uchar3>(static_cast<uchar>(x * 2 + y + seed), static_cast<uchar>(y * 3 + seed * 7),
+                                  static_cast<uchar>(x + 100 + seed * x));
+        }
+    }
+    return source;
+}
+
+// Largest per channel difference between two images
+static float maxDifference(const fk::Ptr2D<float3>& a, const fk::Ptr2D<float3>& b) {
+    float diff = 0.f;
+    for (uint y = 0; y < a.dims().height; ++y) {
+        for (uint x = 0; x < a.dims().width; ++x) {
+            const float3 va = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), a.ptr());
+            const float3 vb = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), b.ptr());
+            diff = std::fmax(diff, std::fabs(va.x - vb.x));
+            diff = std::fmax(diff, std::fabs(va.y - vb.y));
+            diff = std::fmax(diff, std::fabs(va.z - vb.z));
+        }
+    }
+    return diff;
+}
+
+static void testWarping(CpuStream& stream) {
+    const fk::Ptr2D<uchar3> source = makeSource(64, 48);
+    fk::WarpingParameters<fk::WarpType::Perspective> params{};
+    const float matrix[3][3]{ { 0.9f, 0.1f, -3.f }, { -0.05f, 1.1f, 2.f }, { 0.0004f, 0.0003f, 1.f } };
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            params.transformMatrix.data[i][j] = matrix[i][j];
+        }
+    }
+    params.dstSize = fk::Size(70, 50);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    const auto warp = read.then(fk::Warping<fk::WarpType::Perspective>::build(params));
+
+    fk::Ptr2D<float3> direct(70, 50, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, warp, fk::PerThreadWrite<fk::ND::_2D, float3>::build(direct));
+
+    fk::Ptr2D<float2> floatMap;
+    const auto floatRemap = fk::RemapTable::bake(warp, floatMap, stream);
+    fk::Ptr2D<float3> remapped(70, 50, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, read, floatRemap, fk::PerThreadWrite<fk::ND::_2D, float3>::build(remapped));
+    check("float2 map reproduces the perspective Warping", maxDifference(direct, remapped) == 0.f);
+
+    fk::Ptr2D<short2> fixedMap;
+    const auto fixedRemap = fk::RemapTable::bake(warp, fixedMap, stream);
+    fk::Ptr2D<float3> fixed(70, 50, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, read, fixedRemap, fk::PerThreadWrite<fk::ND::_2D, float3>::build(fixed));
+    // 64 pixels wide: 9 fractional bits, the largest gradient is 3 per pixel
+    check("short2 map uses the most fractional bits", fixedRemap.params.mapScale == 1.f / 512.f);
+    check("short2 map stays within its quantization of the Warping", maxDifference(direct, fixed) < 0.01f);
+}
+
+static void testResize(CpuStream& stream) {
+    const fk::Ptr2D<uchar3> source = makeSource(40, 30);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(source);
+    const fk::Size dstSize(64, 64);
+    const float3 background = fk::make_<float3>(1.f, 2.f, 3.f);
+    const auto resize = fk::Resize<fk::InterpolationType::INTER_LINEAR, fk::AspectRatio::PRESERVE_AR>::build(
+        read, dstSize, background);
+
+    fk::Ptr2D<float3> direct(64, 64, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, resize, fk::PerThreadWrite<fk::ND::_2D, float3>::build(direct));
+
+    fk::Ptr2D<float2> map;
+    const auto remap = fk::RemapTable::bake(resize, map, stream);
+    check("maps default to host memory for CPU streams", map.getMemType() == fk::MemType::Host);
+    fk::Ptr2D<float3> remapped(64, 64, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, read, remap, fk::PerThreadWrite<fk::ND::_2D, float3>::build(remapped));
+    check("float2 map reproduces Resize with the background value", maxDifference(direct, remapped) == 0.f);
+    fk::Ptr2D<float3> first(64, 64, 0, fk::MemType::Host);
+    fk::executeOperations<CpuDPP>(stream, read, remap, fk::PerThreadWrite<fk::ND::_2D, float3>::build(first));
+
+    // The geometry is reused for other frames of the same size
+    const fk::Ptr2D<uchar3> other = makeSource(40, 30, 13);
+    const auto otherRead = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(other);
+    fk::executeOperations<CpuDPP>(stream,
+        fk::Resize<fk::InterpolationType::INTER_LINEAR, fk::AspectRatio::PRESERVE_AR>::build(otherRead, dstSize, background),
+        fk::PerThreadWrite<fk::ND::_2D, float3>::build(direct));
+    fk::executeOperations<CpuDPP>(stream, otherRead, remap, fk::PerThreadWrite<fk::ND::_2D, float3>::build(remapped));
+    check("a baked map is reused with a new frame",
+          maxDifference(direct, remapped) == 0.f && maxDifference(direct, first) > 0.f);
+}
+
+int launch() {
+    CpuStream stream;
+    testWarping(stream);
+    testResize(stream);
+    check("fractional bits follow the source size",
+          fk::RemapTable::fractionalBits(fk::Size(1920, 1080)) == 4 &&
+          fk::RemapTable::fractionalBits(fk::Size(32768, 10)) == 0);
+    return failures == 0 ? 0 : -1;
+}
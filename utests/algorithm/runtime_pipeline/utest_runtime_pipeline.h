@@ -0,0 +1,200 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/runtime_pipeline/runtime_pipeline.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cstring>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr uint WIDTH = 37;
+constexpr uint HEIGHT = 11;
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+template <typename T>
+static fk::Ptr2D<T> makeImage() {
+    fk::Ptr2D<T> image(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    T* const data = image.ptr().data;
+    uchar* const bytes = reinterpret_cast<uchar*>(data);
+    for (uint y = 0; y < HEIGHT; ++y) {
+        for (uint x = 0; x < WIDTH * sizeof(T) / sizeof(fk::VBase<T>); ++x) {
+            const float value = static_cast<float>((x * 7 + y * 13) % 251) + 1.f;
+            fk::VBase<T>* const row = reinterpret_cast<fk::VBase<T>*>(bytes + static_cast<size_t>(y) * image.dims().pitch);
+            row[x] = static_cast<fk::VBase<T>>(value);
+        }
+    }
+    return image;
+}
+
+template <typename T>
+static bool equalImages(const fk::Ptr2D<T>& a, const fk::Ptr2D<T>& b) {
+    for (uint y = 0; y < HEIGHT; ++y) {
+        for (uint x = 0; x < WIDTH; ++x) {
+            const T va = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), a.ptr());
+            const T vb = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), b.ptr());
+            if (std::memcmp(&va, &vb, sizeof(T)) != 0) return false;
+        }
+    }
+    return true;
+}
+
+static void testFullSuperKernel(CpuStream& stream) {
+    const auto input = makeImage<uchar3>();
+    fk::Ptr2D<float3> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<float3> expected(WIDTH, HEIGHT, 0, fk::MemType::Host);
+
+    fk::RuntimePipeline pipeline(fk::RtFormatOf<uchar3>::value, fk::RtFormatOf<float3>::value);
+    pipeline.add(fk::RtOp::SWAP_RB)
+            .add(fk::RtOp::MUL, 1.f / 255.f)
+            .add(fk::RtOp::SUB, { 0.485f, 0.456f, 0.406f })
+            .add(fk::RtOp::DIV, { 0.229f, 0.224f, 0.225f });
+    const fk::RtPlan plan = pipeline.compile();
+    pipeline.execute(input, output);
+
+    fk::executeOperations<CpuDPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar3>::build(input),
+        fk::Cast<uchar3, float3>::build(),
+        fk::ColorConversion<fk::ColorConversionCodes::COLOR_BGR2RGB, float3, float3>::build(),
+        fk::Mul<float3>::build(fk::make_set<float3>(1.f / 255.f)),
+        fk::Sub<float3>::build(fk::make_<float3>(0.485f, 0.456f, 0.406f)),
+        fk::Div<float3>::build(fk::make_<float3>(0.229f, 0.224f, 0.225f)),
+        fk::PerThreadWrite<fk::ND::_2D, float3>::build(expected));
+
+    check("whole graph lowered to one super-kernel",
+          plan.direct && plan.interpretedNodes == 0 && plan.kernel.name == "u8c3_swap_mul_sub_div");
+    check("super-kernel matches the compile-time pipeline", equalImages(output, expected));
+}
+
+static void testPrefixAndTail(CpuStream& stream) {
+    const auto input = makeImage<uchar3>();
+    fk::Ptr2D<float3> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<float3> expected(WIDTH, HEIGHT, 0, fk::MemType::Host);
+
+    fk::RuntimePipeline pipeline(fk::RtFormatOf<uchar3>::value, fk::RtFormatOf<float3>::value);
+    pipeline.add(fk::RtOp::MUL, 0.5f).add(fk::RtOp::SUB, 0.25f).add(fk::RtOp::LN).add(fk::RtOp::MAX, 0.f);
+    const fk::RtPlan plan = pipeline.compile();
+    pipeline.execute(input, output);
+
+    fk::executeOperations<CpuDPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar3>::build(input),
+        fk::Cast<uchar3, float3>::build(), fk::Mul<float3>::build(fk::make_set<float3>(0.5f)),
+        fk::Sub<float3>::build(fk::make_set<float3>(0.25f)), fk::Ln<float3>::build(),
+        fk::Max<float3>::build(fk::make_set<float3>(0.f)),
+        fk::PerThreadWrite<fk::ND::_2D, float3>::build(expected));
+
+    check("longest prefix is precompiled, tail interpreted",
+          plan.kernel.name == "u8c3_mul_sub" && plan.interpretedNodes == 2 && !plan.direct);
+    check("prefix + interpreter match the compile-time pipeline", equalImages(output, expected));
+}
+
+static void testInterpreterOnly(CpuStream& stream) {
+    const auto input = makeImage<float4>();
+    fk::Ptr2D<uchar> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<uchar> expected(WIDTH, HEIGHT, 0, fk::MemType::Host);
+
+    fk::RuntimePipeline pipeline(fk::RtFormatOf<float4>::value, fk::RtFormatOf<uchar>::value);
+    pipeline.add(fk::RtOp::SWAP_RB).add(fk::RtOp::RGB2GRAY).add(fk::RtOp::MUL, 1.5f);
+    const fk::RtPlan plan = pipeline.compile();
+    pipeline.execute(input, output);
+
+    fk::executeOperations<CpuDPP>(stream, fk::PerThreadRead<fk::ND::_2D, float4>::build(input),
+        fk::ColorConversion<fk::ColorConversionCodes::COLOR_BGRA2RGBA, float4, float4>::build(),
+        fk::RGB2Gray<float4, float>::build(), fk::Mul<float>::build(1.5f),
+        fk::SaturateCast<float, uchar>::build(), fk::PerThreadWrite<fk::ND::_2D, uchar>::build(expected));
+
+    check("unmatched graph falls back to load + interpreter",
+          plan.kernel.ops.empty() && plan.interpretedNodes == 3);
+    check("channel reduction and saturating store", equalImages(output, expected));
+}
+
+static void testParse() {
+    const std::string config =
+        "# ops team preprocessing\n"
+        "input  u8c3\n"
+        "swap_rb\n"
+        "mul    0.0039215686   # to [0, 1]\n"
+        "sub    0.485 0.456 0.406\n"
+        "div    0.229 0.224 0.225\n"
+        "output f32c3\n";
+    fk::RuntimePipeline pipeline = fk::RuntimePipeline::parse(config);
+    check("parsed graph", pipeline.nodes().size() == 4 && pipeline.nodes()[2].params[1] == 0.456f &&
+                          pipeline.nodes()[1].params[2] == 0.0039215686f);
+    check("parsed graph lowered", pipeline.describe() == "super-kernel u8c3_swap_mul_sub_div (4 ops)");
+
+    const auto throws = [](const std::string& text) {
+        try {
+            fk::RuntimePipeline::parse(text);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    check("unknown operation rejected", throws("input u8c3\nblur 3\noutput f32c3\n"));
+    check("missing parameter rejected", throws("input u8c3\nmul\noutput f32c3\n"));
+    check("partial per-channel values rejected", throws("input u8c3\nsub 0.5 0.5\noutput f32c3\n"));
+    check("extra per-channel values rejected", throws("input u8c3\nsub 1 2 3 4\noutput f32c3\n"));
+    check("values follow the channels of the op input",
+          !throws("input u8c4\nrgb2gray\nsub 0.5\noutput f32c1\n") &&
+          throws("input u8c4\nrgb2gray\nsub 1 2 3 4\noutput f32c1\n") &&
+          !throws("input u8c4\nsub 1 2 3 4\noutput f32c4\n"));
+    check("parameters of a parameterless op rejected", throws("input u8c3\nswap_rb 1\noutput f32c3\n"));
+    check("channel mismatch rejected", throws("input u8c3\nrgb2gray\noutput f32c3\n"));
+    check("gray of one channel rejected", throws("input u8c1\nrgb2gray\noutput f32c1\n"));
+}
+
+static void testUserKernel() {
+    fk::RuntimePipeline pipeline(fk::RtFormatOf<uchar4>::value, fk::RtFormatOf<uchar4>::value);
+    pipeline.add(fk::RtOp::MUL, 2.f).add(fk::RtOp::SQRT);
+    check("no direct kernel before registration", !pipeline.compile().direct);
+
+    fk::RtKernelRegistry::instance().add<uchar4, uchar4, fk::RtOp::MUL, fk::RtOp::SQRT>("user_u8c4_mul_sqrt");
+    const fk::RtPlan plan = pipeline.compile();
+    check("user super-kernel selected", plan.direct && plan.kernel.name == "user_u8c4_mul_sqrt");
+
+    const auto input = makeImage<uchar4>();
+    fk::Ptr2D<uchar4> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<uchar4> interpreted(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    pipeline.execute(input, output);
+    // Same graph with an extra no-op node is not covered by the user kernel
+    fk::RuntimePipeline tail(fk::RtFormatOf<uchar4>::value, fk::RtFormatOf<uchar4>::value);
+    tail.add(fk::RtOp::MUL, 2.f).add(fk::RtOp::SQRT).add(fk::RtOp::ADD, 0.f);
+    tail.execute(input, interpreted);
+    check("user super-kernel matches the interpreter", !tail.compile().direct && equalImages(output, interpreted));
+}
+
+int launch() {
+    CpuStream stream;
+    testFullSuperKernel(stream);
+    testPrefixAndTail(stream);
+    testInterpreterOnly(stream);
+    testParse();
+    testUserKernel();
+    return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,127 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <benchmarks/fkBenchmarkHarness.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+static bool near(const double a, const double b) { return std::abs(a - b) <= 1e-9 * (1. + std::abs(b)); }
+
+static void testStats() {
+    // 1..100 ms: closed-form percentiles with linear interpolation
+    std::vector<double> t;
+    for (int i = 100; i >= 1; --i) t.push_back(i);
+    BenchmarkTraffic traffic;
+    traffic.bytes = 1e6;
+    traffic.pixels = 2.5e5;
+    const BenchmarkStats s = computeBenchmarkStats(t, traffic);
+    check("stats samples/min/max", s.samples == 100 && s.minMs == 1. && s.maxMs == 100.);
+    check("stats mean/stddev", near(s.meanMs, 50.5) && near(s.stddevMs, std::sqrt(841.6666666666666)));
+    check("stats p50/p90/p99", near(s.p50Ms, 50.5) && near(s.p90Ms, 90.1) && near(s.p99Ms, 99.01));
+    check("stats throughput over median", near(s.bytesPerSecond, 1e6 / 0.0505) &&
+                                          near(s.pixelsPerSecond, 2.5e5 / 0.0505));
+}
+
+static void testTrafficFromPtr() {
+    fk::Ptr2D<uchar3> in(64, 32, 0, fk::MemType::Host);
+    fk::Ptr2D<float3> out(64, 32, 0, fk::MemType::Host);
+    BenchmarkTraffic traffic;
+    traffic.read(in).write(out);
+    check("traffic bytes/pixels from Ptr sizes",
+          traffic.bytes == 64. * 32. * (3 + 12) && traffic.pixels == 64. * 32.);
+}
+
+static void testRunUntilStable() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    int calls = 0;
+    volatile double sink = 0.;
+    const auto body = [&] {
+        ++calls;
+        for (int i = 0; i < 2000; ++i) sink = sink + std::sqrt(static_cast<double>(i));
+    };
+    BenchmarkConfig config;
+    config.warmup = 3;
+    config.minIters = 5;
+    config.maxIters = 50;
+    config.targetRelStdErr = 1e9;      // anything is stable: stop at minIters
+    const BenchmarkStats quick = runBenchmark(config, stream, BenchmarkTraffic{}, body);
+    check("run-until-stable stops at minIters", quick.samples == 5 && quick.stable && calls == 8);
+
+    calls = 0;
+    config.targetRelStdErr = 0.;       // adaptive stop disabled: run to maxIters
+    const BenchmarkStats full = runBenchmark(config, stream, BenchmarkTraffic{}, body);
+    check("fixed count runs maxIters", full.samples == 50 && !full.stable && calls == 53);
+    check("percentiles are ordered", full.minMs <= full.p50Ms && full.p50Ms <= full.p90Ms &&
+                                     full.p90Ms <= full.p99Ms && full.p99Ms <= full.maxMs);
+}
+
+static void testReport() {
+    BenchmarkStats s;
+    s.samples = 7;
+    s.p50Ms = 1.5;
+    BenchmarkReport report;
+    report.add("resize", { { "w", "1920" }, { "type", "uchar3" } }, s);
+    report.add("resize", { { "w", "3840" }, { "type", "uchar3" } }, s);
+    s.samples = 9;
+    report.add("resize", { { "w", "1920" }, { "type", "uchar3" } }, s);   // replaces
+    check("report keyed by benchmark + params",
+          report.entries().size() == 2 && report.entries()[0].stats.samples == 9);
+    const std::string json = report.toJSON();
+    check("report JSON", json.find("{\"benchmark\": \"resize\", \"params\": {\"w\": \"1920\", "
+                                   "\"type\": \"uchar3\"}, \"samples\": 9") != std::string::npos);
+    const std::string csv = report.toCSV();
+    check("report CSV", csv.rfind("benchmark,params,samples", 0) == 0 &&
+                        csv.find("\nresize,w=3840;type=uchar3,7,") != std::string::npos);
+
+    BenchmarkReport special;
+    BenchmarkStats nonFinite;
+    nonFinite.meanMs = std::numeric_limits<double>::quiet_NaN();
+    nonFinite.bytesPerSecond = std::numeric_limits<double>::infinity();
+    special.add("tab\tname\n\"q\"", { { "path", "a\\b\x01" } }, nonFinite,
+                { { "speedup", -std::numeric_limits<double>::infinity() } });
+    const std::string specialJson = special.toJSON();
+    check("report JSON escapes control characters",
+          specialJson.find("\"tab\\u0009name\\u000a\\\"q\\\"\"") != std::string::npos &&
+          specialJson.find("\"a\\\\b\\u0001\"") != std::string::npos);
+    check("report JSON writes non-finite numbers as null",
+          specialJson.find("\"mean_ms\": null") != std::string::npos &&
+          specialJson.find("\"bytes_per_s\": null") != std::string::npos &&
+          specialJson.find("\"speedup\": null") != std::string::npos &&
+          specialJson.find("nan") == std::string::npos && specialJson.find("inf") == std::string::npos);
+}
+
+int launch() {
+    testStats();
+    testTrafficFromPtr();
+    testRunUntilStable();
+    testReport();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " benchmark harness test(s) FAILED" << std::endl;
+    return -1;
+}
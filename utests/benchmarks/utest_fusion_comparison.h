@@ -0,0 +1,124 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/fkFusionComparison.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr int WIDTH = 37;
+constexpr int HEIGHT = 11;
+
+// uchar -> float -> *2 -> +1 -> int, with uchar/float/float/int between ops
+static void testSplits() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    fk::Ptr2D<uchar> input(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<int> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            input.at(fk::Point{ x, y, 0 }) = static_cast<uchar>(x * 3 + y);
+        }
+    }
+    FusionChain<fk::ParArch::CPU, fk::Read<fk::PerThreadRead<fk::ND::_2D, uchar>>, fk::Unary<fk::Cast<uchar, float>>,
+                fk::Binary<fk::Mul<float>>, fk::Binary<fk::Add<float>>, fk::Unary<fk::Cast<float, int>>,
+                fk::Write<fk::PerThreadWrite<fk::ND::_2D, int>>>
+        chain(stream, fk::PerThreadRead<fk::ND::_2D, uchar>::build(input), fk::Cast<uchar, float>::build(),
+              fk::Mul<float>::build(2.f), fk::Add<float>::build(1.f), fk::Cast<float, int>::build(),
+              fk::PerThreadWrite<fk::ND::_2D, int>::build(output));
+
+    check("chain shape", chain.NUM_OPS == 4 && chain.NUM_GAPS == 3 && chain.unfusedMask() == 7u);
+    check("mask enumeration per mode", chain.masks(FusionSplits::Ends) == std::vector<unsigned int>{ 0u, 7u } &&
+                                       chain.masks(FusionSplits::Single) == std::vector<unsigned int>{ 0u, 1u, 2u, 4u, 7u } &&
+                                       chain.masks(FusionSplits::All).size() == 8);
+    check("labels and launches", chain.label(0u) == "fused" && chain.label(7u) == "unfused" &&
+                                 chain.label(5u) == "split@1,3" && chain.launches(0u) == 1 &&
+                                 chain.launches(5u) == 3 && chain.launches(7u) == 4);
+    const double e = WIDTH * HEIGHT;
+    // ends: uchar in, int out; gap 0 is float (after Cast), gap 2 is float (after Add)
+    check("bytes per split", chain.bytes(0u) == e * 5. && chain.bytes(1u) == e * 13. &&
+                             chain.bytes(7u) == e * (5. + 3. * 8.));
+
+    bool same = true;
+    for (const unsigned int mask : chain.masks(FusionSplits::All)) {
+        fk::setTo(-1, output, stream);
+        chain.run(mask);
+        stream.sync();
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                same &= output.at(fk::Point{ x, y, 0 }) == (x * 3 + y) * 2 + 1;
+            }
+        }
+    }
+    check("every split produces the fused result", same);
+
+    bool threw = false;
+    try {
+        chain.run(8u);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check("out of range mask throws", threw);
+}
+
+static void testCompare() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    fk::Ptr2D<float> input(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<float> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::setTo(1.f, input, stream);
+    BenchmarkConfig config;
+    config.warmup = 1;
+    config.minIters = 2;
+    config.maxIters = 2;
+    const FusionComparison comparison = compareFusion(config, stream, FusionSplits::Single,
+        fk::PerThreadRead<fk::ND::_2D, float>::build(input), fk::Mul<float>::build(2.f),
+        fk::Add<float>::build(1.f), fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+    const auto& r = comparison.results;
+    check("compare runs fused and unfused", r.size() == 2 && r[0].label == "fused" && r[1].label == "unfused" &&
+                                           r[0].stats.samples == 2 && r[1].stats.samples == 2);
+    check("fused is the baseline", r[0].speedup == 1. && r[0].bytesSaved == 0.);
+    check("bytes saved by fusing", r[1].bytesSaved == 2. * sizeof(float) * WIDTH * HEIGHT && r[1].launches == 2);
+
+    BenchmarkReport report;
+    comparison.addTo(report, "mul_add", { { "w", std::to_string(WIDTH) } });
+    check("report carries split metrics", report.entries().size() == 2 &&
+                                          report.entries()[1].params.back().second == "unfused" &&
+                                          report.toJSON().find("\"metrics\": {\"launches\": 2, \"bytes\": ") !=
+                                              std::string::npos &&
+                                          report.toCSV().find(",launches=2;bytes=") != std::string::npos);
+}
+
+int launch() {
+    testSplits();
+    testCompare();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " fusion comparison test(s) FAILED" << std::endl;
+    return -1;
+}
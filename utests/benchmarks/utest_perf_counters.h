@@ -0,0 +1,148 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/fkBenchmarkHarness.h>
+#include <benchmarks/fkBenchmarksCommon.h>
+
+#include <cstdlib>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+static volatile double sink = 0.;
+
+static void work() {
+    double acc = 0.;
+    for (int i = 0; i < 200000; ++i) acc += static_cast<double>(i % 7) * 0.5;
+    sink = acc;
+}
+
+// Whatever the machine exposes, counters either work or say why they do not
+static void testCounters() {
+    PerfCounters counters;
+    counters.start();
+    work();
+    const PerfSample sample = counters.stop();
+    if (counters.available()) {
+        std::cout << "perf counters available, IPC " << sample.ipc() << std::endl;
+        check("available counters produce samples", sample.validMask != 0 && counters.unavailableReason().empty());
+        check("instructions counted", !sample.has(PerfCounter::Instructions) || sample[PerfCounter::Instructions] > 0.);
+    } else {
+        std::cout << "perf counters unavailable: " << counters.unavailableReason() << std::endl;
+        check("unavailable counters give empty samples", sample.validMask == 0 && sample.ipc() == 0. &&
+                                                         !counters.unavailableReason().empty());
+    }
+    check("stop without start is empty", counters.stop().validMask == 0);
+}
+
+static void testDisabledByEnvironment() {
+    setenv("FK_PERF_COUNTERS", "0", 1);
+    PerfCounters counters;
+    unsetenv("FK_PERF_COUNTERS");
+    counters.start();
+    check("FK_PERF_COUNTERS=0 disables counters", !counters.available() && counters.stop().validMask == 0 &&
+                                                  counters.unavailableReason() == "disabled by FK_PERF_COUNTERS=0");
+}
+
+static void testSampleMath() {
+    PerfSample a, b;
+    a.values = { 100., 250., 4., 2., 1. };
+    a.validMask = 0x1f;
+    b.values = { 300., 350., 6., 0., 3. };
+    b.validMask = 0x1b;     // no L1D misses
+    PerfSample sum;
+    sum.accumulate(a, true).accumulate(b, false);
+    const PerfSample mean = sum.scaled(0.5);
+    check("mean keeps only counters valid in every sample",
+          mean.ipc() == 1.5 && mean.has(PerfCounter::LLCMisses) && !mean.has(PerfCounter::L1DMisses) &&
+          mean[PerfCounter::BranchMisses] == 2.);
+
+    std::array<PerfSample, ITERS> samples;
+    samples.fill(a);
+    check("marker CSV columns", meanPerfSample(samples).ipc() == 2.5 &&
+                                perfCsvValues(meanPerfSample(samples)).rfind(", 2.5, 100, 250, 4, 2, 1", 0) == 0 &&
+                                perfCsvValues(PerfSample{}) == ", NA, NA, NA, NA, NA, NA" &&
+                                perfCsvHeader("fused ").rfind(", fused IPC, fused Mean cycles", 0) == 0);
+    const std::array<PerfSample, ITERS>* noSamples = nullptr;
+    check("markers without counters fill the columns with NA",
+          perfCsvValues(&samples) == perfCsvValues(meanPerfSample(samples)) &&
+          perfCsvValues(noSamples) == ", NA, NA, NA, NA, NA, NA");
+
+    BenchmarkStats stats;
+    stats.counters = a;
+    BenchmarkTraffic traffic;
+    traffic.pixels = 50.;
+    const auto metrics = perfCounterMetrics(stats, traffic);
+    check("harness metrics per pixel", metrics.size() == 6 && metrics[0].first == "ipc" && metrics[0].second == 2.5 &&
+                                       metrics[1].first == "cycles_per_pixel" && metrics[1].second == 2. &&
+                                       perfCounterMetrics(BenchmarkStats{}, traffic).empty());
+}
+
+static void testMarkers() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    TimeMarkerOne<fk::ParArch::CPU> one(stream);
+    BenchmarkResultsNumbersOne resF;
+    one.start();
+    work();
+    one.stop(resF, 0);
+    const bool oneOk = one.counters().available() ? one.getCounterSamples()[0].validMask != 0 &&
+                                                        counterSamplesOf(one) == &one.getCounterSamples()
+                                                  : one.getCounterSamples()[0].validMask == 0 &&
+                                                        counterSamplesOf(one) == nullptr;
+    check("TimeMarkerOne collects counters when available", oneOk && one.getElapsedTime()[0] >= 0.f);
+
+    TimeMarkerTwo<fk::ParArch::CPU> two(stream);
+    BenchmarkResultsNumbersTwo resT;
+    two.startFirst();
+    work();
+    two.stopFirstStartSecond(resT, 0);
+    work();
+    two.stopSecond(resT, 0);
+    const auto samples = counterSamplesOfTwo(two);
+    const bool twoOk = two.counters().available()
+        ? two.getFirstCounterSamples()[0].validMask != 0 && two.getSecondCounterSamples()[0].validMask != 0 &&
+          samples.first == &two.getFirstCounterSamples()
+        : samples.first == nullptr && samples.second == nullptr;
+    check("TimeMarkerTwo collects counters per execution", twoOk);
+
+    BenchmarkConfig config;
+    config.warmup = 0;
+    config.minIters = 2;
+    config.maxIters = 2;
+    const BenchmarkStats stats = runBenchmark(config, stream, BenchmarkTraffic{}, work);
+    check("runBenchmark averages counters", stats.counters.validMask == 0 ||
+                                            stats.counters[PerfCounter::Instructions] > 0.);
+}
+
+int launch() {
+    testCounters();
+    testDisabledByEnvironment();
+    testSampleMath();
+    testMarkers();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " perf counter test(s) FAILED" << std::endl;
+    return -1;
+}
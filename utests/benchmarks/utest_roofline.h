@@ -0,0 +1,145 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+#include <tests/main.h>
+
+#include <benchmarks/fkRoofline.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/image_processing/saturate.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+
+#include <cmath>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+using ReadU8 = fk::Read<fk::PerThreadRead<fk::ND::_2D, uchar>>;
+using ReadU8C3 = fk::Read<fk::PerThreadRead<fk::ND::_2D, uchar3>>;
+using WriteF = fk::Write<fk::PerThreadWrite<fk::ND::_2D, float>>;
+using WriteU8 = fk::Write<fk::PerThreadWrite<fk::ND::_2D, uchar>>;
+
+// uchar in, float out; Cast is free and Mul is one op
+using CastMul = RooflineModel<ReadU8, fk::Unary<fk::Cast<uchar, float>>, fk::Binary<fk::Mul<float>>, WriteF>;
+static_assert(CastMul::BYTES_READ_PER_ELEMENT == 1. && CastMul::BYTES_WRITTEN_PER_ELEMENT == 4.);
+static_assert(CastMul::OPS_PER_ELEMENT == 1. && CastMul::ARITHMETIC_INTENSITY == 0.2);
+
+// uchar3 in, uchar out; float3 Mul and Sub are 3 ops each, gray is 5, SaturateCast 1
+using Preprocess = RooflineModel<ReadU8C3, fk::Unary<fk::SaturateCast<uchar3, float3>>,
+                                 fk::Binary<fk::Mul<float3>>, fk::Binary<fk::Sub<float3>>,
+                                 fk::Unary<fk::RGB2Gray<float3, float>>, fk::Unary<fk::SaturateCast<float, uchar>>,
+                                 WriteU8>;
+static_assert(Preprocess::BYTES_PER_ELEMENT == 4. && Preprocess::OPS_PER_ELEMENT == 3. + 3. + 3. + 5. + 1.);
+
+static void testFusedModel() {
+    fk::Ptr2D<uchar> input(8, 8, 0, fk::MemType::Host);
+    fk::Ptr2D<float> output(8, 8, 0, fk::MemType::Host);
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(input).then(fk::Cast<uchar, float>::build());
+    const auto write = fk::Mul<float>::build(2.f).then(fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+    using Fused = RooflineModel<decltype(read), decltype(write)>;
+    check("fused IOps count like the unfused chain",
+          Fused::BYTES_PER_ELEMENT == CastMul::BYTES_PER_ELEMENT && Fused::OPS_PER_ELEMENT == CastMul::OPS_PER_ELEMENT);
+}
+
+static void testMachinePeak() {
+    const MachinePeak peak = measureCpuMachinePeak(size_t{ 1 } << 16, size_t{ 1 } << 12, 2);
+    check("probe measures bandwidth and ops", peak.bandwidthGBps > 0. && peak.gops > 0.);
+    const MachinePeak fixed{ 10., 40. };
+    check("ridge point and roof", fixed.ridgePoint() == 4. && fixed.attainableGops(1.) == 10. &&
+                                  fixed.attainableGops(8.) == 40.);
+    bool threw = false;
+    try {
+        measureCpuMachinePeak(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check("empty probe throws", threw);
+}
+
+static void testAnalyze() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    fk::Ptr2D<uchar> input(64, 32, 0, fk::MemType::Host);
+    fk::Ptr2D<float> output(64, 32, 0, fk::MemType::Host);
+    fk::setTo(uchar(3), input, stream);
+    BenchmarkConfig config;
+    config.warmup = 1;
+    config.minIters = 2;
+    config.maxIters = 2;
+    // AI 0.2 against a ridge of 4 ops/byte: memory bound
+    const RooflineResult r = analyzeRoofline(config, stream, MachinePeak{ 10., 40. },
+        fk::PerThreadRead<fk::ND::_2D, uchar>::build(input), fk::Cast<uchar, float>::build(),
+        fk::Mul<float>::build(2.f), fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+    stream.sync();
+    check("pipeline ran", output.at(fk::Point{ 5, 5, 0 }) == 6.f);
+    check("model numbers", r.elements == 64. * 32. && r.bytesPerElement == 5. && r.opsPerElement == 1. &&
+                           r.stats.samples == 2 && r.attainableGops == 2.);
+    check("memory bound classification", r.bound == RooflineBound::Memory &&
+                                         r.achievedGBps > 0. && std::abs(r.achievedGops * 5. - r.achievedGBps) <= 1e-9 * r.achievedGBps &&
+                                         r.efficiency == r.achievedGBps / 10.);
+
+    check("unknown cache size flags nothing", !r.cacheResident && r.roofGBps == 10. &&
+                                              r.workingSetBytes == 64. * 32. * 5.);
+
+    BenchmarkReport report;
+    r.addTo(report, "cast_mul");
+    check("report carries roofline metrics",
+          report.entries().size() == 1 && report.entries()[0].params.back().second == "memory" &&
+          report.toJSON().find("\"intensity\": 0.2") != std::string::npos);
+}
+
+static void testCacheResident() {
+    fk::Stream_<fk::ParArch::CPU> stream;
+    fk::Ptr2D<uchar> input(64, 32, 0, fk::MemType::Host);
+    fk::Ptr2D<float> output(64, 32, 0, fk::MemType::Host);
+    fk::setTo(uchar(3), input, stream);
+    BenchmarkConfig config;
+    config.warmup = 1;
+    config.minIters = 2;
+    config.maxIters = 2;
+    // A 10 KiB working set against a 1 MiB cache and a DRAM peak no
+    // in-cache run could stay under: the roof is probed in cache instead
+    MachinePeak peak{ 1e-6, 40. };
+    peak.lastLevelCacheBytes = size_t{ 1 } << 20;
+    const RooflineResult r = analyzeRoofline(config, stream, peak,
+        fk::PerThreadRead<fk::ND::_2D, uchar>::build(input), fk::Cast<uchar, float>::build(),
+        fk::Mul<float>::build(2.f), fk::PerThreadWrite<fk::ND::_2D, float>::build(output));
+    check("cache resident working set is flagged", r.cacheResident && r.workingSetBytes == 64. * 32. * 5.);
+    check("cache resident roof is probed, not the DRAM peak",
+          r.roofGBps > peak.bandwidthGBps && r.peak.bandwidthGBps == peak.bandwidthGBps &&
+          r.efficiency == (r.bound == RooflineBound::Memory ? r.achievedGBps / r.roofGBps : r.achievedGops / peak.gops));
+
+    BenchmarkReport report;
+    r.addTo(report, "cast_mul");
+    check("report carries the cache flag", report.toJSON().find("\"cache_resident\": \"true\"") != std::string::npos);
+}
+
+int launch() {
+    testFusedModel();
+    testMachinePeak();
+    testAnalyze();
+    testCacheResident();
+    if (failures == 0) { return 0; }
+    std::cout << failures << " roofline test(s) FAILED" << std::endl;
+    return -1;
+}
@@ -1579,6 +1579,138 @@ bool test_pow_rt() {
     return allCorrect;
 }
 
+// ============================================================================
+// Tests for the batch (fk::Array) kernels selected by cxp::Exec
+// ============================================================================
+
+template <typename T>
+inline long long get_ulp_distance_any(T a, T b) {
+    using Bits = std::conditional_t<std::is_same_v<T, float>, int32_t, int64_t>;
+    if (std::isnan(a) && std::isnan(b))
+        return 0;
+    if (a == b)
+        return 0;
+    if (std::isnan(a) || std::isnan(b) || std::isinf(a) || std::isinf(b))
+        return -1;
+    Bits ia, ib;
+    std::memcpy(&ia, &a, sizeof(T));
+    std::memcpy(&ib, &b, sizeof(T));
+    // Map the sign-magnitude encoding onto a monotonic integer line
+    ia = ia < 0 ? std::numeric_limits<Bits>::min() - ia : ia;
+    ib = ib < 0 ? std::numeric_limits<Bits>::min() - ib : ib;
+    return ia > ib ? static_cast<long long>(ia - ib) : static_cast<long long>(ib - ia);
+}
+
+constexpr bool test_batch_exp_log_ct() {
+    constexpr fk::Array<float, 4> xf{{0.0f, 1.0f, -1.0f, 2.0f}};
+    constexpr auto ef = cxp::expf::f(xf);
+    static_assert(ef[0] == 1.0f, "batch expf(0) should be 1");
+    static_assert(ef[1] > 2.71828f && ef[1] < 2.71829f, "batch expf(1) precision error");
+    static_assert(ef[2] > 0.36787f && ef[2] < 0.36788f, "batch expf(-1) precision error");
+    static_assert(ef[3] > 7.38905f && ef[3] < 7.38906f, "batch expf(2) precision error");
+
+    constexpr fk::Array<float, 8> sf{{std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                                      -std::numeric_limits<float>::infinity(), 89.0f, -105.0f, -88.3721771f, 0.5f,
+                                      -0.0f}};
+    constexpr auto esf = cxp::exp::f(sf);
+    static_assert(cxp::isnan::f(esf[0]), "batch exp(NaN) should be NaN");
+    static_assert(cxp::isinf::f(esf[1]) && cxp::isinf::f(esf[3]), "batch exp overflow should be inf");
+    static_assert(esf[2] == 0.0f && esf[4] == 0.0f, "batch exp underflow should be 0");
+    static_assert(esf[5] > 4.173e-39f && esf[5] < 4.174e-39f, "batch exp subnormal result precision error");
+    static_assert(esf[7] == 1.0f, "batch exp(-0) should be 1");
+
+    constexpr auto lsf = cxp::log::f(fk::Array<float, 8>{{std::numeric_limits<float>::quiet_NaN(), -1.0f, 0.0f,
+                                                        std::numeric_limits<float>::infinity(), 1.0f, 0.5f,
+                                                        std::numeric_limits<float>::denorm_min(), 2.718281828f}});
+    static_assert(cxp::isnan::f(lsf[0]) && cxp::isnan::f(lsf[1]), "batch log(NaN or negative) should be NaN");
+    static_assert(cxp::isinf::f(lsf[2]) && lsf[2] < 0.0f, "batch log(0) should be -inf");
+    static_assert(cxp::isinf::f(lsf[3]) && lsf[3] > 0.0f, "batch log(inf) should be inf");
+    static_assert(lsf[4] == 0.0f, "batch log(1) should be 0");
+    static_assert(lsf[5] > -0.6932f && lsf[5] < -0.6931f, "batch log(0.5) precision error");
+    static_assert(lsf[6] > -103.2790f && lsf[6] < -103.2789f, "batch log(denorm_min) precision error");
+    static_assert(lsf[7] > 0.9999f && lsf[7] < 1.0001f, "batch log(e) precision error");
+
+    constexpr auto ld = cxp::log::f(fk::Array<double, 4>{{1.0, 0.5, 1e-310, 1e300}});
+    static_assert(ld[0] == 0.0 && ld[1] > -0.69315 && ld[1] < -0.69314, "batch log(double) precision error");
+    static_assert(ld[2] > -713.81 && ld[2] < -713.79 && ld[3] > 690.77 && ld[3] < 690.78,
+                  "batch log(double) range error");
+    constexpr auto ed = cxp::exp::f(fk::Array<double, 4>{{0.0, 1.0, -740.0, 709.0}});
+    static_assert(ed[0] == 1.0 && ed[1] > 2.718281828 && ed[1] < 2.718281829, "batch exp(double) precision error");
+    static_assert(ed[2] > 0.0 && ed[3] > 8.21e307 && ed[3] < 8.22e307, "batch exp(double) range error");
+
+    // Ops without a batch kernel run per lane
+    constexpr auto fl = cxp::floor::f(fk::Array<float, 4>{{1.5f, -1.5f, 2.0f, -0.25f}});
+    static_assert(fl[0] == 1.0f && fl[1] == -2.0f && fl[2] == 2.0f && fl[3] == -1.0f, "per lane batch floor failed");
+    return true;
+}
+
+// Sweeps [lo, hi] in N-lane batches, comparing each lane with the scalar function
+template <typename Func, typename T, size_t N>
+bool check_batch_sweep(const char* name, const T lo, const T hi, const int points, const long long maxUlp) {
+    long long worst = 0;
+    T worstX = lo;
+    const T step = (hi - lo) / static_cast<T>(points);
+    for (int i = 0; i < points; i += static_cast<int>(N)) {
+        fk::Array<T, N> x{};
+        for (size_t l = 0; l < N; ++l) {
+            x[l] = lo + step * static_cast<T>(i + static_cast<int>(l));
+        }
+        const fk::Array<T, N> actual = Func::f(x);
+        for (size_t l = 0; l < N; ++l) {
+            const long long ulp = get_ulp_distance_any(actual[l], static_cast<T>(Func::f(x[l])));
+            if (ulp < 0 || ulp > worst) {
+                worst = ulp < 0 ? maxUlp + 1 : ulp;
+                worstX = x[l];
+            }
+        }
+    }
+    if (worst > maxUlp) {
+        std::cout << std::setprecision(std::numeric_limits<T>::max_digits10) << "Failed: batch " << name << "<"
+                  << fk::typeToString<T>() << ", " << N << "> differs from the scalar version by " << worst
+                  << " ULP at " << worstX << " (bound " << maxUlp << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename T, size_t N>
+bool test_batch_exp_log_rt() {
+    constexpr bool IS_FLOAT = std::is_same_v<T, float>;
+    bool allCorrect{true};
+    allCorrect &= check_batch_sweep<cxp::exp, T, N>("exp", IS_FLOAT ? T(-103) : T(-744), IS_FLOAT ? T(88.5) : T(709.7),
+                                                     20000, IS_FLOAT ? 1 : 3);
+    allCorrect &= check_batch_sweep<cxp::exp, T, N>("exp", T(-1), T(1), 4000, IS_FLOAT ? 1 : 3);
+    allCorrect &= check_batch_sweep<cxp::log, T, N>("log", T(1e-6), T(4), 20000, 3);
+    allCorrect &= check_batch_sweep<cxp::log, T, N>("log", T(0.9), T(1.1), 4000, 3);
+    allCorrect &= check_batch_sweep<cxp::log, T, N>("log", T(1), IS_FLOAT ? T(3e38) : T(1e308), 4000, 3);
+    if constexpr (IS_FLOAT) {
+        allCorrect &= check_batch_sweep<cxp::expf, float, N>("expf", -20.0f, 20.0f, 4000, 1);
+        allCorrect &= check_batch_sweep<cxp::logf, float, N>("logf", 1e-38f, 1e-36f, 4000, 3);
+    }
+
+    // Special values in every lane position
+    const T specials[] = {std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::infinity(),
+                          -std::numeric_limits<T>::infinity(), T(0), T(-0.0), T(-1),
+                          std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max()};
+    for (const T special : specials) {
+        for (size_t lane = 0; lane < N; ++lane) {
+            fk::Array<T, N> x{};
+            for (size_t l = 0; l < N; ++l) {
+                x[l] = T(1);
+            }
+            x[lane] = special;
+            const auto e = cxp::exp::f(x);
+            const auto lg = cxp::log::f(x);
+            if (get_ulp_distance_any(e[lane], cxp::exp::f(special)) != 0 ||
+                get_ulp_distance_any(lg[lane], cxp::log::f(special)) > 3) {
+                std::cout << "Failed: batch exp/log special value " << special << " in lane " << lane << std::endl;
+                allCorrect = false;
+            }
+        }
+    }
+    return allCorrect;
+}
+
 // Runtime tests to complement compile-time tests
 bool runtime_tests() {
     bool allCorrect{true};
@@ -1671,6 +1803,13 @@ bool runtime_tests() {
     allCorrect &= test_signbit_rt<float>();
     allCorrect &= test_signbit_rt<double>();
 
+    // Test the batch exp/log kernels against the scalar versions
+    allCorrect &= test_batch_exp_log_rt<float, 4>();
+    allCorrect &= test_batch_exp_log_rt<float, 8>();
+    allCorrect &= test_batch_exp_log_rt<float, 16>();
+    allCorrect &= test_batch_exp_log_rt<double, 4>();
+    allCorrect &= test_batch_exp_log_rt<double, 8>();
+
     return allCorrect;
 }
 
@@ -1735,6 +1874,7 @@ int launch() {
     static_assert(test_log_ct<float>(), "log compile-time tests failed for float");
     static_assert(test_log_ct<double>(), "log compile-time tests failed for double");
     static_assert(test_pow_ct(), "pow compile-time tests failed");
+    static_assert(test_batch_exp_log_ct(), "batch exp/log compile-time tests failed");
 
     // Runtime tests
     if (!runtime_tests()) {
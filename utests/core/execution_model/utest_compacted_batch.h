@@ -0,0 +1,184 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/core/execution_model/operation_model/dynamic_batch_operations.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr uint BATCH = 5;
+constexpr uint MAX_SIDE = 48;
+constexpr float SENTINEL = -7.f;
+constexpr std::array<uint, BATCH> WIDTHS{ 48, 3, 17, 0, 31 };
+constexpr std::array<uint, BATCH> HEIGHTS{ 40, 5, 48, 9, 1 };
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CompactedDPP = fk::CompactedBatchTransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+struct Batch {
+    fk::Ptr2D<uchar> source;
+    std::array<fk::Ptr2D<uchar>, BATCH> crops;
+    std::array<fk::Ptr2D<float>, BATCH> outputs;     // MAX_SIDE x MAX_SIDE allocations
+    std::array<fk::Ptr2D<float>, BATCH> outputViews; // cropped to the plane size
+
+    explicit Batch(const fk::MemType type = fk::MemType::Host) : source(128, 128, 0, type) {
+        for (int y = 0; y < 128; ++y) {
+            for (int x = 0; x < 128; ++x) {
+                source.at(fk::Point{ x, y, 0 }) = static_cast<uchar>((x * 3 + y * 7) % 256);
+            }
+        }
+        for (uint i = 0; i < BATCH; ++i) {
+            crops[i] = source.crop(fk::Point(static_cast<int>(i * 11), static_cast<int>(i * 5), 0),
+                                   fk::PtrDims<fk::ND::_2D>(WIDTHS[i], HEIGHTS[i], source.dims().pitch));
+            outputs[i] = fk::Ptr2D<float>(MAX_SIDE, MAX_SIDE, 0, type);
+            outputViews[i] = outputs[i].crop(fk::Point(0, 0, 0),
+                                             fk::PtrDims<fk::ND::_2D>(WIDTHS[i], HEIGHTS[i], outputs[i].dims().pitch));
+        }
+        reset();
+    }
+
+    void reset() {
+        for (auto& output : outputs) {
+            for (int y = 0; y < static_cast<int>(MAX_SIDE); ++y) {
+                for (int x = 0; x < static_cast<int>(MAX_SIDE); ++x) {
+                    output.at(fk::Point{ x, y, 0 }) = SENTINEL;
+                }
+            }
+        }
+    }
+
+    // Every real pixel holds source * 0.5, everything else the sentinel
+    bool valid() const {
+        for (uint i = 0; i < BATCH; ++i) {
+            for (int y = 0; y < static_cast<int>(MAX_SIDE); ++y) {
+                for (int x = 0; x < static_cast<int>(MAX_SIDE); ++x) {
+                    const fk::Point p{ x, y, 0 };
+                    const bool inside = static_cast<uint>(x) < WIDTHS[i] && static_cast<uint>(y) < HEIGHTS[i];
+                    const float expected = inside ? crops[i].at(p) * 0.5f : SENTINEL;
+                    if (outputs[i].at(p) != expected) return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static void testCompactedExecution(CpuStream& stream) {
+    Batch batch;
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(batch.crops);
+    const auto write = fk::PerThreadWrite<fk::ND::_2D, float>::build(batch.outputViews);
+    fk::executeOperations<CompactedDPP>(stream, read, fk::Cast<uchar, float>::build(),
+                                        fk::Mul<float>::build(0.5f), write);
+    check("only the real pixels of each plane are visited", batch.valid());
+
+    uint workItems = 0;
+    const std::vector<fk::CompactedPlane> planes = fk::CompactedBatchPlanes::build(read, workItems);
+    uint pixels = 0;
+    for (uint i = 0; i < BATCH; ++i) pixels += WIDTHS[i] * HEIGHTS[i];
+    check("work items are the sum of the plane areas", workItems == pixels && planes[2].firstItem == 48 * 40 + 15);
+
+    // Arbitrary splits of the work range, as workers would take them
+    batch.reset();
+    const fk::CompactedBatchTransformDPPDetails details{ planes.data(), BATCH, workItems };
+    const auto fused = fk::FusedOperation<>::build(fk::Cast<uchar, float>::build(), fk::Mul<float>::build(0.5f));
+    const std::array<uint, 6> cuts{ 0, 7, 1930, 1935, 2700, workItems };
+    for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+        CompactedDPP::exec_range(details, cuts[i], cuts[i + 1], read, fused, write);
+    }
+    check("split ranges cover the batch exactly once", batch.valid());
+}
+
+static void testDynamicBatch(CpuStream& stream) {
+    Batch batch;
+    std::vector<fk::Read<fk::PerThreadRead<fk::ND::_2D, uchar>>> reads;
+    for (const auto& crop : batch.crops) reads.push_back(fk::PerThreadRead<fk::ND::_2D, uchar>::build(crop));
+    fk::Ptr1D<fk::OperationData<fk::PerThreadRead<fk::ND::_2D, uchar>>> readPlanes;
+    const auto read = fk::DynamicBatchRead<fk::PlanePolicy::PROCESS_ALL>::build(reads, readPlanes, stream);
+    fk::executeOperations<CompactedDPP>(stream, read, fk::Cast<uchar, float>::build(), fk::Mul<float>::build(0.5f),
+                                        fk::PerThreadWrite<fk::ND::_2D, float>::build(batch.outputViews));
+    check("runtime sized batches are compacted too", batch.valid());
+}
+
+static void testUniformBatch(CpuStream& stream) {
+    // Equal planes: same result as the TransformDPP grid
+    fk::Ptr2D<uchar> image(23, 9, 0, fk::MemType::Host);
+    for (uint y = 0; y < 9; ++y) {
+        for (uint x = 0; x < 23; ++x) {
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), image.ptr()) = static_cast<uchar>(x * y);
+        }
+    }
+    const std::array<fk::Ptr2D<uchar>, 2> inputs{ image, image };
+    fk::Tensor<float> compacted(23, 9, 2, 1, fk::MemType::Host);
+    fk::Tensor<float> grid(23, 9, 2, 1, fk::MemType::Host);
+    fk::executeOperations<CompactedDPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar>::build(inputs),
+        fk::Cast<uchar, float>::build(), fk::PerThreadWrite<fk::ND::_3D, float>::build(compacted));
+    fk::executeOperations<CpuDPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar>::build(inputs),
+        fk::Cast<uchar, float>::build(), fk::PerThreadWrite<fk::ND::_3D, float>::build(grid));
+    bool same = true;
+    for (int z = 0; z < 2; ++z) {
+        for (int y = 0; y < 9; ++y) {
+            for (int x = 0; x < 23; ++x) {
+                same &= *fk::PtrAccessor<fk::ND::_3D>::cr_point(fk::Point(x, y, z), compacted.ptr()) ==
+                        *fk::PtrAccessor<fk::ND::_3D>::cr_point(fk::Point(x, y, z), grid.ptr());
+            }
+        }
+    }
+    check("uniform batch matches TransformDPP", same);
+}
+
+#if defined(__NVCC__)
+// The GPU kernel, with its stream ordered plane table
+static void testCompactedGPU() {
+    fk::Stream_<fk::ParArch::GPU_NVIDIA> stream;
+    Batch batch(fk::MemType::DeviceAndPinned);
+    batch.source.upload(stream);
+    for (auto& output : batch.outputs) output.upload(stream);
+    fk::executeOperations<fk::CompactedBatchTransformDPP<fk::ParArch::GPU_NVIDIA>>(stream,
+        fk::PerThreadRead<fk::ND::_2D, uchar>::build(batch.crops), fk::Cast<uchar, float>::build(),
+        fk::Mul<float>::build(0.5f), fk::PerThreadWrite<fk::ND::_2D, float>::build(batch.outputViews));
+    for (auto& output : batch.outputs) output.download(stream);
+    stream.sync();
+    check("GPU kernel visits only the real pixels of each plane", batch.valid());
+}
+#endif
+
+int launch() {
+    CpuStream stream;
+    testCompactedExecution(stream);
+    testDynamicBatch(stream);
+    testUniformBatch(stream);
+#if defined(__NVCC__)
+    testCompactedGPU();
+#endif
+    return failures == 0 ? 0 : -1;
+}
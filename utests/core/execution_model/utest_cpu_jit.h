@@ -0,0 +1,235 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+// __ONLY_CPU__
+// __CPU_JIT__
+#include <tests/main.h>
+
+#include <fused_kernel/core/execution_model/cpu_jit.h>
+#include <fused_kernel/algorithms/runtime_pipeline/runtime_pipeline_jit.h>
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <sys/stat.h>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr uint WIDTH = 61;
+constexpr uint HEIGHT = 17;
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+template <typename T>
+static fk::Ptr2D<T> makeImage() {
+    fk::Ptr2D<T> image(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    for (uint y = 0; y < HEIGHT; ++y) {
+        for (uint x = 0; x < WIDTH; ++x) {
+            *fk::PtrAccessor<fk::ND::_2D>::point(fk::Point(x, y, 0), image.ptr()) =
+                fk::make_set<T>(static_cast<fk::VBase<T>>((x * 5 + y * 3) % 200 + 1));
+        }
+    }
+    return image;
+}
+
+template <typename T>
+static bool equalImages(const fk::Ptr2D<T>& a, const fk::Ptr2D<T>& b) {
+    for (uint y = 0; y < HEIGHT; ++y) {
+        for (uint x = 0; x < WIDTH; ++x) {
+            const T va = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), a.ptr());
+            const T vb = *fk::PtrAccessor<fk::ND::_2D>::cr_point(fk::Point(x, y, 0), b.ptr());
+            if (std::memcmp(&va, &vb, sizeof(T)) != 0) return false;
+        }
+    }
+    return true;
+}
+
+static fk::CpuJitConfig testConfig(const std::filesystem::path& cacheDir) {
+    fk::CpuJitConfig config = fk::CpuJitConfig::fromEnvironment();
+    config.cacheDir = cacheDir;
+    return config;
+}
+
+static void testExecuteOperations(CpuStream& stream, const std::filesystem::path& cacheDir) {
+    const auto input = makeImage<uchar3>();
+    fk::Ptr2D<float3> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<float3> expected(WIDTH, HEIGHT, 0, fk::MemType::Host);
+
+    const auto read = fk::PerThreadRead<fk::ND::_2D, uchar3>::build(input);
+    const auto cast = fk::Cast<uchar3, float3>::build();
+    const auto mul = fk::Mul<float3>::build(fk::make_set<float3>(0.5f));
+    const auto sub = fk::Sub<float3>::build(fk::make_<float3>(1.f, 2.f, 3.f));
+
+    fk::executeOperations<CpuDPP>(stream, read, cast, mul, sub, fk::PerThreadWrite<fk::ND::_2D, float3>::build(expected));
+
+    fk::CpuJit jit(testConfig(cacheDir));
+    jit.executeOperations<CpuDPP>(stream, read, cast, mul, sub, fk::PerThreadWrite<fk::ND::_2D, float3>::build(output));
+    check("first run compiles the pipeline", jit.stats().compiled == 1 && jit.stats().diskHits == 0);
+    check("JIT pipeline matches the compiled pipeline", equalImages(output, expected));
+
+    // Params are runtime values, so they do not change the generated source
+    jit.executeOperations<CpuDPP>(stream, read, cast, fk::Mul<float3>::build(fk::make_set<float3>(2.f)), sub,
+                                  fk::PerThreadWrite<fk::ND::_2D, float3>::build(output));
+    check("new params reuse the loaded object", jit.stats().compiled == 1 && jit.stats().memoryHits == 1);
+
+    // A new process would start like a new CpuJit on the same directory
+    fk::CpuJit warm(testConfig(cacheDir));
+    warm.executeOperations<CpuDPP>(stream, read, cast, mul, sub, fk::PerThreadWrite<fk::ND::_2D, float3>::build(output));
+    check("warm start loads from the disk cache", warm.stats().compiled == 0 && warm.stats().diskHits == 1);
+    check("cached pipeline matches the compiled pipeline", equalImages(output, expected));
+}
+
+static void testRuntimePipeline(const std::filesystem::path& cacheDir) {
+    const auto input = makeImage<uchar4>();
+    fk::Ptr2D<uchar4> output(WIDTH, HEIGHT, 0, fk::MemType::Host);
+    fk::Ptr2D<uchar4> interpreted(WIDTH, HEIGHT, 0, fk::MemType::Host);
+
+    fk::RuntimePipeline reference(fk::RtFormatOf<uchar4>::value, fk::RtFormatOf<uchar4>::value);
+    reference.add(fk::RtOp::ADD, 3.f).add(fk::RtOp::SQRT).add(fk::RtOp::MUL, 9.f);
+    check("graph has no precompiled super-kernel", !reference.compile().direct);
+    reference.execute(input, interpreted);
+
+    fk::CpuJit jit(testConfig(cacheDir));
+    fk::RuntimePipeline pipeline = reference;
+    const fk::RtPlan plan = fk::jitCompile(pipeline, jit);
+    pipeline.execute(input, output);
+    check("JIT super-kernel covers the graph", plan.direct && plan.interpretedNodes == 0 &&
+                                               plan.kernel.name == "jit_u8c4_add_sqrt_mul_u8c4");
+    check("JIT super-kernel matches the interpreter", equalImages(output, interpreted));
+    check("registered for later pipelines", reference.compile().direct && jit.stats().compiled == 1);
+}
+
+static void testCompileError(const std::filesystem::path& cacheDir) {
+    fk::CpuJit jit(testConfig(cacheDir));
+    bool thrown = false;
+    try {
+        jit.load("extern \"C\" void broken() { undeclared(); }\n", "broken");
+    } catch (const std::runtime_error& error) {
+        thrown = std::string(error.what()).find("undeclared") != std::string::npos;
+    }
+    check("compiler errors are reported", thrown && jit.stats().compiled == 0);
+}
+
+// A header edit must not reuse the objects built from the old header
+static void testHeaderChange(const std::filesystem::path& cacheDir) {
+    const std::filesystem::path includeDir = cacheDir / "include";
+    std::filesystem::create_directories(includeDir);
+    const std::filesystem::path header = includeDir / "fk_utest_jit_header.h";
+    const auto writeHeader = [&header](const char* text) {
+        std::ofstream file(header, std::ios::trunc);
+        file << text;
+    };
+    fk::CpuJitConfig config = testConfig(cacheDir);
+    config.includeDirs.push_back(includeDir.string());
+    config.headers.push_back("fk_utest_jit_header.h");
+    const std::string body = "extern \"C\" int value() { return FK_UTEST_JIT_VALUE; }\n";
+
+    writeHeader("#define FK_UTEST_JIT_VALUE 1\n");
+    fk::CpuJit before(config);
+    const int first = reinterpret_cast<int (*)()>(before.load(body, "value"))();
+    writeHeader("#define FK_UTEST_JIT_VALUE 200\n");
+    fk::CpuJit after(config);
+    const int second = reinterpret_cast<int (*)()>(after.load(body, "value"))();
+    check("header changes invalidate the cache key", before.key(body) != after.key(body) &&
+                                                     first == 1 && second == 200 && after.stats().compiled == 1);
+}
+
+// The default cache is per user, and nothing another user could write is dlopened
+static void testCacheOwnership(const std::filesystem::path& cacheDir) {
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    const char* home = std::getenv("HOME");
+    const std::string savedXdg = xdg != nullptr ? xdg : "";
+    const std::string savedHome = home != nullptr ? home : "";
+    setenv("XDG_CACHE_HOME", "/fk/xdg", 1);
+    const bool xdgDefault = fk::CpuJitConfig::defaultCacheDir() == std::filesystem::path("/fk/xdg/fkl_cpu_jit");
+    unsetenv("XDG_CACHE_HOME");
+    unsetenv("HOME");
+    const bool tempDefault = fk::CpuJitConfig::defaultCacheDir().filename() == "fkl_cpu_jit_" + std::to_string(geteuid());
+    if (xdg != nullptr) setenv("XDG_CACHE_HOME", savedXdg.c_str(), 1);
+    if (home != nullptr) setenv("HOME", savedHome.c_str(), 1);
+    check("default cache directory is per user", xdgDefault && tempDefault);
+
+    const std::string body = "extern \"C\" int owned() { return 7; }\n";
+    const std::filesystem::path ownDir = cacheDir / "own";
+    fk::CpuJit jit(testConfig(ownDir));
+    const int value = reinterpret_cast<int (*)()>(jit.load(body, "owned"))();
+    struct stat info;
+    const bool privateDir = stat(ownDir.c_str(), &info) == 0 && (info.st_mode & 0777) == 0700;
+    check("cache directory is created with mode 0700", value == 7 && privateDir);
+
+    const auto refused = [&body](const std::filesystem::path& dir) {
+        fk::CpuJit other(testConfig(dir));
+        try {
+            other.load(body, "owned");
+        } catch (const std::runtime_error& error) {
+            return std::string(error.what()).find("refusing") != std::string::npos;
+        }
+        return false;
+    };
+    const std::filesystem::path sharedDir = cacheDir / "shared";
+    std::filesystem::create_directories(sharedDir);
+    std::filesystem::permissions(sharedDir, std::filesystem::perms::all);
+    check("world writable cache directory is refused", refused(sharedDir));
+
+    std::filesystem::permissions(ownDir / (jit.key(body) + ".so"), std::filesystem::perms::group_write,
+                                 std::filesystem::perm_options::add);
+    check("group writable object is refused", refused(ownDir));
+}
+
+static void testConcurrentLoads(const std::filesystem::path& cacheDir) {
+    fk::CpuJit jit(testConfig(cacheDir / "concurrent"));
+    const std::string body = "extern \"C\" int shared() { return 11; }\n";
+    void* addresses[2]{};
+    std::thread first([&] { addresses[0] = jit.load(body, "shared"); });
+    std::thread second([&] { addresses[1] = jit.load(body, "shared"); });
+    first.join();
+    second.join();
+    const fk::CpuJitStats stats = jit.stats();
+    check("concurrent loads of one object agree",
+          addresses[0] != nullptr && addresses[0] == addresses[1] &&
+          reinterpret_cast<int (*)()>(addresses[0])() == 11 &&
+          stats.compiled + stats.diskHits + stats.memoryHits == 2 && stats.compiled >= 1);
+}
+
+int launch() {
+    const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() /
+                                           ("fkl_utest_cpu_jit_" + std::to_string(getpid()));
+    CpuStream stream;
+    testExecuteOperations(stream, cacheDir);
+    testRuntimePipeline(cacheDir);
+    testHeaderChange(cacheDir);
+    testCompileError(cacheDir);
+    testCacheOwnership(cacheDir);
+    testConcurrentLoads(cacheDir);
+    std::error_code error;
+    std::filesystem::remove_all(cacheDir, error);
+    return failures == 0 ? 0 : -1;
+}
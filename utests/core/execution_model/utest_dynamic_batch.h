@@ -0,0 +1,203 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/core/execution_model/operation_model/dynamic_batch_operations.h>
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr uint WIDTH = 29;
+constexpr uint HEIGHT = 13;
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+using PlaneRead = fk::PerThreadRead<fk::ND::_2D, uchar3>;
+
+static std::vector<fk::Ptr2D<uchar3>> makeImages(const uint count, const fk::MemType type = fk::MemType::Host) {
+    std::vector<fk::Ptr2D<uchar3>> images;
+    for (uint i = 0; i < count; ++i) {
+        fk::Ptr2D<uchar3> image(WIDTH, HEIGHT, 0, type);
+        for (uint y = 0; y < HEIGHT; ++y) {
+            for (uint x = 0; x < WIDTH; ++x) {
+                image.at(fk::Point(x, y, 0)) =
+                    fk::make_<uchar3>(static_cast<uchar>(x + i), static_cast<uchar>(y * 3 + i), static_cast<uchar>(i * 11));
+            }
+        }
+        images.push_back(image);
+    }
+    return images;
+}
+
+static bool equalTensors(const fk::Tensor<float3>& a, const fk::Tensor<float3>& b, const uint planes) {
+    for (uint z = 0; z < planes; ++z) {
+        for (uint y = 0; y < HEIGHT; ++y) {
+            for (uint x = 0; x < WIDTH; ++x) {
+                const float3 va = *fk::PtrAccessor<fk::ND::_3D>::cr_point(fk::Point(x, y, z), a.ptr());
+                const float3 vb = *fk::PtrAccessor<fk::ND::_3D>::cr_point(fk::Point(x, y, z), b.ptr());
+                if (std::memcmp(&va, &vb, sizeof(float3)) != 0) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static std::vector<fk::Read<PlaneRead>> makeReads(const std::vector<fk::Ptr2D<uchar3>>& images) {
+    std::vector<fk::Read<PlaneRead>> reads;
+    for (const auto& image : images) reads.push_back(PlaneRead::build(image));
+    return reads;
+}
+
+static void testProcessAll(CpuStream& stream) {
+    constexpr uint BATCH = 5;
+    const auto images = makeImages(BATCH);
+    std::array<fk::Ptr2D<uchar3>, BATCH> imageArray;
+    for (uint i = 0; i < BATCH; ++i) imageArray[i] = images[i];
+
+    fk::Tensor<float3> output(WIDTH, HEIGHT, BATCH, 1, fk::MemType::Host);
+    fk::Tensor<float3> expected(WIDTH, HEIGHT, BATCH, 1, fk::MemType::Host);
+    const auto mul = fk::Mul<float3>::build(fk::make_set<float3>(0.5f));
+
+    fk::executeOperations<CpuDPP>(stream, PlaneRead::build(imageArray), fk::Cast<uchar3, float3>::build(), mul,
+                                  fk::PerThreadWrite<fk::ND::_3D, float3>::build(expected));
+
+    fk::Ptr1D<fk::OperationData<PlaneRead>> planes;
+    const auto batchRead = fk::DynamicBatchRead<fk::PlanePolicy::PROCESS_ALL>::build(makeReads(images), planes, stream);
+    fk::executeOperations<CpuDPP>(stream, batchRead, fk::Cast<uchar3, float3>::build(), mul,
+                                  fk::PerThreadWrite<fk::ND::_3D, float3>::build(output));
+
+    check("dynamic batch matches the compile-time batch", equalTensors(output, expected, BATCH));
+    // The CPU launch reads planes.ptr(), so planes can not take defaultMemType,
+    // which is DeviceAndPinned when this file is compiled by nvcc
+    check("planes default to host memory on CPU streams", planes.getMemType() == fk::MemType::Host);
+    check("grid covers the runtime batch", batchRead.params.activeThreads.z == BATCH &&
+                                           batchRead.params.activeThreads.x == WIDTH);
+}
+
+static void testConditional(CpuStream& stream) {
+    constexpr uint BATCH = 7;
+    constexpr int USED = 4;
+    const auto images = makeImages(BATCH);
+    const float3 defaultValue = fk::make_<float3>(-1.f, -2.f, -3.f);
+
+    fk::Tensor<float3> output(WIDTH, HEIGHT, BATCH, 1, fk::MemType::Host);
+    fk::Tensor<float3> expected(WIDTH, HEIGHT, BATCH, 1, fk::MemType::Host);
+    std::array<fk::Ptr2D<uchar3>, BATCH> imageArray;
+    for (uint i = 0; i < BATCH; ++i) imageArray[i] = images[i];
+    fk::executeOperations<CpuDPP>(stream, PlaneRead::build(USED, fk::make_<uchar3>(0, 0, 0), imageArray),
+                                  fk::Cast<uchar3, float3>::build(), fk::PerThreadWrite<fk::ND::_3D, float3>::build(expected));
+    for (uint z = USED; z < BATCH; ++z) {
+        for (uint y = 0; y < HEIGHT; ++y) {
+            for (uint x = 0; x < WIDTH; ++x) {
+                *fk::PtrAccessor<fk::ND::_3D>::point(fk::Point(x, y, z), expected.ptr()) = defaultValue;
+            }
+        }
+    }
+
+    // Runtime batch sizes share one type and one buffer, grown on demand
+    using FusedRead = decltype(fk::FusedOperation<>::build(PlaneRead::build(images[0]), fk::Cast<uchar3, float3>::build()));
+    std::vector<FusedRead> reads;
+    for (const auto& image : images) {
+        reads.push_back(fk::FusedOperation<>::build(PlaneRead::build(image), fk::Cast<uchar3, float3>::build()));
+    }
+    fk::Ptr1D<fk::OperationData<typename FusedRead::Operation>> planes(2, 0, fk::MemType::Host);
+    const auto small = fk::DynamicBatchRead<fk::PlanePolicy::CONDITIONAL_WITH_DEFAULT>::build(
+        std::vector<FusedRead>(reads.begin(), reads.begin() + 2), 2, defaultValue, planes, stream);
+    const auto batchRead = fk::DynamicBatchRead<fk::PlanePolicy::CONDITIONAL_WITH_DEFAULT>::build(reads, USED, defaultValue, planes, stream);
+    check("batch sizes share one instantiation", std::is_same_v<decltype(small), decltype(batchRead)>);
+    check("planes buffer grows to the batch", planes.dims().width == BATCH);
+
+    fk::executeOperations<CpuDPP>(stream, batchRead, fk::PerThreadWrite<fk::ND::_3D, float3>::build(output));
+    check("unused planes get the default value", equalTensors(output, expected, BATCH));
+}
+
+static void testEmptyBatch(CpuStream& stream) {
+    fk::Ptr1D<fk::OperationData<PlaneRead>> planes;
+    bool thrown = false;
+    try {
+        fk::DynamicBatchRead<fk::PlanePolicy::PROCESS_ALL>::build(std::vector<fk::Read<PlaneRead>>{}, planes, stream);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check("empty batch rejected", thrown);
+}
+
+#if defined(__NVCC__)
+// The same batch on a GPU stream: planes default to DeviceAndPinned and are uploaded
+static void testProcessAllGPU() {
+    constexpr uint BATCH = 5;
+    fk::Stream_<fk::ParArch::GPU_NVIDIA> stream;
+    auto images = makeImages(BATCH, fk::MemType::DeviceAndPinned);
+    for (auto& image : images) image.upload(stream);
+
+    fk::Tensor<float3> output(WIDTH, HEIGHT, BATCH, 1, fk::MemType::DeviceAndPinned);
+    fk::Tensor<float3> expected(WIDTH, HEIGHT, BATCH, 1, fk::MemType::Host);
+    CpuStream cpuStream;
+    fk::Ptr1D<fk::OperationData<PlaneRead>> cpuPlanes;
+    fk::executeOperations<CpuDPP>(cpuStream,
+                                  fk::DynamicBatchRead<fk::PlanePolicy::PROCESS_ALL>::build(makeReads(makeImages(BATCH)),
+                                                                                            cpuPlanes, cpuStream),
+                                  fk::Cast<uchar3, float3>::build(),
+                                  fk::PerThreadWrite<fk::ND::_3D, float3>::build(expected));
+
+    fk::Ptr1D<fk::OperationData<PlaneRead>> planes;
+    const auto batchRead = fk::DynamicBatchRead<fk::PlanePolicy::PROCESS_ALL>::build(makeReads(images), planes, stream);
+    fk::executeOperations<fk::TransformDPP<fk::ParArch::GPU_NVIDIA>>(stream, batchRead,
+                                                                      fk::Cast<uchar3, float3>::build(),
+                                                                      fk::PerThreadWrite<fk::ND::_3D, float3>::build(output));
+    output.download(stream);
+    stream.sync();
+
+    bool same = planes.getMemType() == fk::MemType::DeviceAndPinned;
+    for (uint z = 0; z < BATCH; ++z) {
+        for (uint y = 0; y < HEIGHT; ++y) {
+            for (uint x = 0; x < WIDTH; ++x) {
+                const float3 va = output.at(fk::Point(x, y, z));
+                const float3 vb = expected.at(fk::Point(x, y, z));
+                same = same && std::memcmp(&va, &vb, sizeof(float3)) == 0;
+            }
+        }
+    }
+    check("dynamic batch on a GPU stream matches the CPU stream", same);
+}
+#endif
+
+int launch() {
+    CpuStream stream;
+    testProcessAll(stream);
+    testConditional(stream);
+    testEmptyBatch(stream);
+#if defined(__NVCC__)
+    testProcessAllGPU();
+#endif
+    return failures == 0 ? 0 : -1;
+}
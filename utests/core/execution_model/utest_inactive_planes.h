@@ -0,0 +1,168 @@
+/* Copyright 2026 the Fused Kernel Library authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <tests/main.h>
+
+#include <fused_kernel/algorithms/basic_ops/arithmetic.h>
+#include <fused_kernel/algorithms/basic_ops/cast.h>
+#include <fused_kernel/algorithms/basic_ops/memory_operations.h>
+#include <fused_kernel/core/data/ptr_utils.h>
+#include <fused_kernel/core/execution_model/operation_model/dynamic_batch_operations.h>
+#include <fused_kernel/fused_kernel.h>
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+static int failures = 0;
+
+static void check(const char* name, const bool ok) {
+    if (ok) {
+        std::cout << "Running test " << name << ": Success!!" << std::endl;
+    } else {
+        std::cout << "FAIL " << name << std::endl;
+        ++failures;
+    }
+}
+
+constexpr uint BATCH = 8;
+constexpr uint WIDTH = 6;
+constexpr uint HEIGHT = 4;
+constexpr uchar DEFAULT_VALUE = 9;
+constexpr float SENTINEL = -7.f;
+
+using CpuDPP = fk::TransformDPP<fk::ParArch::CPU>;
+using CompactedDPP = fk::CompactedBatchTransformDPP<fk::ParArch::CPU>;
+using CpuStream = fk::Stream_<fk::ParArch::CPU>;
+
+struct Planes {
+    std::array<fk::Ptr2D<uchar>, BATCH> inputs;
+    fk::Tensor<float> output;
+
+    explicit Planes(const fk::MemType type = fk::MemType::Host) : output(WIDTH, HEIGHT, BATCH, 1, type) {
+        for (int z = 0; z < static_cast<int>(BATCH); ++z) {
+            inputs[z] = fk::Ptr2D<uchar>(WIDTH, HEIGHT, 0, type);
+            for (int y = 0; y < static_cast<int>(HEIGHT); ++y) {
+                for (int x = 0; x < static_cast<int>(WIDTH); ++x) {
+                    inputs[z].at(fk::Point{ x, y, 0 }) = static_cast<uchar>(x + y * 10 + z * 40);
+                    output.at(fk::Point{ x, y, z }) = SENTINEL;
+                }
+            }
+        }
+    }
+
+    // Used planes hold input * 0.5 + 1, the inactive ones the default through the
+    // same chain, or the sentinel when they are skipped
+    bool valid(const int usedPlanes, const bool filled) const {
+        for (int z = 0; z < static_cast<int>(BATCH); ++z) {
+            for (int y = 0; y < static_cast<int>(HEIGHT); ++y) {
+                for (int x = 0; x < static_cast<int>(WIDTH); ++x) {
+                    float expected = SENTINEL;
+                    if (z < usedPlanes) {
+                        expected = inputs[z].at(fk::Point{ x, y, 0 }) * 0.5f + 1.f;
+                    } else if (filled) {
+                        expected = DEFAULT_VALUE * 0.5f + 1.f;
+                    }
+                    if (output.at(fk::Point{ x, y, z }) != expected) return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+template <typename DPP, typename StreamType, typename ReadIOp>
+static void execute(StreamType& stream, const ReadIOp& read, Planes& planes) {
+    fk::executeOperations<DPP>(stream, read, fk::Cast<uchar, float>::build(), fk::Mul<float>::build(0.5f),
+                               fk::Add<float>::build(1.f), fk::PerThreadWrite<fk::ND::_3D, float>::build(planes.output));
+}
+
+template <typename DPP>
+static void testInactivePlanes(CpuStream& stream, const char* fillName, const char* skipName) {
+    {
+        Planes planes;
+        execute<DPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar>::build(3, DEFAULT_VALUE, planes.inputs), planes);
+        check(fillName, planes.valid(3, true));
+    }
+    {
+        Planes planes;
+        auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(3, DEFAULT_VALUE, planes.inputs);
+        read.params.inactivePlanes = fk::InactivePlanes::SKIP;
+        execute<DPP>(stream, read, planes);
+        check(skipName, planes.valid(3, false));
+    }
+}
+
+#if defined(__NVCC__)
+// The same fill and skip cases through the GPU kernels
+template <typename DPP>
+static void testInactivePlanesGPU(const char* fillName, const char* skipName) {
+    fk::Stream_<fk::ParArch::GPU_NVIDIA> stream;
+    for (const fk::InactivePlanes mode : { fk::InactivePlanes::FILL, fk::InactivePlanes::SKIP }) {
+        Planes planes(fk::MemType::DeviceAndPinned);
+        for (auto& input : planes.inputs) input.upload(stream);
+        planes.output.upload(stream);
+        auto read = fk::PerThreadRead<fk::ND::_2D, uchar>::build(3, DEFAULT_VALUE, planes.inputs);
+        read.params.inactivePlanes = mode;
+        execute<DPP>(stream, read, planes);
+        planes.output.download(stream);
+        stream.sync();
+        const bool filled = mode == fk::InactivePlanes::FILL;
+        check(filled ? fillName : skipName, planes.valid(3, filled));
+    }
+}
+#endif
+
+static void testPlaneCounts(CpuStream& stream) {
+    bool ok = true;
+    for (const int usedPlanes : { -2, 0, 1, 7, 8, 12 }) {
+        Planes planes;
+        execute<CpuDPP>(stream, fk::PerThreadRead<fk::ND::_2D, uchar>::build(usedPlanes, DEFAULT_VALUE, planes.inputs), planes);
+        ok &= planes.valid(usedPlanes, true);
+    }
+    check("usedPlanes out of range is clamped to the batch", ok);
+}
+
+static void testDynamicBatch(CpuStream& stream) {
+    Planes planes;
+    std::vector<fk::Read<fk::PerThreadRead<fk::ND::_2D, uchar>>> reads;
+    for (const auto& input : planes.inputs) reads.push_back(fk::PerThreadRead<fk::ND::_2D, uchar>::build(input));
+    fk::Ptr1D<fk::OperationData<fk::PerThreadRead<fk::ND::_2D, uchar>>> readPlanes;
+    auto read = fk::DynamicBatchRead<fk::PlanePolicy::CONDITIONAL_WITH_DEFAULT>::build(reads, 5, DEFAULT_VALUE, readPlanes, stream);
+    execute<CpuDPP>(stream, read, planes);
+    check("DynamicBatchRead fills its inactive planes", planes.valid(5, true));
+
+    Planes skipped;
+    read.params.inactivePlanes = fk::InactivePlanes::SKIP;
+    execute<CpuDPP>(stream, read, skipped);
+    check("DynamicBatchRead skips its inactive planes", skipped.valid(5, false));
+}
+
+int launch() {
+    CpuStream stream;
+    testInactivePlanes<CpuDPP>(stream, "TransformDPP fills the inactive planes with the default",
+                               "TransformDPP leaves skipped planes untouched");
+    testInactivePlanes<CompactedDPP>(stream, "CompactedBatchTransformDPP fills the inactive planes with the default",
+                                     "CompactedBatchTransformDPP leaves skipped planes untouched");
+    testPlaneCounts(stream);
+    testDynamicBatch(stream);
+#if defined(__NVCC__)
+    testInactivePlanesGPU<fk::TransformDPP<fk::ParArch::GPU_NVIDIA>>(
+        "GPU TransformDPP fills the inactive planes with the default", "GPU TransformDPP leaves skipped planes untouched");
+    testInactivePlanesGPU<fk::CompactedBatchTransformDPP<fk::ParArch::GPU_NVIDIA>>(
+        "GPU CompactedBatchTransformDPP fills the inactive planes with the default",
+        "GPU CompactedBatchTransformDPP leaves skipped planes untouched");
+#endif
+    return failures == 0 ? 0 : -1;
+}